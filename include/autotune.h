@@ -6,6 +6,9 @@
 #ifndef _AUTOTUNE_H
 #define _AUTOTUNE_H
 
+#define AUTOTUNE_CACHE_FOLDER  "autotune"
+#define AUTOTUNE_CACHE_VERSION (0x68636174756e6500 | 0x01)
+
 HC_API_CALL void *thread_autotune (void *p);
 
 #endif // _AUTOTUNE_H
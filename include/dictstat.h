@@ -20,6 +20,13 @@
 #define DICTSTAT_FILENAME "hashcat.dictstat2"
 #define DICTSTAT_VERSION  (0x6863646963743200 | 0x02)
 
+#define DICTSTAT_INDEX_FOLDER   "dictidx"
+#define DICTSTAT_INDEX_VERSION  (0x6863646963746900 | 0x02)
+#define DICTSTAT_INDEX_INTERVAL 0x40000
+#define DICTSTAT_GZIDX_SPAN     0x2000000
+
+#define INCR_DICTSTAT_INDEX 1024
+
 int sort_by_dictstat (const void *s1, const void *s2);
 
 int  dictstat_init    (hashcat_ctx_t *hashcat_ctx);
@@ -29,4 +36,11 @@ int  dictstat_write   (hashcat_ctx_t *hashcat_ctx);
 u64  dictstat_find    (hashcat_ctx_t *hashcat_ctx, dictstat_t *d);
 void dictstat_append  (hashcat_ctx_t *hashcat_ctx, dictstat_t *d);
 
+void dictstat_index_reset (hashcat_ctx_t *hashcat_ctx);
+void dictstat_index_read  (hashcat_ctx_t *hashcat_ctx, const dictstat_t *d, const u32 parser, const char *dictfile);
+int  dictstat_index_write (hashcat_ctx_t *hashcat_ctx, const dictstat_t *d, const u32 parser, const char *dictfile, u64 *index_buf, const u64 index_cnt, hc_gzidx_t *gzidx);
+bool dictstat_index_find  (hashcat_ctx_t *hashcat_ctx, const char *dictfile, const u64 words, u64 *index_words, u64 *index_off);
+
+const hc_gzidx_t *dictstat_index_find_gzidx (hashcat_ctx_t *hashcat_ctx, const char *dictfile);
+
 #endif // _DICTSTAT_H
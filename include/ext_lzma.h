@@ -7,6 +7,9 @@
 
 #include <LzmaDec.h>
 #include <Lzma2Dec.h>
+#include <Xz.h>
+#include <XzCrc64.h>
+#include <7zCrc.h>
 
 #include "contrib/minizip/ioapi.h"
 #include "contrib/minizip/unzip.h"
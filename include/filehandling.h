@@ -11,6 +11,9 @@
 #include <errno.h>
 #include <inttypes.h>
 
+#define INCR_GZIDX   64
+#define XZ_WAIT_USEC 100
+
 #if defined (__CYGWIN__)
 int    _wopen       (const char *path, int oflag, ...);
 #endif
@@ -25,12 +28,19 @@ off_t  hc_ftell     (HCFILE *fp);
 int    hc_fgetc     (HCFILE *fp);
 int    hc_fileno    (HCFILE *fp);
 int    hc_feof      (HCFILE *fp);
+int    hc_ferror    (HCFILE *fp);
 void   hc_fflush    (HCFILE *fp);
 void   hc_fclose    (HCFILE *fp);
 int    hc_fputc     (int c, HCFILE *fp);
 char  *hc_fgets     (char *buf, int len, HCFILE *fp);
 size_t hc_fwrite    (const void *ptr, size_t size, size_t nmemb, HCFILE *fp);
 size_t hc_fread     (void *ptr, size_t size, size_t nmemb, HCFILE *fp);
+bool   hc_fmmap     (HCFILE *fp);
+
+bool        hc_gzidx_build   (HCFILE *fp, const u64 span);
+hc_gzidx_t *hc_gzidx_release (HCFILE *fp);
+void        hc_gzidx_attach  (HCFILE *fp, const hc_gzidx_t *gzidx);
+void        hc_gzidx_free    (hc_gzidx_t *gzidx);
 
 size_t fgetl        (HCFILE *fp, char *line_buf, const size_t line_sz);
 u64    count_lines  (HCFILE *fp);
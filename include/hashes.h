@@ -6,6 +6,8 @@
 #ifndef _HASHES_H
 #define _HASHES_H
 
+#define CRACK_WRITER_WAIT_USEC  100
+
 int sort_by_string       (const void *p1, const void *p2);
 int sort_by_digest_p0p1  (const void *v1, const void *v2, void *v3);
 int sort_by_salt         (const void *v1, const void *v2);
@@ -16,7 +18,14 @@ int hash_encode (const hashconfig_t *hashconfig, const hashes_t *hashes, const m
 
 int save_hash (hashcat_ctx_t *hashcat_ctx);
 
-void check_hash (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, plain_t *plain);
+crack_entry_t *check_hash (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, plain_t *plain);
+
+HC_API_CALL void *thread_crack_writer (void *p);
+
+int  crack_writer_init    (hashcat_ctx_t *hashcat_ctx);
+void crack_writer_destroy (hashcat_ctx_t *hashcat_ctx);
+void crack_writer_push    (hashcat_ctx_t *hashcat_ctx, crack_entry_t *cracks_head, crack_entry_t *cracks_tail, const u64 cracks_cnt);
+void crack_writer_drain   (hashcat_ctx_t *hashcat_ctx);
 
 int check_cracked (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u32 salt_pos);
 
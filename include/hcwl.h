@@ -0,0 +1,28 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#ifndef _HCWL_H
+#define _HCWL_H
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <inttypes.h>
+
+#define HCWL_VERSION      (0x6863776c00000000 | 0x01)
+#define HCWL_EXTENSION    ".hcwl"
+#define HCWL_DATA_OFFSET  4096
+#define HCWL_STAGE_SIZE   0x10000
+
+bool hcwl_detect       (HCFILE *fp);
+int  hcwl_check        (hashcat_ctx_t *hashcat_ctx, HCFILE *fp, const char *dictfile);
+int  hcwl_count_words  (hashcat_ctx_t *hashcat_ctx, HCFILE *fp, u64 *result);
+int  hcwl_compile      (hashcat_ctx_t *hashcat_ctx);
+
+int  hcwl_open         (hashcat_ctx_t *hashcat_ctx, hcwl_t *hcwl, HCFILE *fp);
+void hcwl_close        (hcwl_t *hcwl);
+void hcwl_get          (hcwl_t *hcwl, HCFILE *fp, hc_device_param_t *device_param, const u64 words_off, const u64 words_fin);
+
+#endif // _HCWL_H
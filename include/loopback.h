@@ -18,6 +18,8 @@ void loopback_destroy       (hashcat_ctx_t *hashcat_ctx);
 int  loopback_write_open    (hashcat_ctx_t *hashcat_ctx);
 void loopback_write_close   (hashcat_ctx_t *hashcat_ctx);
 void loopback_write_append  (hashcat_ctx_t *hashcat_ctx, const u8 *plain_ptr, const unsigned int plain_len);
+void loopback_write_lock    (hashcat_ctx_t *hashcat_ctx);
+void loopback_write_unlock  (hashcat_ctx_t *hashcat_ctx);
 void loopback_write_unlink  (hashcat_ctx_t *hashcat_ctx);
 
 #endif // _LOOPBACK_H
@@ -13,23 +13,41 @@
 
 #define INCR_POT 1000
 
+#define POTFILE_IDX_SUFFIX  ".idx"
+#define POTFILE_IDX_VERSION (0x6863706f74696400 | 0x02)
+
+#define POTFILE_IDX_LINE    1 // one line appended by hashcat, searchable by fingerprint
+#define POTFILE_IDX_LEGACY  2 // lines of unknown hash-mode, not written through the index
+#define POTFILE_IDX_SCAN    3 // a legacy range or lines of other hash-modes were parsed once for this hash-mode, their lines have POTFILE_IDX_LINE entries now
+
+#define INCR_POTFILE_IDX    0x10000
+
+#define POTFILE_REMOVE_CHUNK_MIN  0x400000 // bytes of the potfile per parser thread, at least
+#define POTFILE_REMOVE_LINES_MIN  0x400    // indexed lines per parser thread, at least
+
 int  potfile_init             (hashcat_ctx_t *hashcat_ctx);
 int  potfile_read_open        (hashcat_ctx_t *hashcat_ctx);
 void potfile_read_close       (hashcat_ctx_t *hashcat_ctx);
 int  potfile_write_open       (hashcat_ctx_t *hashcat_ctx);
 void potfile_write_close      (hashcat_ctx_t *hashcat_ctx);
 void potfile_write_append     (hashcat_ctx_t *hashcat_ctx, const char *out_buf, const int out_len, u8 *plain_ptr, unsigned int plain_len);
+void potfile_write_lock       (hashcat_ctx_t *hashcat_ctx);
+void potfile_write_unlock     (hashcat_ctx_t *hashcat_ctx);
 int  potfile_remove_parse     (hashcat_ctx_t *hashcat_ctx);
+
+HC_API_CALL void *thread_potfile_remove (void *p);
+
 void potfile_destroy          (hashcat_ctx_t *hashcat_ctx);
 int  potfile_handle_show      (hashcat_ctx_t *hashcat_ctx);
 int  potfile_handle_left      (hashcat_ctx_t *hashcat_ctx);
 
 void potfile_update_hash      (hashcat_ctx_t *hashcat_ctx, hash_t *found,  char *line_pw_buf, int line_pw_len);
-void potfile_update_hashes    (hashcat_ctx_t *hashcat_ctx, hash_t *hash_buf, char *line_pw_buf, int line_pw_len, pot_tree_entry_t *tree);
+void potfile_update_hashes    (hashcat_ctx_t *hashcat_ctx, hash_t *hash_buf, char *line_pw_buf, int line_pw_len, const u64 line_off, const pot_hash_table_t *hash_table, hc_thread_mutex_t *mux);
 
-void pot_tree_destroy      (pot_tree_entry_t *tree);
+void pot_hash_table_init    (pot_hash_table_t *hash_table, const hashconfig_t *hashconfig, const hash_t *hashes_buf, const u32 hashes_cnt);
+void pot_hash_table_destroy (pot_hash_table_t *hash_table);
+bool pot_hash_table_exists  (const pot_hash_table_t *hash_table, const u64 fingerprint);
 
-int  sort_pot_tree_by_hash (const void *v1, const void *v2);
 int  sort_pot_orig_line    (const void *v1, const void *v2);
 
 #endif // _POTFILE_H
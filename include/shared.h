@@ -83,6 +83,10 @@ const u8 *hc_strchr_next (const u8 *input_buf, const int input_len, const u8 sep
 const u8 *hc_strchr_last (const u8 *input_buf, const int input_len, const u8 separator);
 
 int count_char (const u8 *buf, const int len, const u8 c);
+
+u64 hc_find_newline   (const char *buf, const u64 len);
+u64 hc_count_newlines (const char *buf, const u64 len);
+
 float get_entropy (const u8 *buf, const int len);
 
 int select_read_timeout  (int sockfd, const int sec);
@@ -29,6 +29,10 @@ char       *status_get_guess_base                     (const hashcat_ctx_t *hash
 int         status_get_guess_base_offset              (const hashcat_ctx_t *hashcat_ctx);
 int         status_get_guess_base_count               (const hashcat_ctx_t *hashcat_ctx);
 double      status_get_guess_base_percent             (const hashcat_ctx_t *hashcat_ctx);
+double      status_get_guess_base_io_wait_msec        (const hashcat_ctx_t *hashcat_ctx);
+u64         status_get_dispatch_cnt                   (const hashcat_ctx_t *hashcat_ctx);
+u64         status_get_dispatch_retry_cnt             (const hashcat_ctx_t *hashcat_ctx);
+u64         status_get_dispatch_locked_cnt            (const hashcat_ctx_t *hashcat_ctx);
 char       *status_get_guess_mod                      (const hashcat_ctx_t *hashcat_ctx);
 int         status_get_guess_mod_offset               (const hashcat_ctx_t *hashcat_ctx);
 int         status_get_guess_mod_count                (const hashcat_ctx_t *hashcat_ctx);
@@ -72,6 +76,7 @@ double      status_get_hashes_msec_dev                (const hashcat_ctx_t *hash
 double      status_get_hashes_msec_dev_benchmark      (const hashcat_ctx_t *hashcat_ctx, const int backend_devices_idx);
 double      status_get_exec_msec_all                  (const hashcat_ctx_t *hashcat_ctx);
 double      status_get_exec_msec_dev                  (const hashcat_ctx_t *hashcat_ctx, const int backend_devices_idx);
+double      status_get_hook_msec_dev                  (const hashcat_ctx_t *hashcat_ctx, const int backend_devices_idx);
 char       *status_get_speed_sec_all                  (const hashcat_ctx_t *hashcat_ctx);
 char       *status_get_speed_sec_dev                  (const hashcat_ctx_t *hashcat_ctx, const int backend_devices_idx);
 int         status_get_cpt_cur_min                    (const hashcat_ctx_t *hashcat_ctx);
@@ -18,8 +18,14 @@
 #if defined (_POSIX)
 #include <pthread.h>
 #include <pwd.h>
+#include <sys/uio.h>
 #endif // _POSIX
 
-int process_stdout (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u64 pws_cnt);
+#define STDOUT_HOST_BATCH         0x10000
+#define STDOUT_WORKERS_MAX        64
+#define STDOUT_WORKER_CANDIDATES  0x40000
+
+int process_stdout      (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u64 pws_cnt);
+int process_stdout_host (hashcat_ctx_t *hashcat_ctx);
 
 #endif // _STDOUT_H
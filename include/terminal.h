@@ -54,5 +54,6 @@ void status_display_machine_readable    (hashcat_ctx_t *hashcat_ctx);
 void status_display                     (hashcat_ctx_t *hashcat_ctx);
 void status_benchmark_machine_readable  (hashcat_ctx_t *hashcat_ctx);
 void status_benchmark                   (hashcat_ctx_t *hashcat_ctx);
+void status_kernel_cache_warm           (hashcat_ctx_t *hashcat_ctx);
 
 #endif // _TERMINAL_H
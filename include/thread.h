@@ -58,6 +58,13 @@
 
 #endif
 
+// all supported compilers (gcc, clang and mingw) provide the __atomic builtins
+
+#define hc_atomic_load(p)           __atomic_load_n    ((p), __ATOMIC_ACQUIRE)
+#define hc_atomic_store(p,v)        __atomic_store_n   ((p), (v), __ATOMIC_RELEASE)
+#define hc_atomic_fetch_add(p,v)    __atomic_fetch_add ((p), (v), __ATOMIC_ACQ_REL)
+#define hc_atomic_cas(p,e,v)        __atomic_compare_exchange_n ((p), (e), (v), false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+
 /*
 #if defined (_WIN)
 
@@ -145,6 +145,7 @@ typedef enum event_identifier
   EVENT_BACKEND_SESSION_HOSTMEM   = 0x000000a2,
   EVENT_BACKEND_DEVICE_INIT_POST  = 0x000000a3,
   EVENT_BACKEND_DEVICE_INIT_PRE   = 0x000000a4,
+  EVENT_BACKEND_KERNEL_CACHE_WARM = 0x000000a5,
   EVENT_OUTERLOOP_FINISHED        = 0x000000b0,
   EVENT_OUTERLOOP_MAINSCREEN      = 0x000000b1,
   EVENT_OUTERLOOP_STARTING        = 0x000000b2,
@@ -582,6 +583,7 @@ typedef enum user_options_defaults
   BRAIN_SESSION            = 0,
   #endif
   DEBUG_MODE               = 0,
+  DISPATCH_BALANCE         = false,
   EXAMPLE_HASHES           = false,
   FORCE                    = false,
   HWMON_DISABLE            = false,
@@ -597,6 +599,7 @@ typedef enum user_options_defaults
   INCREMENT_MIN            = 1,
   KEEP_GUESSING            = false,
   KERNEL_ACCEL             = 0,
+  KERNEL_CACHE_WARM        = false,
   KERNEL_LOOPS             = 0,
   KERNEL_THREADS           = 0,
   KEYSPACE                 = false,
@@ -644,12 +647,15 @@ typedef enum user_options_defaults
   STATUS_TIMER             = 10,
   STDIN_TIMEOUT_ABORT      = 120,
   STDOUT_FLAG              = false,
+  STDOUT_HOST              = false,
   USAGE                    = false,
   USERNAME                 = false,
   VERSION                  = false,
   VERACRYPT_PIM_START      = 485,
   VERACRYPT_PIM_STOP       = 485,
   WORDLIST_AUTOHEX_DISABLE = false,
+  WORDLIST_COMPILE         = false,
+  WORDLIST_READ_AHEAD      = 2,
   WORKLOAD_PROFILE         = 2,
 
 } user_options_defaults_t;
@@ -765,6 +771,11 @@ typedef enum user_options_map
   IDX_VERSION_LOWER             = 'v',
   IDX_VERSION                   = 'V',
   IDX_WORDLIST_AUTOHEX_DISABLE  = 0xff4c,
+  IDX_WORDLIST_COMPILE          = 0xff4d,
+  IDX_WORDLIST_READ_AHEAD       = 0xff4e,
+  IDX_STDOUT_HOST               = 0xff4f,
+  IDX_DISPATCH_BALANCE          = 0xff50,
+  IDX_KERNEL_CACHE_WARM         = 0xff51,
   IDX_WORKLOAD_PROFILE          = 'w',
 
 } user_options_map_t;
@@ -1023,6 +1034,84 @@ typedef struct link_speed
 
 // file handling
 
+#define GZIDX_WINSIZE 32768   // deflate window, required to restart inflate in the middle of a stream
+#define GZIDX_CHUNK   0x10000
+
+typedef struct hc_gzidx_point
+{
+  u64 out;                    // uncompressed offset
+  u64 in;                     // compressed offset of the first complete byte of the block
+  u64 bits;                   // number of bits of the block in the byte before in, 0 to 7
+  u8  window[GZIDX_WINSIZE];  // the uncompressed data preceding out
+
+} hc_gzidx_point_t;
+
+typedef struct hc_gzidx
+{
+  u64 span;
+
+  hc_gzidx_point_t *points;
+  u64               cnt;
+  u64               avail;
+
+} hc_gzidx_t;
+
+typedef struct hc_gzstream
+{
+  z_stream strm;
+  bool     raw;               // inflating raw deflate data after restarting at a checkpoint
+  bool     member;            // at the start of another gzip member, anything unparseable is trailing garbage
+  bool     eof;
+
+  u8      *in_buf;
+  u64      in_pos;            // compressed offset of the next byte read from the file
+
+  u8       window[GZIDX_WINSIZE]; // ring of the most recently inflated bytes, reads are served from here
+  u32      win_have;
+  u32      win_pos;
+  u32      win_pend;          // inflated bytes right before win_pos which were not returned yet
+
+  u64      out_pos;           // uncompressed offset of the next byte returned to the reader
+
+  hc_gzidx_t *build;          // checkpoints recorded while inflating from the start
+  u64         build_last;
+
+} hc_gzstream_t;
+
+#define XZ_BLOCKS     8         // read-ahead depth of the decoder thread
+#define XZ_BLOCK_SIZE 0x100000
+#define XZ_IN_SIZE    0x10000
+
+typedef struct hc_xzstream
+{
+  bool        lzma_alone;     // .lzma file (LZMA-alone header) instead of an .xz container
+
+  CXzUnpacker xz;
+  CLzmaDec    lzma;
+  u64         lzma_left;      // uncompressed size from the .lzma header, -1 if unknown
+
+  u8         *in_buf;
+  size_t      in_len;
+  size_t      in_pos;
+  bool        in_eof;
+
+  u8         *blocks[XZ_BLOCKS];
+  size_t      blocks_len[XZ_BLOCKS];
+
+  u64         blocks_put;     // blocks decoded by the thread
+  u64         blocks_get;     // blocks completely consumed by the reader
+  size_t      block_pos;      // read position in the current block
+
+  bool        run;            // cleared to stop the decoder thread
+  bool        finished;       // no more blocks after blocks_put
+  bool        error;
+
+  u64         out_pos;
+
+  hc_thread_t thread;
+
+} hc_xzstream_t;
+
 typedef struct hc_fp
 {
   int         fd;
@@ -1033,6 +1122,21 @@ typedef struct hc_fp
 
   bool        is_gzip;
   bool        is_zip;
+  bool        is_xz;   // .xz or .lzma, read-only
+  bool        is_mmap;
+
+  char       *mm_buf; // mmap'd plain file, see hc_fmmap ()
+  u64         mm_len;
+  u64         mm_pos;
+
+  char       *rd_buf; // read-ahead buffer of fgetl ()
+  size_t      rd_len;
+  size_t      rd_pos;
+
+  hc_gzstream_t    *gzs;   // own inflate state, replaces gfp for reading once set, see hc_gzidx_build ()
+  const hc_gzidx_t *gzidx; // checkpoints of this gzip file, not owned
+
+  hc_xzstream_t    *xzs;   // decoder and read-ahead thread of an .xz or .lzma file
 
   char       *mode;
   const char *path;
@@ -1061,6 +1165,8 @@ typedef struct hc_device_param
   u64     device_maxmem_alloc;
   u64     device_global_mem;
   u64     device_available_mem;
+  double  device_transfer_pinned;   // host to device MB/s, measured for --backend-info
+  double  device_transfer_pageable;
   u32     device_maxclock_frequency;
   size_t  device_maxworkgroup_size;
   u64     device_local_mem_size;
@@ -1180,6 +1286,10 @@ typedef struct hc_device_param
   u64     kernel_power;
   u64     hardware_power;
 
+  u32     kernels_built;    // programs loaded in the last backend_session_begin ()
+  u32     kernels_cached;   // of those, how many came from the kernel cache
+  double  kernels_msec;     // wall time of the parallel build
+
   u64  size_pws;
   u64  size_pws_amp;
   u64  size_pws_comp;
@@ -1229,10 +1339,21 @@ typedef struct hc_device_param
 
   void     *hooks_buf;
 
+  struct hook_pool *hook_pool;      // long-lived workers running module_hook12/module_hook23
+  u64       hook_usec;              // time spent in the hooks since the session started, updated atomically
+
   pw_idx_t *pws_idx;
   u32      *pws_comp;
   u64       pws_cnt;
 
+  bool      pws_prefetch;           // the next batch is uploaded into a second device slot while the current one is cracked
+  pw_idx_t *pws_prefetch_idx;       // host buffers of the batch in flight, swapped with pws_idx/pws_comp
+  u32      *pws_prefetch_comp;
+  u64       pws_prefetch_cnt;
+  bool      pws_prefetched;         // an upload into the second device slot is in flight
+
+  bool      host_pinned;            // pws_comp, pws_idx and combs_buf are page-locked, see host_buffers_alloc()
+
   pw_pre_t *pws_pre_buf;  // for slow candidates
   u64       pws_pre_cnt;
 
@@ -1241,6 +1362,8 @@ typedef struct hc_device_param
 
   u64     words_off;
   u64     words_done;
+  u64     words_claimed;    // words handed to this device by get_work (), for --dispatch-balance
+  u64     words_cracked;    // words of words_claimed which went through run_cracker ()
 
   u64     outerloop_pos;
   u64     outerloop_left;
@@ -1350,9 +1473,11 @@ typedef struct hc_device_param
   CUdevice          cuda_device;
   CUcontext         cuda_context;
   CUstream          cuda_stream;
+  CUstream          cuda_stream_copy;
 
   CUevent           cuda_event1;
   CUevent           cuda_event2;
+  CUevent           cuda_event_prefetch;
 
   CUmodule          cuda_module;
   CUmodule          cuda_module_shared;
@@ -1385,6 +1510,8 @@ typedef struct hc_device_param
   CUdeviceptr       cuda_d_pws_amp_buf;
   CUdeviceptr       cuda_d_pws_comp_buf;
   CUdeviceptr       cuda_d_pws_idx;
+  CUdeviceptr       cuda_d_pws_prefetch_comp_buf;
+  CUdeviceptr       cuda_d_pws_prefetch_idx;
   CUdeviceptr       cuda_d_words_buf_l;
   CUdeviceptr       cuda_d_words_buf_r;
   CUdeviceptr       cuda_d_rules;
@@ -1436,6 +1563,9 @@ typedef struct hc_device_param
   cl_device_id      opencl_device;
   cl_context        opencl_context;
   cl_command_queue  opencl_command_queue;
+  cl_command_queue  opencl_command_queue_copy;
+
+  cl_event          opencl_event_prefetch;
 
   cl_program        opencl_program;
   cl_program        opencl_program_shared;
@@ -1468,6 +1598,13 @@ typedef struct hc_device_param
   cl_mem            opencl_d_pws_amp_buf;
   cl_mem            opencl_d_pws_comp_buf;
   cl_mem            opencl_d_pws_idx;
+  cl_mem            opencl_d_pws_prefetch_comp_buf;
+  cl_mem            opencl_d_pws_prefetch_idx;
+  cl_mem            opencl_h_pws_comp;        // CL_MEM_ALLOC_HOST_PTR buffers mapped for the host buffers of the same name
+  cl_mem            opencl_h_pws_idx;
+  cl_mem            opencl_h_pws_prefetch_comp;
+  cl_mem            opencl_h_pws_prefetch_idx;
+  cl_mem            opencl_h_combs_buf;
   cl_mem            opencl_d_words_buf_l;
   cl_mem            opencl_d_words_buf_r;
   cl_mem            opencl_d_rules;
@@ -1683,6 +1820,14 @@ typedef struct dictstat_ctx
   size_t cnt;
   #endif
 
+  // sparse word offset index of the most recently counted dictionary
+
+  char *index_dictfile;
+  u64  *index_buf;
+  u64   index_cnt;
+
+  hc_gzidx_t *index_gzidx;       // inflate checkpoints if the dictionary is gzip compressed
+
 } dictstat_ctx_t;
 
 typedef struct loopback_ctx
@@ -1734,33 +1879,73 @@ typedef struct potfile_ctx
   u8      *out_buf; // allocates [HCBUFSIZ_LARGE];
   u8      *tmp_buf; // allocates [HCBUFSIZ_LARGE];
 
+  // binary index next to the potfile, see potfile_idx_remove_parse ()
+
+  HCFILE   idx_fp;
+
+  bool     idx_enabled;
+
+  char    *idx_filename;
+
+  hash_t   idx_hash; // scratch for decoding the lines we append
+  u64      idx_pos;  // potfile offset of the next line we append
+
 } potfile_ctx_t;
 
-// this is a linked list structure of all the hashes with the same "key" (hash or hash + salt)
+typedef struct potfile_idx_entry
+{
+  u32 type;         // POTFILE_IDX_LINE, POTFILE_IDX_LEGACY or POTFILE_IDX_SCAN
+  u32 hash_mode;
+  u64 fingerprint;  // digest and salt, only for POTFILE_IDX_LINE
+  u64 offset;
+  u64 length;
+  u64 line_hash;    // content of the line, only for POTFILE_IDX_LINE
+
+} potfile_idx_entry_t;
+
+// open addressing hash table over the loaded hashes, used to match the potfile lines
+// the key is the fingerprint of digest (dgst_pos0...dgst_pos3) and salt, identical keys are all kept
+// (e.g. same hashes, but different user names with --username and --show, we want to update all of them!)
 
-typedef struct pot_hash_node
+typedef struct pot_hash_slot
 {
-  hash_t *hash_buf;
+  u64 fingerprint;
+  u32 hash_idx;     // position in hashes_buf plus one, 0 marks an empty slot
+  u32 pad;
 
-  struct pot_hash_node *next;
+} pot_hash_slot_t;
 
-} pot_hash_node_t;
+typedef struct pot_hash_table
+{
+  pot_hash_slot_t *slots;
+
+  u64 mask;         // number of slots minus one, always a power of two
+
+  u64 *line_offs;   // per loaded hash, potfile offset plus one of the line its pw_buf is from, 0 if none
 
-// Attention: this is only used when --show and --username are used together
-// there could be multiple entries for each identical hash+salt combination
-// (e.g. same hashes, but different user names... we want to print all of them!)
-// that is why we use a linked list here
+} pot_hash_table_t;
 
-typedef struct pot_tree_entry
+typedef struct potfile_remove_chunk
 {
-  pot_hash_node_t *nodes; // head of the linked list (under the field "hash_buf" it contains the sorting keys)
+  struct hashcat_ctx *hashcat_ctx;
+
+  HCFILE   *fp;               // the potfile itself or a view of the mapped potfile limited to this chunk
+
+  u64       off_start;
+  u64       off_end;          // -1 for up to the end of the file
 
-  // the hashconfig is required to distinguish between salted and non-salted hashes and to make sure
-  // we compare the correct dgst_pos0...dgst_pos3
+  const potfile_idx_entry_t *lines_buf; // if set, only these indexed lines are parsed
+  u64        lines_cnt;
 
-  hashconfig_t *hashconfig;
+  HCFILE   *idx_fp;           // if set, a POTFILE_IDX_LINE entry is written for each decoded line
 
-} pot_tree_entry_t;
+  const pot_hash_table_t *hash_table;
+
+  hc_thread_mutex_t *mux;     // serializes the updates of the found hashes and the index writes
+
+  bool      idx_stale;        // set if an indexed line does not match its entry, the potfile was rewritten
+
+} potfile_remove_chunk_t;
 
 typedef struct pot_orig_line_entry
 {
@@ -1858,6 +2043,40 @@ typedef struct tuning_db
 
 } tuning_db_t;
 
+typedef struct wl_readahead_slot
+{
+  char *buf;                // owned buffer, for streamed wordlists and the unterminated last line of mapped ones
+  u64   avail;
+
+  char *seg;                // segment handed to the parser, either buf or a pointer into the mapping
+  u64   cnt;
+
+} wl_readahead_slot_t;
+
+typedef struct wl_readahead
+{
+  bool enabled;
+
+  // a dedicated I/O thread keeps up to "depth" segments loaded ahead of the one being parsed
+
+  HCFILE *fp;
+
+  wl_readahead_slot_t *slots;
+  u32   slots_cnt;          // depth plus the segment currently parsed
+
+  u64   filled;             // segments published by the I/O thread
+  u64   released;           // segments the parser is done with
+  u64   taken;              // segments handed to the parser
+
+  bool  run;
+  bool  finished;
+
+  u64   wait_usec;          // time the parser spent waiting for the I/O thread
+
+  hc_thread_t thread;
+
+} wl_readahead_t;
+
 typedef struct wl_data
 {
   bool enabled;
@@ -1868,14 +2087,120 @@ typedef struct wl_data
   u64  cnt;
   u64  pos;
 
+  char *seg; // current segment, either buf or a pointer into a mmap'd wordlist
+
+  char *word_buf;   // scratch copy of a word which gets uppercased or hex decoded, seg may be read-only
+  u64   word_avail;
+
+  wl_readahead_t ra;
+
   bool    iconv_enabled;
   iconv_t iconv_ctx;
   char   *iconv_tmp;
 
-  void (*func) (char *, u64, u64 *, u64 *);
+  void (*func) (const char *, u64, u64 *, u64 *);
 
 } wl_data_t;
 
+typedef struct count_words_chunk
+{
+  struct hashcat_ctx *hashcat_ctx; // private copy with its own wl_data
+
+  HCFILE fp;                       // view of the mapped wordlist limited to this range
+
+  u64  off_start;
+  u64  off_end;
+
+  u64  comp;
+  u64  words;
+  u64  words2;
+
+  bool index_enabled;
+
+  u64 *index_buf;                  // offset following every COUNT_WORDS_CHECKPOINT'th word of this range
+  u64  index_cnt;
+  u64  index_avail;
+
+  bool finished;
+
+} count_words_chunk_t;
+
+typedef struct wl_ring_slot
+{
+  u64       seq;            // sequence number of the published batch plus one, 0 if the slot was never used
+  u64       words_cnt;      // base words in this batch, including the rejected ones
+  u64       words_done;     // base words already taken by the device threads
+
+  pw_idx_t *pws_idx;        // one entry per base word, offset and count in units of pws_comp
+  u32      *pws_comp;       // candidates, already padded to a multiple of 4 bytes
+  u64       pws_comp_avail;
+  u8       *pws_rejected;   // set for base words rejected by the -j rule or the length checks
+
+} wl_ring_slot_t;
+
+typedef struct hcwl_header
+{
+  u64  version;
+
+  u32  parser;                  // see wl_data_parser ()
+  u32  len_max;                 // PW_MAX at compile time
+
+  char encoding_from[64];
+  char encoding_to[64];
+
+  u64  cnt;                     // all words, any length
+  u64  hist[PW_MAX + 1];        // words per length, the buckets follow in this order
+
+} hcwl_header_t;
+
+typedef struct hcwl
+{
+  bool enabled;
+
+  hcwl_header_t header;
+
+  // only the buckets within pw_min and pw_max of the current hash-mode are part of the keyspace
+
+  u32  len_min;
+  u32  len_max;
+
+  u64  words_first[PW_MAX + 2]; // index of the first selected word of each length, words_first[len_max + 1] is the total
+  u64  data_off[PW_MAX + 1];    // file offset of each length bucket
+
+  hc_thread_mutex_t mux_read;   // serializes the reads if the file could not be mapped
+
+} hcwl_t;
+
+typedef struct wl_ring
+{
+  bool enabled;
+
+  // the wordlist is read, decoded and filtered only once by a dedicated reader thread
+  // which publishes fixed-size batches of base words into a bounded ring of slots
+
+  HCFILE               fp;
+  char                *dictfile;
+  struct hashcat_ctx  *hashcat_ctx_tmp;
+
+  u64  words_start;
+  u64  words_end;
+
+  wl_ring_slot_t *slots;
+  u64             slots_cnt; // enough for a full round of all devices, see wl_ring_init ()
+
+  // a compiled wordlist needs no reader thread, see hcwl_get ()
+
+  hcwl_t hcwl;
+
+  u64  io_wait_usec;        // copy of the read-ahead wait time of the reader thread, for the status display
+
+  bool run;
+  bool finished;
+
+  hc_thread_t thread;
+
+} wl_ring_t;
+
 typedef struct user_options
 {
   const char  *hc_bin;
@@ -1917,6 +2242,7 @@ typedef struct user_options
   bool         brain_server;
   #endif
   bool         example_hashes;
+  bool         dispatch_balance;
   bool         force;
   bool         hwmon_disable;
   bool         hex_charset;
@@ -1924,6 +2250,7 @@ typedef struct user_options
   bool         hex_wordlist;
   bool         increment;
   bool         keep_guessing;
+  bool         kernel_cache_warm;
   bool         keyspace;
   bool         left;
   bool         logfile_disable;
@@ -1949,6 +2276,7 @@ typedef struct user_options
   bool         status;
   bool         status_json;
   bool         stdout_flag;
+  bool         stdout_host;
   bool         stdin_timeout_abort_chgd;
   bool         usage;
   bool         username;
@@ -1956,6 +2284,7 @@ typedef struct user_options
   bool         veracrypt_pim_stop_chgd;
   bool         version;
   bool         wordlist_autohex_disable;
+  bool         wordlist_compile;
   #ifdef WITH_BRAIN
   char        *brain_host;
   char        *brain_password;
@@ -2021,6 +2350,7 @@ typedef struct user_options
   u32          runtime;
   u32          scrypt_tmto;
   u32          segment_size;
+  u32          wordlist_read_ahead;
   u32          status_timer;
   u32          stdin_timeout_abort;
   u32          veracrypt_pim_start;
@@ -2170,6 +2500,51 @@ typedef struct cpt_ctx
 
 } cpt_ctx_t;
 
+typedef struct crack_entry
+{
+  // everything check_hash () needs from the device, the rest of the output is built by the crack writer thread
+
+  u32   salt_pos;
+  u32   digest_pos;
+
+  u8   *plain_buf;          // points right behind the entry, same allocation
+  int   plain_len;
+
+  u64   crackpos;
+
+  u8    debug_rule_buf[256];
+  int   debug_rule_len;
+  u8    debug_plain_buf[256];
+  int   debug_plain_len;
+
+  void *tmps;               // only with OPTS_TYPE_COPY_TMPS
+
+  struct crack_entry *next;
+
+} crack_entry_t;
+
+typedef struct crack_writer
+{
+  bool enabled;
+
+  // the device threads queue the cracks, a single writer thread does the encoding and the file I/O
+
+  hc_thread_mutex_t      mux;
+  hc_thread_semaphore_t  sem;           // posted once per queued batch, and once more to shut down
+
+  crack_entry_t         *head;
+  crack_entry_t         *tail;
+
+  u64   queued_cnt;         // entries in the list
+  u64   pushed_cnt;         // entries ever queued, for crack_writer_drain ()
+  u64   written_cnt;        // entries already written
+
+  bool  run;
+
+  hc_thread_t thread;
+
+} crack_writer_t;
+
 typedef struct device_info
 {
   bool    skipped_dev;
@@ -2177,6 +2552,7 @@ typedef struct device_info
   double  hashes_msec_dev;
   double  hashes_msec_dev_benchmark;
   double  exec_msec_dev;
+  double  hook_msec_dev;
   char   *speed_sec_dev;
   char   *guess_candidates_dev;
   char   *hwmon_dev;
@@ -2215,6 +2591,10 @@ typedef struct hashcat_status
   int         guess_base_offset;
   int         guess_base_count;
   double      guess_base_percent;
+  double      guess_base_io_wait_msec;
+  u64         dispatch_cnt;
+  u64         dispatch_retry_cnt;
+  u64         dispatch_locked_cnt;
   char       *guess_mod;
   int         guess_mod_offset;
   int         guess_mod_count;
@@ -2322,6 +2702,10 @@ typedef struct status_ctx
   u64  words_base;              // the unamplified max keyspace
   u64  words_cnt;               // the amplified max keyspace
 
+  u64  dispatch_cnt;            // get_work () calls which handed out work, counted atomically
+  u64  dispatch_retry_cnt;      // get_work () compare-and-swap retries on words_off because another device claimed work in between
+  u64  dispatch_locked_cnt;     // get_work () calls which took mux_dispatcher to set kernel_power_final
+
   /**
    * progress
    */
@@ -2407,6 +2791,7 @@ typedef struct event_ctx
   size_t prev_len;
 
   hc_thread_mutex_t mux_event;
+  hc_thread_mutex_t mux_log;   // held while msg_buf is filled and printed
 
 } event_ctx_t;
 
@@ -2504,6 +2889,7 @@ typedef struct hashcat_ctx
   bitmap_ctx_t          *bitmap_ctx;
   combinator_ctx_t      *combinator_ctx;
   cpt_ctx_t             *cpt_ctx;
+  crack_writer_t        *crack_writer;
   debugfile_ctx_t       *debugfile_ctx;
   dictstat_ctx_t        *dictstat_ctx;
   event_ctx_t           *event_ctx;
@@ -2529,6 +2915,7 @@ typedef struct hashcat_ctx
   user_options_extra_t  *user_options_extra;
   user_options_t        *user_options;
   wl_data_t             *wl_data;
+  wl_ring_t             *wl_ring;
 
   void (*event) (const u32, struct hashcat_ctx *, const void *, const size_t);
 
@@ -2542,22 +2929,80 @@ typedef struct thread_param
 
 } thread_param_t;
 
-typedef struct hook_thread_param
+typedef struct stdout_worker
 {
-  int tid;
-  int tsz;
+  hashcat_ctx_t     *hashcat_ctx;
+  hc_device_param_t *device_param;
 
-  module_ctx_t *module_ctx;
-  status_ctx_t *status_ctx;
+  u64   gidvid_start;
+  u64   gidvid_stop;
 
+  char *buf;
+  u64   len;
+  u64   avail;
+
+} stdout_worker_t;
+
+typedef struct kernel_build
+{
+  hashcat_ctx_t     *hashcat_ctx;
   hc_device_param_t *device_param;
 
-  void *hook_salts_buf;
+  const char *kernel_name;
+  char        source_file[256];
+  char        cached_file[256];
+  const char *build_options_buf;
+  bool        cache_disable;
+
+  cl_program *opencl_program;
+  CUmodule   *cuda_module;
+
+  bool        cached;   // a cached binary was there before the build started
+  bool        rc;
+
+} kernel_build_t;
+
+typedef struct backend_session_param
+{
+  hashcat_ctx_t *hashcat_ctx;
+
+  int   backend_devices_idx;
+
+  u64   size_total_host;    // host memory allocated for the device, summed up for EVENT_BACKEND_SESSION_HOSTMEM
+  int   rc;                 // 0 = ready, 1 = skipped, -1 = error
+
+} backend_session_param_t;
+
+// each hook job is split into about HOOK_POOL_CHUNKS chunks per worker, claimed one after the other
+
+#define HOOK_POOL_CHUNKS 16
+
+typedef struct hook_pool
+{
+  hc_thread_t           *threads;
+  int                    threads_cnt;
+
+  hc_thread_semaphore_t  sem_work;    // posted once per worker for each job, and once more to shut down
+  hc_thread_semaphore_t  sem_done;    // posted by each worker after it found no chunk left
+
+  bool                   shutdown;
+
+  status_ctx_t          *status_ctx;
+
+  hc_device_param_t     *device_param;
+
+  // the current job, written by hook_pool_run() before the workers are woken up
+
+  void                 (*hook) (hc_device_param_t *, const void *, const u32, const u64);
+
+  void                  *hook_salts_buf;
 
-  u32 salt_pos;
-  u64 pws_cnt;
+  u32                    salt_pos;
+  u64                    pws_cnt;
+  u64                    pws_chunk;
+  u64                    pws_pos;     // next password to claim, advanced atomically by the workers
 
-} hook_thread_param_t;
+} hook_pool_t;
 
 #define MAX_TOKENS     128
 #define MAX_SIGNATURES 16
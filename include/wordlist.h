@@ -9,21 +9,49 @@
 #include <time.h>
 #include <inttypes.h>
 
+#define WL_RING_SLOTS_MIN   64
+#define WL_RING_SLOT_WORDS  0x2000
+#define WL_RING_WAIT_USEC   100
+
+#define INCR_WL_RING_COMP   0x10000
+
+#define WL_READAHEAD_WAIT_USEC  100
+
+#define COUNT_WORDS_CHUNK_MIN   0x4000000
+#define COUNT_WORDS_CHECKPOINT  0x1000
+#define COUNT_WORDS_WAIT_USEC   100000
+
 size_t convert_from_hex (hashcat_ctx_t *hashcat_ctx, char *line_buf, const size_t line_len);
 
 void pw_pre_add  (hc_device_param_t *device_param, const u8 *pw_buf, const int pw_len, const u8 *base_buf, const int base_len, const int rule_idx);
 void pw_base_add (hc_device_param_t *device_param, pw_pre_t *pw_pre);
 void pw_add      (hc_device_param_t *device_param, const u8 *pw_buf, const int pw_len);
 
-void get_next_word_lm  (char *buf, u64 sz, u64 *len, u64 *off);
-void get_next_word_uc  (char *buf, u64 sz, u64 *len, u64 *off);
-void get_next_word_std (char *buf, u64 sz, u64 *len, u64 *off);
+void get_next_word_lm  (const char *buf, u64 sz, u64 *len, u64 *off);
+void get_next_word_uc  (const char *buf, u64 sz, u64 *len, u64 *off);
+void get_next_word_std (const char *buf, u64 sz, u64 *len, u64 *off);
 
 void get_next_word   (hashcat_ctx_t *hashcat_ctx, HCFILE *fp, char **out_buf, u32 *out_len);
+void skip_words      (hashcat_ctx_t *hashcat_ctx, HCFILE *fp, const char *dictfile, u64 *words_cur, const u64 words_off);
+u32  wl_data_parser  (hashcat_ctx_t *hashcat_ctx);
 int  load_segment    (hashcat_ctx_t *hashcat_ctx, HCFILE *fp);
+bool wl_data_feof    (hashcat_ctx_t *hashcat_ctx, HCFILE *fp);
 int  count_words     (hashcat_ctx_t *hashcat_ctx, HCFILE *fp, const char *dictfile, u64 *result);
 
+HC_API_CALL void *thread_count_words (void *p);
+
 int  wl_data_init    (hashcat_ctx_t *hashcat_ctx);
 void wl_data_destroy (hashcat_ctx_t *hashcat_ctx);
 
+HC_API_CALL void *thread_wl_readahead (void *p);
+
+int  wl_readahead_start (hashcat_ctx_t *hashcat_ctx, HCFILE *fp);
+void wl_readahead_stop  (hashcat_ctx_t *hashcat_ctx);
+
+HC_API_CALL void *thread_wl_ring (void *p);
+
+int  wl_ring_init    (hashcat_ctx_t *hashcat_ctx);
+void wl_ring_destroy (hashcat_ctx_t *hashcat_ctx);
+u64  wl_ring_get     (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u64 words_off, const u64 words_fin);
+
 #endif // _WORDLIST_H
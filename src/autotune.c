@@ -5,9 +5,14 @@
 
 #include "common.h"
 #include "types.h"
+#include "memory.h"
+#include "bitops.h"
 #include "event.h"
+#include "filehandling.h"
 #include "backend.h"
+#include "shared.h"
 #include "status.h"
+#include "emu_inc_hash_md5.h"
 #include "autotune.h"
 
 static double try_run (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u32 kernel_accel, const u32 kernel_loops)
@@ -96,105 +101,183 @@ static double try_run_preferred (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *
 }
 */
 
-static int autotune (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
+static char *autotune_cache_filename (hashcat_ctx_t *hashcat_ctx, const hc_device_param_t *device_param)
 {
-  const hashconfig_t    *hashconfig   = hashcat_ctx->hashconfig;
-  const backend_ctx_t   *backend_ctx  = hashcat_ctx->backend_ctx;
-  const straight_ctx_t  *straight_ctx = hashcat_ctx->straight_ctx;
-  const user_options_t  *user_options = hashcat_ctx->user_options;
+  const backend_ctx_t   *backend_ctx   = hashcat_ctx->backend_ctx;
+  const folder_config_t *folder_config = hashcat_ctx->folder_config;
+  const hashconfig_t    *hashconfig    = hashcat_ctx->hashconfig;
+  const hashes_t        *hashes        = hashcat_ctx->hashes;
+  const user_options_t  *user_options  = hashcat_ctx->user_options;
+
+  // everything the search result depends on is part of the key, the tuning ranges cover -w, -O, rules and masks
+
+  char *key = (char *) hcmalloc (HCBUFSIZ_TINY);
+
+  const int keylen = snprintf (key, HCBUFSIZ_TINY - 64, "%d-%d-%d-%s-%s-%s-%u-%u-%u-%u-%u-%u-%u-%u-%u-%u-%u",
+    backend_ctx->comptime,
+    backend_ctx->cuda_driver_version,
+    device_param->is_opencl,
+    device_param->device_name,
+    device_param->opencl_device_version,
+    device_param->opencl_driver_version,
+    hashconfig->hash_mode,
+    user_options->attack_mode,
+    hashes->salts_cnt,
+    hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL,
+    device_param->vector_width,
+    device_param->kernel_threads,
+    device_param->kernel_accel_min,
+    device_param->kernel_accel_max,
+    device_param->kernel_loops_min,
+    device_param->kernel_loops_max,
+    (u32) backend_ctx->target_msec);
+
+  md5_ctx_t md5_ctx;
+
+  md5_init   (&md5_ctx);
+  md5_update (&md5_ctx, (u32 *) key, MIN (keylen, HCBUFSIZ_TINY - 64));
+  md5_final  (&md5_ctx);
+
+  hcfree (key);
+
+  char *filename;
+
+  hc_asprintf (&filename, "%s/%s/m%05u_a%u.%08x%08x.tune", folder_config->profile_dir, AUTOTUNE_CACHE_FOLDER, hashconfig->hash_mode, user_options->attack_mode, md5_ctx.h[0], md5_ctx.h[1]);
+
+  return filename;
+}
 
-  const double target_msec = backend_ctx->target_msec;
+static bool autotune_cache_read (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, u32 *kernel_accel_out, u32 *kernel_loops_out)
+{
+  const backend_ctx_t *backend_ctx = hashcat_ctx->backend_ctx;
 
-  const u32 kernel_accel_min = device_param->kernel_accel_min;
-  const u32 kernel_accel_max = device_param->kernel_accel_max;
+  char *filename = autotune_cache_filename (hashcat_ctx, device_param);
 
-  const u32 kernel_loops_min = device_param->kernel_loops_min;
-  const u32 kernel_loops_max = device_param->kernel_loops_max;
+  HCFILE fp;
 
-  u32 kernel_accel = kernel_accel_min;
-  u32 kernel_loops = kernel_loops_min;
+  if (hc_fopen (&fp, filename, "rb") == false)
+  {
+    // first run with this setup, do not error out
 
-  // in this case the user specified a fixed -n and -u on the commandline
-  // no way to tune anything
-  // but we need to run a few caching rounds
+    hcfree (filename);
 
-  if ((kernel_accel_min == kernel_accel_max) && (kernel_loops_min == kernel_loops_max))
-  {
-    #if defined (DEBUG)
+    return false;
+  }
 
-    // don't do any autotune in debug mode in this case
-    // we're propably during kernel development
+  hcfree (filename);
 
-    #else
+  u64 v;
+  u32 tune[3];
 
-    if (hashconfig->warmup_disable == false)
-    {
-      try_run (hashcat_ctx, device_param, kernel_accel, kernel_loops);
-      try_run (hashcat_ctx, device_param, kernel_accel, kernel_loops);
-      try_run (hashcat_ctx, device_param, kernel_accel, kernel_loops);
-      try_run (hashcat_ctx, device_param, kernel_accel, kernel_loops);
-    }
+  const size_t nread1 = hc_fread (&v,   sizeof (u64), 1, &fp);
+  const size_t nread2 = hc_fread (tune, sizeof (u32), 3, &fp);
 
-    #endif
+  hc_fclose (&fp);
 
-    device_param->kernel_accel = kernel_accel;
-    device_param->kernel_loops = kernel_loops;
+  if ((nread1 != 1) || (nread2 != 3)) return false;
 
-    const u32 kernel_power = device_param->hardware_power * device_param->kernel_accel;
+  if (byte_swap_64 (v) != AUTOTUNE_CACHE_VERSION) return false;
 
-    device_param->kernel_power = kernel_power;
+  const u32 kernel_accel   = tune[0];
+  const u32 kernel_loops   = tune[1];
+  const u32 kernel_threads = tune[2];
 
-    return 0;
-  }
+  if ((kernel_accel < device_param->kernel_accel_min) || (kernel_accel > device_param->kernel_accel_max)) return false;
+  if ((kernel_loops < device_param->kernel_loops_min) || (kernel_loops > device_param->kernel_loops_max)) return false;
 
-  // from here it's clear we are allowed to autotune
-  // so let's init some fake words
+  if (kernel_threads != device_param->kernel_threads) return false;
 
-  const u32 kernel_power_max = device_param->hardware_power * kernel_accel_max;
+  // the first run warms up the device, the second one has to stay close to the target in both directions,
+  // otherwise something changed on the system (clocks, load) and the values are searched again
 
-  int CL_rc;
-  int CU_rc;
+  try_run (hashcat_ctx, device_param, kernel_accel, kernel_loops);
 
-  if (device_param->is_cuda == true)
-  {
-    CU_rc = run_cuda_kernel_atinit (hashcat_ctx, device_param, device_param->cuda_d_pws_buf, kernel_power_max);
+  const double exec_msec = try_run (hashcat_ctx, device_param, kernel_accel, kernel_loops);
 
-    if (CU_rc == -1) return -1;
-  }
+  if (exec_msec > (backend_ctx->target_msec * 2)) return false;
 
-  if (device_param->is_opencl == true)
-  {
-    CL_rc = run_opencl_kernel_atinit (hashcat_ctx, device_param, device_param->opencl_d_pws_buf, kernel_power_max);
+  // a device that got faster would stay underfilled, unless the cached values are already at the limits
 
-    if (CL_rc == -1) return -1;
-  }
+  const bool at_max = (kernel_accel == device_param->kernel_accel_max) && (kernel_loops == device_param->kernel_loops_max);
 
-  if (user_options->slow_candidates == true)
+  if ((at_max == false) && (exec_msec < (backend_ctx->target_msec / 2))) return false;
+
+  *kernel_accel_out = kernel_accel;
+  *kernel_loops_out = kernel_loops;
+
+  return true;
+}
+
+static void autotune_cache_write (hashcat_ctx_t *hashcat_ctx, const hc_device_param_t *device_param, const u32 kernel_accel, const u32 kernel_loops)
+{
+  char *filename = autotune_cache_filename (hashcat_ctx, device_param);
+
+  // devices of the same model share the file, write to a temporary one and rename it afterwards
+
+  char *filename_tmp;
+
+  hc_asprintf (&filename_tmp, "%s.%d.%u.tmp", filename, (int) getpid (), device_param->device_id);
+
+  HCFILE fp;
+
+  if (hc_fopen (&fp, filename_tmp, "wb") == false)
   {
+    event_log_warning (hashcat_ctx, "%s: %s", filename_tmp, strerror (errno));
+
+    hcfree (filename_tmp);
+    hcfree (filename);
+
+    return;
   }
-  else
+
+  const u64 v = byte_swap_64 (AUTOTUNE_CACHE_VERSION);
+
+  const u32 tune[3] = { kernel_accel, kernel_loops, device_param->kernel_threads };
+
+  const size_t nwrite1 = hc_fwrite (&v,   sizeof (u64), 1, &fp);
+  const size_t nwrite2 = hc_fwrite (tune, sizeof (u32), 3, &fp);
+
+  hc_fclose (&fp);
+
+  if ((nwrite1 != 1) || (nwrite2 != 3))
   {
-    if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-    {
-      if (straight_ctx->kernel_rules_cnt > 1)
-      {
-        if (device_param->is_cuda == true)
-        {
-          CU_rc = hc_cuMemcpyDtoD (hashcat_ctx, device_param->cuda_d_rules_c, device_param->cuda_d_rules, MIN (kernel_loops_max, KERNEL_RULES) * sizeof (kernel_rule_t));
+    // a short file would only be rejected on the next read, don't let it replace a good one
 
-          if (CU_rc == -1) return -1;
-        }
+    event_log_warning (hashcat_ctx, "%s: %s", filename_tmp, strerror (errno));
 
-        if (device_param->is_opencl == true)
-        {
-          CL_rc = hc_clEnqueueCopyBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_rules, device_param->opencl_d_rules_c, 0, 0, MIN (kernel_loops_max, KERNEL_RULES) * sizeof (kernel_rule_t), 0, NULL, NULL);
+    unlink (filename_tmp);
 
-          if (CL_rc == -1) return -1;
-        }
-      }
-    }
+    hcfree (filename_tmp);
+    hcfree (filename);
+
+    return;
   }
 
+  #if defined (_WIN)
+  unlink (filename);
+  #endif
+
+  if (rename (filename_tmp, filename) == -1) unlink (filename_tmp);
+
+  hcfree (filename_tmp);
+  hcfree (filename);
+}
+
+static int autotune_search (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, u32 *kernel_accel_out, u32 *kernel_loops_out)
+{
+  const backend_ctx_t *backend_ctx = hashcat_ctx->backend_ctx;
+
+  const double target_msec = backend_ctx->target_msec;
+
+  const u32 kernel_accel_min = device_param->kernel_accel_min;
+  const u32 kernel_accel_max = device_param->kernel_accel_max;
+
+  const u32 kernel_loops_min = device_param->kernel_loops_min;
+  const u32 kernel_loops_max = device_param->kernel_loops_max;
+
+  u32 kernel_accel = kernel_accel_min;
+  u32 kernel_loops = kernel_loops_min;
+
   // Do a pre-autotune test run to find out if kernel runtime is above some TDR limit
 
   u32 kernel_loops_max_reduced = kernel_loops_max;
@@ -312,6 +395,117 @@ static int autotune (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param
     kernel_accel *= exec_accel_min;
   }
 
+  *kernel_accel_out = kernel_accel;
+  *kernel_loops_out = kernel_loops;
+
+  return 0;
+}
+
+static int autotune (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
+{
+  const hashconfig_t    *hashconfig   = hashcat_ctx->hashconfig;
+  const straight_ctx_t  *straight_ctx = hashcat_ctx->straight_ctx;
+  const user_options_t  *user_options = hashcat_ctx->user_options;
+
+  const u32 kernel_accel_min = device_param->kernel_accel_min;
+  const u32 kernel_accel_max = device_param->kernel_accel_max;
+
+  const u32 kernel_loops_min = device_param->kernel_loops_min;
+  const u32 kernel_loops_max = device_param->kernel_loops_max;
+
+  u32 kernel_accel = kernel_accel_min;
+  u32 kernel_loops = kernel_loops_min;
+
+  // in this case the user specified a fixed -n and -u on the commandline
+  // no way to tune anything
+  // but we need to run a few caching rounds
+
+  if ((kernel_accel_min == kernel_accel_max) && (kernel_loops_min == kernel_loops_max))
+  {
+    #if defined (DEBUG)
+
+    // don't do any autotune in debug mode in this case
+    // we're propably during kernel development
+
+    #else
+
+    if (hashconfig->warmup_disable == false)
+    {
+      try_run (hashcat_ctx, device_param, kernel_accel, kernel_loops);
+      try_run (hashcat_ctx, device_param, kernel_accel, kernel_loops);
+      try_run (hashcat_ctx, device_param, kernel_accel, kernel_loops);
+      try_run (hashcat_ctx, device_param, kernel_accel, kernel_loops);
+    }
+
+    #endif
+
+    device_param->kernel_accel = kernel_accel;
+    device_param->kernel_loops = kernel_loops;
+
+    const u32 kernel_power = device_param->hardware_power * device_param->kernel_accel;
+
+    device_param->kernel_power = kernel_power;
+
+    return 0;
+  }
+
+  // from here it's clear we are allowed to autotune
+  // so let's init some fake words
+
+  const u32 kernel_power_max = device_param->hardware_power * kernel_accel_max;
+
+  int CL_rc;
+  int CU_rc;
+
+  if (device_param->is_cuda == true)
+  {
+    CU_rc = run_cuda_kernel_atinit (hashcat_ctx, device_param, device_param->cuda_d_pws_buf, kernel_power_max);
+
+    if (CU_rc == -1) return -1;
+  }
+
+  if (device_param->is_opencl == true)
+  {
+    CL_rc = run_opencl_kernel_atinit (hashcat_ctx, device_param, device_param->opencl_d_pws_buf, kernel_power_max);
+
+    if (CL_rc == -1) return -1;
+  }
+
+  if (user_options->slow_candidates == true)
+  {
+  }
+  else
+  {
+    if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+    {
+      if (straight_ctx->kernel_rules_cnt > 1)
+      {
+        if (device_param->is_cuda == true)
+        {
+          CU_rc = hc_cuMemcpyDtoD (hashcat_ctx, device_param->cuda_d_rules_c, device_param->cuda_d_rules, MIN (kernel_loops_max, KERNEL_RULES) * sizeof (kernel_rule_t));
+
+          if (CU_rc == -1) return -1;
+        }
+
+        if (device_param->is_opencl == true)
+        {
+          CL_rc = hc_clEnqueueCopyBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_rules, device_param->opencl_d_rules_c, 0, 0, MIN (kernel_loops_max, KERNEL_RULES) * sizeof (kernel_rule_t), 0, NULL, NULL);
+
+          if (CL_rc == -1) return -1;
+        }
+      }
+    }
+  }
+
+  // a stored result of an earlier session only needs a validation run, otherwise do the full search
+
+  if (autotune_cache_read (hashcat_ctx, device_param, &kernel_accel, &kernel_loops) == false)
+  {
+    if (autotune_search (hashcat_ctx, device_param, &kernel_accel, &kernel_loops) == -1) return -1;
+
+    autotune_cache_write (hashcat_ctx, device_param, kernel_accel, kernel_loops);
+  }
+
   // start finding best thread count is easier.
   // it's either the preferred or the maximum thread count
 
@@ -6,7 +6,6 @@
 #include "common.h"
 #include "types.h"
 #include "memory.h"
-#include "locking.h"
 #include "thread.h"
 #include "timer.h"
 #include "tuningdb.h"
@@ -477,20 +476,22 @@ static bool write_kernel_binary (hashcat_ctx_t *hashcat_ctx, const char *kernel_
 {
   if (binary_size > 0)
   {
-    HCFILE fp;
+    // write to a temporary file next to the cached one and rename it afterwards,
+    // so that other devices or concurrent sessions never load a partially written kernel
 
-    if (hc_fopen (&fp, kernel_file, "wb") == false)
-    {
-      event_log_error (hashcat_ctx, "%s: %s", kernel_file, strerror (errno));
+    static u32 kernel_file_seq = 0;
 
-      return false;
-    }
+    char *kernel_file_tmp = NULL;
+
+    hc_asprintf (&kernel_file_tmp, "%s.%d.%u.tmp", kernel_file, (int) getpid (), hc_atomic_fetch_add (&kernel_file_seq, 1));
+
+    HCFILE fp;
 
-    if (hc_lockfile (&fp) == -1)
+    if (hc_fopen (&fp, kernel_file_tmp, "wb") == false)
     {
-      hc_fclose (&fp);
+      event_log_error (hashcat_ctx, "%s: %s", kernel_file_tmp, strerror (errno));
 
-      event_log_error (hashcat_ctx, "%s: %s", kernel_file, strerror (errno));
+      hcfree (kernel_file_tmp);
 
       return false;
     }
@@ -499,16 +500,30 @@ static bool write_kernel_binary (hashcat_ctx_t *hashcat_ctx, const char *kernel_
 
     hc_fflush (&fp);
 
-    if (hc_unlockfile (&fp) == -1)
+    hc_fclose (&fp);
+
+    #if defined (_WIN)
+    // rename () does not replace an existing file on windows
+
+    unlink (kernel_file);
+    #endif
+
+    if (rename (kernel_file_tmp, kernel_file) == -1)
     {
-      hc_fclose (&fp);
+      // someone else stored the same kernel in the meantime, which is just as good
 
-      event_log_error (hashcat_ctx, "%s: %s", kernel_file, strerror (errno));
+      const bool stored = (hc_path_exist (kernel_file) == true);
 
-      return false;
+      if (stored == false) event_log_error (hashcat_ctx, "%s: %s", kernel_file, strerror (errno));
+
+      unlink (kernel_file_tmp);
+
+      hcfree (kernel_file_tmp);
+
+      return stored;
     }
 
-    hc_fclose (&fp);
+    hcfree (kernel_file_tmp);
   }
 
   return true;
@@ -982,6 +997,7 @@ int cuda_init (hashcat_ctx_t *hashcat_ctx)
   HC_LOAD_FUNC_CUDA (cuda, cuMemcpyDtoD,             cuMemcpyDtoD_v2,           CUDA_CUMEMCPYDTOD,              CUDA, 1);
   HC_LOAD_FUNC_CUDA (cuda, cuMemcpyDtoH,             cuMemcpyDtoH_v2,           CUDA_CUMEMCPYDTOH,              CUDA, 1);
   HC_LOAD_FUNC_CUDA (cuda, cuMemcpyHtoD,             cuMemcpyHtoD_v2,           CUDA_CUMEMCPYHTOD,              CUDA, 1);
+  HC_LOAD_FUNC_CUDA (cuda, cuMemcpyHtoDAsync,        cuMemcpyHtoDAsync_v2,      CUDA_CUMEMCPYHTODASYNC,         CUDA, 1);
   HC_LOAD_FUNC_CUDA (cuda, cuMemFree,                cuMemFree_v2,              CUDA_CUMEMFREE,                 CUDA, 1);
   HC_LOAD_FUNC_CUDA (cuda, cuMemFreeHost,            cuMemFreeHost,             CUDA_CUMEMFREEHOST,             CUDA, 1);
   HC_LOAD_FUNC_CUDA (cuda, cuMemGetInfo,             cuMemGetInfo_v2,           CUDA_CUMEMGETINFO,              CUDA, 1);
@@ -1379,6 +1395,33 @@ int hc_cuMemAlloc (hashcat_ctx_t *hashcat_ctx, CUdeviceptr *dptr, size_t bytesiz
   return 0;
 }
 
+int hc_cuMemAllocHost (hashcat_ctx_t *hashcat_ctx, void **pp, size_t bytesize)
+{
+  backend_ctx_t *backend_ctx = hashcat_ctx->backend_ctx;
+
+  CUDA_PTR *cuda = (CUDA_PTR *) backend_ctx->cuda;
+
+  const CUresult CU_err = cuda->cuMemAllocHost (pp, bytesize);
+
+  if (CU_err != CUDA_SUCCESS)
+  {
+    const char *pStr = NULL;
+
+    if (cuda->cuGetErrorString (CU_err, &pStr) == CUDA_SUCCESS)
+    {
+      event_log_error (hashcat_ctx, "cuMemAllocHost(): %s", pStr);
+    }
+    else
+    {
+      event_log_error (hashcat_ctx, "cuMemAllocHost(): %d", CU_err);
+    }
+
+    return -1;
+  }
+
+  return 0;
+}
+
 int hc_cuMemFree (hashcat_ctx_t *hashcat_ctx, CUdeviceptr dptr)
 {
   backend_ctx_t *backend_ctx = hashcat_ctx->backend_ctx;
@@ -1406,6 +1449,33 @@ int hc_cuMemFree (hashcat_ctx_t *hashcat_ctx, CUdeviceptr dptr)
   return 0;
 }
 
+int hc_cuMemFreeHost (hashcat_ctx_t *hashcat_ctx, void *p)
+{
+  backend_ctx_t *backend_ctx = hashcat_ctx->backend_ctx;
+
+  CUDA_PTR *cuda = (CUDA_PTR *) backend_ctx->cuda;
+
+  const CUresult CU_err = cuda->cuMemFreeHost (p);
+
+  if (CU_err != CUDA_SUCCESS)
+  {
+    const char *pStr = NULL;
+
+    if (cuda->cuGetErrorString (CU_err, &pStr) == CUDA_SUCCESS)
+    {
+      event_log_error (hashcat_ctx, "cuMemFreeHost(): %s", pStr);
+    }
+    else
+    {
+      event_log_error (hashcat_ctx, "cuMemFreeHost(): %d", CU_err);
+    }
+
+    return -1;
+  }
+
+  return 0;
+}
+
 int hc_cuMemcpyDtoH (hashcat_ctx_t *hashcat_ctx, void *dstHost, CUdeviceptr srcDevice, size_t ByteCount)
 {
   backend_ctx_t *backend_ctx = hashcat_ctx->backend_ctx;
@@ -1487,6 +1557,33 @@ int hc_cuMemcpyHtoD (hashcat_ctx_t *hashcat_ctx, CUdeviceptr dstDevice, const vo
   return 0;
 }
 
+int hc_cuMemcpyHtoDAsync (hashcat_ctx_t *hashcat_ctx, CUdeviceptr dstDevice, const void *srcHost, size_t ByteCount, CUstream hStream)
+{
+  backend_ctx_t *backend_ctx = hashcat_ctx->backend_ctx;
+
+  CUDA_PTR *cuda = (CUDA_PTR *) backend_ctx->cuda;
+
+  const CUresult CU_err = cuda->cuMemcpyHtoDAsync (dstDevice, srcHost, ByteCount, hStream);
+
+  if (CU_err != CUDA_SUCCESS)
+  {
+    const char *pStr = NULL;
+
+    if (cuda->cuGetErrorString (CU_err, &pStr) == CUDA_SUCCESS)
+    {
+      event_log_error (hashcat_ctx, "cuMemcpyHtoDAsync(): %s", pStr);
+    }
+    else
+    {
+      event_log_error (hashcat_ctx, "cuMemcpyHtoDAsync(): %d", CU_err);
+    }
+
+    return -1;
+  }
+
+  return 0;
+}
+
 int hc_cuModuleGetFunction (hashcat_ctx_t *hashcat_ctx, CUfunction *hfunc, CUmodule hmod, const char *name)
 {
   backend_ctx_t *backend_ctx = hashcat_ctx->backend_ctx;
@@ -2837,6 +2934,33 @@ int gidd_to_pw_t (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, c
   return 0;
 }
 
+static void hook_pool_run (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, void (*hook) (hc_device_param_t *, const void *, const u32, const u64), const u32 salt_pos, const u64 pws_cnt)
+{
+  hashes_t *hashes = hashcat_ctx->hashes;
+
+  hook_pool_t *hook_pool = device_param->hook_pool;
+
+  hook_pool->hook           = hook;
+  hook_pool->hook_salts_buf = hashes->hook_salts_buf;
+  hook_pool->salt_pos       = salt_pos;
+  hook_pool->pws_cnt        = pws_cnt;
+  hook_pool->pws_chunk      = MAX (1, pws_cnt / ((u64) hook_pool->threads_cnt * HOOK_POOL_CHUNKS));
+
+  hc_atomic_store (&hook_pool->pws_pos, 0);
+
+  hc_timer_t timer_hook;
+
+  hc_timer_set (&timer_hook);
+
+  for (int i = 0; i < hook_pool->threads_cnt; i++) hc_thread_sem_post (hook_pool->sem_work);
+
+  for (int i = 0; i < hook_pool->threads_cnt; i++) hc_thread_sem_wait (hook_pool->sem_done);
+
+  // read by the status thread
+
+  hc_atomic_fetch_add (&device_param->hook_usec, (u64) (hc_timer_get (timer_hook) * 1000));
+}
+
 int choose_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u32 highest_pw_len, const u64 pws_cnt, const u32 fast_iteration, const u32 salt_pos)
 {
   hashconfig_t   *hashconfig   = hashcat_ctx->hashconfig;
@@ -2950,43 +3074,7 @@ int choose_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
           if (hc_clEnqueueReadBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_hooks, CL_TRUE, 0, pws_cnt * hashconfig->hook_size, device_param->hooks_buf, 0, NULL, NULL) == -1) return -1;
         }
 
-        const int hook_threads = (int) user_options->hook_threads;
-
-        hook_thread_param_t *hook_threads_param = (hook_thread_param_t *) hccalloc (hook_threads, sizeof (hook_thread_param_t));
-
-        for (int i = 0; i < hook_threads; i++)
-        {
-          hook_thread_param_t *hook_thread_param = hook_threads_param + i;
-
-          hook_thread_param->tid = i;
-          hook_thread_param->tsz = hook_threads;
-
-          hook_thread_param->module_ctx = module_ctx;
-          hook_thread_param->status_ctx = status_ctx;
-
-          hook_thread_param->device_param = device_param;
-
-          hook_thread_param->hook_salts_buf = hashes->hook_salts_buf;
-
-          hook_thread_param->salt_pos = salt_pos;
-
-          hook_thread_param->pws_cnt = pws_cnt;
-        }
-
-        hc_thread_t *c_threads = (hc_thread_t *) hccalloc (hook_threads, sizeof (hc_thread_t));
-
-        for (int i = 0; i < hook_threads; i++)
-        {
-          hook_thread_param_t *hook_thread_param = hook_threads_param + i;
-
-          hc_thread_create (c_threads[i], hook12_thread, hook_thread_param);
-        }
-
-        hc_thread_wait (hook_threads, c_threads);
-
-        hcfree (c_threads);
-
-        hcfree (hook_threads_param);
+        hook_pool_run (hashcat_ctx, device_param, module_ctx->module_hook12, salt_pos, pws_cnt);
 
         if (device_param->is_cuda == true)
         {
@@ -3071,43 +3159,7 @@ int choose_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
           if (hc_clEnqueueReadBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_hooks, CL_TRUE, 0, pws_cnt * hashconfig->hook_size, device_param->hooks_buf, 0, NULL, NULL) == -1) return -1;
         }
 
-        const int hook_threads = (int) user_options->hook_threads;
-
-        hook_thread_param_t *hook_threads_param = (hook_thread_param_t *) hccalloc (hook_threads, sizeof (hook_thread_param_t));
-
-        for (int i = 0; i < hook_threads; i++)
-        {
-          hook_thread_param_t *hook_thread_param = hook_threads_param + i;
-
-          hook_thread_param->tid = i;
-          hook_thread_param->tsz = hook_threads;
-
-          hook_thread_param->module_ctx = module_ctx;
-          hook_thread_param->status_ctx = status_ctx;
-
-          hook_thread_param->device_param = device_param;
-
-          hook_thread_param->hook_salts_buf = hashes->hook_salts_buf;
-
-          hook_thread_param->salt_pos = salt_pos;
-
-          hook_thread_param->pws_cnt = pws_cnt;
-        }
-
-        hc_thread_t *c_threads = (hc_thread_t *) hccalloc (hook_threads, sizeof (hc_thread_t));
-
-        for (int i = 0; i < hook_threads; i++)
-        {
-          hook_thread_param_t *hook_thread_param = hook_threads_param + i;
-
-          hc_thread_create (c_threads[i], hook23_thread, hook_thread_param);
-        }
-
-        hc_thread_wait (hook_threads, c_threads);
-
-        hcfree (c_threads);
-
-        hcfree (hook_threads_param);
+        hook_pool_run (hashcat_ctx, device_param, module_ctx->module_hook23, salt_pos, pws_cnt);
 
         if (device_param->is_cuda == true)
         {
@@ -3962,6 +4014,12 @@ int run_kernel_decompress (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device
     const size_t global_work_size[3] = { num_elements,    1, 1 };
     const size_t local_work_size[3]  = { kernel_threads,  1, 1 };
 
+    if (device_param->pws_prefetch == true)
+    {
+      if (hc_clSetKernelArg (hashcat_ctx, opencl_kernel, 0, sizeof (cl_mem), device_param->kernel_params_decompress[0]) == -1) return -1;
+      if (hc_clSetKernelArg (hashcat_ctx, opencl_kernel, 1, sizeof (cl_mem), device_param->kernel_params_decompress[1]) == -1) return -1;
+    }
+
     if (hc_clSetKernelArg (hashcat_ctx, opencl_kernel, 3, sizeof (cl_ulong), device_param->kernel_params_decompress[3]) == -1) return -1;
 
     if (hc_clEnqueueNDRangeKernel (hashcat_ctx, device_param->opencl_command_queue, opencl_kernel, 1, NULL, global_work_size, local_work_size, 0, NULL, NULL) == -1) return -1;
@@ -3974,130 +4032,293 @@ int run_kernel_decompress (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device
   return 0;
 }
 
-int run_copy (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u64 pws_cnt)
+static void rebuild_pws_compressed (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u64 pws_cnt)
+{
+  combinator_ctx_t *combinator_ctx = hashcat_ctx->combinator_ctx;
+  hashconfig_t     *hashconfig     = hashcat_ctx->hashconfig;
+  user_options_t   *user_options   = hashcat_ctx->user_options;
+
+  // optimized combinator kernels expect the padding byte right behind the base word
+
+  if (user_options->attack_mode == ATTACK_MODE_COMBI)
+  {
+    if (combinator_ctx->combs_mode != COMBINATOR_MODE_BASE_RIGHT) return;
+  }
+  else if (user_options->attack_mode != ATTACK_MODE_HYBRID2)
+  {
+    return;
+  }
+
+  if (hashconfig->opts_type & OPTS_TYPE_PT_ADD01)
+  {
+    rebuild_pws_compressed_append (device_param, pws_cnt, 0x01);
+  }
+  else if (hashconfig->opts_type & OPTS_TYPE_PT_ADD06)
+  {
+    rebuild_pws_compressed_append (device_param, pws_cnt, 0x06);
+  }
+  else if (hashconfig->opts_type & OPTS_TYPE_PT_ADD80)
+  {
+    rebuild_pws_compressed_append (device_param, pws_cnt, 0x80);
+  }
+}
+
+static bool pws_prefetch_supported (hashcat_ctx_t *hashcat_ctx)
 {
-  combinator_ctx_t     *combinator_ctx      = hashcat_ctx->combinator_ctx;
   hashconfig_t         *hashconfig          = hashcat_ctx->hashconfig;
   user_options_t       *user_options        = hashcat_ctx->user_options;
   user_options_extra_t *user_options_extra  = hashcat_ctx->user_options_extra;
 
-  // init speed timer
+  // only the base words read by calc () from a wordlist go through pws_idx and pws_comp_buf
 
-  #if defined (_WIN)
-  if (device_param->timer_speed.QuadPart == 0)
+  if (user_options->slow_candidates == true) return false;
+
+  if (user_options->stdout_flag == true) return false;
+
+  if (user_options_extra->wordlist_mode == WL_MODE_STDIN) return false;
+
+  if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT) return true;
+
+  if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
   {
-    hc_timer_set (&device_param->timer_speed);
+    if (hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL) return true;
+
+    if (user_options->attack_mode == ATTACK_MODE_COMBI)   return true;
+    if (user_options->attack_mode == ATTACK_MODE_HYBRID1) return true;
   }
-  #else
-  if (device_param->timer_speed.tv_sec == 0)
+
+  return false;
+}
+
+void pws_prefetch_swap (hc_device_param_t *device_param, const bool swap_device)
+{
+  pw_idx_t *pws_idx  = device_param->pws_idx;
+  u32      *pws_comp = device_param->pws_comp;
+  u64       pws_cnt  = device_param->pws_cnt;
+
+  device_param->pws_idx  = device_param->pws_prefetch_idx;
+  device_param->pws_comp = device_param->pws_prefetch_comp;
+  device_param->pws_cnt  = device_param->pws_prefetch_cnt;
+
+  device_param->pws_prefetch_idx  = pws_idx;
+  device_param->pws_prefetch_comp = pws_comp;
+  device_param->pws_prefetch_cnt  = pws_cnt;
+
+  // the mapped host buffers have to be unmapped through the cl_mem they came from
+
+  if (device_param->is_opencl == true)
   {
-    hc_timer_set (&device_param->timer_speed);
+    cl_mem opencl_h_pws_idx  = device_param->opencl_h_pws_idx;
+    cl_mem opencl_h_pws_comp = device_param->opencl_h_pws_comp;
+
+    device_param->opencl_h_pws_idx  = device_param->opencl_h_pws_prefetch_idx;
+    device_param->opencl_h_pws_comp = device_param->opencl_h_pws_prefetch_comp;
+
+    device_param->opencl_h_pws_prefetch_idx  = opencl_h_pws_idx;
+    device_param->opencl_h_pws_prefetch_comp = opencl_h_pws_comp;
   }
-  #endif
 
-  if (user_options->slow_candidates == true)
+  if (swap_device == false) return;
+
+  // the kernel_params_decompress[] entries point to these members, so the decompress kernel follows the swap
+
+  if (device_param->is_cuda == true)
   {
-    if (device_param->is_cuda == true)
-    {
-      if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_pws_idx, device_param->pws_idx, pws_cnt * sizeof (pw_idx_t)) == -1) return -1;
+    CUdeviceptr cuda_d_pws_idx      = device_param->cuda_d_pws_idx;
+    CUdeviceptr cuda_d_pws_comp_buf = device_param->cuda_d_pws_comp_buf;
 
-      const pw_idx_t *pw_idx = device_param->pws_idx + pws_cnt;
+    device_param->cuda_d_pws_idx      = device_param->cuda_d_pws_prefetch_idx;
+    device_param->cuda_d_pws_comp_buf = device_param->cuda_d_pws_prefetch_comp_buf;
 
-      const u32 off = pw_idx->off;
+    device_param->cuda_d_pws_prefetch_idx      = cuda_d_pws_idx;
+    device_param->cuda_d_pws_prefetch_comp_buf = cuda_d_pws_comp_buf;
+  }
 
-      if (off)
-      {
-        if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_pws_comp_buf, device_param->pws_comp, off * sizeof (u32)) == -1) return -1;
-      }
-    }
+  if (device_param->is_opencl == true)
+  {
+    cl_mem opencl_d_pws_idx      = device_param->opencl_d_pws_idx;
+    cl_mem opencl_d_pws_comp_buf = device_param->opencl_d_pws_comp_buf;
 
-    if (device_param->is_opencl == true)
-    {
-      if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_pws_idx, CL_TRUE, 0, pws_cnt * sizeof (pw_idx_t), device_param->pws_idx, 0, NULL, NULL) == -1) return -1;
+    device_param->opencl_d_pws_idx      = device_param->opencl_d_pws_prefetch_idx;
+    device_param->opencl_d_pws_comp_buf = device_param->opencl_d_pws_prefetch_comp_buf;
 
-      const pw_idx_t *pw_idx = device_param->pws_idx + pws_cnt;
+    device_param->opencl_d_pws_prefetch_idx      = opencl_d_pws_idx;
+    device_param->opencl_d_pws_prefetch_comp_buf = opencl_d_pws_comp_buf;
+  }
+}
 
-      const u32 off = pw_idx->off;
+int run_copy_prefetch (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u64 pws_cnt)
+{
+  hashconfig_t *hashconfig = hashcat_ctx->hashconfig;
 
-      if (off)
-      {
-        if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_pws_comp_buf, CL_TRUE, 0, off * sizeof (u32), device_param->pws_comp, 0, NULL, NULL) == -1) return -1;
-      }
-    }
+  // called while the host buffers of the next batch are swapped in, the upload goes to the idle device slot
+  // and runs on its own queue, so it overlaps with the kernels of the current batch
 
-    if (run_kernel_decompress (hashcat_ctx, device_param, pws_cnt) == -1) return -1;
+  if (hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL)
+  {
+    rebuild_pws_compressed (hashcat_ctx, device_param, pws_cnt);
   }
-  else
+
+  const pw_idx_t *pw_idx = device_param->pws_idx + pws_cnt;
+
+  const u32 off = pw_idx->off;
+
+  if (device_param->is_cuda == true)
   {
-    if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
+    if (hc_cuMemcpyHtoDAsync (hashcat_ctx, device_param->cuda_d_pws_prefetch_idx, device_param->pws_idx, pws_cnt * sizeof (pw_idx_t), device_param->cuda_stream_copy) == -1) return -1;
+
+    if (off)
     {
-      if (device_param->is_cuda == true)
-      {
-        if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_pws_idx, device_param->pws_idx, pws_cnt * sizeof (pw_idx_t)) == -1) return -1;
+      if (hc_cuMemcpyHtoDAsync (hashcat_ctx, device_param->cuda_d_pws_prefetch_comp_buf, device_param->pws_comp, off * sizeof (u32), device_param->cuda_stream_copy) == -1) return -1;
+    }
 
-        const pw_idx_t *pw_idx = device_param->pws_idx + pws_cnt;
+    if (hc_cuEventRecord (hashcat_ctx, device_param->cuda_event_prefetch, device_param->cuda_stream_copy) == -1) return -1;
+  }
 
-        const u32 off = pw_idx->off;
+  if (device_param->is_opencl == true)
+  {
+    // the copy queue is in-order, the event of the last write covers both
 
-        if (off)
-        {
-          if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_pws_comp_buf, device_param->pws_comp, off * sizeof (u32)) == -1) return -1;
-        }
-      }
+    cl_event *event_idx = (off) ? NULL : &device_param->opencl_event_prefetch;
 
-      if (device_param->is_opencl == true)
-      {
-        if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_pws_idx, CL_TRUE, 0, pws_cnt * sizeof (pw_idx_t), device_param->pws_idx, 0, NULL, NULL) == -1) return -1;
+    if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue_copy, device_param->opencl_d_pws_prefetch_idx, CL_FALSE, 0, pws_cnt * sizeof (pw_idx_t), device_param->pws_idx, 0, NULL, event_idx) == -1) return -1;
 
-        const pw_idx_t *pw_idx = device_param->pws_idx + pws_cnt;
+    if (off)
+    {
+      if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue_copy, device_param->opencl_d_pws_prefetch_comp_buf, CL_FALSE, 0, off * sizeof (u32), device_param->pws_comp, 0, NULL, &device_param->opencl_event_prefetch) == -1) return -1;
+    }
 
-        const u32 off = pw_idx->off;
+    if (hc_clFlush (hashcat_ctx, device_param->opencl_command_queue_copy) == -1) return -1;
+  }
 
-        if (off)
-        {
-          if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_pws_comp_buf, CL_TRUE, 0, off * sizeof (u32), device_param->pws_comp, 0, NULL, NULL) == -1) return -1;
-        }
-      }
+  device_param->pws_prefetched = true;
 
-      if (run_kernel_decompress (hashcat_ctx, device_param, pws_cnt) == -1) return -1;
-    }
-    else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
+  return 0;
+}
+
+int run_copy_prefetch_wait (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
+{
+  device_param->pws_prefetched = false;
+
+  if (device_param->is_cuda == true)
+  {
+    if (hc_cuEventSynchronize (hashcat_ctx, device_param->cuda_event_prefetch) == -1) return -1;
+  }
+
+  if (device_param->is_opencl == true)
+  {
+    if (hc_clWaitForEvents (hashcat_ctx, 1, &device_param->opencl_event_prefetch) == -1) return -1;
+
+    if (hc_clReleaseEvent (hashcat_ctx, device_param->opencl_event_prefetch) == -1) return -1;
+
+    device_param->opencl_event_prefetch = NULL;
+  }
+
+  return 0;
+}
+
+int run_copy (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u64 pws_cnt)
+{
+  hashconfig_t         *hashconfig          = hashcat_ctx->hashconfig;
+  user_options_t       *user_options        = hashcat_ctx->user_options;
+  user_options_extra_t *user_options_extra  = hashcat_ctx->user_options_extra;
+
+  // init speed timer
+
+  #if defined (_WIN)
+  if (device_param->timer_speed.QuadPart == 0)
+  {
+    hc_timer_set (&device_param->timer_speed);
+  }
+  #else
+  if (device_param->timer_speed.tv_sec == 0)
+  {
+    hc_timer_set (&device_param->timer_speed);
+  }
+  #endif
+
+  if (device_param->pws_prefetched == true)
+  {
+    // the batch was uploaded by run_copy_prefetch () while the previous one was cracked
+
+    if (run_copy_prefetch_wait (hashcat_ctx, device_param) == -1) return -1;
+
+    if (run_kernel_decompress (hashcat_ctx, device_param, pws_cnt) == -1) return -1;
+
+    return 0;
+  }
+
+  if (user_options->slow_candidates == true)
+  {
+    if (device_param->is_cuda == true)
     {
-      if (hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL)
+      if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_pws_idx, device_param->pws_idx, pws_cnt * sizeof (pw_idx_t)) == -1) return -1;
+
+      const pw_idx_t *pw_idx = device_param->pws_idx + pws_cnt;
+
+      const u32 off = pw_idx->off;
+
+      if (off)
       {
-        if (user_options->attack_mode == ATTACK_MODE_COMBI)
+        if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_pws_comp_buf, device_param->pws_comp, off * sizeof (u32)) == -1) return -1;
+      }
+    }
+
+    if (device_param->is_opencl == true)
+    {
+      if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_pws_idx, CL_TRUE, 0, pws_cnt * sizeof (pw_idx_t), device_param->pws_idx, 0, NULL, NULL) == -1) return -1;
+
+      const pw_idx_t *pw_idx = device_param->pws_idx + pws_cnt;
+
+      const u32 off = pw_idx->off;
+
+      if (off)
+      {
+        if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_pws_comp_buf, CL_TRUE, 0, off * sizeof (u32), device_param->pws_comp, 0, NULL, NULL) == -1) return -1;
+      }
+    }
+
+    if (run_kernel_decompress (hashcat_ctx, device_param, pws_cnt) == -1) return -1;
+  }
+  else
+  {
+    if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
+    {
+      if (device_param->is_cuda == true)
+      {
+        if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_pws_idx, device_param->pws_idx, pws_cnt * sizeof (pw_idx_t)) == -1) return -1;
+
+        const pw_idx_t *pw_idx = device_param->pws_idx + pws_cnt;
+
+        const u32 off = pw_idx->off;
+
+        if (off)
         {
-          if (combinator_ctx->combs_mode == COMBINATOR_MODE_BASE_RIGHT)
-          {
-            if (hashconfig->opts_type & OPTS_TYPE_PT_ADD01)
-            {
-              rebuild_pws_compressed_append (device_param, pws_cnt, 0x01);
-            }
-            else if (hashconfig->opts_type & OPTS_TYPE_PT_ADD06)
-            {
-              rebuild_pws_compressed_append (device_param, pws_cnt, 0x06);
-            }
-            else if (hashconfig->opts_type & OPTS_TYPE_PT_ADD80)
-            {
-              rebuild_pws_compressed_append (device_param, pws_cnt, 0x80);
-            }
-          }
+          if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_pws_comp_buf, device_param->pws_comp, off * sizeof (u32)) == -1) return -1;
         }
-        else if (user_options->attack_mode == ATTACK_MODE_HYBRID2)
+      }
+
+      if (device_param->is_opencl == true)
+      {
+        if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_pws_idx, CL_TRUE, 0, pws_cnt * sizeof (pw_idx_t), device_param->pws_idx, 0, NULL, NULL) == -1) return -1;
+
+        const pw_idx_t *pw_idx = device_param->pws_idx + pws_cnt;
+
+        const u32 off = pw_idx->off;
+
+        if (off)
         {
-          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD01)
-          {
-            rebuild_pws_compressed_append (device_param, pws_cnt, 0x01);
-          }
-          else if (hashconfig->opts_type & OPTS_TYPE_PT_ADD06)
-          {
-            rebuild_pws_compressed_append (device_param, pws_cnt, 0x06);
-          }
-          else if (hashconfig->opts_type & OPTS_TYPE_PT_ADD80)
-          {
-            rebuild_pws_compressed_append (device_param, pws_cnt, 0x80);
-          }
+          if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_pws_comp_buf, CL_TRUE, 0, off * sizeof (u32), device_param->pws_comp, 0, NULL, NULL) == -1) return -1;
         }
+      }
+
+      if (run_kernel_decompress (hashcat_ctx, device_param, pws_cnt) == -1) return -1;
+    }
+    else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
+    {
+      if (hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL)
+      {
+        rebuild_pws_compressed (hashcat_ctx, device_param, pws_cnt);
 
         if (device_param->is_cuda == true)
         {
@@ -4848,6 +5069,7 @@ int backend_ctx_init (hashcat_ctx_t *hashcat_ctx)
   if (user_options->keyspace       == true) return 0;
   if (user_options->left           == true) return 0;
   if (user_options->show           == true) return 0;
+  if (user_options->stdout_host    == true) return 0;
   if (user_options->usage          == true) return 0;
   if (user_options->version        == true) return 0;
 
@@ -5298,6 +5520,123 @@ void backend_ctx_destroy (hashcat_ctx_t *hashcat_ctx)
   memset (backend_ctx, 0, sizeof (backend_ctx_t));
 }
 
+// host to device bandwidth shown by --backend-info, once from pageable and once from page-locked memory
+
+#define TRANSFER_CHECKS_CNT  4
+#define TRANSFER_CHECKS_SIZE (32 * 1024 * 1024)
+
+static double transfer_checks_speed (const double msec)
+{
+  if (msec <= 0) return 0;
+
+  return ((double) TRANSFER_CHECKS_CNT * TRANSFER_CHECKS_SIZE / 1024 / 1024) / (msec / 1000);
+}
+
+static double cuda_transfer_check (CUDA_PTR *cuda, CUdeviceptr device_buf, const void *host_buf)
+{
+  // the first copy is not timed, it pays for the lazy setup in the driver
+
+  if (cuda->cuMemcpyHtoD (device_buf, host_buf, TRANSFER_CHECKS_SIZE) != CUDA_SUCCESS) return 0;
+
+  hc_timer_t timer;
+
+  hc_timer_set (&timer);
+
+  for (int i = 0; i < TRANSFER_CHECKS_CNT; i++)
+  {
+    if (cuda->cuMemcpyHtoD (device_buf, host_buf, TRANSFER_CHECKS_SIZE) != CUDA_SUCCESS) return 0;
+  }
+
+  return transfer_checks_speed (hc_timer_get (timer));
+}
+
+static void cuda_transfer_checks (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
+{
+  backend_ctx_t *backend_ctx = hashcat_ctx->backend_ctx;
+
+  CUDA_PTR *cuda = (CUDA_PTR *) backend_ctx->cuda;
+
+  CUdeviceptr device_buf;
+
+  if (cuda->cuMemAlloc (&device_buf, TRANSFER_CHECKS_SIZE) != CUDA_SUCCESS) return;
+
+  void *pageable_buf = hcmalloc (TRANSFER_CHECKS_SIZE);
+
+  device_param->device_transfer_pageable = cuda_transfer_check (cuda, device_buf, pageable_buf);
+
+  hcfree (pageable_buf);
+
+  void *pinned_buf = NULL;
+
+  if (hc_cuMemAllocHost (hashcat_ctx, &pinned_buf, TRANSFER_CHECKS_SIZE) == 0)
+  {
+    memset (pinned_buf, 0, TRANSFER_CHECKS_SIZE);
+
+    device_param->device_transfer_pinned = cuda_transfer_check (cuda, device_buf, pinned_buf);
+
+    hc_cuMemFreeHost (hashcat_ctx, pinned_buf);
+  }
+
+  cuda->cuMemFree (device_buf);
+}
+
+static double opencl_transfer_check (OCL_PTR *ocl, cl_command_queue command_queue, cl_mem device_buf, const void *host_buf)
+{
+  if (ocl->clEnqueueWriteBuffer (command_queue, device_buf, CL_TRUE, 0, TRANSFER_CHECKS_SIZE, host_buf, 0, NULL, NULL) != CL_SUCCESS) return 0;
+
+  hc_timer_t timer;
+
+  hc_timer_set (&timer);
+
+  for (int i = 0; i < TRANSFER_CHECKS_CNT; i++)
+  {
+    if (ocl->clEnqueueWriteBuffer (command_queue, device_buf, CL_TRUE, 0, TRANSFER_CHECKS_SIZE, host_buf, 0, NULL, NULL) != CL_SUCCESS) return 0;
+  }
+
+  return transfer_checks_speed (hc_timer_get (timer));
+}
+
+static void opencl_transfer_checks (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, cl_context context, cl_command_queue command_queue)
+{
+  backend_ctx_t *backend_ctx = hashcat_ctx->backend_ctx;
+
+  OCL_PTR *ocl = (OCL_PTR *) backend_ctx->ocl;
+
+  cl_int CL_err;
+
+  cl_mem device_buf = ocl->clCreateBuffer (context, CL_MEM_READ_ONLY, TRANSFER_CHECKS_SIZE, NULL, &CL_err);
+
+  if (CL_err != CL_SUCCESS) return;
+
+  void *pageable_buf = hcmalloc (TRANSFER_CHECKS_SIZE);
+
+  device_param->device_transfer_pageable = opencl_transfer_check (ocl, command_queue, device_buf, pageable_buf);
+
+  hcfree (pageable_buf);
+
+  cl_mem pinned_mem = ocl->clCreateBuffer (context, CL_MEM_READ_WRITE | CL_MEM_ALLOC_HOST_PTR, TRANSFER_CHECKS_SIZE, NULL, &CL_err);
+
+  if (CL_err == CL_SUCCESS)
+  {
+    void *pinned_buf = ocl->clEnqueueMapBuffer (command_queue, pinned_mem, CL_TRUE, CL_MAP_READ | CL_MAP_WRITE, 0, TRANSFER_CHECKS_SIZE, 0, NULL, NULL, &CL_err);
+
+    if (CL_err == CL_SUCCESS)
+    {
+      memset (pinned_buf, 0, TRANSFER_CHECKS_SIZE);
+
+      device_param->device_transfer_pinned = opencl_transfer_check (ocl, command_queue, device_buf, pinned_buf);
+
+      ocl->clEnqueueUnmapMemObject (command_queue, pinned_mem, pinned_buf, 0, NULL, NULL);
+
+      ocl->clFinish (command_queue);
+    }
+
+    ocl->clReleaseMemObject (pinned_mem);
+  }
+
+  ocl->clReleaseMemObject (device_buf);
+}
+
 int backend_ctx_devices_init (hashcat_ctx_t *hashcat_ctx, const int comptime)
 {
   backend_ctx_t  *backend_ctx  = hashcat_ctx->backend_ctx;
@@ -5617,6 +5956,11 @@ int backend_ctx_devices_init (hashcat_ctx_t *hashcat_ctx, const int comptime)
 
       device_param->device_available_mem = (u64) free;
 
+      if ((user_options->backend_info == true) && (device_param->skipped == false))
+      {
+        cuda_transfer_checks (hashcat_ctx, device_param);
+      }
+
       if (hc_cuCtxDestroy (hashcat_ctx, cuda_context) == -1) return -1;
     }
   }
@@ -6526,6 +6870,11 @@ int backend_ctx_devices_init (hashcat_ctx_t *hashcat_ctx, const int comptime)
           hcfree (tmp_device);
         }
 
+        if ((user_options->backend_info == true) && (device_param->skipped == false))
+        {
+          opencl_transfer_checks (hashcat_ctx, device_param, context, command_queue);
+        }
+
         hc_clReleaseCommandQueue (hashcat_ctx, command_queue);
 
         hc_clReleaseContext (hashcat_ctx, context);
@@ -7340,147 +7689,258 @@ static bool load_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_p
   return true;
 }
 
-int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
+static HC_API_CALL void *load_kernel_thread (void *p)
 {
-  const bitmap_ctx_t         *bitmap_ctx          = hashcat_ctx->bitmap_ctx;
-  const folder_config_t      *folder_config       = hashcat_ctx->folder_config;
-  const hashconfig_t         *hashconfig          = hashcat_ctx->hashconfig;
-  const hashes_t             *hashes              = hashcat_ctx->hashes;
-  const module_ctx_t         *module_ctx          = hashcat_ctx->module_ctx;
-        backend_ctx_t        *backend_ctx         = hashcat_ctx->backend_ctx;
-  const straight_ctx_t       *straight_ctx        = hashcat_ctx->straight_ctx;
-  const user_options_extra_t *user_options_extra  = hashcat_ctx->user_options_extra;
-  const user_options_t       *user_options        = hashcat_ctx->user_options;
-
-  if (backend_ctx->enabled == false) return 0;
+  kernel_build_t *kernel_build = (kernel_build_t *) p;
 
-  u64 size_total_host_all = 0;
+  hc_device_param_t *device_param = kernel_build->device_param;
 
-  u32 hardware_power_all = 0;
+  // the CUDA context was created in the device thread, it has to be made current here as well
 
-  for (int backend_devices_idx = 0; backend_devices_idx < backend_ctx->backend_devices_cnt; backend_devices_idx++)
+  if (device_param->is_cuda == true)
   {
-    /**
-     * host buffer
-     */
+    if (hc_cuCtxSetCurrent (kernel_build->hashcat_ctx, device_param->cuda_context) == -1) return NULL;
+  }
 
-    hc_device_param_t *device_param = &backend_ctx->devices_param[backend_devices_idx];
+  kernel_build->cached = (kernel_build->cache_disable == false) && (hc_path_read (kernel_build->cached_file) == true) && (hc_path_is_empty (kernel_build->cached_file) == false);
 
-    if (device_param->skipped == true) continue;
+  kernel_build->rc = load_kernel (kernel_build->hashcat_ctx, device_param, kernel_build->kernel_name, kernel_build->source_file, kernel_build->cached_file, kernel_build->build_options_buf, kernel_build->cache_disable, kernel_build->opencl_program, kernel_build->cuda_module);
 
-    EVENT_DATA (EVENT_BACKEND_DEVICE_INIT_PRE, &backend_devices_idx, sizeof (int));
+  return NULL;
+}
 
-    const int device_id = device_param->device_id;
+static void hook_pool_init (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
+{
+  status_ctx_t   *status_ctx   = hashcat_ctx->status_ctx;
+  user_options_t *user_options = hashcat_ctx->user_options;
 
-    /**
-     * module depending checks
-     */
+  // the workers live as long as the session, hook_pool_run () only wakes them up for each batch and salt
 
-    device_param->skipped_warning = false;
+  hook_pool_t *hook_pool = (hook_pool_t *) hccalloc (1, sizeof (hook_pool_t));
 
-    if (module_ctx->module_unstable_warning != MODULE_DEFAULT)
-    {
-      const bool unstable_warning = module_ctx->module_unstable_warning (hashconfig, user_options, user_options_extra, device_param);
+  // --hook-threads is per device, each of them runs its hooks at the same time as the others
 
-      if ((unstable_warning == true) && (user_options->force == false))
-      {
-        event_log_warning (hashcat_ctx, "* Device #%u: Skipping hash-mode %u - known CUDA/OpenCL Runtime/Driver issue (not a hashcat issue)", device_id + 1, hashconfig->hash_mode);
-        event_log_warning (hashcat_ctx, "             You can use --force to override, but do not report related errors.");
+  hook_pool->threads_cnt  = (int) MAX (1, user_options->hook_threads);
+  hook_pool->threads      = (hc_thread_t *) hccalloc (hook_pool->threads_cnt, sizeof (hc_thread_t));
+  hook_pool->status_ctx   = status_ctx;
+  hook_pool->device_param = device_param;
 
-        device_param->skipped_warning = true;
+  hc_thread_sem_init (hook_pool->sem_work);
+  hc_thread_sem_init (hook_pool->sem_done);
 
-        continue;
-      }
-    }
+  for (int i = 0; i < hook_pool->threads_cnt; i++)
+  {
+    hc_thread_create (hook_pool->threads[i], hook_thread, hook_pool);
+  }
 
-    // vector_width
+  device_param->hook_pool = hook_pool;
+  device_param->hook_usec = 0;
+}
 
-    int vector_width = 0;
+static void hook_pool_destroy (hc_device_param_t *device_param)
+{
+  hook_pool_t *hook_pool = device_param->hook_pool;
 
-    if (user_options->backend_vector_width_chgd == false)
-    {
-      // tuning db
+  if (hook_pool == NULL) return;
 
-      tuning_db_entry_t *tuningdb_entry;
+  hook_pool->shutdown = true;
 
-      if (user_options->slow_candidates == true)
-      {
-        tuningdb_entry = tuning_db_search (hashcat_ctx, device_param->device_name, device_param->opencl_device_type, 0, hashconfig->hash_mode);
-      }
-      else
-      {
-        tuningdb_entry = tuning_db_search (hashcat_ctx, device_param->device_name, device_param->opencl_device_type, user_options->attack_mode, hashconfig->hash_mode);
-      }
+  for (int i = 0; i < hook_pool->threads_cnt; i++) hc_thread_sem_post (hook_pool->sem_work);
 
-      if (tuningdb_entry == NULL || tuningdb_entry->vector_width == -1)
-      {
-        if (hashconfig->opti_type & OPTI_TYPE_USES_BITS_64)
-        {
-          if (device_param->is_cuda == true)
-          {
-            // cuda does not support this query
+  hc_thread_wait (hook_pool->threads_cnt, hook_pool->threads);
 
-            vector_width = 1;
-          }
+  hc_thread_sem_close (hook_pool->sem_work);
+  hc_thread_sem_close (hook_pool->sem_done);
 
-          if (device_param->is_opencl == true)
-          {
-            if (hc_clGetDeviceInfo (hashcat_ctx, device_param->opencl_device, CL_DEVICE_NATIVE_VECTOR_WIDTH_LONG, sizeof (vector_width), &vector_width, NULL) == -1) return -1;
-          }
-        }
-        else
-        {
-          if (device_param->is_cuda == true)
-          {
-            // cuda does not support this query
+  hcfree (hook_pool->threads);
+  hcfree (hook_pool);
 
-            vector_width = 1;
-          }
+  device_param->hook_pool = NULL;
+}
 
-          if (device_param->is_opencl == true)
-          {
-            if (hc_clGetDeviceInfo (hashcat_ctx, device_param->opencl_device, CL_DEVICE_NATIVE_VECTOR_WIDTH_INT,  sizeof (vector_width), &vector_width, NULL) == -1) return -1;
-          }
-        }
-      }
-      else
-      {
-        vector_width = (cl_uint) tuningdb_entry->vector_width;
-      }
-    }
-    else
+static void *host_buffer_alloc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const size_t size, cl_mem *opencl_h_buf)
+{
+  backend_ctx_t *backend_ctx = hashcat_ctx->backend_ctx;
+
+  // failing here is not fatal, the caller falls back to pageable memory
+
+  void *buf = NULL;
+
+  if (device_param->is_cuda == true)
+  {
+    if (hc_cuMemAllocHost (hashcat_ctx, &buf, size) == -1) return NULL;
+  }
+
+  if (device_param->is_opencl == true)
+  {
+    OCL_PTR *ocl = (OCL_PTR *) backend_ctx->ocl;
+
+    cl_int CL_err;
+
+    cl_mem mem = ocl->clCreateBuffer (device_param->opencl_context, CL_MEM_READ_WRITE | CL_MEM_ALLOC_HOST_PTR, size, NULL, &CL_err);
+
+    if (CL_err != CL_SUCCESS) return NULL;
+
+    // the buffer stays mapped for the whole session, only the host side of it is ever used
+
+    buf = ocl->clEnqueueMapBuffer (device_param->opencl_command_queue, mem, CL_TRUE, CL_MAP_READ | CL_MAP_WRITE, 0, size, 0, NULL, NULL, &CL_err);
+
+    if (CL_err != CL_SUCCESS)
     {
-      vector_width = user_options->backend_vector_width;
+      ocl->clReleaseMemObject (mem);
+
+      return NULL;
     }
 
-    // We can't have SIMD in kernels where we have an unknown final password length
-    // It also turns out that pure kernels (that have a higher register pressure)
-    // actually run faster on scalar GPU (like 1080) without SIMD
+    *opencl_h_buf = mem;
+  }
+
+  memset (buf, 0, size);
+
+  return buf;
+}
+
+static void host_buffer_free (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, void *buf, cl_mem opencl_h_buf)
+{
+  if (buf == NULL) return;
+
+  if (device_param->host_pinned == false)
+  {
+    hcfree (buf);
+
+    return;
+  }
+
+  if (device_param->is_cuda == true)
+  {
+    hc_cuMemFreeHost (hashcat_ctx, buf);
+  }
+
+  if (device_param->is_opencl == true)
+  {
+    hc_clEnqueueUnmapMemObject (hashcat_ctx, device_param->opencl_command_queue, opencl_h_buf, buf, 0, NULL, NULL);
+
+    hc_clFinish (hashcat_ctx, device_param->opencl_command_queue);
+
+    hc_clReleaseMemObject (hashcat_ctx, opencl_h_buf);
+  }
+}
+
+static void host_buffers_free (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
+{
+  host_buffer_free (hashcat_ctx, device_param, device_param->pws_comp,          device_param->opencl_h_pws_comp);
+  host_buffer_free (hashcat_ctx, device_param, device_param->pws_idx,           device_param->opencl_h_pws_idx);
+  host_buffer_free (hashcat_ctx, device_param, device_param->pws_prefetch_comp, device_param->opencl_h_pws_prefetch_comp);
+  host_buffer_free (hashcat_ctx, device_param, device_param->pws_prefetch_idx,  device_param->opencl_h_pws_prefetch_idx);
+  host_buffer_free (hashcat_ctx, device_param, device_param->combs_buf,         device_param->opencl_h_combs_buf);
+
+  device_param->pws_comp          = NULL;
+  device_param->pws_idx           = NULL;
+  device_param->pws_prefetch_comp = NULL;
+  device_param->pws_prefetch_idx  = NULL;
+  device_param->combs_buf         = NULL;
+
+  device_param->opencl_h_pws_comp          = NULL;
+  device_param->opencl_h_pws_idx           = NULL;
+  device_param->opencl_h_pws_prefetch_comp = NULL;
+  device_param->opencl_h_pws_prefetch_idx  = NULL;
+  device_param->opencl_h_combs_buf         = NULL;
+}
+
+static void host_buffers_alloc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
+{
+  // the buffers uploaded for every batch are page-locked, so the transfers skip the driver's bounce buffer
+  // and the uploads of run_copy_prefetch () really run asynchronously
+
+  const size_t size_combs = KERNEL_COMBS * sizeof (pw_t);
+
+  device_param->host_pinned = true;
+
+  device_param->pws_comp  = (u32 *)      host_buffer_alloc (hashcat_ctx, device_param, device_param->size_pws_comp, &device_param->opencl_h_pws_comp);
+  device_param->pws_idx   = (pw_idx_t *) host_buffer_alloc (hashcat_ctx, device_param, device_param->size_pws_idx,  &device_param->opencl_h_pws_idx);
+  device_param->combs_buf = (pw_t *)     host_buffer_alloc (hashcat_ctx, device_param, size_combs,                  &device_param->opencl_h_combs_buf);
+
+  bool pinned_failed = ((device_param->pws_comp == NULL) || (device_param->pws_idx == NULL) || (device_param->combs_buf == NULL));
+
+  if ((pinned_failed == false) && (device_param->pws_prefetch == true))
+  {
+    device_param->pws_prefetch_comp = (u32 *)      host_buffer_alloc (hashcat_ctx, device_param, device_param->size_pws_comp, &device_param->opencl_h_pws_prefetch_comp);
+    device_param->pws_prefetch_idx  = (pw_idx_t *) host_buffer_alloc (hashcat_ctx, device_param, device_param->size_pws_idx,  &device_param->opencl_h_pws_prefetch_idx);
+
+    pinned_failed = ((device_param->pws_prefetch_comp == NULL) || (device_param->pws_prefetch_idx == NULL));
+  }
+
+  if (pinned_failed == false) return;
+
+  host_buffers_free (hashcat_ctx, device_param);
+
+  device_param->host_pinned = false;
+
+  event_log_warning (hashcat_ctx, "* Device #%u: Could not allocate page-locked host memory, falling back to pageable memory.", device_param->device_id + 1);
+
+  device_param->pws_comp  = (u32 *)      hcmalloc (device_param->size_pws_comp);
+  device_param->pws_idx   = (pw_idx_t *) hcmalloc (device_param->size_pws_idx);
+  device_param->combs_buf = (pw_t *)     hccalloc (KERNEL_COMBS, sizeof (pw_t));
+
+  if (device_param->pws_prefetch == true)
+  {
+    device_param->pws_prefetch_comp = (u32 *)      hcmalloc (device_param->size_pws_comp);
+    device_param->pws_prefetch_idx  = (pw_idx_t *) hcmalloc (device_param->size_pws_idx);
+  }
+}
+
+static int backend_session_begin_device (hashcat_ctx_t *hashcat_ctx, const int backend_devices_idx, u64 *size_total_host_all)
+{
+  const bitmap_ctx_t         *bitmap_ctx          = hashcat_ctx->bitmap_ctx;
+  const folder_config_t      *folder_config       = hashcat_ctx->folder_config;
+  const hashconfig_t         *hashconfig          = hashcat_ctx->hashconfig;
+  const hashes_t             *hashes              = hashcat_ctx->hashes;
+  const module_ctx_t         *module_ctx          = hashcat_ctx->module_ctx;
+  const backend_ctx_t        *backend_ctx         = hashcat_ctx->backend_ctx;
+  const straight_ctx_t       *straight_ctx        = hashcat_ctx->straight_ctx;
+  const user_options_extra_t *user_options_extra  = hashcat_ctx->user_options_extra;
+  const user_options_t       *user_options        = hashcat_ctx->user_options;
+
+  /**
+   * host buffer
+   */
+
+  hc_device_param_t *device_param = &backend_ctx->devices_param[backend_devices_idx];
+
+  if (device_param->skipped == true) return 1;
+
+  const int device_id = device_param->device_id;
+
+  /**
+   * module depending checks
+   */
+
+  device_param->skipped_warning = false;
+
+  if (module_ctx->module_unstable_warning != MODULE_DEFAULT)
+  {
+    const bool unstable_warning = module_ctx->module_unstable_warning (hashconfig, user_options, user_options_extra, device_param);
 
-    if ((hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL) == 0)
+    if ((unstable_warning == true) && (user_options->force == false))
     {
-      if (device_param->opencl_device_type & CL_DEVICE_TYPE_GPU)
-      {
-        vector_width = 1;
-      }
-    }
+      event_log_warning (hashcat_ctx, "* Device #%u: Skipping hash-mode %u - known CUDA/OpenCL Runtime/Driver issue (not a hashcat issue)", device_id + 1, hashconfig->hash_mode);
+      event_log_warning (hashcat_ctx, "             You can use --force to override, but do not report related errors.");
 
-    if (vector_width > 16) vector_width = 16;
+      device_param->skipped_warning = true;
 
-    device_param->vector_width = vector_width;
+      return 1;
+    }
+  }
 
-    /**
-     * kernel accel and loops tuning db adjustment
-     */
+  // vector_width
 
-    device_param->kernel_accel_min   = hashconfig->kernel_accel_min;
-    device_param->kernel_accel_max   = hashconfig->kernel_accel_max;
-    device_param->kernel_loops_min   = hashconfig->kernel_loops_min;
-    device_param->kernel_loops_max   = hashconfig->kernel_loops_max;
-    device_param->kernel_threads_min = hashconfig->kernel_threads_min;
-    device_param->kernel_threads_max = hashconfig->kernel_threads_max;
+  int vector_width = 0;
 
-    tuning_db_entry_t *tuningdb_entry = NULL;
+  if (user_options->backend_vector_width_chgd == false)
+  {
+    // tuning db
+
+    tuning_db_entry_t *tuningdb_entry;
 
     if (user_options->slow_candidates == true)
     {
@@ -7491,2767 +7951,2932 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
       tuningdb_entry = tuning_db_search (hashcat_ctx, device_param->device_name, device_param->opencl_device_type, user_options->attack_mode, hashconfig->hash_mode);
     }
 
-    // user commandline option override tuning db
-    // but both have to stay inside the boundaries of the module
-
-    if (user_options->kernel_accel_chgd == true)
+    if (tuningdb_entry == NULL || tuningdb_entry->vector_width == -1)
     {
-      const u32 _kernel_accel = user_options->kernel_accel;
-
-      if ((_kernel_accel >= device_param->kernel_accel_min) && (_kernel_accel <= device_param->kernel_accel_max))
+      if (hashconfig->opti_type & OPTI_TYPE_USES_BITS_64)
       {
-        device_param->kernel_accel_min = _kernel_accel;
-        device_param->kernel_accel_max = _kernel_accel;
-      }
-    }
-    else
-    {
-      if (tuningdb_entry != NULL)
-      {
-        const u32 _kernel_accel = tuningdb_entry->kernel_accel;
+        if (device_param->is_cuda == true)
+        {
+          // cuda does not support this query
+
+          vector_width = 1;
+        }
 
-        if (_kernel_accel)
+        if (device_param->is_opencl == true)
         {
-          if ((_kernel_accel >= device_param->kernel_accel_min) && (_kernel_accel <= device_param->kernel_accel_max))
-          {
-            device_param->kernel_accel_min = _kernel_accel;
-            device_param->kernel_accel_max = _kernel_accel;
-          }
+          if (hc_clGetDeviceInfo (hashcat_ctx, device_param->opencl_device, CL_DEVICE_NATIVE_VECTOR_WIDTH_LONG, sizeof (vector_width), &vector_width, NULL) == -1) return -1;
         }
       }
-    }
+      else
+      {
+        if (device_param->is_cuda == true)
+        {
+          // cuda does not support this query
 
-    if (user_options->kernel_loops_chgd == true)
-    {
-      const u32 _kernel_loops = user_options->kernel_loops;
+          vector_width = 1;
+        }
 
-      if ((_kernel_loops >= device_param->kernel_loops_min) && (_kernel_loops <= device_param->kernel_loops_max))
-      {
-        device_param->kernel_loops_min = _kernel_loops;
-        device_param->kernel_loops_max = _kernel_loops;
+        if (device_param->is_opencl == true)
+        {
+          if (hc_clGetDeviceInfo (hashcat_ctx, device_param->opencl_device, CL_DEVICE_NATIVE_VECTOR_WIDTH_INT,  sizeof (vector_width), &vector_width, NULL) == -1) return -1;
+        }
       }
     }
     else
     {
-      if (tuningdb_entry != NULL)
-      {
-        u32 _kernel_loops = tuningdb_entry->kernel_loops;
+      vector_width = (cl_uint) tuningdb_entry->vector_width;
+    }
+  }
+  else
+  {
+    vector_width = user_options->backend_vector_width;
+  }
 
-        if (_kernel_loops)
-        {
-          if (user_options->workload_profile == 1)
-          {
-            _kernel_loops = (_kernel_loops > 8) ? _kernel_loops / 8 : 1;
-          }
-          else if (user_options->workload_profile == 2)
-          {
-            _kernel_loops = (_kernel_loops > 4) ? _kernel_loops / 4 : 1;
-          }
+  // We can't have SIMD in kernels where we have an unknown final password length
+  // It also turns out that pure kernels (that have a higher register pressure)
+  // actually run faster on scalar GPU (like 1080) without SIMD
 
-          if ((_kernel_loops >= device_param->kernel_loops_min) && (_kernel_loops <= device_param->kernel_loops_max))
-          {
-            device_param->kernel_loops_min = _kernel_loops;
-            device_param->kernel_loops_max = _kernel_loops;
-          }
-        }
-      }
+  if ((hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL) == 0)
+  {
+    if (device_param->opencl_device_type & CL_DEVICE_TYPE_GPU)
+    {
+      vector_width = 1;
     }
+  }
+
+  if (vector_width > 16) vector_width = 16;
+
+  device_param->vector_width = vector_width;
+
+  /**
+   * kernel accel and loops tuning db adjustment
+   */
 
-    // there's no thread column in tuning db, stick to commandline if defined
+  device_param->kernel_accel_min   = hashconfig->kernel_accel_min;
+  device_param->kernel_accel_max   = hashconfig->kernel_accel_max;
+  device_param->kernel_loops_min   = hashconfig->kernel_loops_min;
+  device_param->kernel_loops_max   = hashconfig->kernel_loops_max;
+  device_param->kernel_threads_min = hashconfig->kernel_threads_min;
+  device_param->kernel_threads_max = hashconfig->kernel_threads_max;
 
-    if (user_options->kernel_threads_chgd == true)
+  tuning_db_entry_t *tuningdb_entry = NULL;
+
+  if (user_options->slow_candidates == true)
+  {
+    tuningdb_entry = tuning_db_search (hashcat_ctx, device_param->device_name, device_param->opencl_device_type, 0, hashconfig->hash_mode);
+  }
+  else
+  {
+    tuningdb_entry = tuning_db_search (hashcat_ctx, device_param->device_name, device_param->opencl_device_type, user_options->attack_mode, hashconfig->hash_mode);
+  }
+
+  // user commandline option override tuning db
+  // but both have to stay inside the boundaries of the module
+
+  if (user_options->kernel_accel_chgd == true)
+  {
+    const u32 _kernel_accel = user_options->kernel_accel;
+
+    if ((_kernel_accel >= device_param->kernel_accel_min) && (_kernel_accel <= device_param->kernel_accel_max))
+    {
+      device_param->kernel_accel_min = _kernel_accel;
+      device_param->kernel_accel_max = _kernel_accel;
+    }
+  }
+  else
+  {
+    if (tuningdb_entry != NULL)
     {
-      const u32 _kernel_threads = user_options->kernel_threads;
+      const u32 _kernel_accel = tuningdb_entry->kernel_accel;
 
-      if ((_kernel_threads >= device_param->kernel_threads_min) && (_kernel_threads <= device_param->kernel_threads_max))
+      if (_kernel_accel)
       {
-        device_param->kernel_threads_min = _kernel_threads;
-        device_param->kernel_threads_max = _kernel_threads;
+        if ((_kernel_accel >= device_param->kernel_accel_min) && (_kernel_accel <= device_param->kernel_accel_max))
+        {
+          device_param->kernel_accel_min = _kernel_accel;
+          device_param->kernel_accel_max = _kernel_accel;
+        }
       }
     }
+  }
 
-    if (user_options->slow_candidates == true)
+  if (user_options->kernel_loops_chgd == true)
+  {
+    const u32 _kernel_loops = user_options->kernel_loops;
+
+    if ((_kernel_loops >= device_param->kernel_loops_min) && (_kernel_loops <= device_param->kernel_loops_max))
     {
+      device_param->kernel_loops_min = _kernel_loops;
+      device_param->kernel_loops_max = _kernel_loops;
     }
-    else
+  }
+  else
+  {
+    if (tuningdb_entry != NULL)
     {
-      // we have some absolute limits for fast hashes (because of limit constant memory), make sure not to overstep
+      u32 _kernel_loops = tuningdb_entry->kernel_loops;
 
-      if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+      if (_kernel_loops)
       {
-        if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
+        if (user_options->workload_profile == 1)
         {
-          device_param->kernel_loops_min = MIN (device_param->kernel_loops_min, KERNEL_RULES);
-          device_param->kernel_loops_max = MIN (device_param->kernel_loops_max, KERNEL_RULES);
+          _kernel_loops = (_kernel_loops > 8) ? _kernel_loops / 8 : 1;
         }
-        else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
+        else if (user_options->workload_profile == 2)
         {
-          device_param->kernel_loops_min = MIN (device_param->kernel_loops_min, KERNEL_COMBS);
-          device_param->kernel_loops_max = MIN (device_param->kernel_loops_max, KERNEL_COMBS);
+          _kernel_loops = (_kernel_loops > 4) ? _kernel_loops / 4 : 1;
         }
-        else if (user_options_extra->attack_kern == ATTACK_KERN_BF)
+
+        if ((_kernel_loops >= device_param->kernel_loops_min) && (_kernel_loops <= device_param->kernel_loops_max))
         {
-          device_param->kernel_loops_min = MIN (device_param->kernel_loops_min, KERNEL_BFS);
-          device_param->kernel_loops_max = MIN (device_param->kernel_loops_max, KERNEL_BFS);
+          device_param->kernel_loops_min = _kernel_loops;
+          device_param->kernel_loops_max = _kernel_loops;
         }
       }
     }
+  }
 
-    device_param->kernel_loops_min_sav = device_param->kernel_loops_min;
-    device_param->kernel_loops_max_sav = device_param->kernel_loops_max;
+  // there's no thread column in tuning db, stick to commandline if defined
 
-    /**
-     * device properties
-     */
+  if (user_options->kernel_threads_chgd == true)
+  {
+    const u32 _kernel_threads = user_options->kernel_threads;
 
-    const u32 device_processors = device_param->device_processors;
+    if ((_kernel_threads >= device_param->kernel_threads_min) && (_kernel_threads <= device_param->kernel_threads_max))
+    {
+      device_param->kernel_threads_min = _kernel_threads;
+      device_param->kernel_threads_max = _kernel_threads;
+    }
+  }
 
-    /**
-     * create context for each device
-     */
+  if (user_options->slow_candidates == true)
+  {
+  }
+  else
+  {
+    // we have some absolute limits for fast hashes (because of limit constant memory), make sure not to overstep
 
-    if (device_param->is_cuda == true)
+    if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
     {
-      if (hc_cuCtxCreate (hashcat_ctx, &device_param->cuda_context, CU_CTX_SCHED_BLOCKING_SYNC, device_param->cuda_device) == -1) return -1;
+      if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
+      {
+        device_param->kernel_loops_min = MIN (device_param->kernel_loops_min, KERNEL_RULES);
+        device_param->kernel_loops_max = MIN (device_param->kernel_loops_max, KERNEL_RULES);
+      }
+      else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
+      {
+        device_param->kernel_loops_min = MIN (device_param->kernel_loops_min, KERNEL_COMBS);
+        device_param->kernel_loops_max = MIN (device_param->kernel_loops_max, KERNEL_COMBS);
+      }
+      else if (user_options_extra->attack_kern == ATTACK_KERN_BF)
+      {
+        device_param->kernel_loops_min = MIN (device_param->kernel_loops_min, KERNEL_BFS);
+        device_param->kernel_loops_max = MIN (device_param->kernel_loops_max, KERNEL_BFS);
+      }
     }
+  }
 
-    if (device_param->is_opencl == true)
-    {
-      /*
-      cl_context_properties properties[3];
+  device_param->kernel_loops_min_sav = device_param->kernel_loops_min;
+  device_param->kernel_loops_max_sav = device_param->kernel_loops_max;
 
-      properties[0] = CL_CONTEXT_PLATFORM;
-      properties[1] = (cl_context_properties) device_param->opencl_platform;
-      properties[2] = 0;
+  /**
+   * device properties
+   */
 
-      CL_rc = hc_clCreateContext (hashcat_ctx, properties, 1, &device_param->opencl_device, NULL, NULL, &device_param->opencl_context);
-      */
+  const u32 device_processors = device_param->device_processors;
 
-      if (hc_clCreateContext (hashcat_ctx, NULL, 1, &device_param->opencl_device, NULL, NULL, &device_param->opencl_context) == -1) return -1;
+  /**
+   * upload the next password batch while the current one is cracked
+   */
 
-      /**
-       * create command-queue
-       */
+  device_param->pws_prefetch = pws_prefetch_supported (hashcat_ctx);
 
-      // not supported with NV
-      // device_param->opencl_command_queue = hc_clCreateCommandQueueWithProperties (hashcat_ctx, device_param->opencl_device, NULL);
+  /**
+   * create context for each device
+   */
 
-      if (hc_clCreateCommandQueue (hashcat_ctx, device_param->opencl_context, device_param->opencl_device, CL_QUEUE_PROFILING_ENABLE, &device_param->opencl_command_queue) == -1) return -1;
-    }
+  if (device_param->is_cuda == true)
+  {
+    if (hc_cuCtxCreate (hashcat_ctx, &device_param->cuda_context, CU_CTX_SCHED_BLOCKING_SYNC, device_param->cuda_device) == -1) return -1;
+  }
+
+  if (device_param->is_opencl == true)
+  {
+    /*
+    cl_context_properties properties[3];
+
+    properties[0] = CL_CONTEXT_PLATFORM;
+    properties[1] = (cl_context_properties) device_param->opencl_platform;
+    properties[2] = 0;
+
+    CL_rc = hc_clCreateContext (hashcat_ctx, properties, 1, &device_param->opencl_device, NULL, NULL, &device_param->opencl_context);
+    */
+
+    if (hc_clCreateContext (hashcat_ctx, NULL, 1, &device_param->opencl_device, NULL, NULL, &device_param->opencl_context) == -1) return -1;
 
     /**
-     * create stream for CUDA devices
+     * create command-queue
      */
 
-    if (device_param->is_cuda == true)
+    // not supported with NV
+    // device_param->opencl_command_queue = hc_clCreateCommandQueueWithProperties (hashcat_ctx, device_param->opencl_device, NULL);
+
+    if (hc_clCreateCommandQueue (hashcat_ctx, device_param->opencl_context, device_param->opencl_device, CL_QUEUE_PROFILING_ENABLE, &device_param->opencl_command_queue) == -1) return -1;
+
+    // the uploads of the next password batch go through their own queue, otherwise they would wait for the kernels in front of them
+
+    if (device_param->pws_prefetch == true)
     {
-      if (hc_cuStreamCreate (hashcat_ctx, &device_param->cuda_stream, CU_STREAM_DEFAULT) == -1) return -1;
+      if (hc_clCreateCommandQueue (hashcat_ctx, device_param->opencl_context, device_param->opencl_device, 0, &device_param->opencl_command_queue_copy) == -1) return -1;
     }
+  }
 
-    /**
-     * create events for CUDA devices
-     */
+  /**
+   * create stream for CUDA devices
+   */
 
-    if (device_param->is_cuda == true)
-    {
-      if (hc_cuEventCreate (hashcat_ctx, &device_param->cuda_event1, CU_EVENT_DEFAULT) == -1) return -1;
+  if (device_param->is_cuda == true)
+  {
+    if (hc_cuStreamCreate (hashcat_ctx, &device_param->cuda_stream, CU_STREAM_DEFAULT) == -1) return -1;
 
-      if (hc_cuEventCreate (hashcat_ctx, &device_param->cuda_event2, CU_EVENT_DEFAULT) == -1) return -1;
+    if (device_param->pws_prefetch == true)
+    {
+      if (hc_cuStreamCreate (hashcat_ctx, &device_param->cuda_stream_copy, CU_STREAM_NON_BLOCKING) == -1) return -1;
     }
+  }
 
-    /**
-     * create input buffers on device : calculate size of fixed memory buffers
-     */
+  /**
+   * create events for CUDA devices
+   */
 
-    u64 size_root_css   = SP_PW_MAX *           sizeof (cs_t);
-    u64 size_markov_css = SP_PW_MAX * CHARSIZ * sizeof (cs_t);
+  if (device_param->is_cuda == true)
+  {
+    if (hc_cuEventCreate (hashcat_ctx, &device_param->cuda_event1, CU_EVENT_DEFAULT) == -1) return -1;
 
-    device_param->size_root_css   = size_root_css;
-    device_param->size_markov_css = size_markov_css;
+    if (hc_cuEventCreate (hashcat_ctx, &device_param->cuda_event2, CU_EVENT_DEFAULT) == -1) return -1;
 
-    u64 size_results = sizeof (u32);
+    if (device_param->pws_prefetch == true)
+    {
+      if (hc_cuEventCreate (hashcat_ctx, &device_param->cuda_event_prefetch, CU_EVENT_DISABLE_TIMING) == -1) return -1;
+    }
+  }
 
-    device_param->size_results = size_results;
+  /**
+   * create input buffers on device : calculate size of fixed memory buffers
+   */
 
-    u64 size_rules   = (u64) straight_ctx->kernel_rules_cnt * sizeof (kernel_rule_t);
-    u64 size_rules_c = (u64) KERNEL_RULES                   * sizeof (kernel_rule_t);
+  u64 size_root_css   = SP_PW_MAX *           sizeof (cs_t);
+  u64 size_markov_css = SP_PW_MAX * CHARSIZ * sizeof (cs_t);
 
-    device_param->size_rules    = size_rules;
-    device_param->size_rules_c  = size_rules_c;
+  device_param->size_root_css   = size_root_css;
+  device_param->size_markov_css = size_markov_css;
 
-    u64 size_plains  = (u64) hashes->digests_cnt * sizeof (plain_t);
-    u64 size_salts   = (u64) hashes->salts_cnt   * sizeof (salt_t);
-    u64 size_esalts  = (u64) hashes->digests_cnt * hashconfig->esalt_size;
-    u64 size_shown   = (u64) hashes->digests_cnt * sizeof (u32);
-    u64 size_digests = (u64) hashes->digests_cnt * (u64) hashconfig->dgst_size;
+  u64 size_results = sizeof (u32);
 
-    device_param->size_plains   = size_plains;
-    device_param->size_digests  = size_digests;
-    device_param->size_shown    = size_shown;
-    device_param->size_salts    = size_salts;
-    device_param->size_esalts   = size_esalts;
+  device_param->size_results = size_results;
 
-    u64 size_combs = KERNEL_COMBS * sizeof (pw_t);
-    u64 size_bfs   = KERNEL_BFS   * sizeof (bf_t);
-    u64 size_tm    = 32           * sizeof (bs_word_t);
+  u64 size_rules   = (u64) straight_ctx->kernel_rules_cnt * sizeof (kernel_rule_t);
+  u64 size_rules_c = (u64) KERNEL_RULES                   * sizeof (kernel_rule_t);
 
-    device_param->size_bfs      = size_bfs;
-    device_param->size_combs    = size_combs;
-    device_param->size_tm       = size_tm;
+  device_param->size_rules    = size_rules;
+  device_param->size_rules_c  = size_rules_c;
 
-    u64 size_st_digests = 1 * hashconfig->dgst_size;
-    u64 size_st_salts   = 1 * sizeof (salt_t);
-    u64 size_st_esalts  = 1 * hashconfig->esalt_size;
+  u64 size_plains  = (u64) hashes->digests_cnt * sizeof (plain_t);
+  u64 size_salts   = (u64) hashes->salts_cnt   * sizeof (salt_t);
+  u64 size_esalts  = (u64) hashes->digests_cnt * hashconfig->esalt_size;
+  u64 size_shown   = (u64) hashes->digests_cnt * sizeof (u32);
+  u64 size_digests = (u64) hashes->digests_cnt * (u64) hashconfig->dgst_size;
 
-    device_param->size_st_digests = size_st_digests;
-    device_param->size_st_salts   = size_st_salts;
-    device_param->size_st_esalts  = size_st_esalts;
+  device_param->size_plains   = size_plains;
+  device_param->size_digests  = size_digests;
+  device_param->size_shown    = size_shown;
+  device_param->size_salts    = size_salts;
+  device_param->size_esalts   = size_esalts;
 
-    u64 size_extra_buffer = 4;
+  u64 size_combs = KERNEL_COMBS * sizeof (pw_t);
+  u64 size_bfs   = KERNEL_BFS   * sizeof (bf_t);
+  u64 size_tm    = 32           * sizeof (bs_word_t);
 
-    if (module_ctx->module_extra_buffer_size != MODULE_DEFAULT)
-    {
-      const u64 extra_buffer_size = module_ctx->module_extra_buffer_size (hashconfig, user_options, user_options_extra, hashes, device_param);
+  device_param->size_bfs      = size_bfs;
+  device_param->size_combs    = size_combs;
+  device_param->size_tm       = size_tm;
 
-      if (extra_buffer_size == (u64) -1)
-      {
-        event_log_error (hashcat_ctx, "Invalid extra buffer size.");
+  u64 size_st_digests = 1 * hashconfig->dgst_size;
+  u64 size_st_salts   = 1 * sizeof (salt_t);
+  u64 size_st_esalts  = 1 * hashconfig->esalt_size;
 
-        return -1;
-      }
+  device_param->size_st_digests = size_st_digests;
+  device_param->size_st_salts   = size_st_salts;
+  device_param->size_st_esalts  = size_st_esalts;
+
+  u64 size_extra_buffer = 4;
 
-      device_param->extra_buffer_size = extra_buffer_size;
+  if (module_ctx->module_extra_buffer_size != MODULE_DEFAULT)
+  {
+    const u64 extra_buffer_size = module_ctx->module_extra_buffer_size (hashconfig, user_options, user_options_extra, hashes, device_param);
+
+    if (extra_buffer_size == (u64) -1)
+    {
+      event_log_error (hashcat_ctx, "Invalid extra buffer size.");
 
-      size_extra_buffer = extra_buffer_size;
+      return -1;
     }
 
-    // kern type
+    device_param->extra_buffer_size = extra_buffer_size;
+
+    size_extra_buffer = extra_buffer_size;
+  }
+
+  // kern type
 
-    u32 kern_type = hashconfig->kern_type;
+  u32 kern_type = hashconfig->kern_type;
 
-    if (module_ctx->module_kern_type_dynamic != MODULE_DEFAULT)
+  if (module_ctx->module_kern_type_dynamic != MODULE_DEFAULT)
+  {
+    if (user_options->benchmark == true)
     {
-      if (user_options->benchmark == true)
-      {
-      }
-      else
-      {
-        void        *digests_buf    = hashes->digests_buf;
-        salt_t      *salts_buf      = hashes->salts_buf;
-        void        *esalts_buf     = hashes->esalts_buf;
-        void        *hook_salts_buf = hashes->hook_salts_buf;
-        hashinfo_t **hash_info      = hashes->hash_info;
+    }
+    else
+    {
+      void        *digests_buf    = hashes->digests_buf;
+      salt_t      *salts_buf      = hashes->salts_buf;
+      void        *esalts_buf     = hashes->esalts_buf;
+      void        *hook_salts_buf = hashes->hook_salts_buf;
+      hashinfo_t **hash_info      = hashes->hash_info;
 
-        hashinfo_t *hash_info_ptr = NULL;
+      hashinfo_t *hash_info_ptr = NULL;
 
-        if (hash_info) hash_info_ptr = hash_info[0];
+      if (hash_info) hash_info_ptr = hash_info[0];
 
-        kern_type = (u32) module_ctx->module_kern_type_dynamic (hashconfig, digests_buf, salts_buf, esalts_buf, hook_salts_buf, hash_info_ptr);
-      }
+      kern_type = (u32) module_ctx->module_kern_type_dynamic (hashconfig, digests_buf, salts_buf, esalts_buf, hook_salts_buf, hash_info_ptr);
     }
+  }
 
-    // built options
+  // built options
 
-    const size_t build_options_sz = 4096;
+  const size_t build_options_sz = 4096;
 
-    char *build_options_buf = (char *) hcmalloc (build_options_sz);
+  char *build_options_buf = (char *) hcmalloc (build_options_sz);
 
-    int build_options_len = 0;
+  int build_options_len = 0;
 
-    #if defined (_WIN)
-    build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-D KERNEL_STATIC -I OpenCL -I \"%s\" ", folder_config->cpath_real);
-    #else
-    build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-D KERNEL_STATIC -I OpenCL -I %s ", folder_config->cpath_real);
-    #endif
+  #if defined (_WIN)
+  build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-D KERNEL_STATIC -I OpenCL -I \"%s\" ", folder_config->cpath_real);
+  #else
+  build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-D KERNEL_STATIC -I OpenCL -I %s ", folder_config->cpath_real);
+  #endif
 
-    /* currently disabled, hangs NEO drivers since 20.09.
-       was required for NEO driver 20.08 to workaround the same issue!
-       we go with the latest version
+  /* currently disabled, hangs NEO drivers since 20.09.
+     was required for NEO driver 20.08 to workaround the same issue!
+     we go with the latest version
 
-    if (device_param->is_opencl == true)
+  if (device_param->is_opencl == true)
+  {
+    if (device_param->use_opencl12 == true)
     {
-      if (device_param->use_opencl12 == true)
-      {
-        build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-cl-std=CL1.2 ");
-      }
-      else if (device_param->use_opencl20 == true)
-      {
-        build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-cl-std=CL2.0 ");
-      }
-      else if (device_param->use_opencl21 == true)
-      {
-        build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-cl-std=CL2.1 ");
-      }
+      build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-cl-std=CL1.2 ");
     }
-    */
+    else if (device_param->use_opencl20 == true)
+    {
+      build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-cl-std=CL2.0 ");
+    }
+    else if (device_param->use_opencl21 == true)
+    {
+      build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-cl-std=CL2.1 ");
+    }
+  }
+  */
 
-    // we don't have sm_* on vendors not NV but it doesn't matter
+  // we don't have sm_* on vendors not NV but it doesn't matter
 
-    #if defined (DEBUG)
-    build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-D LOCAL_MEM_TYPE=%d -D VENDOR_ID=%u -D CUDA_ARCH=%u -D HAS_ADD=%u -D HAS_ADDC=%u -D HAS_SUB=%u -D HAS_SUBC=%u -D HAS_VADD=%u -D HAS_VADDC=%u -D HAS_VADD_CO=%u -D HAS_VADDC_CO=%u -D HAS_VSUB=%u -D HAS_VSUBB=%u -D HAS_VSUB_CO=%u -D HAS_VSUBB_CO=%u -D HAS_VPERM=%u -D HAS_VADD3=%u -D HAS_VBFE=%u -D HAS_BFE=%u -D HAS_LOP3=%u -D HAS_MOV64=%u -D HAS_PRMT=%u -D VECT_SIZE=%d -D DEVICE_TYPE=%u -D DGST_R0=%u -D DGST_R1=%u -D DGST_R2=%u -D DGST_R3=%u -D DGST_ELEM=%u -D KERN_TYPE=%u -D ATTACK_EXEC=%u -D ATTACK_KERN=%u ", device_param->device_local_mem_type, device_param->opencl_platform_vendor_id, (device_param->sm_major * 100) + (device_param->sm_minor * 10), device_param->has_add, device_param->has_addc, device_param->has_sub, device_param->has_subc, device_param->has_vadd, device_param->has_vaddc, device_param->has_vadd_co, device_param->has_vaddc_co, device_param->has_vsub, device_param->has_vsubb, device_param->has_vsub_co, device_param->has_vsubb_co, device_param->has_vperm, device_param->has_vadd3, device_param->has_vbfe, device_param->has_bfe, device_param->has_lop3, device_param->has_mov64, device_param->has_prmt, device_param->vector_width, (u32) device_param->opencl_device_type, hashconfig->dgst_pos0, hashconfig->dgst_pos1, hashconfig->dgst_pos2, hashconfig->dgst_pos3, hashconfig->dgst_size / 4, kern_type, hashconfig->attack_exec, user_options_extra->attack_kern);
-    #else
-    build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-D LOCAL_MEM_TYPE=%d -D VENDOR_ID=%u -D CUDA_ARCH=%u -D HAS_ADD=%u -D HAS_ADDC=%u -D HAS_SUB=%u -D HAS_SUBC=%u -D HAS_VADD=%u -D HAS_VADDC=%u -D HAS_VADD_CO=%u -D HAS_VADDC_CO=%u -D HAS_VSUB=%u -D HAS_VSUBB=%u -D HAS_VSUB_CO=%u -D HAS_VSUBB_CO=%u -D HAS_VPERM=%u -D HAS_VADD3=%u -D HAS_VBFE=%u -D HAS_BFE=%u -D HAS_LOP3=%u -D HAS_MOV64=%u -D HAS_PRMT=%u -D VECT_SIZE=%d -D DEVICE_TYPE=%u -D DGST_R0=%u -D DGST_R1=%u -D DGST_R2=%u -D DGST_R3=%u -D DGST_ELEM=%u -D KERN_TYPE=%u -D ATTACK_EXEC=%u -D ATTACK_KERN=%u -w ", device_param->device_local_mem_type, device_param->opencl_platform_vendor_id, (device_param->sm_major * 100) + (device_param->sm_minor * 10), device_param->has_add, device_param->has_addc, device_param->has_sub, device_param->has_subc, device_param->has_vadd, device_param->has_vaddc, device_param->has_vadd_co, device_param->has_vaddc_co, device_param->has_vsub, device_param->has_vsubb, device_param->has_vsub_co, device_param->has_vsubb_co, device_param->has_vperm, device_param->has_vadd3, device_param->has_vbfe, device_param->has_bfe, device_param->has_lop3, device_param->has_mov64, device_param->has_prmt, device_param->vector_width, (u32) device_param->opencl_device_type, hashconfig->dgst_pos0, hashconfig->dgst_pos1, hashconfig->dgst_pos2, hashconfig->dgst_pos3, hashconfig->dgst_size / 4, kern_type, hashconfig->attack_exec, user_options_extra->attack_kern);
-    #endif
+  #if defined (DEBUG)
+  build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-D LOCAL_MEM_TYPE=%d -D VENDOR_ID=%u -D CUDA_ARCH=%u -D HAS_ADD=%u -D HAS_ADDC=%u -D HAS_SUB=%u -D HAS_SUBC=%u -D HAS_VADD=%u -D HAS_VADDC=%u -D HAS_VADD_CO=%u -D HAS_VADDC_CO=%u -D HAS_VSUB=%u -D HAS_VSUBB=%u -D HAS_VSUB_CO=%u -D HAS_VSUBB_CO=%u -D HAS_VPERM=%u -D HAS_VADD3=%u -D HAS_VBFE=%u -D HAS_BFE=%u -D HAS_LOP3=%u -D HAS_MOV64=%u -D HAS_PRMT=%u -D VECT_SIZE=%d -D DEVICE_TYPE=%u -D DGST_R0=%u -D DGST_R1=%u -D DGST_R2=%u -D DGST_R3=%u -D DGST_ELEM=%u -D KERN_TYPE=%u -D ATTACK_EXEC=%u -D ATTACK_KERN=%u ", device_param->device_local_mem_type, device_param->opencl_platform_vendor_id, (device_param->sm_major * 100) + (device_param->sm_minor * 10), device_param->has_add, device_param->has_addc, device_param->has_sub, device_param->has_subc, device_param->has_vadd, device_param->has_vaddc, device_param->has_vadd_co, device_param->has_vaddc_co, device_param->has_vsub, device_param->has_vsubb, device_param->has_vsub_co, device_param->has_vsubb_co, device_param->has_vperm, device_param->has_vadd3, device_param->has_vbfe, device_param->has_bfe, device_param->has_lop3, device_param->has_mov64, device_param->has_prmt, device_param->vector_width, (u32) device_param->opencl_device_type, hashconfig->dgst_pos0, hashconfig->dgst_pos1, hashconfig->dgst_pos2, hashconfig->dgst_pos3, hashconfig->dgst_size / 4, kern_type, hashconfig->attack_exec, user_options_extra->attack_kern);
+  #else
+  build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-D LOCAL_MEM_TYPE=%d -D VENDOR_ID=%u -D CUDA_ARCH=%u -D HAS_ADD=%u -D HAS_ADDC=%u -D HAS_SUB=%u -D HAS_SUBC=%u -D HAS_VADD=%u -D HAS_VADDC=%u -D HAS_VADD_CO=%u -D HAS_VADDC_CO=%u -D HAS_VSUB=%u -D HAS_VSUBB=%u -D HAS_VSUB_CO=%u -D HAS_VSUBB_CO=%u -D HAS_VPERM=%u -D HAS_VADD3=%u -D HAS_VBFE=%u -D HAS_BFE=%u -D HAS_LOP3=%u -D HAS_MOV64=%u -D HAS_PRMT=%u -D VECT_SIZE=%d -D DEVICE_TYPE=%u -D DGST_R0=%u -D DGST_R1=%u -D DGST_R2=%u -D DGST_R3=%u -D DGST_ELEM=%u -D KERN_TYPE=%u -D ATTACK_EXEC=%u -D ATTACK_KERN=%u -w ", device_param->device_local_mem_type, device_param->opencl_platform_vendor_id, (device_param->sm_major * 100) + (device_param->sm_minor * 10), device_param->has_add, device_param->has_addc, device_param->has_sub, device_param->has_subc, device_param->has_vadd, device_param->has_vaddc, device_param->has_vadd_co, device_param->has_vaddc_co, device_param->has_vsub, device_param->has_vsubb, device_param->has_vsub_co, device_param->has_vsubb_co, device_param->has_vperm, device_param->has_vadd3, device_param->has_vbfe, device_param->has_bfe, device_param->has_lop3, device_param->has_mov64, device_param->has_prmt, device_param->vector_width, (u32) device_param->opencl_device_type, hashconfig->dgst_pos0, hashconfig->dgst_pos1, hashconfig->dgst_pos2, hashconfig->dgst_pos3, hashconfig->dgst_size / 4, kern_type, hashconfig->attack_exec, user_options_extra->attack_kern);
+  #endif
 
-    build_options_buf[build_options_len] = 0;
+  build_options_buf[build_options_len] = 0;
 
-    /*
-    if (device_param->opencl_device_type & CL_DEVICE_TYPE_CPU)
+  /*
+  if (device_param->opencl_device_type & CL_DEVICE_TYPE_CPU)
+  {
+    if (device_param->opencl_platform_vendor_id == VENDOR_ID_INTEL_SDK)
     {
-      if (device_param->opencl_platform_vendor_id == VENDOR_ID_INTEL_SDK)
-      {
-        strncat (build_options_buf, " -cl-opt-disable", 16);
-      }
+      strncat (build_options_buf, " -cl-opt-disable", 16);
     }
-    */
-
-    #if defined (DEBUG)
-    if (user_options->quiet == false) event_log_warning (hashcat_ctx, "* Device #%u: build_options '%s'", device_id + 1, build_options_buf);
-    #endif
+  }
+  */
 
-    /**
-     * device_name_chksum
-     */
+  #if defined (DEBUG)
+  if (user_options->quiet == false) event_log_warning (hashcat_ctx, "* Device #%u: build_options '%s'", device_id + 1, build_options_buf);
+  #endif
 
-    char *device_name_chksum        = (char *) hcmalloc (HCBUFSIZ_TINY);
-    char *device_name_chksum_amp_mp = (char *) hcmalloc (HCBUFSIZ_TINY);
+  /**
+   * device_name_chksum
+   */
 
-    const size_t dnclen = snprintf (device_name_chksum, HCBUFSIZ_TINY, "%d-%d-%d-%u-%s-%s-%s-%d-%u",
-      backend_ctx->comptime,
-      backend_ctx->cuda_driver_version,
-      device_param->is_opencl,
-      device_param->opencl_platform_vendor_id,
-      device_param->device_name,
-      device_param->opencl_device_version,
-      device_param->opencl_driver_version,
-      device_param->vector_width,
-      hashconfig->kern_type);
+  char *device_name_chksum        = (char *) hcmalloc (HCBUFSIZ_TINY);
+  char *device_name_chksum_amp_mp = (char *) hcmalloc (HCBUFSIZ_TINY);
 
-    const size_t dnclen_amp_mp = snprintf (device_name_chksum_amp_mp, HCBUFSIZ_TINY, "%d-%d-%d-%u-%s-%s-%s",
-      backend_ctx->comptime,
-      backend_ctx->cuda_driver_version,
-      device_param->is_opencl,
-      device_param->opencl_platform_vendor_id,
-      device_param->device_name,
-      device_param->opencl_device_version,
-      device_param->opencl_driver_version);
+  const size_t dnclen = snprintf (device_name_chksum, HCBUFSIZ_TINY, "%d-%d-%d-%u-%s-%s-%s-%d-%u",
+    backend_ctx->comptime,
+    backend_ctx->cuda_driver_version,
+    device_param->is_opencl,
+    device_param->opencl_platform_vendor_id,
+    device_param->device_name,
+    device_param->opencl_device_version,
+    device_param->opencl_driver_version,
+    device_param->vector_width,
+    hashconfig->kern_type);
 
-    md5_ctx_t md5_ctx;
+  const size_t dnclen_amp_mp = snprintf (device_name_chksum_amp_mp, HCBUFSIZ_TINY, "%d-%d-%d-%u-%s-%s-%s",
+    backend_ctx->comptime,
+    backend_ctx->cuda_driver_version,
+    device_param->is_opencl,
+    device_param->opencl_platform_vendor_id,
+    device_param->device_name,
+    device_param->opencl_device_version,
+    device_param->opencl_driver_version);
 
-    md5_init   (&md5_ctx);
-    md5_update (&md5_ctx, (u32 *) device_name_chksum, dnclen);
-    md5_final  (&md5_ctx);
+  md5_ctx_t md5_ctx;
 
-    snprintf (device_name_chksum, HCBUFSIZ_TINY, "%08x", md5_ctx.h[0]);
+  md5_init   (&md5_ctx);
+  md5_update (&md5_ctx, (u32 *) device_name_chksum, dnclen);
+  md5_final  (&md5_ctx);
 
-    md5_init   (&md5_ctx);
-    md5_update (&md5_ctx, (u32 *) device_name_chksum_amp_mp, dnclen_amp_mp);
-    md5_final  (&md5_ctx);
+  snprintf (device_name_chksum, HCBUFSIZ_TINY, "%08x", md5_ctx.h[0]);
 
-    snprintf (device_name_chksum_amp_mp, HCBUFSIZ_TINY, "%08x", md5_ctx.h[0]);
+  md5_init   (&md5_ctx);
+  md5_update (&md5_ctx, (u32 *) device_name_chksum_amp_mp, dnclen_amp_mp);
+  md5_final  (&md5_ctx);
 
-    /**
-     * kernel cache
-     */
+  snprintf (device_name_chksum_amp_mp, HCBUFSIZ_TINY, "%08x", md5_ctx.h[0]);
 
-    bool cache_disable = false;
+  /**
+   * kernel cache
+   */
 
-    // Seems to be completely broken on Apple + (Intel?) CPU
-    // To reproduce set cache_disable to false and run benchmark -b
+  bool cache_disable = false;
 
-    if (device_param->opencl_platform_vendor_id == VENDOR_ID_APPLE)
-    {
-      if (device_param->opencl_device_type & CL_DEVICE_TYPE_CPU)
-      {
-        cache_disable = true;
-      }
-    }
+  // Seems to be completely broken on Apple + (Intel?) CPU
+  // To reproduce set cache_disable to false and run benchmark -b
 
-    if (module_ctx->module_jit_cache_disable != MODULE_DEFAULT)
+  if (device_param->opencl_platform_vendor_id == VENDOR_ID_APPLE)
+  {
+    if (device_param->opencl_device_type & CL_DEVICE_TYPE_CPU)
     {
-      cache_disable = module_ctx->module_jit_cache_disable (hashconfig, user_options, user_options_extra, hashes, device_param);
+      cache_disable = true;
     }
+  }
 
-    /**
-     * shared kernel with no hashconfig dependencies
-     */
+  if (module_ctx->module_jit_cache_disable != MODULE_DEFAULT)
+  {
+    cache_disable = module_ctx->module_jit_cache_disable (hashconfig, user_options, user_options_extra, hashes, device_param);
+  }
 
-    {
-      /**
-       * kernel shared source filename
-       */
+  /**
+   * kernels: the shared kernel with no hashconfig dependencies, the main kernel, the word generator kernel and the amplifier kernel
+   */
 
-      char source_file[256] = { 0 };
+  char *build_options_module_buf = (char *) hcmalloc (build_options_sz);
 
-      generate_source_kernel_shared_filename (folder_config->shared_dir, source_file);
+  int build_options_module_len = 0;
 
-      if (hc_path_read (source_file) == false)
-      {
-        event_log_error (hashcat_ctx, "%s: %s", source_file, strerror (errno));
+  build_options_module_len += snprintf (build_options_module_buf + build_options_module_len, build_options_sz - build_options_module_len, "%s ", build_options_buf);
 
-        return -1;
-      }
-
-      /**
-       * kernel shared cached filename
-       */
+  if (module_ctx->module_jit_build_options != MODULE_DEFAULT)
+  {
+    char *jit_build_options = module_ctx->module_jit_build_options (hashconfig, user_options, user_options_extra, hashes, device_param);
 
-      char cached_file[256] = { 0 };
+    if (jit_build_options != NULL)
+    {
+      build_options_module_len += snprintf (build_options_module_buf + build_options_module_len, build_options_sz - build_options_module_len, "%s", jit_build_options);
 
-      generate_cached_kernel_shared_filename (folder_config->profile_dir, device_name_chksum_amp_mp, cached_file);
+      // this is a bit ugly
+      // would be better to have the module return the value as value
 
-      const bool rc_load_kernel = load_kernel (hashcat_ctx, device_param, "shared_kernel", source_file, cached_file, build_options_buf, cache_disable, &device_param->opencl_program_shared, &device_param->cuda_module_shared);
+      u32 fixed_local_size = 0;
 
-      if (rc_load_kernel == false)
+      if (sscanf (jit_build_options, "-D FIXED_LOCAL_SIZE=%u", &fixed_local_size) == 1)
       {
-        event_log_error (hashcat_ctx, "* Device #%u: Kernel %s build failed.", device_param->device_id + 1, source_file);
-
-        return -1;
+        device_param->kernel_threads_min = fixed_local_size;
+        device_param->kernel_threads_max = fixed_local_size;
       }
+    }
+  }
 
-      if (device_param->is_cuda == true)
-      {
-        // GPU memset
+  build_options_module_buf[build_options_module_len] = 0;
 
-        if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_memset, device_param->cuda_module_shared, "gpu_memset") == -1) return -1;
+  #if defined (DEBUG)
+  if (user_options->quiet == false) event_log_warning (hashcat_ctx, "* Device #%u: build_options_module '%s'", device_id + 1, build_options_module_buf);
+  #endif
 
-        if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_memset, &device_param->kernel_wgs_memset) == -1) return -1;
+  kernel_build_t kernel_builds[4];
 
-        if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_memset, &device_param->kernel_local_mem_size_memset) == -1) return -1;
+  memset (kernel_builds, 0, sizeof (kernel_builds));
 
-        if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function_memset, &device_param->kernel_dynamic_local_mem_size_memset) == -1) return -1;
+  int kernel_builds_cnt = 0;
 
-        device_param->kernel_preferred_wgs_multiple_memset = device_param->cuda_warp_size;
+  kernel_build_t *kernel_build_shared = &kernel_builds[kernel_builds_cnt++];
 
-        //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_memset, 0, sizeof (cl_mem),   device_param->kernel_params_memset[0]); if (CL_rc == -1) return -1;
-        //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_memset, 1, sizeof (cl_uint),  device_param->kernel_params_memset[1]); if (CL_rc == -1) return -1;
-        //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_memset, 2, sizeof (cl_ulong), device_param->kernel_params_memset[2]); if (CL_rc == -1) return -1;
+  generate_source_kernel_shared_filename (folder_config->shared_dir, kernel_build_shared->source_file);
 
-        // GPU autotune init
+  generate_cached_kernel_shared_filename (folder_config->profile_dir, device_name_chksum_amp_mp, kernel_build_shared->cached_file);
 
-        if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_atinit, device_param->cuda_module_shared, "gpu_atinit") == -1) return -1;
+  kernel_build_shared->kernel_name       = "shared_kernel";
+  kernel_build_shared->build_options_buf = build_options_buf;
+  kernel_build_shared->opencl_program    = &device_param->opencl_program_shared;
+  kernel_build_shared->cuda_module       = &device_param->cuda_module_shared;
 
-        if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_atinit, &device_param->kernel_wgs_atinit) == -1) return -1;
+  kernel_build_t *kernel_build_main = &kernel_builds[kernel_builds_cnt++];
 
-        if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_atinit, &device_param->kernel_local_mem_size_atinit) == -1) return -1;
+  generate_source_kernel_filename (user_options->slow_candidates, hashconfig->attack_exec, user_options_extra->attack_kern, kern_type, hashconfig->opti_type, folder_config->shared_dir, kernel_build_main->source_file);
 
-        if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function_atinit, &device_param->kernel_dynamic_local_mem_size_atinit) == -1) return -1;
+  generate_cached_kernel_filename (user_options->slow_candidates, hashconfig->attack_exec, user_options_extra->attack_kern, kern_type, hashconfig->opti_type, folder_config->profile_dir, device_name_chksum, kernel_build_main->cached_file);
 
-        device_param->kernel_preferred_wgs_multiple_atinit = device_param->cuda_warp_size;
+  kernel_build_main->kernel_name       = "main_kernel";
+  kernel_build_main->build_options_buf = build_options_module_buf;
+  kernel_build_main->opencl_program    = &device_param->opencl_program;
+  kernel_build_main->cuda_module       = &device_param->cuda_module;
 
-        // CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_atinit, 0, sizeof (cl_mem),   device_param->kernel_params_atinit[0]); if (CL_rc == -1) return -1;
-        // CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_atinit, 1, sizeof (cl_ulong), device_param->kernel_params_atinit[1]); if (CL_rc == -1) return -1;
+  if (user_options->slow_candidates == false)
+  {
+    if (user_options->attack_mode != ATTACK_MODE_STRAIGHT)
+    {
+      kernel_build_t *kernel_build_mp = &kernel_builds[kernel_builds_cnt++];
 
-        // GPU decompress
+      generate_source_kernel_mp_filename (hashconfig->opti_type, hashconfig->opts_type, folder_config->shared_dir, kernel_build_mp->source_file);
 
-        if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_decompress, device_param->cuda_module_shared, "gpu_decompress") == -1) return -1;
+      generate_cached_kernel_mp_filename (hashconfig->opti_type, hashconfig->opts_type, folder_config->profile_dir, device_name_chksum_amp_mp, kernel_build_mp->cached_file);
 
-        if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_decompress, &device_param->kernel_wgs_decompress) == -1) return -1;
+      kernel_build_mp->kernel_name       = "mp_kernel";
+      kernel_build_mp->build_options_buf = build_options_buf;
+      kernel_build_mp->opencl_program    = &device_param->opencl_program_mp;
+      kernel_build_mp->cuda_module       = &device_param->cuda_module_mp;
+    }
 
-        if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_decompress, &device_param->kernel_local_mem_size_decompress) == -1) return -1;
+    if (hashconfig->attack_exec != ATTACK_EXEC_INSIDE_KERNEL)
+    {
+      kernel_build_t *kernel_build_amp = &kernel_builds[kernel_builds_cnt++];
 
-        if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function_decompress, &device_param->kernel_dynamic_local_mem_size_decompress) == -1) return -1;
+      generate_source_kernel_amp_filename (user_options_extra->attack_kern, folder_config->shared_dir, kernel_build_amp->source_file);
 
-        device_param->kernel_preferred_wgs_multiple_decompress = device_param->cuda_warp_size;
-      }
+      generate_cached_kernel_amp_filename (user_options_extra->attack_kern, folder_config->profile_dir, device_name_chksum_amp_mp, kernel_build_amp->cached_file);
 
-      if (device_param->is_opencl == true)
-      {
-        // GPU memset
+      kernel_build_amp->kernel_name       = "amp_kernel";
+      kernel_build_amp->build_options_buf = build_options_buf;
+      kernel_build_amp->opencl_program    = &device_param->opencl_program_amp;
+      kernel_build_amp->cuda_module       = &device_param->cuda_module_amp;
+    }
+  }
 
-        if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program_shared, "gpu_memset", &device_param->opencl_kernel_memset) == -1) return -1;
+  int rc_builds = 0;
 
-        if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel_memset, &device_param->kernel_wgs_memset) == -1) return -1;
+  for (int kernel_builds_idx = 0; kernel_builds_idx < kernel_builds_cnt; kernel_builds_idx++)
+  {
+    kernel_build_t *kernel_build = &kernel_builds[kernel_builds_idx];
 
-        if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_memset, &device_param->kernel_local_mem_size_memset) == -1) return -1;
+    if (hc_path_read (kernel_build->source_file) == false)
+    {
+      event_log_error (hashcat_ctx, "%s: %s", kernel_build->source_file, strerror (errno));
 
-        if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_memset, &device_param->kernel_dynamic_local_mem_size_memset) == -1) return -1;
+      rc_builds = -1;
 
-        if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel_memset, &device_param->kernel_preferred_wgs_multiple_memset) == -1) return -1;
+      break;
+    }
 
-        // GPU autotune init
+    kernel_build->hashcat_ctx   = hashcat_ctx;
+    kernel_build->device_param  = device_param;
+    kernel_build->cache_disable = cache_disable;
+  }
 
-        if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program_shared, "gpu_atinit", &device_param->opencl_kernel_atinit) == -1) return -1;
+  if (rc_builds == 0)
+  {
+    // on a cold cache the programs are compiled at the same time, each one in its own thread
 
-        if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel_atinit, &device_param->kernel_wgs_atinit) == -1) return -1;
+    hc_thread_t kernel_build_threads[4];
 
-        if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_atinit, &device_param->kernel_local_mem_size_atinit) == -1) return -1;
+    hc_timer_t timer_builds;
 
-        if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_atinit, &device_param->kernel_dynamic_local_mem_size_atinit) == -1) return -1;
+    hc_timer_set (&timer_builds);
 
-        if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel_atinit, &device_param->kernel_preferred_wgs_multiple_atinit) == -1) return -1;
+    for (int kernel_builds_idx = 0; kernel_builds_idx < kernel_builds_cnt; kernel_builds_idx++)
+    {
+      hc_thread_create (kernel_build_threads[kernel_builds_idx], load_kernel_thread, &kernel_builds[kernel_builds_idx]);
+    }
 
-        // GPU decompress
+    hc_thread_wait (kernel_builds_cnt, kernel_build_threads);
 
-        if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program_shared, "gpu_decompress", &device_param->opencl_kernel_decompress) == -1) return -1;
+    device_param->kernels_msec   = hc_timer_get (timer_builds);
+    device_param->kernels_built  = (u32) kernel_builds_cnt;
+    device_param->kernels_cached = 0;
 
-        if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel_decompress, &device_param->kernel_wgs_decompress) == -1) return -1;
+    for (int kernel_builds_idx = 0; kernel_builds_idx < kernel_builds_cnt; kernel_builds_idx++)
+    {
+      const kernel_build_t *kernel_build = &kernel_builds[kernel_builds_idx];
 
-        if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_decompress, &device_param->kernel_local_mem_size_decompress) == -1) return -1;
+      if (kernel_build->cached == true) device_param->kernels_cached++;
 
-        if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_decompress, &device_param->kernel_dynamic_local_mem_size_decompress) == -1) return -1;
+      if (kernel_build->rc == false)
+      {
+        event_log_error (hashcat_ctx, "* Device #%u: Kernel %s build failed.", device_param->device_id + 1, kernel_build->source_file);
 
-        if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel_decompress, &device_param->kernel_preferred_wgs_multiple_decompress) == -1) return -1;
+        rc_builds = -1;
       }
     }
+  }
 
-    /**
-     * main kernel
-     */
+  hcfree (build_options_module_buf);
+  hcfree (build_options_buf);
 
-    {
-      char *build_options_module_buf = (char *) hcmalloc (build_options_sz);
+  if (rc_builds == -1)
+  {
+    hcfree (device_name_chksum);
+    hcfree (device_name_chksum_amp_mp);
 
-      int build_options_module_len = 0;
+    return -1;
+  }
 
-      build_options_module_len += snprintf (build_options_module_buf + build_options_module_len, build_options_sz - build_options_module_len, "%s ", build_options_buf);
+  /**
+   * shared kernel functions
+   */
 
-      if (module_ctx->module_jit_build_options != MODULE_DEFAULT)
-      {
-        char *jit_build_options = module_ctx->module_jit_build_options (hashconfig, user_options, user_options_extra, hashes, device_param);
+  {
+    if (device_param->is_cuda == true)
+    {
+      // GPU memset
 
-        if (jit_build_options != NULL)
-        {
-          build_options_module_len += snprintf (build_options_module_buf + build_options_module_len, build_options_sz - build_options_module_len, "%s", jit_build_options);
+      if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_memset, device_param->cuda_module_shared, "gpu_memset") == -1) return -1;
 
-          // this is a bit ugly
-          // would be better to have the module return the value as value
+      if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_memset, &device_param->kernel_wgs_memset) == -1) return -1;
 
-          u32 fixed_local_size = 0;
+      if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_memset, &device_param->kernel_local_mem_size_memset) == -1) return -1;
 
-          if (sscanf (jit_build_options, "-D FIXED_LOCAL_SIZE=%u", &fixed_local_size) == 1)
-          {
-            device_param->kernel_threads_min = fixed_local_size;
-            device_param->kernel_threads_max = fixed_local_size;
-          }
-        }
-      }
+      if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function_memset, &device_param->kernel_dynamic_local_mem_size_memset) == -1) return -1;
 
-      build_options_module_buf[build_options_module_len] = 0;
+      device_param->kernel_preferred_wgs_multiple_memset = device_param->cuda_warp_size;
 
-      #if defined (DEBUG)
-      if (user_options->quiet == false) event_log_warning (hashcat_ctx, "* Device #%u: build_options_module '%s'", device_id + 1, build_options_module_buf);
-      #endif
+      //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_memset, 0, sizeof (cl_mem),   device_param->kernel_params_memset[0]); if (CL_rc == -1) return -1;
+      //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_memset, 1, sizeof (cl_uint),  device_param->kernel_params_memset[1]); if (CL_rc == -1) return -1;
+      //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_memset, 2, sizeof (cl_ulong), device_param->kernel_params_memset[2]); if (CL_rc == -1) return -1;
 
-      /**
-       * kernel source filename
-       */
+      // GPU autotune init
 
-      char source_file[256] = { 0 };
+      if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_atinit, device_param->cuda_module_shared, "gpu_atinit") == -1) return -1;
 
-      generate_source_kernel_filename (user_options->slow_candidates, hashconfig->attack_exec, user_options_extra->attack_kern, kern_type, hashconfig->opti_type, folder_config->shared_dir, source_file);
+      if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_atinit, &device_param->kernel_wgs_atinit) == -1) return -1;
 
-      if (hc_path_read (source_file) == false)
-      {
-        event_log_error (hashcat_ctx, "%s: %s", source_file, strerror (errno));
+      if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_atinit, &device_param->kernel_local_mem_size_atinit) == -1) return -1;
 
-        return -1;
-      }
+      if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function_atinit, &device_param->kernel_dynamic_local_mem_size_atinit) == -1) return -1;
 
-      /**
-       * kernel cached filename
-       */
+      device_param->kernel_preferred_wgs_multiple_atinit = device_param->cuda_warp_size;
 
-      char cached_file[256] = { 0 };
+      // CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_atinit, 0, sizeof (cl_mem),   device_param->kernel_params_atinit[0]); if (CL_rc == -1) return -1;
+      // CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_atinit, 1, sizeof (cl_ulong), device_param->kernel_params_atinit[1]); if (CL_rc == -1) return -1;
 
-      generate_cached_kernel_filename (user_options->slow_candidates, hashconfig->attack_exec, user_options_extra->attack_kern, kern_type, hashconfig->opti_type, folder_config->profile_dir, device_name_chksum, cached_file);
+      // GPU decompress
 
-      /**
-       * load kernel
-       */
+      if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_decompress, device_param->cuda_module_shared, "gpu_decompress") == -1) return -1;
 
-      const bool rc_load_kernel = load_kernel (hashcat_ctx, device_param, "main_kernel", source_file, cached_file, build_options_module_buf, cache_disable, &device_param->opencl_program, &device_param->cuda_module);
+      if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_decompress, &device_param->kernel_wgs_decompress) == -1) return -1;
 
-      if (rc_load_kernel == false)
-      {
-        event_log_error (hashcat_ctx, "* Device #%u: Kernel %s build failed.", device_param->device_id + 1, source_file);
+      if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_decompress, &device_param->kernel_local_mem_size_decompress) == -1) return -1;
 
-        return -1;
-      }
+      if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function_decompress, &device_param->kernel_dynamic_local_mem_size_decompress) == -1) return -1;
 
-      hcfree (build_options_module_buf);
+      device_param->kernel_preferred_wgs_multiple_decompress = device_param->cuda_warp_size;
     }
 
-    /**
-     * word generator kernel
-     */
-
-    if (user_options->slow_candidates == true)
-    {
-    }
-    else
+    if (device_param->is_opencl == true)
     {
-      if (user_options->attack_mode != ATTACK_MODE_STRAIGHT)
-      {
-        /**
-         * kernel mp source filename
-         */
-
-        char source_file[256] = { 0 };
-
-        generate_source_kernel_mp_filename (hashconfig->opti_type, hashconfig->opts_type, folder_config->shared_dir, source_file);
-
-        if (hc_path_read (source_file) == false)
-        {
-          event_log_error (hashcat_ctx, "%s: %s", source_file, strerror (errno));
+      // GPU memset
 
-          return -1;
-        }
+      if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program_shared, "gpu_memset", &device_param->opencl_kernel_memset) == -1) return -1;
 
-        /**
-         * kernel mp cached filename
-         */
+      if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel_memset, &device_param->kernel_wgs_memset) == -1) return -1;
 
-        char cached_file[256] = { 0 };
+      if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_memset, &device_param->kernel_local_mem_size_memset) == -1) return -1;
 
-        generate_cached_kernel_mp_filename (hashconfig->opti_type, hashconfig->opts_type, folder_config->profile_dir, device_name_chksum_amp_mp, cached_file);
+      if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_memset, &device_param->kernel_dynamic_local_mem_size_memset) == -1) return -1;
 
-        const bool rc_load_kernel = load_kernel (hashcat_ctx, device_param, "mp_kernel", source_file, cached_file, build_options_buf, cache_disable, &device_param->opencl_program_mp, &device_param->cuda_module_mp);
+      if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel_memset, &device_param->kernel_preferred_wgs_multiple_memset) == -1) return -1;
 
-        if (rc_load_kernel == false)
-        {
-          event_log_error (hashcat_ctx, "* Device #%u: Kernel %s build failed.", device_param->device_id + 1, source_file);
+      // GPU autotune init
 
-          return -1;
-        }
-      }
-    }
+      if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program_shared, "gpu_atinit", &device_param->opencl_kernel_atinit) == -1) return -1;
 
-    /**
-     * amplifier kernel
-     */
+      if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel_atinit, &device_param->kernel_wgs_atinit) == -1) return -1;
 
-    if (user_options->slow_candidates == true)
-    {
-    }
-    else
-    {
-      if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-      {
+      if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_atinit, &device_param->kernel_local_mem_size_atinit) == -1) return -1;
 
-      }
-      else
-      {
-        /**
-         * kernel amp source filename
-         */
+      if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_atinit, &device_param->kernel_dynamic_local_mem_size_atinit) == -1) return -1;
 
-        char source_file[256] = { 0 };
+      if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel_atinit, &device_param->kernel_preferred_wgs_multiple_atinit) == -1) return -1;
 
-        generate_source_kernel_amp_filename (user_options_extra->attack_kern, folder_config->shared_dir, source_file);
+      // GPU decompress
 
-        if (hc_path_read (source_file) == false)
-        {
-          event_log_error (hashcat_ctx, "%s: %s", source_file, strerror (errno));
+      if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program_shared, "gpu_decompress", &device_param->opencl_kernel_decompress) == -1) return -1;
 
-          return -1;
-        }
+      if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel_decompress, &device_param->kernel_wgs_decompress) == -1) return -1;
 
-        /**
-         * kernel amp cached filename
-         */
+      if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_decompress, &device_param->kernel_local_mem_size_decompress) == -1) return -1;
 
-        char cached_file[256] = { 0 };
+      if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_decompress, &device_param->kernel_dynamic_local_mem_size_decompress) == -1) return -1;
 
-        generate_cached_kernel_amp_filename (user_options_extra->attack_kern, folder_config->profile_dir, device_name_chksum_amp_mp, cached_file);
+      if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel_decompress, &device_param->kernel_preferred_wgs_multiple_decompress) == -1) return -1;
+    }
+  }
 
-        const bool rc_load_kernel = load_kernel (hashcat_ctx, device_param, "amp_kernel", source_file, cached_file, build_options_buf, cache_disable, &device_param->opencl_program_amp, &device_param->cuda_module_amp);
+  hcfree (device_name_chksum);
+  hcfree (device_name_chksum_amp_mp);
 
-        if (rc_load_kernel == false)
-        {
-          event_log_error (hashcat_ctx, "* Device #%u: Kernel %s build failed.", device_param->device_id + 1, source_file);
+  // some algorithm collide too fast, make that impossible
 
-          return -1;
-        }
+  if (user_options->benchmark == true)
+  {
+    ((u32 *) hashes->digests_buf)[0] = -1U;
+    ((u32 *) hashes->digests_buf)[1] = -1U;
+    ((u32 *) hashes->digests_buf)[2] = -1U;
+    ((u32 *) hashes->digests_buf)[3] = -1U;
+  }
 
-        hcfree (build_options_buf);
-      }
-    }
+  /**
+   * global buffers
+   */
 
-    hcfree (device_name_chksum);
-    hcfree (device_name_chksum_amp_mp);
+  const u64 size_total_fixed
+    = bitmap_ctx->bitmap_size
+    + bitmap_ctx->bitmap_size
+    + bitmap_ctx->bitmap_size
+    + bitmap_ctx->bitmap_size
+    + bitmap_ctx->bitmap_size
+    + bitmap_ctx->bitmap_size
+    + bitmap_ctx->bitmap_size
+    + bitmap_ctx->bitmap_size
+    + size_plains
+    + size_digests
+    + size_shown
+    + size_salts
+    + size_results
+    + size_extra_buffer
+    + size_st_digests
+    + size_st_salts
+    + size_st_esalts
+    + size_esalts
+    + size_markov_css
+    + size_root_css
+    + size_rules
+    + size_rules_c
+    + size_tm;
+
+  if (size_total_fixed > device_param->device_available_mem)
+  {
+    event_log_error (hashcat_ctx, "* Device #%u: Not enough allocatable device memory for this hashlist and/or ruleset.", device_id + 1);
 
-    // some algorithm collide too fast, make that impossible
+    return -1;
+  }
 
-    if (user_options->benchmark == true)
-    {
-      ((u32 *) hashes->digests_buf)[0] = -1U;
-      ((u32 *) hashes->digests_buf)[1] = -1U;
-      ((u32 *) hashes->digests_buf)[2] = -1U;
-      ((u32 *) hashes->digests_buf)[3] = -1U;
-    }
+  if (device_param->is_cuda == true)
+  {
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bitmap_s1_a,    bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bitmap_s1_b,    bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bitmap_s1_c,    bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bitmap_s1_d,    bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bitmap_s2_a,    bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bitmap_s2_b,    bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bitmap_s2_c,    bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bitmap_s2_d,    bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_plain_bufs,     size_plains)             == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_digests_buf,    size_digests)            == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_digests_shown,  size_shown)              == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_salt_bufs,      size_salts)              == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_result,         size_results)            == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_extra0_buf,     size_extra_buffer / 4)   == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_extra1_buf,     size_extra_buffer / 4)   == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_extra2_buf,     size_extra_buffer / 4)   == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_extra3_buf,     size_extra_buffer / 4)   == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_st_digests_buf, size_st_digests)         == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_st_salts_buf,   size_st_salts)           == -1) return -1;
+
+    if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_bitmap_s1_a, bitmap_ctx->bitmap_s1_a, bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_bitmap_s1_b, bitmap_ctx->bitmap_s1_b, bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_bitmap_s1_c, bitmap_ctx->bitmap_s1_c, bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_bitmap_s1_d, bitmap_ctx->bitmap_s1_d, bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_bitmap_s2_a, bitmap_ctx->bitmap_s2_a, bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_bitmap_s2_b, bitmap_ctx->bitmap_s2_b, bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_bitmap_s2_c, bitmap_ctx->bitmap_s2_c, bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_bitmap_s2_d, bitmap_ctx->bitmap_s2_d, bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_digests_buf, hashes->digests_buf,     size_digests)            == -1) return -1;
+    if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_salt_bufs,   hashes->salts_buf,       size_salts)              == -1) return -1;
 
     /**
-     * global buffers
+     * special buffers
      */
 
-    const u64 size_total_fixed
-      = bitmap_ctx->bitmap_size
-      + bitmap_ctx->bitmap_size
-      + bitmap_ctx->bitmap_size
-      + bitmap_ctx->bitmap_size
-      + bitmap_ctx->bitmap_size
-      + bitmap_ctx->bitmap_size
-      + bitmap_ctx->bitmap_size
-      + bitmap_ctx->bitmap_size
-      + size_plains
-      + size_digests
-      + size_shown
-      + size_salts
-      + size_results
-      + size_extra_buffer
-      + size_st_digests
-      + size_st_salts
-      + size_st_esalts
-      + size_esalts
-      + size_markov_css
-      + size_root_css
-      + size_rules
-      + size_rules_c
-      + size_tm;
-
-    if (size_total_fixed > device_param->device_available_mem)
+    if (user_options->slow_candidates == true)
     {
-      event_log_error (hashcat_ctx, "* Device #%u: Not enough allocatable device memory for this hashlist and/or ruleset.", device_id + 1);
-
-      return -1;
+      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_rules_c, size_rules_c) == -1) return -1;
     }
-
-    if (device_param->is_cuda == true)
+    else
     {
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bitmap_s1_a,    bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bitmap_s1_b,    bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bitmap_s1_c,    bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bitmap_s1_d,    bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bitmap_s2_a,    bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bitmap_s2_b,    bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bitmap_s2_c,    bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bitmap_s2_d,    bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_plain_bufs,     size_plains)             == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_digests_buf,    size_digests)            == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_digests_shown,  size_shown)              == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_salt_bufs,      size_salts)              == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_result,         size_results)            == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_extra0_buf,     size_extra_buffer / 4)   == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_extra1_buf,     size_extra_buffer / 4)   == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_extra2_buf,     size_extra_buffer / 4)   == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_extra3_buf,     size_extra_buffer / 4)   == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_st_digests_buf, size_st_digests)         == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_st_salts_buf,   size_st_salts)           == -1) return -1;
-
-      if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_bitmap_s1_a, bitmap_ctx->bitmap_s1_a, bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_bitmap_s1_b, bitmap_ctx->bitmap_s1_b, bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_bitmap_s1_c, bitmap_ctx->bitmap_s1_c, bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_bitmap_s1_d, bitmap_ctx->bitmap_s1_d, bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_bitmap_s2_a, bitmap_ctx->bitmap_s2_a, bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_bitmap_s2_b, bitmap_ctx->bitmap_s2_b, bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_bitmap_s2_c, bitmap_ctx->bitmap_s2_c, bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_bitmap_s2_d, bitmap_ctx->bitmap_s2_d, bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_digests_buf, hashes->digests_buf,     size_digests)            == -1) return -1;
-      if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_salt_bufs,   hashes->salts_buf,       size_salts)              == -1) return -1;
-
-      /**
-       * special buffers
-       */
-
-      if (user_options->slow_candidates == true)
-      {
-        if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_rules_c, size_rules_c) == -1) return -1;
-      }
-      else
+      if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
       {
-        if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
-        {
-          if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_rules,   size_rules) == -1) return -1;
-
-          if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-          {
-            size_t dummy = 0;
+        if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_rules,   size_rules) == -1) return -1;
 
-            if (hc_cuModuleGetGlobal (hashcat_ctx, &device_param->cuda_d_rules_c, &dummy, device_param->cuda_module, "generic_constant") == -1) return -1;
-          }
-          else
-          {
-            if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_rules_c, size_rules_c) == -1) return -1;
-          }
+        if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+        {
+          size_t dummy = 0;
 
-          if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_rules, straight_ctx->kernel_rules_buf, size_rules) == -1) return -1;
+          if (hc_cuModuleGetGlobal (hashcat_ctx, &device_param->cuda_d_rules_c, &dummy, device_param->cuda_module, "generic_constant") == -1) return -1;
         }
-        else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
+        else
         {
-          if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_combs,          size_combs)      == -1) return -1;
-          if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_combs_c,        size_combs)      == -1) return -1;
-          if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_root_css_buf,   size_root_css)   == -1) return -1;
-          if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_markov_css_buf, size_markov_css) == -1) return -1;
+          if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_rules_c, size_rules_c) == -1) return -1;
         }
-        else if (user_options_extra->attack_kern == ATTACK_KERN_BF)
-        {
-          if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bfs,            size_bfs)        == -1) return -1;
-          if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_root_css_buf,   size_root_css)   == -1) return -1;
-          if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_markov_css_buf, size_markov_css) == -1) return -1;
-
-          if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-          {
-            size_t dummy = 0;
 
-            if (hc_cuModuleGetGlobal (hashcat_ctx, &device_param->cuda_d_bfs_c, &dummy, device_param->cuda_module, "generic_constant") == -1) return -1;
-
-            if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_tm_c,           size_tm)       == -1) return -1;
-          }
-          else
-          {
-            if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bfs_c,          size_bfs)      == -1) return -1;
-            if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_tm_c,           size_tm)       == -1) return -1;
-          }
-        }
+        if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_rules, straight_ctx->kernel_rules_buf, size_rules) == -1) return -1;
       }
-
-      if (size_esalts)
+      else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
       {
-        if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_esalt_bufs, size_esalts) == -1) return -1;
-
-        if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_esalt_bufs, hashes->esalts_buf, size_esalts) == -1) return -1;
+        if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_combs,          size_combs)      == -1) return -1;
+        if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_combs_c,        size_combs)      == -1) return -1;
+        if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_root_css_buf,   size_root_css)   == -1) return -1;
+        if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_markov_css_buf, size_markov_css) == -1) return -1;
       }
-
-      if (hashconfig->st_hash != NULL)
+      else if (user_options_extra->attack_kern == ATTACK_KERN_BF)
       {
-        if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_st_digests_buf, hashes->st_digests_buf, size_st_digests) == -1) return -1;
-        if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_st_salts_buf,   hashes->st_salts_buf,   size_st_salts)   == -1) return -1;
+        if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bfs,            size_bfs)        == -1) return -1;
+        if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_root_css_buf,   size_root_css)   == -1) return -1;
+        if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_markov_css_buf, size_markov_css) == -1) return -1;
 
-        if (size_esalts)
+        if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
         {
-          if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_st_esalts_buf, size_st_esalts) == -1) return -1;
+          size_t dummy = 0;
+
+          if (hc_cuModuleGetGlobal (hashcat_ctx, &device_param->cuda_d_bfs_c, &dummy, device_param->cuda_module, "generic_constant") == -1) return -1;
 
-          if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_st_esalts_buf, hashes->st_esalts_buf, size_st_esalts) == -1) return -1;
+          if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_tm_c,           size_tm)       == -1) return -1;
+        }
+        else
+        {
+          if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bfs_c,          size_bfs)      == -1) return -1;
+          if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_tm_c,           size_tm)       == -1) return -1;
         }
       }
     }
 
-    if (device_param->is_opencl == true)
+    if (size_esalts)
     {
-      if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY,   bitmap_ctx->bitmap_size, NULL, &device_param->opencl_d_bitmap_s1_a)    == -1) return -1;
-      if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY,   bitmap_ctx->bitmap_size, NULL, &device_param->opencl_d_bitmap_s1_b)    == -1) return -1;
-      if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY,   bitmap_ctx->bitmap_size, NULL, &device_param->opencl_d_bitmap_s1_c)    == -1) return -1;
-      if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY,   bitmap_ctx->bitmap_size, NULL, &device_param->opencl_d_bitmap_s1_d)    == -1) return -1;
-      if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY,   bitmap_ctx->bitmap_size, NULL, &device_param->opencl_d_bitmap_s2_a)    == -1) return -1;
-      if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY,   bitmap_ctx->bitmap_size, NULL, &device_param->opencl_d_bitmap_s2_b)    == -1) return -1;
-      if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY,   bitmap_ctx->bitmap_size, NULL, &device_param->opencl_d_bitmap_s2_c)    == -1) return -1;
-      if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY,   bitmap_ctx->bitmap_size, NULL, &device_param->opencl_d_bitmap_s2_d)    == -1) return -1;
-      if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_WRITE,  size_plains,             NULL, &device_param->opencl_d_plain_bufs)     == -1) return -1;
-      if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY,   size_digests,            NULL, &device_param->opencl_d_digests_buf)    == -1) return -1;
-      if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_WRITE,  size_shown,              NULL, &device_param->opencl_d_digests_shown)  == -1) return -1;
-      if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY,   size_salts,              NULL, &device_param->opencl_d_salt_bufs)      == -1) return -1;
-      if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_WRITE,  size_results,            NULL, &device_param->opencl_d_result)         == -1) return -1;
-      if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_WRITE,  size_extra_buffer / 4,   NULL, &device_param->opencl_d_extra0_buf)     == -1) return -1;
-      if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_WRITE,  size_extra_buffer / 4,   NULL, &device_param->opencl_d_extra1_buf)     == -1) return -1;
-      if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_WRITE,  size_extra_buffer / 4,   NULL, &device_param->opencl_d_extra2_buf)     == -1) return -1;
-      if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_WRITE,  size_extra_buffer / 4,   NULL, &device_param->opencl_d_extra3_buf)     == -1) return -1;
-      if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY,   size_st_digests,         NULL, &device_param->opencl_d_st_digests_buf) == -1) return -1;
-      if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY,   size_st_salts,           NULL, &device_param->opencl_d_st_salts_buf)   == -1) return -1;
-
-      if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_bitmap_s1_a, CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s1_a, 0, NULL, NULL) == -1) return -1;
-      if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_bitmap_s1_b, CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s1_b, 0, NULL, NULL) == -1) return -1;
-      if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_bitmap_s1_c, CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s1_c, 0, NULL, NULL) == -1) return -1;
-      if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_bitmap_s1_d, CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s1_d, 0, NULL, NULL) == -1) return -1;
-      if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_bitmap_s2_a, CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s2_a, 0, NULL, NULL) == -1) return -1;
-      if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_bitmap_s2_b, CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s2_b, 0, NULL, NULL) == -1) return -1;
-      if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_bitmap_s2_c, CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s2_c, 0, NULL, NULL) == -1) return -1;
-      if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_bitmap_s2_d, CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s2_d, 0, NULL, NULL) == -1) return -1;
-      if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_digests_buf, CL_TRUE, 0, size_digests,            hashes->digests_buf,     0, NULL, NULL) == -1) return -1;
-      if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_salt_bufs,   CL_TRUE, 0, size_salts,              hashes->salts_buf,       0, NULL, NULL) == -1) return -1;
+      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_esalt_bufs, size_esalts) == -1) return -1;
 
-      /**
-       * special buffers
-       */
-
-      if (user_options->slow_candidates == true)
-      {
-        if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY, size_rules_c, NULL, &device_param->opencl_d_rules_c)   == -1) return -1;
-      }
-      else
-      {
-        if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
-        {
-          if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY, size_rules,   NULL, &device_param->opencl_d_rules)   == -1) return -1;
-          if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY, size_rules_c, NULL, &device_param->opencl_d_rules_c) == -1) return -1;
+      if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_esalt_bufs, hashes->esalts_buf, size_esalts) == -1) return -1;
+    }
 
-          if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_rules, CL_TRUE, 0, size_rules, straight_ctx->kernel_rules_buf, 0, NULL, NULL) == -1) return -1;
-        }
-        else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
-        {
-          if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY, size_combs,      NULL, &device_param->opencl_d_combs)          == -1) return -1;
-          if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY, size_combs,      NULL, &device_param->opencl_d_combs_c)        == -1) return -1;
-          if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY, size_root_css,   NULL, &device_param->opencl_d_root_css_buf)   == -1) return -1;
-          if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY, size_markov_css, NULL, &device_param->opencl_d_markov_css_buf) == -1) return -1;
-        }
-        else if (user_options_extra->attack_kern == ATTACK_KERN_BF)
-        {
-          if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY, size_bfs,        NULL, &device_param->opencl_d_bfs)            == -1) return -1;
-          if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY, size_bfs,        NULL, &device_param->opencl_d_bfs_c)          == -1) return -1;
-          if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY, size_tm,         NULL, &device_param->opencl_d_tm_c)           == -1) return -1;
-          if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY, size_root_css,   NULL, &device_param->opencl_d_root_css_buf)   == -1) return -1;
-          if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY, size_markov_css, NULL, &device_param->opencl_d_markov_css_buf) == -1) return -1;
-        }
-      }
+    if (hashconfig->st_hash != NULL)
+    {
+      if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_st_digests_buf, hashes->st_digests_buf, size_st_digests) == -1) return -1;
+      if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_st_salts_buf,   hashes->st_salts_buf,   size_st_salts)   == -1) return -1;
 
       if (size_esalts)
       {
-        if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY, size_esalts, NULL, &device_param->opencl_d_esalt_bufs) == -1) return -1;
+        if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_st_esalts_buf, size_st_esalts) == -1) return -1;
 
-        if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_esalt_bufs, CL_TRUE, 0, size_esalts, hashes->esalts_buf, 0, NULL, NULL) == -1) return -1;
-      }
-
-      if (hashconfig->st_hash != NULL)
-      {
-        if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_st_digests_buf,  CL_TRUE, 0, size_st_digests,         hashes->st_digests_buf,  0, NULL, NULL) == -1) return -1;
-        if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_st_salts_buf,    CL_TRUE, 0, size_st_salts,           hashes->st_salts_buf,    0, NULL, NULL) == -1) return -1;
-
-        if (size_esalts)
-        {
-          if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY, size_st_esalts, NULL, &device_param->opencl_d_st_esalts_buf) == -1) return -1;
-
-          if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_st_esalts_buf, CL_TRUE, 0, size_st_esalts, hashes->st_esalts_buf, 0, NULL, NULL) == -1) return -1;
-        }
+        if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_st_esalts_buf, hashes->st_esalts_buf, size_st_esalts) == -1) return -1;
       }
     }
+  }
+
+  if (device_param->is_opencl == true)
+  {
+    if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY,   bitmap_ctx->bitmap_size, NULL, &device_param->opencl_d_bitmap_s1_a)    == -1) return -1;
+    if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY,   bitmap_ctx->bitmap_size, NULL, &device_param->opencl_d_bitmap_s1_b)    == -1) return -1;
+    if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY,   bitmap_ctx->bitmap_size, NULL, &device_param->opencl_d_bitmap_s1_c)    == -1) return -1;
+    if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY,   bitmap_ctx->bitmap_size, NULL, &device_param->opencl_d_bitmap_s1_d)    == -1) return -1;
+    if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY,   bitmap_ctx->bitmap_size, NULL, &device_param->opencl_d_bitmap_s2_a)    == -1) return -1;
+    if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY,   bitmap_ctx->bitmap_size, NULL, &device_param->opencl_d_bitmap_s2_b)    == -1) return -1;
+    if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY,   bitmap_ctx->bitmap_size, NULL, &device_param->opencl_d_bitmap_s2_c)    == -1) return -1;
+    if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY,   bitmap_ctx->bitmap_size, NULL, &device_param->opencl_d_bitmap_s2_d)    == -1) return -1;
+    if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_WRITE,  size_plains,             NULL, &device_param->opencl_d_plain_bufs)     == -1) return -1;
+    if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY,   size_digests,            NULL, &device_param->opencl_d_digests_buf)    == -1) return -1;
+    if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_WRITE,  size_shown,              NULL, &device_param->opencl_d_digests_shown)  == -1) return -1;
+    if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY,   size_salts,              NULL, &device_param->opencl_d_salt_bufs)      == -1) return -1;
+    if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_WRITE,  size_results,            NULL, &device_param->opencl_d_result)         == -1) return -1;
+    if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_WRITE,  size_extra_buffer / 4,   NULL, &device_param->opencl_d_extra0_buf)     == -1) return -1;
+    if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_WRITE,  size_extra_buffer / 4,   NULL, &device_param->opencl_d_extra1_buf)     == -1) return -1;
+    if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_WRITE,  size_extra_buffer / 4,   NULL, &device_param->opencl_d_extra2_buf)     == -1) return -1;
+    if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_WRITE,  size_extra_buffer / 4,   NULL, &device_param->opencl_d_extra3_buf)     == -1) return -1;
+    if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY,   size_st_digests,         NULL, &device_param->opencl_d_st_digests_buf) == -1) return -1;
+    if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY,   size_st_salts,           NULL, &device_param->opencl_d_st_salts_buf)   == -1) return -1;
+
+    if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_bitmap_s1_a, CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s1_a, 0, NULL, NULL) == -1) return -1;
+    if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_bitmap_s1_b, CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s1_b, 0, NULL, NULL) == -1) return -1;
+    if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_bitmap_s1_c, CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s1_c, 0, NULL, NULL) == -1) return -1;
+    if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_bitmap_s1_d, CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s1_d, 0, NULL, NULL) == -1) return -1;
+    if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_bitmap_s2_a, CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s2_a, 0, NULL, NULL) == -1) return -1;
+    if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_bitmap_s2_b, CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s2_b, 0, NULL, NULL) == -1) return -1;
+    if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_bitmap_s2_c, CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s2_c, 0, NULL, NULL) == -1) return -1;
+    if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_bitmap_s2_d, CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s2_d, 0, NULL, NULL) == -1) return -1;
+    if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_digests_buf, CL_TRUE, 0, size_digests,            hashes->digests_buf,     0, NULL, NULL) == -1) return -1;
+    if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_salt_bufs,   CL_TRUE, 0, size_salts,              hashes->salts_buf,       0, NULL, NULL) == -1) return -1;
 
     /**
-     * kernel args
+     * special buffers
      */
 
-    device_param->kernel_params_buf32[24] = bitmap_ctx->bitmap_mask;
-    device_param->kernel_params_buf32[25] = bitmap_ctx->bitmap_shift1;
-    device_param->kernel_params_buf32[26] = bitmap_ctx->bitmap_shift2;
-    device_param->kernel_params_buf32[27] = 0; // salt_pos
-    device_param->kernel_params_buf32[28] = 0; // loop_pos
-    device_param->kernel_params_buf32[29] = 0; // loop_cnt
-    device_param->kernel_params_buf32[30] = 0; // kernel_rules_cnt
-    device_param->kernel_params_buf32[31] = 0; // digests_cnt
-    device_param->kernel_params_buf32[32] = 0; // digests_offset
-    device_param->kernel_params_buf32[33] = 0; // combs_mode
-    device_param->kernel_params_buf64[34] = 0; // gid_max
-
-    if (device_param->is_cuda == true)
-    {
-      device_param->kernel_params[ 0] = NULL; // &device_param->cuda_d_pws_buf;
-      device_param->kernel_params[ 1] = &device_param->cuda_d_rules_c;
-      device_param->kernel_params[ 2] = &device_param->cuda_d_combs_c;
-      device_param->kernel_params[ 3] = &device_param->cuda_d_bfs_c;
-      device_param->kernel_params[ 4] = NULL; // &device_param->cuda_d_tmps;
-      device_param->kernel_params[ 5] = NULL; // &device_param->cuda_d_hooks;
-      device_param->kernel_params[ 6] = &device_param->cuda_d_bitmap_s1_a;
-      device_param->kernel_params[ 7] = &device_param->cuda_d_bitmap_s1_b;
-      device_param->kernel_params[ 8] = &device_param->cuda_d_bitmap_s1_c;
-      device_param->kernel_params[ 9] = &device_param->cuda_d_bitmap_s1_d;
-      device_param->kernel_params[10] = &device_param->cuda_d_bitmap_s2_a;
-      device_param->kernel_params[11] = &device_param->cuda_d_bitmap_s2_b;
-      device_param->kernel_params[12] = &device_param->cuda_d_bitmap_s2_c;
-      device_param->kernel_params[13] = &device_param->cuda_d_bitmap_s2_d;
-      device_param->kernel_params[14] = &device_param->cuda_d_plain_bufs;
-      device_param->kernel_params[15] = &device_param->cuda_d_digests_buf;
-      device_param->kernel_params[16] = &device_param->cuda_d_digests_shown;
-      device_param->kernel_params[17] = &device_param->cuda_d_salt_bufs;
-      device_param->kernel_params[18] = &device_param->cuda_d_esalt_bufs;
-      device_param->kernel_params[19] = &device_param->cuda_d_result;
-      device_param->kernel_params[20] = &device_param->cuda_d_extra0_buf;
-      device_param->kernel_params[21] = &device_param->cuda_d_extra1_buf;
-      device_param->kernel_params[22] = &device_param->cuda_d_extra2_buf;
-      device_param->kernel_params[23] = &device_param->cuda_d_extra3_buf;
-    }
-
-    if (device_param->is_opencl == true)
-    {
-      device_param->kernel_params[ 0] = NULL; // &device_param->opencl_d_pws_buf;
-      device_param->kernel_params[ 1] = &device_param->opencl_d_rules_c;
-      device_param->kernel_params[ 2] = &device_param->opencl_d_combs_c;
-      device_param->kernel_params[ 3] = &device_param->opencl_d_bfs_c;
-      device_param->kernel_params[ 4] = NULL; // &device_param->opencl_d_tmps;
-      device_param->kernel_params[ 5] = NULL; // &device_param->opencl_d_hooks;
-      device_param->kernel_params[ 6] = &device_param->opencl_d_bitmap_s1_a;
-      device_param->kernel_params[ 7] = &device_param->opencl_d_bitmap_s1_b;
-      device_param->kernel_params[ 8] = &device_param->opencl_d_bitmap_s1_c;
-      device_param->kernel_params[ 9] = &device_param->opencl_d_bitmap_s1_d;
-      device_param->kernel_params[10] = &device_param->opencl_d_bitmap_s2_a;
-      device_param->kernel_params[11] = &device_param->opencl_d_bitmap_s2_b;
-      device_param->kernel_params[12] = &device_param->opencl_d_bitmap_s2_c;
-      device_param->kernel_params[13] = &device_param->opencl_d_bitmap_s2_d;
-      device_param->kernel_params[14] = &device_param->opencl_d_plain_bufs;
-      device_param->kernel_params[15] = &device_param->opencl_d_digests_buf;
-      device_param->kernel_params[16] = &device_param->opencl_d_digests_shown;
-      device_param->kernel_params[17] = &device_param->opencl_d_salt_bufs;
-      device_param->kernel_params[18] = &device_param->opencl_d_esalt_bufs;
-      device_param->kernel_params[19] = &device_param->opencl_d_result;
-      device_param->kernel_params[20] = &device_param->opencl_d_extra0_buf;
-      device_param->kernel_params[21] = &device_param->opencl_d_extra1_buf;
-      device_param->kernel_params[22] = &device_param->opencl_d_extra2_buf;
-      device_param->kernel_params[23] = &device_param->opencl_d_extra3_buf;
-    }
-
-    device_param->kernel_params[24] = &device_param->kernel_params_buf32[24];
-    device_param->kernel_params[25] = &device_param->kernel_params_buf32[25];
-    device_param->kernel_params[26] = &device_param->kernel_params_buf32[26];
-    device_param->kernel_params[27] = &device_param->kernel_params_buf32[27];
-    device_param->kernel_params[28] = &device_param->kernel_params_buf32[28];
-    device_param->kernel_params[29] = &device_param->kernel_params_buf32[29];
-    device_param->kernel_params[30] = &device_param->kernel_params_buf32[30];
-    device_param->kernel_params[31] = &device_param->kernel_params_buf32[31];
-    device_param->kernel_params[32] = &device_param->kernel_params_buf32[32];
-    device_param->kernel_params[33] = &device_param->kernel_params_buf32[33];
-    device_param->kernel_params[34] = &device_param->kernel_params_buf64[34];
-
     if (user_options->slow_candidates == true)
     {
+      if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY, size_rules_c, NULL, &device_param->opencl_d_rules_c)   == -1) return -1;
     }
     else
     {
-      device_param->kernel_params_mp_buf64[3] = 0;
-      device_param->kernel_params_mp_buf32[4] = 0;
-      device_param->kernel_params_mp_buf32[5] = 0;
-      device_param->kernel_params_mp_buf32[6] = 0;
-      device_param->kernel_params_mp_buf32[7] = 0;
-      device_param->kernel_params_mp_buf64[8] = 0;
-
-      if (hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL)
+      if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
       {
-        if (device_param->is_cuda == true)
-        {
-          device_param->kernel_params_mp[0] = &device_param->cuda_d_combs;
-        }
+        if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY, size_rules,   NULL, &device_param->opencl_d_rules)   == -1) return -1;
+        if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY, size_rules_c, NULL, &device_param->opencl_d_rules_c) == -1) return -1;
 
-        if (device_param->is_opencl == true)
-        {
-          device_param->kernel_params_mp[0] = &device_param->opencl_d_combs;
-        }
+        if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_rules, CL_TRUE, 0, size_rules, straight_ctx->kernel_rules_buf, 0, NULL, NULL) == -1) return -1;
       }
-      else
+      else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
       {
-        if (user_options->attack_mode == ATTACK_MODE_HYBRID1)
-        {
-          if (device_param->is_cuda == true)
-          {
-            device_param->kernel_params_mp[0] = &device_param->cuda_d_combs;
-          }
-
-          if (device_param->is_opencl == true)
-          {
-            device_param->kernel_params_mp[0] = &device_param->opencl_d_combs;
-          }
-        }
-        else
-        {
-          device_param->kernel_params_mp[0] = NULL; // (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-                                                    // ? &device_param->opencl_d_pws_buf
-                                                    // : &device_param->opencl_d_pws_amp_buf;
-        }
+        if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY, size_combs,      NULL, &device_param->opencl_d_combs)          == -1) return -1;
+        if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY, size_combs,      NULL, &device_param->opencl_d_combs_c)        == -1) return -1;
+        if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY, size_root_css,   NULL, &device_param->opencl_d_root_css_buf)   == -1) return -1;
+        if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY, size_markov_css, NULL, &device_param->opencl_d_markov_css_buf) == -1) return -1;
       }
-
-      if (device_param->is_cuda == true)
+      else if (user_options_extra->attack_kern == ATTACK_KERN_BF)
       {
-        device_param->kernel_params_mp[1] = &device_param->cuda_d_root_css_buf;
-        device_param->kernel_params_mp[2] = &device_param->cuda_d_markov_css_buf;
+        if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY, size_bfs,        NULL, &device_param->opencl_d_bfs)            == -1) return -1;
+        if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY, size_bfs,        NULL, &device_param->opencl_d_bfs_c)          == -1) return -1;
+        if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY, size_tm,         NULL, &device_param->opencl_d_tm_c)           == -1) return -1;
+        if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY, size_root_css,   NULL, &device_param->opencl_d_root_css_buf)   == -1) return -1;
+        if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY, size_markov_css, NULL, &device_param->opencl_d_markov_css_buf) == -1) return -1;
       }
+    }
 
-      if (device_param->is_opencl == true)
-      {
-        device_param->kernel_params_mp[1] = &device_param->opencl_d_root_css_buf;
-        device_param->kernel_params_mp[2] = &device_param->opencl_d_markov_css_buf;
-      }
+    if (size_esalts)
+    {
+      if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY, size_esalts, NULL, &device_param->opencl_d_esalt_bufs) == -1) return -1;
 
-      device_param->kernel_params_mp[3] = &device_param->kernel_params_mp_buf64[3];
-      device_param->kernel_params_mp[4] = &device_param->kernel_params_mp_buf32[4];
-      device_param->kernel_params_mp[5] = &device_param->kernel_params_mp_buf32[5];
-      device_param->kernel_params_mp[6] = &device_param->kernel_params_mp_buf32[6];
-      device_param->kernel_params_mp[7] = &device_param->kernel_params_mp_buf32[7];
-      device_param->kernel_params_mp[8] = &device_param->kernel_params_mp_buf64[8];
+      if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_esalt_bufs, CL_TRUE, 0, size_esalts, hashes->esalts_buf, 0, NULL, NULL) == -1) return -1;
+    }
 
-      device_param->kernel_params_mp_l_buf64[3] = 0;
-      device_param->kernel_params_mp_l_buf32[4] = 0;
-      device_param->kernel_params_mp_l_buf32[5] = 0;
-      device_param->kernel_params_mp_l_buf32[6] = 0;
-      device_param->kernel_params_mp_l_buf32[7] = 0;
-      device_param->kernel_params_mp_l_buf32[8] = 0;
-      device_param->kernel_params_mp_l_buf64[9] = 0;
+    if (hashconfig->st_hash != NULL)
+    {
+      if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_st_digests_buf,  CL_TRUE, 0, size_st_digests,         hashes->st_digests_buf,  0, NULL, NULL) == -1) return -1;
+      if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_st_salts_buf,    CL_TRUE, 0, size_st_salts,           hashes->st_salts_buf,    0, NULL, NULL) == -1) return -1;
 
-      device_param->kernel_params_mp_l[0] = NULL; // (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-                                                  // ? &device_param->opencl_d_pws_buf
-                                                  // : &device_param->opencl_d_pws_amp_buf;
-      if (device_param->is_cuda == true)
+      if (size_esalts)
       {
-        device_param->kernel_params_mp_l[1] = &device_param->cuda_d_root_css_buf;
-        device_param->kernel_params_mp_l[2] = &device_param->cuda_d_markov_css_buf;
-      }
+        if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY, size_st_esalts, NULL, &device_param->opencl_d_st_esalts_buf) == -1) return -1;
 
-      if (device_param->is_opencl == true)
-      {
-        device_param->kernel_params_mp_l[1] = &device_param->opencl_d_root_css_buf;
-        device_param->kernel_params_mp_l[2] = &device_param->opencl_d_markov_css_buf;
+        if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_st_esalts_buf, CL_TRUE, 0, size_st_esalts, hashes->st_esalts_buf, 0, NULL, NULL) == -1) return -1;
       }
+    }
+  }
 
-      device_param->kernel_params_mp_l[3] = &device_param->kernel_params_mp_l_buf64[3];
-      device_param->kernel_params_mp_l[4] = &device_param->kernel_params_mp_l_buf32[4];
-      device_param->kernel_params_mp_l[5] = &device_param->kernel_params_mp_l_buf32[5];
-      device_param->kernel_params_mp_l[6] = &device_param->kernel_params_mp_l_buf32[6];
-      device_param->kernel_params_mp_l[7] = &device_param->kernel_params_mp_l_buf32[7];
-      device_param->kernel_params_mp_l[8] = &device_param->kernel_params_mp_l_buf32[8];
-      device_param->kernel_params_mp_l[9] = &device_param->kernel_params_mp_l_buf64[9];
-
-      device_param->kernel_params_mp_r_buf64[3] = 0;
-      device_param->kernel_params_mp_r_buf32[4] = 0;
-      device_param->kernel_params_mp_r_buf32[5] = 0;
-      device_param->kernel_params_mp_r_buf32[6] = 0;
-      device_param->kernel_params_mp_r_buf32[7] = 0;
-      device_param->kernel_params_mp_r_buf64[8] = 0;
+  /**
+   * kernel args
+   */
 
-      if (device_param->is_cuda == true)
-      {
-        device_param->kernel_params_mp_r[0] = &device_param->cuda_d_bfs;
-        device_param->kernel_params_mp_r[1] = &device_param->cuda_d_root_css_buf;
-        device_param->kernel_params_mp_r[2] = &device_param->cuda_d_markov_css_buf;
-      }
+  device_param->kernel_params_buf32[24] = bitmap_ctx->bitmap_mask;
+  device_param->kernel_params_buf32[25] = bitmap_ctx->bitmap_shift1;
+  device_param->kernel_params_buf32[26] = bitmap_ctx->bitmap_shift2;
+  device_param->kernel_params_buf32[27] = 0; // salt_pos
+  device_param->kernel_params_buf32[28] = 0; // loop_pos
+  device_param->kernel_params_buf32[29] = 0; // loop_cnt
+  device_param->kernel_params_buf32[30] = 0; // kernel_rules_cnt
+  device_param->kernel_params_buf32[31] = 0; // digests_cnt
+  device_param->kernel_params_buf32[32] = 0; // digests_offset
+  device_param->kernel_params_buf32[33] = 0; // combs_mode
+  device_param->kernel_params_buf64[34] = 0; // gid_max
 
-      if (device_param->is_opencl == true)
-      {
-        device_param->kernel_params_mp_r[0] = &device_param->opencl_d_bfs;
-        device_param->kernel_params_mp_r[1] = &device_param->opencl_d_root_css_buf;
-        device_param->kernel_params_mp_r[2] = &device_param->opencl_d_markov_css_buf;
-      }
+  if (device_param->is_cuda == true)
+  {
+    device_param->kernel_params[ 0] = NULL; // &device_param->cuda_d_pws_buf;
+    device_param->kernel_params[ 1] = &device_param->cuda_d_rules_c;
+    device_param->kernel_params[ 2] = &device_param->cuda_d_combs_c;
+    device_param->kernel_params[ 3] = &device_param->cuda_d_bfs_c;
+    device_param->kernel_params[ 4] = NULL; // &device_param->cuda_d_tmps;
+    device_param->kernel_params[ 5] = NULL; // &device_param->cuda_d_hooks;
+    device_param->kernel_params[ 6] = &device_param->cuda_d_bitmap_s1_a;
+    device_param->kernel_params[ 7] = &device_param->cuda_d_bitmap_s1_b;
+    device_param->kernel_params[ 8] = &device_param->cuda_d_bitmap_s1_c;
+    device_param->kernel_params[ 9] = &device_param->cuda_d_bitmap_s1_d;
+    device_param->kernel_params[10] = &device_param->cuda_d_bitmap_s2_a;
+    device_param->kernel_params[11] = &device_param->cuda_d_bitmap_s2_b;
+    device_param->kernel_params[12] = &device_param->cuda_d_bitmap_s2_c;
+    device_param->kernel_params[13] = &device_param->cuda_d_bitmap_s2_d;
+    device_param->kernel_params[14] = &device_param->cuda_d_plain_bufs;
+    device_param->kernel_params[15] = &device_param->cuda_d_digests_buf;
+    device_param->kernel_params[16] = &device_param->cuda_d_digests_shown;
+    device_param->kernel_params[17] = &device_param->cuda_d_salt_bufs;
+    device_param->kernel_params[18] = &device_param->cuda_d_esalt_bufs;
+    device_param->kernel_params[19] = &device_param->cuda_d_result;
+    device_param->kernel_params[20] = &device_param->cuda_d_extra0_buf;
+    device_param->kernel_params[21] = &device_param->cuda_d_extra1_buf;
+    device_param->kernel_params[22] = &device_param->cuda_d_extra2_buf;
+    device_param->kernel_params[23] = &device_param->cuda_d_extra3_buf;
+  }
 
-      device_param->kernel_params_mp_r[3] = &device_param->kernel_params_mp_r_buf64[3];
-      device_param->kernel_params_mp_r[4] = &device_param->kernel_params_mp_r_buf32[4];
-      device_param->kernel_params_mp_r[5] = &device_param->kernel_params_mp_r_buf32[5];
-      device_param->kernel_params_mp_r[6] = &device_param->kernel_params_mp_r_buf32[6];
-      device_param->kernel_params_mp_r[7] = &device_param->kernel_params_mp_r_buf32[7];
-      device_param->kernel_params_mp_r[8] = &device_param->kernel_params_mp_r_buf64[8];
+  if (device_param->is_opencl == true)
+  {
+    device_param->kernel_params[ 0] = NULL; // &device_param->opencl_d_pws_buf;
+    device_param->kernel_params[ 1] = &device_param->opencl_d_rules_c;
+    device_param->kernel_params[ 2] = &device_param->opencl_d_combs_c;
+    device_param->kernel_params[ 3] = &device_param->opencl_d_bfs_c;
+    device_param->kernel_params[ 4] = NULL; // &device_param->opencl_d_tmps;
+    device_param->kernel_params[ 5] = NULL; // &device_param->opencl_d_hooks;
+    device_param->kernel_params[ 6] = &device_param->opencl_d_bitmap_s1_a;
+    device_param->kernel_params[ 7] = &device_param->opencl_d_bitmap_s1_b;
+    device_param->kernel_params[ 8] = &device_param->opencl_d_bitmap_s1_c;
+    device_param->kernel_params[ 9] = &device_param->opencl_d_bitmap_s1_d;
+    device_param->kernel_params[10] = &device_param->opencl_d_bitmap_s2_a;
+    device_param->kernel_params[11] = &device_param->opencl_d_bitmap_s2_b;
+    device_param->kernel_params[12] = &device_param->opencl_d_bitmap_s2_c;
+    device_param->kernel_params[13] = &device_param->opencl_d_bitmap_s2_d;
+    device_param->kernel_params[14] = &device_param->opencl_d_plain_bufs;
+    device_param->kernel_params[15] = &device_param->opencl_d_digests_buf;
+    device_param->kernel_params[16] = &device_param->opencl_d_digests_shown;
+    device_param->kernel_params[17] = &device_param->opencl_d_salt_bufs;
+    device_param->kernel_params[18] = &device_param->opencl_d_esalt_bufs;
+    device_param->kernel_params[19] = &device_param->opencl_d_result;
+    device_param->kernel_params[20] = &device_param->opencl_d_extra0_buf;
+    device_param->kernel_params[21] = &device_param->opencl_d_extra1_buf;
+    device_param->kernel_params[22] = &device_param->opencl_d_extra2_buf;
+    device_param->kernel_params[23] = &device_param->opencl_d_extra3_buf;
+  }
+
+  device_param->kernel_params[24] = &device_param->kernel_params_buf32[24];
+  device_param->kernel_params[25] = &device_param->kernel_params_buf32[25];
+  device_param->kernel_params[26] = &device_param->kernel_params_buf32[26];
+  device_param->kernel_params[27] = &device_param->kernel_params_buf32[27];
+  device_param->kernel_params[28] = &device_param->kernel_params_buf32[28];
+  device_param->kernel_params[29] = &device_param->kernel_params_buf32[29];
+  device_param->kernel_params[30] = &device_param->kernel_params_buf32[30];
+  device_param->kernel_params[31] = &device_param->kernel_params_buf32[31];
+  device_param->kernel_params[32] = &device_param->kernel_params_buf32[32];
+  device_param->kernel_params[33] = &device_param->kernel_params_buf32[33];
+  device_param->kernel_params[34] = &device_param->kernel_params_buf64[34];
 
-      device_param->kernel_params_amp_buf32[5] = 0; // combs_mode
-      device_param->kernel_params_amp_buf64[6] = 0; // gid_max
+  if (user_options->slow_candidates == true)
+  {
+  }
+  else
+  {
+    device_param->kernel_params_mp_buf64[3] = 0;
+    device_param->kernel_params_mp_buf32[4] = 0;
+    device_param->kernel_params_mp_buf32[5] = 0;
+    device_param->kernel_params_mp_buf32[6] = 0;
+    device_param->kernel_params_mp_buf32[7] = 0;
+    device_param->kernel_params_mp_buf64[8] = 0;
 
+    if (hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL)
+    {
       if (device_param->is_cuda == true)
       {
-        device_param->kernel_params_amp[0] = NULL; // &device_param->cuda_d_pws_buf;
-        device_param->kernel_params_amp[1] = NULL; // &device_param->cuda_d_pws_amp_buf;
-        device_param->kernel_params_amp[2] = &device_param->cuda_d_rules_c;
-        device_param->kernel_params_amp[3] = &device_param->cuda_d_combs_c;
-        device_param->kernel_params_amp[4] = &device_param->cuda_d_bfs_c;
+        device_param->kernel_params_mp[0] = &device_param->cuda_d_combs;
       }
 
       if (device_param->is_opencl == true)
       {
-        device_param->kernel_params_amp[0] = NULL; // &device_param->opencl_d_pws_buf;
-        device_param->kernel_params_amp[1] = NULL; // &device_param->opencl_d_pws_amp_buf;
-        device_param->kernel_params_amp[2] = &device_param->opencl_d_rules_c;
-        device_param->kernel_params_amp[3] = &device_param->opencl_d_combs_c;
-        device_param->kernel_params_amp[4] = &device_param->opencl_d_bfs_c;
+        device_param->kernel_params_mp[0] = &device_param->opencl_d_combs;
       }
-
-      device_param->kernel_params_amp[5] = &device_param->kernel_params_amp_buf32[5];
-      device_param->kernel_params_amp[6] = &device_param->kernel_params_amp_buf64[6];
-
-      if (device_param->is_cuda == true)
+    }
+    else
+    {
+      if (user_options->attack_mode == ATTACK_MODE_HYBRID1)
       {
-        device_param->kernel_params_tm[0] = &device_param->cuda_d_bfs_c;
-        device_param->kernel_params_tm[1] = &device_param->cuda_d_tm_c;
-      }
+        if (device_param->is_cuda == true)
+        {
+          device_param->kernel_params_mp[0] = &device_param->cuda_d_combs;
+        }
 
-      if (device_param->is_opencl == true)
+        if (device_param->is_opencl == true)
+        {
+          device_param->kernel_params_mp[0] = &device_param->opencl_d_combs;
+        }
+      }
+      else
       {
-        device_param->kernel_params_tm[0] = &device_param->opencl_d_bfs_c;
-        device_param->kernel_params_tm[1] = &device_param->opencl_d_tm_c;
+        device_param->kernel_params_mp[0] = NULL; // (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+                                                  // ? &device_param->opencl_d_pws_buf
+                                                  // : &device_param->opencl_d_pws_amp_buf;
       }
     }
 
-    device_param->kernel_params_memset_buf32[1] = 0; // value
-    device_param->kernel_params_memset_buf64[2] = 0; // gid_max
+    if (device_param->is_cuda == true)
+    {
+      device_param->kernel_params_mp[1] = &device_param->cuda_d_root_css_buf;
+      device_param->kernel_params_mp[2] = &device_param->cuda_d_markov_css_buf;
+    }
+
+    if (device_param->is_opencl == true)
+    {
+      device_param->kernel_params_mp[1] = &device_param->opencl_d_root_css_buf;
+      device_param->kernel_params_mp[2] = &device_param->opencl_d_markov_css_buf;
+    }
+
+    device_param->kernel_params_mp[3] = &device_param->kernel_params_mp_buf64[3];
+    device_param->kernel_params_mp[4] = &device_param->kernel_params_mp_buf32[4];
+    device_param->kernel_params_mp[5] = &device_param->kernel_params_mp_buf32[5];
+    device_param->kernel_params_mp[6] = &device_param->kernel_params_mp_buf32[6];
+    device_param->kernel_params_mp[7] = &device_param->kernel_params_mp_buf32[7];
+    device_param->kernel_params_mp[8] = &device_param->kernel_params_mp_buf64[8];
 
-    device_param->kernel_params_memset[0] = NULL;
-    device_param->kernel_params_memset[1] = &device_param->kernel_params_memset_buf32[1];
-    device_param->kernel_params_memset[2] = &device_param->kernel_params_memset_buf64[2];
+    device_param->kernel_params_mp_l_buf64[3] = 0;
+    device_param->kernel_params_mp_l_buf32[4] = 0;
+    device_param->kernel_params_mp_l_buf32[5] = 0;
+    device_param->kernel_params_mp_l_buf32[6] = 0;
+    device_param->kernel_params_mp_l_buf32[7] = 0;
+    device_param->kernel_params_mp_l_buf32[8] = 0;
+    device_param->kernel_params_mp_l_buf64[9] = 0;
+
+    device_param->kernel_params_mp_l[0] = NULL; // (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+                                                // ? &device_param->opencl_d_pws_buf
+                                                // : &device_param->opencl_d_pws_amp_buf;
+    if (device_param->is_cuda == true)
+    {
+      device_param->kernel_params_mp_l[1] = &device_param->cuda_d_root_css_buf;
+      device_param->kernel_params_mp_l[2] = &device_param->cuda_d_markov_css_buf;
+    }
 
-    device_param->kernel_params_atinit_buf64[1] = 0; // gid_max
+    if (device_param->is_opencl == true)
+    {
+      device_param->kernel_params_mp_l[1] = &device_param->opencl_d_root_css_buf;
+      device_param->kernel_params_mp_l[2] = &device_param->opencl_d_markov_css_buf;
+    }
 
-    device_param->kernel_params_atinit[0] = NULL;
-    device_param->kernel_params_atinit[1] = &device_param->kernel_params_atinit_buf64[1];
+    device_param->kernel_params_mp_l[3] = &device_param->kernel_params_mp_l_buf64[3];
+    device_param->kernel_params_mp_l[4] = &device_param->kernel_params_mp_l_buf32[4];
+    device_param->kernel_params_mp_l[5] = &device_param->kernel_params_mp_l_buf32[5];
+    device_param->kernel_params_mp_l[6] = &device_param->kernel_params_mp_l_buf32[6];
+    device_param->kernel_params_mp_l[7] = &device_param->kernel_params_mp_l_buf32[7];
+    device_param->kernel_params_mp_l[8] = &device_param->kernel_params_mp_l_buf32[8];
+    device_param->kernel_params_mp_l[9] = &device_param->kernel_params_mp_l_buf64[9];
 
-    device_param->kernel_params_decompress_buf64[3] = 0; // gid_max
+    device_param->kernel_params_mp_r_buf64[3] = 0;
+    device_param->kernel_params_mp_r_buf32[4] = 0;
+    device_param->kernel_params_mp_r_buf32[5] = 0;
+    device_param->kernel_params_mp_r_buf32[6] = 0;
+    device_param->kernel_params_mp_r_buf32[7] = 0;
+    device_param->kernel_params_mp_r_buf64[8] = 0;
 
     if (device_param->is_cuda == true)
     {
-      device_param->kernel_params_decompress[0] = NULL; // &device_param->cuda_d_pws_idx;
-      device_param->kernel_params_decompress[1] = NULL; // &device_param->cuda_d_pws_comp_buf;
-      device_param->kernel_params_decompress[2] = NULL; // (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-                                                        // ? &device_param->cuda_d_pws_buf
-                                                        // : &device_param->cuda_d_pws_amp_buf;
+      device_param->kernel_params_mp_r[0] = &device_param->cuda_d_bfs;
+      device_param->kernel_params_mp_r[1] = &device_param->cuda_d_root_css_buf;
+      device_param->kernel_params_mp_r[2] = &device_param->cuda_d_markov_css_buf;
     }
 
     if (device_param->is_opencl == true)
     {
-      device_param->kernel_params_decompress[0] = NULL; // &device_param->opencl_d_pws_idx;
-      device_param->kernel_params_decompress[1] = NULL; // &device_param->opencl_d_pws_comp_buf;
-      device_param->kernel_params_decompress[2] = NULL; // (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-                                                        // ? &device_param->opencl_d_pws_buf
-                                                        // : &device_param->opencl_d_pws_amp_buf;
+      device_param->kernel_params_mp_r[0] = &device_param->opencl_d_bfs;
+      device_param->kernel_params_mp_r[1] = &device_param->opencl_d_root_css_buf;
+      device_param->kernel_params_mp_r[2] = &device_param->opencl_d_markov_css_buf;
     }
 
-    device_param->kernel_params_decompress[3] = &device_param->kernel_params_decompress_buf64[3];
+    device_param->kernel_params_mp_r[3] = &device_param->kernel_params_mp_r_buf64[3];
+    device_param->kernel_params_mp_r[4] = &device_param->kernel_params_mp_r_buf32[4];
+    device_param->kernel_params_mp_r[5] = &device_param->kernel_params_mp_r_buf32[5];
+    device_param->kernel_params_mp_r[6] = &device_param->kernel_params_mp_r_buf32[6];
+    device_param->kernel_params_mp_r[7] = &device_param->kernel_params_mp_r_buf32[7];
+    device_param->kernel_params_mp_r[8] = &device_param->kernel_params_mp_r_buf64[8];
 
-    /**
-     * kernel name
-     */
+    device_param->kernel_params_amp_buf32[5] = 0; // combs_mode
+    device_param->kernel_params_amp_buf64[6] = 0; // gid_max
 
     if (device_param->is_cuda == true)
     {
-      char kernel_name[64] = { 0 };
+      device_param->kernel_params_amp[0] = NULL; // &device_param->cuda_d_pws_buf;
+      device_param->kernel_params_amp[1] = NULL; // &device_param->cuda_d_pws_amp_buf;
+      device_param->kernel_params_amp[2] = &device_param->cuda_d_rules_c;
+      device_param->kernel_params_amp[3] = &device_param->cuda_d_combs_c;
+      device_param->kernel_params_amp[4] = &device_param->cuda_d_bfs_c;
+    }
 
-      if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-      {
-        if (hashconfig->opti_type & OPTI_TYPE_SINGLE_HASH)
-        {
-          if (hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL)
-          {
-            // kernel1
+    if (device_param->is_opencl == true)
+    {
+      device_param->kernel_params_amp[0] = NULL; // &device_param->opencl_d_pws_buf;
+      device_param->kernel_params_amp[1] = NULL; // &device_param->opencl_d_pws_amp_buf;
+      device_param->kernel_params_amp[2] = &device_param->opencl_d_rules_c;
+      device_param->kernel_params_amp[3] = &device_param->opencl_d_combs_c;
+      device_param->kernel_params_amp[4] = &device_param->opencl_d_bfs_c;
+    }
+
+    device_param->kernel_params_amp[5] = &device_param->kernel_params_amp_buf32[5];
+    device_param->kernel_params_amp[6] = &device_param->kernel_params_amp_buf64[6];
+
+    if (device_param->is_cuda == true)
+    {
+      device_param->kernel_params_tm[0] = &device_param->cuda_d_bfs_c;
+      device_param->kernel_params_tm[1] = &device_param->cuda_d_tm_c;
+    }
+
+    if (device_param->is_opencl == true)
+    {
+      device_param->kernel_params_tm[0] = &device_param->opencl_d_bfs_c;
+      device_param->kernel_params_tm[1] = &device_param->opencl_d_tm_c;
+    }
+  }
+
+  device_param->kernel_params_memset_buf32[1] = 0; // value
+  device_param->kernel_params_memset_buf64[2] = 0; // gid_max
+
+  device_param->kernel_params_memset[0] = NULL;
+  device_param->kernel_params_memset[1] = &device_param->kernel_params_memset_buf32[1];
+  device_param->kernel_params_memset[2] = &device_param->kernel_params_memset_buf64[2];
+
+  device_param->kernel_params_atinit_buf64[1] = 0; // gid_max
+
+  device_param->kernel_params_atinit[0] = NULL;
+  device_param->kernel_params_atinit[1] = &device_param->kernel_params_atinit_buf64[1];
 
-            snprintf (kernel_name, sizeof (kernel_name), "m%05u_s%02d", kern_type, 4);
+  device_param->kernel_params_decompress_buf64[3] = 0; // gid_max
 
-            if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function1, device_param->cuda_module, kernel_name) == -1) return -1;
+  if (device_param->is_cuda == true)
+  {
+    device_param->kernel_params_decompress[0] = NULL; // &device_param->cuda_d_pws_idx;
+    device_param->kernel_params_decompress[1] = NULL; // &device_param->cuda_d_pws_comp_buf;
+    device_param->kernel_params_decompress[2] = NULL; // (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+                                                      // ? &device_param->cuda_d_pws_buf
+                                                      // : &device_param->cuda_d_pws_amp_buf;
+  }
 
-            if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function1, &device_param->kernel_wgs1) == -1) return -1;
+  if (device_param->is_opencl == true)
+  {
+    device_param->kernel_params_decompress[0] = NULL; // &device_param->opencl_d_pws_idx;
+    device_param->kernel_params_decompress[1] = NULL; // &device_param->opencl_d_pws_comp_buf;
+    device_param->kernel_params_decompress[2] = NULL; // (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+                                                      // ? &device_param->opencl_d_pws_buf
+                                                      // : &device_param->opencl_d_pws_amp_buf;
+  }
 
-            if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function1, &device_param->kernel_local_mem_size1) == -1) return -1;
+  device_param->kernel_params_decompress[3] = &device_param->kernel_params_decompress_buf64[3];
 
-            if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function1, &device_param->kernel_dynamic_local_mem_size1) == -1) return -1;
+  /**
+   * kernel name
+   */
 
-            device_param->kernel_preferred_wgs_multiple1 = device_param->cuda_warp_size;
+  if (device_param->is_cuda == true)
+  {
+    char kernel_name[64] = { 0 };
 
-            // kernel2
+    if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+    {
+      if (hashconfig->opti_type & OPTI_TYPE_SINGLE_HASH)
+      {
+        if (hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL)
+        {
+          // kernel1
 
-            snprintf (kernel_name, sizeof (kernel_name), "m%05u_s%02d", kern_type, 8);
+          snprintf (kernel_name, sizeof (kernel_name), "m%05u_s%02d", kern_type, 4);
 
-            if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function2, device_param->cuda_module, kernel_name) == -1) return -1;
+          if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function1, device_param->cuda_module, kernel_name) == -1) return -1;
 
-            if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function2, &device_param->kernel_wgs2) == -1) return -1;
+          if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function1, &device_param->kernel_wgs1) == -1) return -1;
 
-            if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function2, &device_param->kernel_local_mem_size2) == -1) return -1;
+          if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function1, &device_param->kernel_local_mem_size1) == -1) return -1;
 
-            if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function2, &device_param->kernel_dynamic_local_mem_size2) == -1) return -1;
+          if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function1, &device_param->kernel_dynamic_local_mem_size1) == -1) return -1;
 
-            device_param->kernel_preferred_wgs_multiple2 = device_param->cuda_warp_size;
+          device_param->kernel_preferred_wgs_multiple1 = device_param->cuda_warp_size;
 
-            // kernel3
+          // kernel2
 
-            snprintf (kernel_name, sizeof (kernel_name), "m%05u_s%02d", kern_type, 16);
+          snprintf (kernel_name, sizeof (kernel_name), "m%05u_s%02d", kern_type, 8);
 
-            if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function3, device_param->cuda_module, kernel_name) == -1) return -1;
+          if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function2, device_param->cuda_module, kernel_name) == -1) return -1;
 
-            if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function3, &device_param->kernel_wgs3) == -1) return -1;
+          if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function2, &device_param->kernel_wgs2) == -1) return -1;
 
-            if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function3, &device_param->kernel_local_mem_size3) == -1) return -1;
+          if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function2, &device_param->kernel_local_mem_size2) == -1) return -1;
 
-            if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function3, &device_param->kernel_dynamic_local_mem_size3) == -1) return -1;
+          if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function2, &device_param->kernel_dynamic_local_mem_size2) == -1) return -1;
 
-            device_param->kernel_preferred_wgs_multiple3 = device_param->cuda_warp_size;
-          }
-          else
-          {
-            snprintf (kernel_name, sizeof (kernel_name), "m%05u_sxx", kern_type);
+          device_param->kernel_preferred_wgs_multiple2 = device_param->cuda_warp_size;
 
-            if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function4, device_param->cuda_module, kernel_name) == -1) return -1;
+          // kernel3
 
-            if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function4, &device_param->kernel_wgs4) == -1) return -1;
+          snprintf (kernel_name, sizeof (kernel_name), "m%05u_s%02d", kern_type, 16);
 
-            if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function4, &device_param->kernel_local_mem_size4) == -1) return -1;
+          if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function3, device_param->cuda_module, kernel_name) == -1) return -1;
 
-            if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function4, &device_param->kernel_dynamic_local_mem_size4) == -1) return -1;
+          if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function3, &device_param->kernel_wgs3) == -1) return -1;
 
-            device_param->kernel_preferred_wgs_multiple4 = device_param->cuda_warp_size;
-          }
+          if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function3, &device_param->kernel_local_mem_size3) == -1) return -1;
+
+          if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function3, &device_param->kernel_dynamic_local_mem_size3) == -1) return -1;
+
+          device_param->kernel_preferred_wgs_multiple3 = device_param->cuda_warp_size;
         }
         else
         {
-          if (hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL)
-          {
-            // kernel1
+          snprintf (kernel_name, sizeof (kernel_name), "m%05u_sxx", kern_type);
 
-            snprintf (kernel_name, sizeof (kernel_name), "m%05u_m%02d", kern_type, 4);
+          if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function4, device_param->cuda_module, kernel_name) == -1) return -1;
 
-            if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function1, device_param->cuda_module, kernel_name) == -1) return -1;
+          if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function4, &device_param->kernel_wgs4) == -1) return -1;
 
-            if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function1, &device_param->kernel_wgs1) == -1) return -1;
+          if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function4, &device_param->kernel_local_mem_size4) == -1) return -1;
 
-            if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function1, &device_param->kernel_local_mem_size1) == -1) return -1;
+          if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function4, &device_param->kernel_dynamic_local_mem_size4) == -1) return -1;
 
-            if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function1, &device_param->kernel_dynamic_local_mem_size1) == -1) return -1;
+          device_param->kernel_preferred_wgs_multiple4 = device_param->cuda_warp_size;
+        }
+      }
+      else
+      {
+        if (hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL)
+        {
+          // kernel1
 
-            device_param->kernel_preferred_wgs_multiple1 = device_param->cuda_warp_size;
+          snprintf (kernel_name, sizeof (kernel_name), "m%05u_m%02d", kern_type, 4);
 
-            // kernel2
+          if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function1, device_param->cuda_module, kernel_name) == -1) return -1;
 
-            snprintf (kernel_name, sizeof (kernel_name), "m%05u_m%02d", kern_type, 8);
+          if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function1, &device_param->kernel_wgs1) == -1) return -1;
 
-            if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function2, device_param->cuda_module, kernel_name) == -1) return -1;
+          if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function1, &device_param->kernel_local_mem_size1) == -1) return -1;
 
-            if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function2, &device_param->kernel_wgs2) == -1) return -1;
+          if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function1, &device_param->kernel_dynamic_local_mem_size1) == -1) return -1;
 
-            if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function2, &device_param->kernel_local_mem_size2) == -1) return -1;
+          device_param->kernel_preferred_wgs_multiple1 = device_param->cuda_warp_size;
 
-            if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function2, &device_param->kernel_dynamic_local_mem_size2) == -1) return -1;
+          // kernel2
 
-            device_param->kernel_preferred_wgs_multiple2 = device_param->cuda_warp_size;
+          snprintf (kernel_name, sizeof (kernel_name), "m%05u_m%02d", kern_type, 8);
 
-            // kernel3
+          if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function2, device_param->cuda_module, kernel_name) == -1) return -1;
 
-            snprintf (kernel_name, sizeof (kernel_name), "m%05u_m%02d", kern_type, 16);
+          if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function2, &device_param->kernel_wgs2) == -1) return -1;
 
-            if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function3, device_param->cuda_module, kernel_name) == -1) return -1;
+          if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function2, &device_param->kernel_local_mem_size2) == -1) return -1;
 
-            if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function3, &device_param->kernel_wgs3) == -1) return -1;
+          if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function2, &device_param->kernel_dynamic_local_mem_size2) == -1) return -1;
 
-            if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function3, &device_param->kernel_local_mem_size3) == -1) return -1;
+          device_param->kernel_preferred_wgs_multiple2 = device_param->cuda_warp_size;
 
-            if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function3, &device_param->kernel_dynamic_local_mem_size3) == -1) return -1;
+          // kernel3
 
-            device_param->kernel_preferred_wgs_multiple3 = device_param->cuda_warp_size;
-          }
-          else
-          {
-            snprintf (kernel_name, sizeof (kernel_name), "m%05u_mxx", kern_type);
+          snprintf (kernel_name, sizeof (kernel_name), "m%05u_m%02d", kern_type, 16);
 
-            if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function4, device_param->cuda_module, kernel_name) == -1) return -1;
+          if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function3, device_param->cuda_module, kernel_name) == -1) return -1;
 
-            if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function4, &device_param->kernel_wgs4) == -1) return -1;
+          if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function3, &device_param->kernel_wgs3) == -1) return -1;
 
-            if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function4, &device_param->kernel_local_mem_size4) == -1) return -1;
+          if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function3, &device_param->kernel_local_mem_size3) == -1) return -1;
 
-            if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function4, &device_param->kernel_dynamic_local_mem_size4) == -1) return -1;
+          if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function3, &device_param->kernel_dynamic_local_mem_size3) == -1) return -1;
 
-            device_param->kernel_preferred_wgs_multiple4 = device_param->cuda_warp_size;
-          }
+          device_param->kernel_preferred_wgs_multiple3 = device_param->cuda_warp_size;
         }
-
-        if (user_options->slow_candidates == true)
+        else
         {
+          snprintf (kernel_name, sizeof (kernel_name), "m%05u_mxx", kern_type);
+
+          if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function4, device_param->cuda_module, kernel_name) == -1) return -1;
+
+          if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function4, &device_param->kernel_wgs4) == -1) return -1;
+
+          if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function4, &device_param->kernel_local_mem_size4) == -1) return -1;
+
+          if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function4, &device_param->kernel_dynamic_local_mem_size4) == -1) return -1;
+
+          device_param->kernel_preferred_wgs_multiple4 = device_param->cuda_warp_size;
         }
-        else
+      }
+
+      if (user_options->slow_candidates == true)
+      {
+      }
+      else
+      {
+        if (user_options->attack_mode == ATTACK_MODE_BF)
         {
-          if (user_options->attack_mode == ATTACK_MODE_BF)
+          if (hashconfig->opts_type & OPTS_TYPE_TM_KERNEL)
           {
-            if (hashconfig->opts_type & OPTS_TYPE_TM_KERNEL)
-            {
-              snprintf (kernel_name, sizeof (kernel_name), "m%05u_tm", kern_type);
+            snprintf (kernel_name, sizeof (kernel_name), "m%05u_tm", kern_type);
 
-              if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_tm, device_param->cuda_module, kernel_name) == -1) return -1;
+            if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_tm, device_param->cuda_module, kernel_name) == -1) return -1;
 
-              if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_tm, &device_param->kernel_wgs_tm) == -1) return -1;
+            if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_tm, &device_param->kernel_wgs_tm) == -1) return -1;
 
-              if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_tm, &device_param->kernel_local_mem_size_tm) == -1) return -1;
+            if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_tm, &device_param->kernel_local_mem_size_tm) == -1) return -1;
 
-              if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function_tm, &device_param->kernel_dynamic_local_mem_size_tm) == -1) return -1;
+            if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function_tm, &device_param->kernel_dynamic_local_mem_size_tm) == -1) return -1;
 
-              device_param->kernel_preferred_wgs_multiple_tm = device_param->cuda_warp_size;
-            }
+            device_param->kernel_preferred_wgs_multiple_tm = device_param->cuda_warp_size;
           }
         }
       }
-      else
-      {
-        // kernel1
+    }
+    else
+    {
+      // kernel1
 
-        snprintf (kernel_name, sizeof (kernel_name), "m%05u_init", kern_type);
+      snprintf (kernel_name, sizeof (kernel_name), "m%05u_init", kern_type);
 
-        if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function1, device_param->cuda_module, kernel_name) == -1) return -1;
+      if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function1, device_param->cuda_module, kernel_name) == -1) return -1;
 
-        if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function1, &device_param->kernel_wgs1) == -1) return -1;
+      if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function1, &device_param->kernel_wgs1) == -1) return -1;
 
-        if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function1, &device_param->kernel_local_mem_size1) == -1) return -1;
+      if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function1, &device_param->kernel_local_mem_size1) == -1) return -1;
 
-        if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function1, &device_param->kernel_dynamic_local_mem_size1) == -1) return -1;
+      if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function1, &device_param->kernel_dynamic_local_mem_size1) == -1) return -1;
 
-        device_param->kernel_preferred_wgs_multiple1 = device_param->cuda_warp_size;
+      device_param->kernel_preferred_wgs_multiple1 = device_param->cuda_warp_size;
 
-        // kernel2
+      // kernel2
 
-        snprintf (kernel_name, sizeof (kernel_name), "m%05u_loop", kern_type);
+      snprintf (kernel_name, sizeof (kernel_name), "m%05u_loop", kern_type);
 
-        if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function2, device_param->cuda_module, kernel_name) == -1) return -1;
+      if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function2, device_param->cuda_module, kernel_name) == -1) return -1;
 
-        if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function2, &device_param->kernel_wgs2) == -1) return -1;
+      if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function2, &device_param->kernel_wgs2) == -1) return -1;
 
-        if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function2, &device_param->kernel_local_mem_size2) == -1) return -1;
+      if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function2, &device_param->kernel_local_mem_size2) == -1) return -1;
 
-        if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function2, &device_param->kernel_dynamic_local_mem_size2) == -1) return -1;
+      if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function2, &device_param->kernel_dynamic_local_mem_size2) == -1) return -1;
 
-        device_param->kernel_preferred_wgs_multiple2 = device_param->cuda_warp_size;
+      device_param->kernel_preferred_wgs_multiple2 = device_param->cuda_warp_size;
 
-        // kernel3
+      // kernel3
 
-        snprintf (kernel_name, sizeof (kernel_name), "m%05u_comp", kern_type);
+      snprintf (kernel_name, sizeof (kernel_name), "m%05u_comp", kern_type);
 
-        if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function3, device_param->cuda_module, kernel_name) == -1) return -1;
+      if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function3, device_param->cuda_module, kernel_name) == -1) return -1;
 
-        if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function3, &device_param->kernel_wgs3) == -1) return -1;
+      if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function3, &device_param->kernel_wgs3) == -1) return -1;
 
-        if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function3, &device_param->kernel_local_mem_size3) == -1) return -1;
+      if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function3, &device_param->kernel_local_mem_size3) == -1) return -1;
 
-        if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function3, &device_param->kernel_dynamic_local_mem_size3) == -1) return -1;
+      if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function3, &device_param->kernel_dynamic_local_mem_size3) == -1) return -1;
 
-        device_param->kernel_preferred_wgs_multiple3 = device_param->cuda_warp_size;
+      device_param->kernel_preferred_wgs_multiple3 = device_param->cuda_warp_size;
 
-        if (hashconfig->opts_type & OPTS_TYPE_LOOP_EXTENDED)
-        {
-          // kernel2e
+      if (hashconfig->opts_type & OPTS_TYPE_LOOP_EXTENDED)
+      {
+        // kernel2e
 
-          snprintf (kernel_name, sizeof (kernel_name), "m%05u_loop_extended", kern_type);
+        snprintf (kernel_name, sizeof (kernel_name), "m%05u_loop_extended", kern_type);
 
-          if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function2e, device_param->cuda_module, kernel_name) == -1) return -1;
+        if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function2e, device_param->cuda_module, kernel_name) == -1) return -1;
 
-          if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function2e, &device_param->kernel_wgs2e) == -1) return -1;
+        if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function2e, &device_param->kernel_wgs2e) == -1) return -1;
 
-          if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function2e, &device_param->kernel_local_mem_size2e) == -1) return -1;
+        if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function2e, &device_param->kernel_local_mem_size2e) == -1) return -1;
 
-          if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function2e, &device_param->kernel_dynamic_local_mem_size2e) == -1) return -1;
+        if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function2e, &device_param->kernel_dynamic_local_mem_size2e) == -1) return -1;
 
-          device_param->kernel_preferred_wgs_multiple2e = device_param->cuda_warp_size;
-        }
+        device_param->kernel_preferred_wgs_multiple2e = device_param->cuda_warp_size;
+      }
 
-        // kernel12
+      // kernel12
 
-        if (hashconfig->opts_type & OPTS_TYPE_HOOK12)
-        {
-          snprintf (kernel_name, sizeof (kernel_name), "m%05u_hook12", kern_type);
+      if (hashconfig->opts_type & OPTS_TYPE_HOOK12)
+      {
+        snprintf (kernel_name, sizeof (kernel_name), "m%05u_hook12", kern_type);
 
-          if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function12, device_param->cuda_module, kernel_name) == -1) return -1;
+        if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function12, device_param->cuda_module, kernel_name) == -1) return -1;
 
-          if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function12, &device_param->kernel_wgs12) == -1) return -1;
+        if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function12, &device_param->kernel_wgs12) == -1) return -1;
 
-          if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function12, &device_param->kernel_local_mem_size12) == -1) return -1;
+        if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function12, &device_param->kernel_local_mem_size12) == -1) return -1;
 
-          if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function12, &device_param->kernel_dynamic_local_mem_size12) == -1) return -1;
+        if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function12, &device_param->kernel_dynamic_local_mem_size12) == -1) return -1;
 
-          device_param->kernel_preferred_wgs_multiple12 = device_param->cuda_warp_size;
-        }
+        device_param->kernel_preferred_wgs_multiple12 = device_param->cuda_warp_size;
+      }
 
-        // kernel23
+      // kernel23
 
-        if (hashconfig->opts_type & OPTS_TYPE_HOOK23)
-        {
-          snprintf (kernel_name, sizeof (kernel_name), "m%05u_hook23", kern_type);
+      if (hashconfig->opts_type & OPTS_TYPE_HOOK23)
+      {
+        snprintf (kernel_name, sizeof (kernel_name), "m%05u_hook23", kern_type);
 
-          if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function23, device_param->cuda_module, kernel_name) == -1) return -1;
+        if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function23, device_param->cuda_module, kernel_name) == -1) return -1;
 
-          if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function23, &device_param->kernel_wgs23) == -1) return -1;
+        if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function23, &device_param->kernel_wgs23) == -1) return -1;
 
-          if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function23, &device_param->kernel_local_mem_size23) == -1) return -1;
+        if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function23, &device_param->kernel_local_mem_size23) == -1) return -1;
 
-          if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function23, &device_param->kernel_dynamic_local_mem_size23) == -1) return -1;
+        if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function23, &device_param->kernel_dynamic_local_mem_size23) == -1) return -1;
 
-          device_param->kernel_preferred_wgs_multiple23 = device_param->cuda_warp_size;
-        }
+        device_param->kernel_preferred_wgs_multiple23 = device_param->cuda_warp_size;
+      }
 
-        // init2
+      // init2
 
-        if (hashconfig->opts_type & OPTS_TYPE_INIT2)
-        {
-          snprintf (kernel_name, sizeof (kernel_name), "m%05u_init2", kern_type);
+      if (hashconfig->opts_type & OPTS_TYPE_INIT2)
+      {
+        snprintf (kernel_name, sizeof (kernel_name), "m%05u_init2", kern_type);
 
-          if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_init2, device_param->cuda_module, kernel_name) == -1) return -1;
+        if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_init2, device_param->cuda_module, kernel_name) == -1) return -1;
 
-          if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_init2, &device_param->kernel_wgs_init2) == -1) return -1;
+        if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_init2, &device_param->kernel_wgs_init2) == -1) return -1;
 
-          if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_init2, &device_param->kernel_local_mem_size_init2) == -1) return -1;
+        if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_init2, &device_param->kernel_local_mem_size_init2) == -1) return -1;
 
-          if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function_init2, &device_param->kernel_dynamic_local_mem_size_init2) == -1) return -1;
+        if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function_init2, &device_param->kernel_dynamic_local_mem_size_init2) == -1) return -1;
 
-          device_param->kernel_preferred_wgs_multiple_init2 = device_param->cuda_warp_size;
-        }
+        device_param->kernel_preferred_wgs_multiple_init2 = device_param->cuda_warp_size;
+      }
 
-        // loop2
+      // loop2
 
-        if (hashconfig->opts_type & OPTS_TYPE_LOOP2)
-        {
-          snprintf (kernel_name, sizeof (kernel_name), "m%05u_loop2", kern_type);
+      if (hashconfig->opts_type & OPTS_TYPE_LOOP2)
+      {
+        snprintf (kernel_name, sizeof (kernel_name), "m%05u_loop2", kern_type);
 
-          if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_loop2, device_param->cuda_module, kernel_name) == -1) return -1;
+        if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_loop2, device_param->cuda_module, kernel_name) == -1) return -1;
 
-          if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_loop2, &device_param->kernel_wgs_loop2) == -1) return -1;
+        if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_loop2, &device_param->kernel_wgs_loop2) == -1) return -1;
 
-          if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_loop2, &device_param->kernel_local_mem_size_loop2) == -1) return -1;
+        if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_loop2, &device_param->kernel_local_mem_size_loop2) == -1) return -1;
 
-          if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function_loop2, &device_param->kernel_dynamic_local_mem_size_loop2) == -1) return -1;
+        if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function_loop2, &device_param->kernel_dynamic_local_mem_size_loop2) == -1) return -1;
 
-          device_param->kernel_preferred_wgs_multiple_loop2 = device_param->cuda_warp_size;
-        }
+        device_param->kernel_preferred_wgs_multiple_loop2 = device_param->cuda_warp_size;
+      }
 
-        // aux1
+      // aux1
 
-        if (hashconfig->opts_type & OPTS_TYPE_AUX1)
-        {
-          snprintf (kernel_name, sizeof (kernel_name), "m%05u_aux1", kern_type);
+      if (hashconfig->opts_type & OPTS_TYPE_AUX1)
+      {
+        snprintf (kernel_name, sizeof (kernel_name), "m%05u_aux1", kern_type);
 
-          if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_aux1, device_param->cuda_module, kernel_name) == -1) return -1;
+        if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_aux1, device_param->cuda_module, kernel_name) == -1) return -1;
 
-          if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_aux1, &device_param->kernel_wgs_aux1) == -1) return -1;
+        if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_aux1, &device_param->kernel_wgs_aux1) == -1) return -1;
 
-          if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_aux1, &device_param->kernel_local_mem_size_aux1) == -1) return -1;
+        if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_aux1, &device_param->kernel_local_mem_size_aux1) == -1) return -1;
 
-          if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function_aux1, &device_param->kernel_dynamic_local_mem_size_aux1) == -1) return -1;
+        if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function_aux1, &device_param->kernel_dynamic_local_mem_size_aux1) == -1) return -1;
 
-          device_param->kernel_preferred_wgs_multiple_aux1 = device_param->cuda_warp_size;
-        }
+        device_param->kernel_preferred_wgs_multiple_aux1 = device_param->cuda_warp_size;
+      }
 
-        // aux2
+      // aux2
 
-        if (hashconfig->opts_type & OPTS_TYPE_AUX2)
-        {
-          snprintf (kernel_name, sizeof (kernel_name), "m%05u_aux2", kern_type);
+      if (hashconfig->opts_type & OPTS_TYPE_AUX2)
+      {
+        snprintf (kernel_name, sizeof (kernel_name), "m%05u_aux2", kern_type);
 
-          if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_aux2, device_param->cuda_module, kernel_name) == -1) return -1;
+        if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_aux2, device_param->cuda_module, kernel_name) == -1) return -1;
 
-          if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_aux2, &device_param->kernel_wgs_aux2) == -1) return -1;
+        if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_aux2, &device_param->kernel_wgs_aux2) == -1) return -1;
 
-          if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_aux2, &device_param->kernel_local_mem_size_aux2) == -1) return -1;
+        if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_aux2, &device_param->kernel_local_mem_size_aux2) == -1) return -1;
 
-          if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function_aux2, &device_param->kernel_dynamic_local_mem_size_aux2) == -1) return -1;
+        if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function_aux2, &device_param->kernel_dynamic_local_mem_size_aux2) == -1) return -1;
 
-          device_param->kernel_preferred_wgs_multiple_aux2 = device_param->cuda_warp_size;
-        }
+        device_param->kernel_preferred_wgs_multiple_aux2 = device_param->cuda_warp_size;
+      }
 
-        // aux3
+      // aux3
 
-        if (hashconfig->opts_type & OPTS_TYPE_AUX3)
-        {
-          snprintf (kernel_name, sizeof (kernel_name), "m%05u_aux3", kern_type);
+      if (hashconfig->opts_type & OPTS_TYPE_AUX3)
+      {
+        snprintf (kernel_name, sizeof (kernel_name), "m%05u_aux3", kern_type);
 
-          if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_aux3, device_param->cuda_module, kernel_name) == -1) return -1;
+        if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_aux3, device_param->cuda_module, kernel_name) == -1) return -1;
 
-          if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_aux3, &device_param->kernel_wgs_aux3) == -1) return -1;
+        if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_aux3, &device_param->kernel_wgs_aux3) == -1) return -1;
 
-          if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_aux3, &device_param->kernel_local_mem_size_aux3) == -1) return -1;
+        if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_aux3, &device_param->kernel_local_mem_size_aux3) == -1) return -1;
 
-          if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function_aux3, &device_param->kernel_dynamic_local_mem_size_aux3) == -1) return -1;
+        if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function_aux3, &device_param->kernel_dynamic_local_mem_size_aux3) == -1) return -1;
 
-          device_param->kernel_preferred_wgs_multiple_aux3 = device_param->cuda_warp_size;
-        }
+        device_param->kernel_preferred_wgs_multiple_aux3 = device_param->cuda_warp_size;
+      }
 
-        // aux4
+      // aux4
 
-        if (hashconfig->opts_type & OPTS_TYPE_AUX4)
-        {
-          snprintf (kernel_name, sizeof (kernel_name), "m%05u_aux4", kern_type);
+      if (hashconfig->opts_type & OPTS_TYPE_AUX4)
+      {
+        snprintf (kernel_name, sizeof (kernel_name), "m%05u_aux4", kern_type);
 
-          if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_aux4, device_param->cuda_module, kernel_name) == -1) return -1;
+        if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_aux4, device_param->cuda_module, kernel_name) == -1) return -1;
 
-          if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_aux4, &device_param->kernel_wgs_aux4) == -1) return -1;
+        if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_aux4, &device_param->kernel_wgs_aux4) == -1) return -1;
 
-          if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_aux4, &device_param->kernel_local_mem_size_aux4) == -1) return -1;
+        if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_aux4, &device_param->kernel_local_mem_size_aux4) == -1) return -1;
 
-          if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function_aux4, &device_param->kernel_dynamic_local_mem_size_aux4) == -1) return -1;
+        if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function_aux4, &device_param->kernel_dynamic_local_mem_size_aux4) == -1) return -1;
 
-          device_param->kernel_preferred_wgs_multiple_aux4 = device_param->cuda_warp_size;
-        }
+        device_param->kernel_preferred_wgs_multiple_aux4 = device_param->cuda_warp_size;
       }
+    }
 
-      //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 0, sizeof (cl_mem),   device_param->kernel_params_decompress[0]); if (CL_rc == -1) return -1;
-      //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 1, sizeof (cl_mem),   device_param->kernel_params_decompress[1]); if (CL_rc == -1) return -1;
-      //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 2, sizeof (cl_mem),   device_param->kernel_params_decompress[2]); if (CL_rc == -1) return -1;
-      //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 3, sizeof (cl_ulong), device_param->kernel_params_decompress[3]); if (CL_rc == -1) return -1;
+    //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 0, sizeof (cl_mem),   device_param->kernel_params_decompress[0]); if (CL_rc == -1) return -1;
+    //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 1, sizeof (cl_mem),   device_param->kernel_params_decompress[1]); if (CL_rc == -1) return -1;
+    //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 2, sizeof (cl_mem),   device_param->kernel_params_decompress[2]); if (CL_rc == -1) return -1;
+    //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 3, sizeof (cl_ulong), device_param->kernel_params_decompress[3]); if (CL_rc == -1) return -1;
 
-      // MP start
+    // MP start
 
-      if (user_options->slow_candidates == true)
-      {
-      }
-      else
+    if (user_options->slow_candidates == true)
+    {
+    }
+    else
+    {
+      if (user_options->attack_mode == ATTACK_MODE_BF)
       {
-        if (user_options->attack_mode == ATTACK_MODE_BF)
-        {
-          // mp_l
+        // mp_l
 
-          if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_mp_l, device_param->cuda_module_mp, "l_markov") == -1) return -1;
+        if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_mp_l, device_param->cuda_module_mp, "l_markov") == -1) return -1;
 
-          if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_mp_l, &device_param->kernel_wgs_mp_l) == -1) return -1;
+        if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_mp_l, &device_param->kernel_wgs_mp_l) == -1) return -1;
 
-          if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_mp_l, &device_param->kernel_local_mem_size_mp_l) == -1) return -1;
+        if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_mp_l, &device_param->kernel_local_mem_size_mp_l) == -1) return -1;
 
-          if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function_mp_l, &device_param->kernel_dynamic_local_mem_size_mp_l) == -1) return -1;
+        if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function_mp_l, &device_param->kernel_dynamic_local_mem_size_mp_l) == -1) return -1;
 
-          device_param->kernel_preferred_wgs_multiple_mp_l = device_param->cuda_warp_size;
+        device_param->kernel_preferred_wgs_multiple_mp_l = device_param->cuda_warp_size;
 
-          // mp_r
+        // mp_r
 
-          if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_mp_r, device_param->cuda_module_mp, "r_markov") == -1) return -1;
+        if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_mp_r, device_param->cuda_module_mp, "r_markov") == -1) return -1;
 
-          if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_mp_r, &device_param->kernel_wgs_mp_r) == -1) return -1;
+        if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_mp_r, &device_param->kernel_wgs_mp_r) == -1) return -1;
 
-          if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_mp_r, &device_param->kernel_local_mem_size_mp_r) == -1) return -1;
+        if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_mp_r, &device_param->kernel_local_mem_size_mp_r) == -1) return -1;
 
-          if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function_mp_r, &device_param->kernel_dynamic_local_mem_size_mp_r) == -1) return -1;
+        if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function_mp_r, &device_param->kernel_dynamic_local_mem_size_mp_r) == -1) return -1;
 
-          device_param->kernel_preferred_wgs_multiple_mp_r = device_param->cuda_warp_size;
+        device_param->kernel_preferred_wgs_multiple_mp_r = device_param->cuda_warp_size;
 
-          if (user_options->attack_mode == ATTACK_MODE_BF)
+        if (user_options->attack_mode == ATTACK_MODE_BF)
+        {
+          if (hashconfig->opts_type & OPTS_TYPE_TM_KERNEL)
           {
-            if (hashconfig->opts_type & OPTS_TYPE_TM_KERNEL)
-            {
-              //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_tm, 0, sizeof (cl_mem), device_param->kernel_params_tm[0]); if (CL_rc == -1) return -1;
-              //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_tm, 1, sizeof (cl_mem), device_param->kernel_params_tm[1]); if (CL_rc == -1) return -1;
-            }
+            //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_tm, 0, sizeof (cl_mem), device_param->kernel_params_tm[0]); if (CL_rc == -1) return -1;
+            //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_tm, 1, sizeof (cl_mem), device_param->kernel_params_tm[1]); if (CL_rc == -1) return -1;
           }
         }
-        else if (user_options->attack_mode == ATTACK_MODE_HYBRID1)
-        {
-          if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_mp, device_param->cuda_module_mp, "C_markov") == -1) return -1;
+      }
+      else if (user_options->attack_mode == ATTACK_MODE_HYBRID1)
+      {
+        if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_mp, device_param->cuda_module_mp, "C_markov") == -1) return -1;
 
-          if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_mp, &device_param->kernel_wgs_mp) == -1) return -1;
+        if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_mp, &device_param->kernel_wgs_mp) == -1) return -1;
 
-          if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_mp, &device_param->kernel_local_mem_size_mp) == -1) return -1;
+        if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_mp, &device_param->kernel_local_mem_size_mp) == -1) return -1;
 
-          if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function_mp, &device_param->kernel_dynamic_local_mem_size_mp) == -1) return -1;
+        if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function_mp, &device_param->kernel_dynamic_local_mem_size_mp) == -1) return -1;
 
-          device_param->kernel_preferred_wgs_multiple_mp = device_param->cuda_warp_size;
-        }
-        else if (user_options->attack_mode == ATTACK_MODE_HYBRID2)
-        {
-          if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_mp, device_param->cuda_module_mp, "C_markov") == -1) return -1;
+        device_param->kernel_preferred_wgs_multiple_mp = device_param->cuda_warp_size;
+      }
+      else if (user_options->attack_mode == ATTACK_MODE_HYBRID2)
+      {
+        if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_mp, device_param->cuda_module_mp, "C_markov") == -1) return -1;
 
-          if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_mp, &device_param->kernel_wgs_mp) == -1) return -1;
+        if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_mp, &device_param->kernel_wgs_mp) == -1) return -1;
 
-          if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_mp, &device_param->kernel_local_mem_size_mp) == -1) return -1;
+        if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_mp, &device_param->kernel_local_mem_size_mp) == -1) return -1;
 
-          if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function_mp, &device_param->kernel_dynamic_local_mem_size_mp) == -1) return -1;
+        if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function_mp, &device_param->kernel_dynamic_local_mem_size_mp) == -1) return -1;
 
-          device_param->kernel_preferred_wgs_multiple_mp = device_param->cuda_warp_size;
-        }
+        device_param->kernel_preferred_wgs_multiple_mp = device_param->cuda_warp_size;
       }
+    }
 
-      if (user_options->slow_candidates == true)
+    if (user_options->slow_candidates == true)
+    {
+    }
+    else
+    {
+      if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
       {
+        // nothing to do
       }
       else
       {
-        if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-        {
-          // nothing to do
-        }
-        else
-        {
-          if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_amp, device_param->cuda_module_amp, "amp") == -1) return -1;
+        if (hc_cuModuleGetFunction (hashcat_ctx, &device_param->cuda_function_amp, device_param->cuda_module_amp, "amp") == -1) return -1;
 
-          if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_amp, &device_param->kernel_wgs_amp) == -1) return -1;
+        if (get_cuda_kernel_wgs (hashcat_ctx, device_param->cuda_function_amp, &device_param->kernel_wgs_amp) == -1) return -1;
 
-          if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_amp, &device_param->kernel_local_mem_size_amp) == -1) return -1;
+        if (get_cuda_kernel_local_mem_size (hashcat_ctx, device_param->cuda_function_amp, &device_param->kernel_local_mem_size_amp) == -1) return -1;
 
-          if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function_amp, &device_param->kernel_dynamic_local_mem_size_amp) == -1) return -1;
+        if (get_cuda_kernel_dynamic_local_mem_size (hashcat_ctx, device_param->cuda_function_amp, &device_param->kernel_dynamic_local_mem_size_amp) == -1) return -1;
 
-          device_param->kernel_preferred_wgs_multiple_amp = device_param->cuda_warp_size;
-        }
+        device_param->kernel_preferred_wgs_multiple_amp = device_param->cuda_warp_size;
+      }
 
-        /*
-        if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-        {
-          // nothing to do
-        }
-        else
+      /*
+      if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+      {
+        // nothing to do
+      }
+      else
+      {
+        for (u32 i = 0; i < 5; i++)
         {
-          for (u32 i = 0; i < 5; i++)
-          {
-            //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, i, sizeof (cl_mem), device_param->kernel_params_amp[i]);
+          //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, i, sizeof (cl_mem), device_param->kernel_params_amp[i]);
 
-            //if (CL_rc == -1) return -1;
-          }
+          //if (CL_rc == -1) return -1;
+        }
 
-          for (u32 i = 5; i < 6; i++)
-          {
-            //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, i, sizeof (cl_uint), device_param->kernel_params_amp[i]);
+        for (u32 i = 5; i < 6; i++)
+        {
+          //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, i, sizeof (cl_uint), device_param->kernel_params_amp[i]);
 
-            //if (CL_rc == -1) return -1;
-          }
+          //if (CL_rc == -1) return -1;
+        }
 
-          for (u32 i = 6; i < 7; i++)
-          {
-            //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, i, sizeof (cl_ulong), device_param->kernel_params_amp[i]);
+        for (u32 i = 6; i < 7; i++)
+        {
+          //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, i, sizeof (cl_ulong), device_param->kernel_params_amp[i]);
 
-            //if (CL_rc == -1) return -1;
-          }
+          //if (CL_rc == -1) return -1;
         }
-        */
       }
+      */
+    }
 
-      // zero some data buffers
+    // zero some data buffers
 
-      if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_plain_bufs,    device_param->size_plains)  == -1) return -1;
-      if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_digests_shown, device_param->size_shown)   == -1) return -1;
-      if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_result,        device_param->size_results) == -1) return -1;
+    if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_plain_bufs,    device_param->size_plains)  == -1) return -1;
+    if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_digests_shown, device_param->size_shown)   == -1) return -1;
+    if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_result,        device_param->size_results) == -1) return -1;
 
-      /**
-       * special buffers
-       */
+    /**
+     * special buffers
+     */
 
-      if (user_options->slow_candidates == true)
+    if (user_options->slow_candidates == true)
+    {
+      if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_rules_c, size_rules_c) == -1) return -1;
+    }
+    else
+    {
+      if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
       {
         if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_rules_c, size_rules_c) == -1) return -1;
       }
-      else
+      else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
       {
-        if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
-        {
-          if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_rules_c, size_rules_c) == -1) return -1;
-        }
-        else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
+        if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_combs,          size_combs)       == -1) return -1;
+        if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_combs_c,        size_combs)       == -1) return -1;
+        if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_root_css_buf,   size_root_css)    == -1) return -1;
+        if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_markov_css_buf, size_markov_css)  == -1) return -1;
+      }
+      else if (user_options_extra->attack_kern == ATTACK_KERN_BF)
+      {
+        if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_bfs,            size_bfs)         == -1) return -1;
+        if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_bfs_c,          size_bfs)         == -1) return -1;
+        if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_tm_c,           size_tm)          == -1) return -1;
+        if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_root_css_buf,   size_root_css)    == -1) return -1;
+        if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_markov_css_buf, size_markov_css)  == -1) return -1;
+      }
+    }
+
+    if (user_options->slow_candidates == true)
+    {
+    }
+    else
+    {
+      if ((user_options->attack_mode == ATTACK_MODE_HYBRID1) || (user_options->attack_mode == ATTACK_MODE_HYBRID2))
+      {
+        /**
+         * prepare mp
+         */
+
+        if (user_options->attack_mode == ATTACK_MODE_HYBRID1)
         {
-          if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_combs,          size_combs)       == -1) return -1;
-          if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_combs_c,        size_combs)       == -1) return -1;
-          if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_root_css_buf,   size_root_css)    == -1) return -1;
-          if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_markov_css_buf, size_markov_css)  == -1) return -1;
+          device_param->kernel_params_mp_buf32[5] = 0;
+          device_param->kernel_params_mp_buf32[6] = 0;
+          device_param->kernel_params_mp_buf32[7] = 0;
+
+          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD01)     device_param->kernel_params_mp_buf32[5] = full01;
+          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD06)     device_param->kernel_params_mp_buf32[5] = full06;
+          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD80)     device_param->kernel_params_mp_buf32[5] = full80;
+          if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS14) device_param->kernel_params_mp_buf32[6] = 1;
+          if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS15) device_param->kernel_params_mp_buf32[7] = 1;
         }
-        else if (user_options_extra->attack_kern == ATTACK_KERN_BF)
+        else if (user_options->attack_mode == ATTACK_MODE_HYBRID2)
         {
-          if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_bfs,            size_bfs)         == -1) return -1;
-          if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_bfs_c,          size_bfs)         == -1) return -1;
-          if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_tm_c,           size_tm)          == -1) return -1;
-          if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_root_css_buf,   size_root_css)    == -1) return -1;
-          if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_markov_css_buf, size_markov_css)  == -1) return -1;
+          device_param->kernel_params_mp_buf32[5] = 0;
+          device_param->kernel_params_mp_buf32[6] = 0;
+          device_param->kernel_params_mp_buf32[7] = 0;
         }
-      }
 
-      if (user_options->slow_candidates == true)
-      {
+        //for (u32 i = 0; i < 3; i++) { CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp, i, sizeof (cl_mem), device_param->kernel_params_mp[i]); if (CL_rc == -1) return -1; }
       }
-      else
+      else if (user_options->attack_mode == ATTACK_MODE_BF)
       {
-        if ((user_options->attack_mode == ATTACK_MODE_HYBRID1) || (user_options->attack_mode == ATTACK_MODE_HYBRID2))
-        {
-          /**
-           * prepare mp
-           */
-
-          if (user_options->attack_mode == ATTACK_MODE_HYBRID1)
-          {
-            device_param->kernel_params_mp_buf32[5] = 0;
-            device_param->kernel_params_mp_buf32[6] = 0;
-            device_param->kernel_params_mp_buf32[7] = 0;
-
-            if (hashconfig->opts_type & OPTS_TYPE_PT_ADD01)     device_param->kernel_params_mp_buf32[5] = full01;
-            if (hashconfig->opts_type & OPTS_TYPE_PT_ADD06)     device_param->kernel_params_mp_buf32[5] = full06;
-            if (hashconfig->opts_type & OPTS_TYPE_PT_ADD80)     device_param->kernel_params_mp_buf32[5] = full80;
-            if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS14) device_param->kernel_params_mp_buf32[6] = 1;
-            if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS15) device_param->kernel_params_mp_buf32[7] = 1;
-          }
-          else if (user_options->attack_mode == ATTACK_MODE_HYBRID2)
-          {
-            device_param->kernel_params_mp_buf32[5] = 0;
-            device_param->kernel_params_mp_buf32[6] = 0;
-            device_param->kernel_params_mp_buf32[7] = 0;
-          }
-
-          //for (u32 i = 0; i < 3; i++) { CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp, i, sizeof (cl_mem), device_param->kernel_params_mp[i]); if (CL_rc == -1) return -1; }
-        }
-        else if (user_options->attack_mode == ATTACK_MODE_BF)
-        {
-          /**
-           * prepare mp_r and mp_l
-           */
+        /**
+         * prepare mp_r and mp_l
+         */
 
-          device_param->kernel_params_mp_l_buf32[6] = 0;
-          device_param->kernel_params_mp_l_buf32[7] = 0;
-          device_param->kernel_params_mp_l_buf32[8] = 0;
+        device_param->kernel_params_mp_l_buf32[6] = 0;
+        device_param->kernel_params_mp_l_buf32[7] = 0;
+        device_param->kernel_params_mp_l_buf32[8] = 0;
 
-          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD01)     device_param->kernel_params_mp_l_buf32[6] = full01;
-          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD06)     device_param->kernel_params_mp_l_buf32[6] = full06;
-          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD80)     device_param->kernel_params_mp_l_buf32[6] = full80;
-          if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS14) device_param->kernel_params_mp_l_buf32[7] = 1;
-          if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS15) device_param->kernel_params_mp_l_buf32[8] = 1;
+        if (hashconfig->opts_type & OPTS_TYPE_PT_ADD01)     device_param->kernel_params_mp_l_buf32[6] = full01;
+        if (hashconfig->opts_type & OPTS_TYPE_PT_ADD06)     device_param->kernel_params_mp_l_buf32[6] = full06;
+        if (hashconfig->opts_type & OPTS_TYPE_PT_ADD80)     device_param->kernel_params_mp_l_buf32[6] = full80;
+        if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS14) device_param->kernel_params_mp_l_buf32[7] = 1;
+        if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS15) device_param->kernel_params_mp_l_buf32[8] = 1;
 
-          //for (u32 i = 0; i < 3; i++) { CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp_l, i, sizeof (cl_mem), device_param->kernel_params_mp_l[i]); if (CL_rc == -1) return -1; }
-          //for (u32 i = 0; i < 3; i++) { CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp_r, i, sizeof (cl_mem), device_param->kernel_params_mp_r[i]); if (CL_rc == -1) return -1; }
-        }
+        //for (u32 i = 0; i < 3; i++) { CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp_l, i, sizeof (cl_mem), device_param->kernel_params_mp_l[i]); if (CL_rc == -1) return -1; }
+        //for (u32 i = 0; i < 3; i++) { CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp_r, i, sizeof (cl_mem), device_param->kernel_params_mp_r[i]); if (CL_rc == -1) return -1; }
       }
     }
+  }
 
-    if (device_param->is_opencl == true)
-    {
-      // GPU memset
+  if (device_param->is_opencl == true)
+  {
+    // GPU memset
 
-      if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_memset, 0, sizeof (cl_mem),   device_param->kernel_params_memset[0]) == -1) return -1;
-      if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_memset, 1, sizeof (cl_uint),  device_param->kernel_params_memset[1]) == -1) return -1;
-      if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_memset, 2, sizeof (cl_ulong), device_param->kernel_params_memset[2]) == -1) return -1;
+    if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_memset, 0, sizeof (cl_mem),   device_param->kernel_params_memset[0]) == -1) return -1;
+    if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_memset, 1, sizeof (cl_uint),  device_param->kernel_params_memset[1]) == -1) return -1;
+    if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_memset, 2, sizeof (cl_ulong), device_param->kernel_params_memset[2]) == -1) return -1;
 
-      // GPU autotune init
+    // GPU autotune init
 
-      if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_atinit, 0, sizeof (cl_mem),   device_param->kernel_params_atinit[0]) == -1) return -1;
-      if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_atinit, 1, sizeof (cl_ulong), device_param->kernel_params_atinit[1]) == -1) return -1;
+    if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_atinit, 0, sizeof (cl_mem),   device_param->kernel_params_atinit[0]) == -1) return -1;
+    if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_atinit, 1, sizeof (cl_ulong), device_param->kernel_params_atinit[1]) == -1) return -1;
 
-      // GPU decompress
+    // GPU decompress
 
-      if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 0, sizeof (cl_mem),   device_param->kernel_params_decompress[0]) == -1) return -1;
-      if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 1, sizeof (cl_mem),   device_param->kernel_params_decompress[1]) == -1) return -1;
-      if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 2, sizeof (cl_mem),   device_param->kernel_params_decompress[2]) == -1) return -1;
-      if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 3, sizeof (cl_ulong), device_param->kernel_params_decompress[3]) == -1) return -1;
+    if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 0, sizeof (cl_mem),   device_param->kernel_params_decompress[0]) == -1) return -1;
+    if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 1, sizeof (cl_mem),   device_param->kernel_params_decompress[1]) == -1) return -1;
+    if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 2, sizeof (cl_mem),   device_param->kernel_params_decompress[2]) == -1) return -1;
+    if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 3, sizeof (cl_ulong), device_param->kernel_params_decompress[3]) == -1) return -1;
 
-      char kernel_name[64] = { 0 };
+    char kernel_name[64] = { 0 };
 
-      if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+    if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+    {
+      if (hashconfig->opti_type & OPTI_TYPE_SINGLE_HASH)
       {
-        if (hashconfig->opti_type & OPTI_TYPE_SINGLE_HASH)
+        if (hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL)
         {
-          if (hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL)
-          {
-            // kernel1
+          // kernel1
 
-            snprintf (kernel_name, sizeof (kernel_name), "m%05u_s%02d", kern_type, 4);
+          snprintf (kernel_name, sizeof (kernel_name), "m%05u_s%02d", kern_type, 4);
 
-            if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel1) == -1) return -1;
+          if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel1) == -1) return -1;
 
-            if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel1, &device_param->kernel_wgs1) == -1) return -1;
+          if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel1, &device_param->kernel_wgs1) == -1) return -1;
 
-            if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel1, &device_param->kernel_local_mem_size1) == -1) return -1;
+          if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel1, &device_param->kernel_local_mem_size1) == -1) return -1;
 
-            if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel1, &device_param->kernel_dynamic_local_mem_size1) == -1) return -1;
+          if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel1, &device_param->kernel_dynamic_local_mem_size1) == -1) return -1;
 
-            if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel1, &device_param->kernel_preferred_wgs_multiple1) == -1) return -1;
+          if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel1, &device_param->kernel_preferred_wgs_multiple1) == -1) return -1;
 
-            // kernel2
+          // kernel2
 
-            snprintf (kernel_name, sizeof (kernel_name), "m%05u_s%02d", kern_type, 8);
+          snprintf (kernel_name, sizeof (kernel_name), "m%05u_s%02d", kern_type, 8);
 
-            if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel2) == -1) return -1;
+          if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel2) == -1) return -1;
 
-            if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel2, &device_param->kernel_wgs2) == -1) return -1;
+          if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel2, &device_param->kernel_wgs2) == -1) return -1;
 
-            if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel2, &device_param->kernel_local_mem_size2) == -1) return -1;
+          if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel2, &device_param->kernel_local_mem_size2) == -1) return -1;
 
-            if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel2, &device_param->kernel_dynamic_local_mem_size2) == -1) return -1;
+          if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel2, &device_param->kernel_dynamic_local_mem_size2) == -1) return -1;
 
-            if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel2, &device_param->kernel_preferred_wgs_multiple2) == -1) return -1;
+          if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel2, &device_param->kernel_preferred_wgs_multiple2) == -1) return -1;
 
-            // kernel3
+          // kernel3
 
-            snprintf (kernel_name, sizeof (kernel_name), "m%05u_s%02d", kern_type, 16);
+          snprintf (kernel_name, sizeof (kernel_name), "m%05u_s%02d", kern_type, 16);
 
-            if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel3) == -1) return -1;
+          if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel3) == -1) return -1;
 
-            if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel3, &device_param->kernel_wgs3) == -1) return -1;
+          if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel3, &device_param->kernel_wgs3) == -1) return -1;
 
-            if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel3, &device_param->kernel_local_mem_size3) == -1) return -1;
+          if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel3, &device_param->kernel_local_mem_size3) == -1) return -1;
 
-            if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel3, &device_param->kernel_dynamic_local_mem_size3) == -1) return -1;
+          if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel3, &device_param->kernel_dynamic_local_mem_size3) == -1) return -1;
 
-            if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel3, &device_param->kernel_preferred_wgs_multiple3) == -1) return -1;
-          }
-          else
-          {
-            snprintf (kernel_name, sizeof (kernel_name), "m%05u_sxx", kern_type);
+          if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel3, &device_param->kernel_preferred_wgs_multiple3) == -1) return -1;
+        }
+        else
+        {
+          snprintf (kernel_name, sizeof (kernel_name), "m%05u_sxx", kern_type);
 
-            if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel4) == -1) return -1;
+          if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel4) == -1) return -1;
 
-            if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel4, &device_param->kernel_wgs4) == -1) return -1;
+          if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel4, &device_param->kernel_wgs4) == -1) return -1;
 
-            if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel4, &device_param->kernel_local_mem_size4) == -1) return -1;
+          if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel4, &device_param->kernel_local_mem_size4) == -1) return -1;
 
-            if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel4, &device_param->kernel_dynamic_local_mem_size4) == -1) return -1;
+          if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel4, &device_param->kernel_dynamic_local_mem_size4) == -1) return -1;
 
-            if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel4, &device_param->kernel_preferred_wgs_multiple4) == -1) return -1;
-          }
+          if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel4, &device_param->kernel_preferred_wgs_multiple4) == -1) return -1;
         }
-        else
+      }
+      else
+      {
+        if (hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL)
         {
-          if (hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL)
-          {
-            // kernel1
+          // kernel1
 
-            snprintf (kernel_name, sizeof (kernel_name), "m%05u_m%02d", kern_type, 4);
+          snprintf (kernel_name, sizeof (kernel_name), "m%05u_m%02d", kern_type, 4);
 
-            if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel1) == -1) return -1;
+          if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel1) == -1) return -1;
 
-            if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel1, &device_param->kernel_wgs1) == -1) return -1;
+          if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel1, &device_param->kernel_wgs1) == -1) return -1;
 
-            if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel1, &device_param->kernel_local_mem_size1) == -1) return -1;
+          if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel1, &device_param->kernel_local_mem_size1) == -1) return -1;
 
-            if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel1, &device_param->kernel_dynamic_local_mem_size1) == -1) return -1;
+          if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel1, &device_param->kernel_dynamic_local_mem_size1) == -1) return -1;
 
-            if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel1, &device_param->kernel_preferred_wgs_multiple1) == -1) return -1;
+          if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel1, &device_param->kernel_preferred_wgs_multiple1) == -1) return -1;
 
-            // kernel2
+          // kernel2
 
-            snprintf (kernel_name, sizeof (kernel_name), "m%05u_m%02d", kern_type, 8);
+          snprintf (kernel_name, sizeof (kernel_name), "m%05u_m%02d", kern_type, 8);
 
-            if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel2) == -1) return -1;
+          if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel2) == -1) return -1;
 
-            if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel2, &device_param->kernel_wgs2) == -1) return -1;
+          if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel2, &device_param->kernel_wgs2) == -1) return -1;
 
-            if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel2, &device_param->kernel_local_mem_size2) == -1) return -1;
+          if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel2, &device_param->kernel_local_mem_size2) == -1) return -1;
 
-            if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel2, &device_param->kernel_dynamic_local_mem_size2) == -1) return -1;
+          if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel2, &device_param->kernel_dynamic_local_mem_size2) == -1) return -1;
 
-            if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel2, &device_param->kernel_preferred_wgs_multiple2) == -1) return -1;
+          if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel2, &device_param->kernel_preferred_wgs_multiple2) == -1) return -1;
 
-            // kernel3
+          // kernel3
 
-            snprintf (kernel_name, sizeof (kernel_name), "m%05u_m%02d", kern_type, 16);
+          snprintf (kernel_name, sizeof (kernel_name), "m%05u_m%02d", kern_type, 16);
 
-            if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel3) == -1) return -1;
+          if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel3) == -1) return -1;
 
-            if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel3, &device_param->kernel_wgs3) == -1) return -1;
+          if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel3, &device_param->kernel_wgs3) == -1) return -1;
 
-            if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel3, &device_param->kernel_local_mem_size3) == -1) return -1;
+          if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel3, &device_param->kernel_local_mem_size3) == -1) return -1;
 
-            if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel3, &device_param->kernel_dynamic_local_mem_size3) == -1) return -1;
+          if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel3, &device_param->kernel_dynamic_local_mem_size3) == -1) return -1;
 
-            if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel3, &device_param->kernel_preferred_wgs_multiple3) == -1) return -1;
-          }
-          else
-          {
-            snprintf (kernel_name, sizeof (kernel_name), "m%05u_mxx", kern_type);
+          if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel3, &device_param->kernel_preferred_wgs_multiple3) == -1) return -1;
+        }
+        else
+        {
+          snprintf (kernel_name, sizeof (kernel_name), "m%05u_mxx", kern_type);
 
-            if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel4) == -1) return -1;
+          if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel4) == -1) return -1;
 
-            if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel4, &device_param->kernel_wgs4) == -1) return -1;
+          if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel4, &device_param->kernel_wgs4) == -1) return -1;
 
-            if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel4, &device_param->kernel_local_mem_size4) == -1) return -1;
+          if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel4, &device_param->kernel_local_mem_size4) == -1) return -1;
 
-            if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel4, &device_param->kernel_dynamic_local_mem_size4) == -1) return -1;
+          if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel4, &device_param->kernel_dynamic_local_mem_size4) == -1) return -1;
 
-            if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel4, &device_param->kernel_preferred_wgs_multiple4) == -1) return -1;
-          }
+          if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel4, &device_param->kernel_preferred_wgs_multiple4) == -1) return -1;
         }
+      }
 
-        if (user_options->slow_candidates == true)
-        {
-        }
-        else
+      if (user_options->slow_candidates == true)
+      {
+      }
+      else
+      {
+        if (user_options->attack_mode == ATTACK_MODE_BF)
         {
-          if (user_options->attack_mode == ATTACK_MODE_BF)
+          if (hashconfig->opts_type & OPTS_TYPE_TM_KERNEL)
           {
-            if (hashconfig->opts_type & OPTS_TYPE_TM_KERNEL)
-            {
-              snprintf (kernel_name, sizeof (kernel_name), "m%05u_tm", kern_type);
+            snprintf (kernel_name, sizeof (kernel_name), "m%05u_tm", kern_type);
 
-              if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel_tm) == -1) return -1;
+            if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel_tm) == -1) return -1;
 
-              if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel_tm, &device_param->kernel_wgs_tm) == -1) return -1;
+            if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel_tm, &device_param->kernel_wgs_tm) == -1) return -1;
 
-              if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_tm, &device_param->kernel_local_mem_size_tm) == -1) return -1;
+            if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_tm, &device_param->kernel_local_mem_size_tm) == -1) return -1;
 
-              if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_tm, &device_param->kernel_dynamic_local_mem_size_tm) == -1) return -1;
+            if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_tm, &device_param->kernel_dynamic_local_mem_size_tm) == -1) return -1;
 
-              if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel_tm, &device_param->kernel_preferred_wgs_multiple_tm) == -1) return -1;
-            }
+            if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel_tm, &device_param->kernel_preferred_wgs_multiple_tm) == -1) return -1;
           }
         }
       }
-      else
-      {
-        // kernel1
+    }
+    else
+    {
+      // kernel1
 
-        snprintf (kernel_name, sizeof (kernel_name), "m%05u_init", kern_type);
+      snprintf (kernel_name, sizeof (kernel_name), "m%05u_init", kern_type);
 
-        if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel1) == -1) return -1;
+      if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel1) == -1) return -1;
 
-        if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel1, &device_param->kernel_wgs1) == -1) return -1;
+      if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel1, &device_param->kernel_wgs1) == -1) return -1;
 
-        if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel1, &device_param->kernel_local_mem_size1) == -1) return -1;
+      if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel1, &device_param->kernel_local_mem_size1) == -1) return -1;
 
-        if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel1, &device_param->kernel_dynamic_local_mem_size1) == -1) return -1;
+      if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel1, &device_param->kernel_dynamic_local_mem_size1) == -1) return -1;
 
-        if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel1, &device_param->kernel_preferred_wgs_multiple1) == -1) return -1;
+      if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel1, &device_param->kernel_preferred_wgs_multiple1) == -1) return -1;
 
-        // kernel2
+      // kernel2
 
-        snprintf (kernel_name, sizeof (kernel_name), "m%05u_loop", kern_type);
+      snprintf (kernel_name, sizeof (kernel_name), "m%05u_loop", kern_type);
 
-        if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel2) == -1) return -1;
+      if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel2) == -1) return -1;
 
-        if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel2, &device_param->kernel_wgs2) == -1) return -1;
+      if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel2, &device_param->kernel_wgs2) == -1) return -1;
 
-        if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel2, &device_param->kernel_local_mem_size2) == -1) return -1;
+      if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel2, &device_param->kernel_local_mem_size2) == -1) return -1;
 
-        if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel2, &device_param->kernel_dynamic_local_mem_size2) == -1) return -1;
+      if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel2, &device_param->kernel_dynamic_local_mem_size2) == -1) return -1;
 
-        if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel2, &device_param->kernel_preferred_wgs_multiple2) == -1) return -1;
+      if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel2, &device_param->kernel_preferred_wgs_multiple2) == -1) return -1;
 
-        // kernel3
+      // kernel3
 
-        snprintf (kernel_name, sizeof (kernel_name), "m%05u_comp", kern_type);
+      snprintf (kernel_name, sizeof (kernel_name), "m%05u_comp", kern_type);
 
-        if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel3) == -1) return -1;
+      if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel3) == -1) return -1;
 
-        if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel3, &device_param->kernel_wgs3) == -1) return -1;
+      if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel3, &device_param->kernel_wgs3) == -1) return -1;
 
-        if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel3, &device_param->kernel_local_mem_size3) == -1) return -1;
+      if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel3, &device_param->kernel_local_mem_size3) == -1) return -1;
 
-        if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel3, &device_param->kernel_dynamic_local_mem_size3) == -1) return -1;
+      if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel3, &device_param->kernel_dynamic_local_mem_size3) == -1) return -1;
 
-        if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel3, &device_param->kernel_preferred_wgs_multiple3) == -1) return -1;
+      if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel3, &device_param->kernel_preferred_wgs_multiple3) == -1) return -1;
 
-        // aux1
+      // aux1
 
-        if (hashconfig->opts_type & OPTS_TYPE_LOOP_EXTENDED)
-        {
-          snprintf (kernel_name, sizeof (kernel_name), "m%05u_loop_extended", kern_type);
+      if (hashconfig->opts_type & OPTS_TYPE_LOOP_EXTENDED)
+      {
+        snprintf (kernel_name, sizeof (kernel_name), "m%05u_loop_extended", kern_type);
 
-          if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel2e) == -1) return -1;
+        if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel2e) == -1) return -1;
 
-          if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel2e, &device_param->kernel_wgs2e) == -1) return -1;
+        if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel2e, &device_param->kernel_wgs2e) == -1) return -1;
 
-          if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel2e, &device_param->kernel_local_mem_size2e) == -1) return -1;
+        if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel2e, &device_param->kernel_local_mem_size2e) == -1) return -1;
 
-          if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel2e, &device_param->kernel_dynamic_local_mem_size2e) == -1) return -1;
+        if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel2e, &device_param->kernel_dynamic_local_mem_size2e) == -1) return -1;
 
-          if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel2e, &device_param->kernel_preferred_wgs_multiple2e) == -1) return -1;
-        }
+        if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel2e, &device_param->kernel_preferred_wgs_multiple2e) == -1) return -1;
+      }
 
-        // kernel12
+      // kernel12
 
-        if (hashconfig->opts_type & OPTS_TYPE_HOOK12)
-        {
-          snprintf (kernel_name, sizeof (kernel_name), "m%05u_hook12", kern_type);
+      if (hashconfig->opts_type & OPTS_TYPE_HOOK12)
+      {
+        snprintf (kernel_name, sizeof (kernel_name), "m%05u_hook12", kern_type);
 
-          if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel12) == -1) return -1;
+        if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel12) == -1) return -1;
 
-          if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel12, &device_param->kernel_wgs12) == -1) return -1;
+        if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel12, &device_param->kernel_wgs12) == -1) return -1;
 
-          if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel12, &device_param->kernel_local_mem_size12) == -1) return -1;
+        if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel12, &device_param->kernel_local_mem_size12) == -1) return -1;
 
-          if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel12, &device_param->kernel_dynamic_local_mem_size12) == -1) return -1;
+        if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel12, &device_param->kernel_dynamic_local_mem_size12) == -1) return -1;
 
-          if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel12, &device_param->kernel_preferred_wgs_multiple12) == -1) return -1;
-        }
+        if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel12, &device_param->kernel_preferred_wgs_multiple12) == -1) return -1;
+      }
 
-        // kernel23
+      // kernel23
 
-        if (hashconfig->opts_type & OPTS_TYPE_HOOK23)
-        {
-          snprintf (kernel_name, sizeof (kernel_name), "m%05u_hook23", kern_type);
+      if (hashconfig->opts_type & OPTS_TYPE_HOOK23)
+      {
+        snprintf (kernel_name, sizeof (kernel_name), "m%05u_hook23", kern_type);
 
-          if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel23) == -1) return -1;
+        if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel23) == -1) return -1;
 
-          if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel23, &device_param->kernel_wgs23) == -1) return -1;
+        if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel23, &device_param->kernel_wgs23) == -1) return -1;
 
-          if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel23, &device_param->kernel_local_mem_size23) == -1) return -1;
+        if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel23, &device_param->kernel_local_mem_size23) == -1) return -1;
 
-          if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel23, &device_param->kernel_dynamic_local_mem_size23) == -1) return -1;
+        if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel23, &device_param->kernel_dynamic_local_mem_size23) == -1) return -1;
 
-          if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel23, &device_param->kernel_preferred_wgs_multiple23) == -1) return -1;
-        }
+        if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel23, &device_param->kernel_preferred_wgs_multiple23) == -1) return -1;
+      }
 
-        // init2
+      // init2
 
-        if (hashconfig->opts_type & OPTS_TYPE_INIT2)
-        {
-          snprintf (kernel_name, sizeof (kernel_name), "m%05u_init2", kern_type);
+      if (hashconfig->opts_type & OPTS_TYPE_INIT2)
+      {
+        snprintf (kernel_name, sizeof (kernel_name), "m%05u_init2", kern_type);
 
-          if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel_init2) == -1) return -1;
+        if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel_init2) == -1) return -1;
 
-          if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel_init2, &device_param->kernel_wgs_init2) == -1) return -1;
+        if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel_init2, &device_param->kernel_wgs_init2) == -1) return -1;
 
-          if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_init2, &device_param->kernel_local_mem_size_init2) == -1) return -1;
+        if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_init2, &device_param->kernel_local_mem_size_init2) == -1) return -1;
 
-          if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_init2, &device_param->kernel_dynamic_local_mem_size_init2) == -1) return -1;
+        if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_init2, &device_param->kernel_dynamic_local_mem_size_init2) == -1) return -1;
 
-          if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel_init2, &device_param->kernel_preferred_wgs_multiple_init2) == -1) return -1;
-        }
+        if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel_init2, &device_param->kernel_preferred_wgs_multiple_init2) == -1) return -1;
+      }
 
-        // loop2
+      // loop2
 
-        if (hashconfig->opts_type & OPTS_TYPE_LOOP2)
-        {
-          snprintf (kernel_name, sizeof (kernel_name), "m%05u_loop2", kern_type);
+      if (hashconfig->opts_type & OPTS_TYPE_LOOP2)
+      {
+        snprintf (kernel_name, sizeof (kernel_name), "m%05u_loop2", kern_type);
 
-          if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel_loop2) == -1) return -1;
+        if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel_loop2) == -1) return -1;
 
-          if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel_loop2, &device_param->kernel_wgs_loop2) == -1) return -1;
+        if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel_loop2, &device_param->kernel_wgs_loop2) == -1) return -1;
 
-          if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_loop2, &device_param->kernel_local_mem_size_loop2) == -1) return -1;
+        if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_loop2, &device_param->kernel_local_mem_size_loop2) == -1) return -1;
 
-          if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_loop2, &device_param->kernel_dynamic_local_mem_size_loop2) == -1) return -1;
+        if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_loop2, &device_param->kernel_dynamic_local_mem_size_loop2) == -1) return -1;
 
-          if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel_loop2, &device_param->kernel_preferred_wgs_multiple_loop2) == -1) return -1;
-        }
+        if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel_loop2, &device_param->kernel_preferred_wgs_multiple_loop2) == -1) return -1;
+      }
 
-        // aux1
+      // aux1
 
-        if (hashconfig->opts_type & OPTS_TYPE_AUX1)
-        {
-          snprintf (kernel_name, sizeof (kernel_name), "m%05u_aux1", kern_type);
+      if (hashconfig->opts_type & OPTS_TYPE_AUX1)
+      {
+        snprintf (kernel_name, sizeof (kernel_name), "m%05u_aux1", kern_type);
 
-          if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel_aux1) == -1) return -1;
+        if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel_aux1) == -1) return -1;
 
-          if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel_aux1, &device_param->kernel_wgs_aux1) == -1) return -1;
+        if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel_aux1, &device_param->kernel_wgs_aux1) == -1) return -1;
 
-          if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_aux1, &device_param->kernel_local_mem_size_aux1) == -1) return -1;
+        if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_aux1, &device_param->kernel_local_mem_size_aux1) == -1) return -1;
 
-          if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_aux1, &device_param->kernel_dynamic_local_mem_size_aux1) == -1) return -1;
+        if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_aux1, &device_param->kernel_dynamic_local_mem_size_aux1) == -1) return -1;
 
-          if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel_aux1, &device_param->kernel_preferred_wgs_multiple_aux1) == -1) return -1;
-        }
+        if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel_aux1, &device_param->kernel_preferred_wgs_multiple_aux1) == -1) return -1;
+      }
 
-        // aux2
+      // aux2
 
-        if (hashconfig->opts_type & OPTS_TYPE_AUX2)
-        {
-          snprintf (kernel_name, sizeof (kernel_name), "m%05u_aux2", kern_type);
+      if (hashconfig->opts_type & OPTS_TYPE_AUX2)
+      {
+        snprintf (kernel_name, sizeof (kernel_name), "m%05u_aux2", kern_type);
 
-          if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel_aux2) == -1) return -1;
+        if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel_aux2) == -1) return -1;
 
-          if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel_aux2, &device_param->kernel_wgs_aux2) == -1) return -1;
+        if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel_aux2, &device_param->kernel_wgs_aux2) == -1) return -1;
 
-          if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_aux2, &device_param->kernel_local_mem_size_aux2) == -1) return -1;
+        if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_aux2, &device_param->kernel_local_mem_size_aux2) == -1) return -1;
 
-          if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_aux2, &device_param->kernel_dynamic_local_mem_size_aux2) == -1) return -1;
+        if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_aux2, &device_param->kernel_dynamic_local_mem_size_aux2) == -1) return -1;
 
-          if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel_aux2, &device_param->kernel_preferred_wgs_multiple_aux2) == -1) return -1;
-        }
+        if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel_aux2, &device_param->kernel_preferred_wgs_multiple_aux2) == -1) return -1;
+      }
 
-        // aux3
+      // aux3
 
-        if (hashconfig->opts_type & OPTS_TYPE_AUX3)
-        {
-          snprintf (kernel_name, sizeof (kernel_name), "m%05u_aux3", kern_type);
+      if (hashconfig->opts_type & OPTS_TYPE_AUX3)
+      {
+        snprintf (kernel_name, sizeof (kernel_name), "m%05u_aux3", kern_type);
 
-          if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel_aux3) == -1) return -1;
+        if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel_aux3) == -1) return -1;
 
-          if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel_aux3, &device_param->kernel_wgs_aux3) == -1) return -1;
+        if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel_aux3, &device_param->kernel_wgs_aux3) == -1) return -1;
 
-          if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_aux3, &device_param->kernel_local_mem_size_aux3) == -1) return -1;
+        if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_aux3, &device_param->kernel_local_mem_size_aux3) == -1) return -1;
 
-          if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_aux3, &device_param->kernel_dynamic_local_mem_size_aux3) == -1) return -1;
+        if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_aux3, &device_param->kernel_dynamic_local_mem_size_aux3) == -1) return -1;
 
-          if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel_aux3, &device_param->kernel_preferred_wgs_multiple_aux3) == -1) return -1;
-        }
+        if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel_aux3, &device_param->kernel_preferred_wgs_multiple_aux3) == -1) return -1;
+      }
 
-        // aux4
+      // aux4
 
-        if (hashconfig->opts_type & OPTS_TYPE_AUX4)
-        {
-          snprintf (kernel_name, sizeof (kernel_name), "m%05u_aux4", kern_type);
+      if (hashconfig->opts_type & OPTS_TYPE_AUX4)
+      {
+        snprintf (kernel_name, sizeof (kernel_name), "m%05u_aux4", kern_type);
 
-          if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel_aux4) == -1) return -1;
+        if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program, kernel_name, &device_param->opencl_kernel_aux4) == -1) return -1;
 
-          if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel_aux4, &device_param->kernel_wgs_aux4) == -1) return -1;
+        if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel_aux4, &device_param->kernel_wgs_aux4) == -1) return -1;
 
-          if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_aux4, &device_param->kernel_local_mem_size_aux4) == -1) return -1;
+        if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_aux4, &device_param->kernel_local_mem_size_aux4) == -1) return -1;
 
-          if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_aux4, &device_param->kernel_dynamic_local_mem_size_aux4) == -1) return -1;
+        if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_aux4, &device_param->kernel_dynamic_local_mem_size_aux4) == -1) return -1;
 
-          if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel_aux4, &device_param->kernel_preferred_wgs_multiple_aux4) == -1) return -1;
-        }
+        if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel_aux4, &device_param->kernel_preferred_wgs_multiple_aux4) == -1) return -1;
       }
+    }
 
-      // MP start
+    // MP start
 
-      if (user_options->slow_candidates == true)
-      {
-      }
-      else
+    if (user_options->slow_candidates == true)
+    {
+    }
+    else
+    {
+      if (user_options->attack_mode == ATTACK_MODE_BF)
       {
-        if (user_options->attack_mode == ATTACK_MODE_BF)
-        {
-          // mp_l
+        // mp_l
 
-          if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program_mp, "l_markov", &device_param->opencl_kernel_mp_l) == -1) return -1;
+        if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program_mp, "l_markov", &device_param->opencl_kernel_mp_l) == -1) return -1;
 
-          if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel_mp_l, &device_param->kernel_wgs_mp_l) == -1) return -1;
+        if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel_mp_l, &device_param->kernel_wgs_mp_l) == -1) return -1;
 
-          if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_mp_l, &device_param->kernel_local_mem_size_mp_l) == -1) return -1;
+        if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_mp_l, &device_param->kernel_local_mem_size_mp_l) == -1) return -1;
 
-          if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_mp_l, &device_param->kernel_dynamic_local_mem_size_mp_l) == -1) return -1;
+        if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_mp_l, &device_param->kernel_dynamic_local_mem_size_mp_l) == -1) return -1;
 
-          if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel_mp_l, &device_param->kernel_preferred_wgs_multiple_mp_l) == -1) return -1;
+        if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel_mp_l, &device_param->kernel_preferred_wgs_multiple_mp_l) == -1) return -1;
 
-          // mp_r
+        // mp_r
 
-          if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program_mp, "r_markov", &device_param->opencl_kernel_mp_r) == -1) return -1;
+        if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program_mp, "r_markov", &device_param->opencl_kernel_mp_r) == -1) return -1;
 
-          if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel_mp_r, &device_param->kernel_wgs_mp_r) == -1) return -1;
+        if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel_mp_r, &device_param->kernel_wgs_mp_r) == -1) return -1;
 
-          if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_mp_r, &device_param->kernel_local_mem_size_mp_r) == -1) return -1;
+        if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_mp_r, &device_param->kernel_local_mem_size_mp_r) == -1) return -1;
 
-          if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_mp_r, &device_param->kernel_dynamic_local_mem_size_mp_r) == -1) return -1;
+        if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_mp_r, &device_param->kernel_dynamic_local_mem_size_mp_r) == -1) return -1;
 
-          if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel_mp_r, &device_param->kernel_preferred_wgs_multiple_mp_r) == -1) return -1;
+        if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel_mp_r, &device_param->kernel_preferred_wgs_multiple_mp_r) == -1) return -1;
 
-          if (user_options->attack_mode == ATTACK_MODE_BF)
+        if (user_options->attack_mode == ATTACK_MODE_BF)
+        {
+          if (hashconfig->opts_type & OPTS_TYPE_TM_KERNEL)
           {
-            if (hashconfig->opts_type & OPTS_TYPE_TM_KERNEL)
-            {
-              if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_tm, 0, sizeof (cl_mem), device_param->kernel_params_tm[0]) == -1) return -1;
-              if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_tm, 1, sizeof (cl_mem), device_param->kernel_params_tm[1]) == -1) return -1;
-            }
+            if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_tm, 0, sizeof (cl_mem), device_param->kernel_params_tm[0]) == -1) return -1;
+            if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_tm, 1, sizeof (cl_mem), device_param->kernel_params_tm[1]) == -1) return -1;
           }
         }
-        else if (user_options->attack_mode == ATTACK_MODE_HYBRID1)
-        {
-          if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program_mp, "C_markov", &device_param->opencl_kernel_mp) == -1) return -1;
+      }
+      else if (user_options->attack_mode == ATTACK_MODE_HYBRID1)
+      {
+        if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program_mp, "C_markov", &device_param->opencl_kernel_mp) == -1) return -1;
 
-          if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel_mp, &device_param->kernel_wgs_mp) == -1) return -1;
+        if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel_mp, &device_param->kernel_wgs_mp) == -1) return -1;
 
-          if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_mp, &device_param->kernel_local_mem_size_mp) == -1) return -1;
+        if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_mp, &device_param->kernel_local_mem_size_mp) == -1) return -1;
 
-          if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_mp, &device_param->kernel_dynamic_local_mem_size_mp) == -1) return -1;
+        if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_mp, &device_param->kernel_dynamic_local_mem_size_mp) == -1) return -1;
 
-          if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel_mp, &device_param->kernel_preferred_wgs_multiple_mp) == -1) return -1;
-        }
-        else if (user_options->attack_mode == ATTACK_MODE_HYBRID2)
-        {
-          if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program_mp, "C_markov", &device_param->opencl_kernel_mp) == -1) return -1;
+        if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel_mp, &device_param->kernel_preferred_wgs_multiple_mp) == -1) return -1;
+      }
+      else if (user_options->attack_mode == ATTACK_MODE_HYBRID2)
+      {
+        if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program_mp, "C_markov", &device_param->opencl_kernel_mp) == -1) return -1;
 
-          if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel_mp, &device_param->kernel_wgs_mp) == -1) return -1;
+        if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel_mp, &device_param->kernel_wgs_mp) == -1) return -1;
 
-          if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_mp, &device_param->kernel_local_mem_size_mp) == -1) return -1;
+        if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_mp, &device_param->kernel_local_mem_size_mp) == -1) return -1;
 
-          if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_mp, &device_param->kernel_dynamic_local_mem_size_mp) == -1) return -1;
+        if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_mp, &device_param->kernel_dynamic_local_mem_size_mp) == -1) return -1;
 
-          if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel_mp, &device_param->kernel_preferred_wgs_multiple_mp) == -1) return -1;
-        }
+        if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel_mp, &device_param->kernel_preferred_wgs_multiple_mp) == -1) return -1;
       }
+    }
 
-      if (user_options->slow_candidates == true)
+    if (user_options->slow_candidates == true)
+    {
+    }
+    else
+    {
+      if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
       {
+        // nothing to do
       }
       else
       {
-        if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-        {
-          // nothing to do
-        }
-        else
-        {
-          if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program_amp, "amp", &device_param->opencl_kernel_amp) == -1) return -1;
+        if (hc_clCreateKernel (hashcat_ctx, device_param->opencl_program_amp, "amp", &device_param->opencl_kernel_amp) == -1) return -1;
 
-          if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel_amp, &device_param->kernel_wgs_amp) == -1) return -1;
+        if (get_opencl_kernel_wgs (hashcat_ctx, device_param, device_param->opencl_kernel_amp, &device_param->kernel_wgs_amp) == -1) return -1;
 
-          if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_amp, &device_param->kernel_local_mem_size_amp) == -1) return -1;
+        if (get_opencl_kernel_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_amp, &device_param->kernel_local_mem_size_amp) == -1) return -1;
 
-          if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_amp, &device_param->kernel_dynamic_local_mem_size_amp) == -1) return -1;
+        if (get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx, device_param, device_param->opencl_kernel_amp, &device_param->kernel_dynamic_local_mem_size_amp) == -1) return -1;
 
-          if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel_amp, &device_param->kernel_preferred_wgs_multiple_amp) == -1) return -1;
-        }
+        if (get_opencl_kernel_preferred_wgs_multiple (hashcat_ctx, device_param, device_param->opencl_kernel_amp, &device_param->kernel_preferred_wgs_multiple_amp) == -1) return -1;
+      }
 
-        if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+      if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+      {
+        // nothing to do
+      }
+      else
+      {
+        for (u32 i = 0; i < 5; i++)
         {
-          // nothing to do
+          if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, i, sizeof (cl_mem), device_param->kernel_params_amp[i]) == -1) return -1;
         }
-        else
-        {
-          for (u32 i = 0; i < 5; i++)
-          {
-            if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, i, sizeof (cl_mem), device_param->kernel_params_amp[i]) == -1) return -1;
-          }
 
-          for (u32 i = 5; i < 6; i++)
-          {
-            if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, i, sizeof (cl_uint), device_param->kernel_params_amp[i]) == -1) return -1;
-          }
+        for (u32 i = 5; i < 6; i++)
+        {
+          if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, i, sizeof (cl_uint), device_param->kernel_params_amp[i]) == -1) return -1;
+        }
 
-          for (u32 i = 6; i < 7; i++)
-          {
-            if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, i, sizeof (cl_ulong), device_param->kernel_params_amp[i]) == -1) return -1;
-          }
+        for (u32 i = 6; i < 7; i++)
+        {
+          if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, i, sizeof (cl_ulong), device_param->kernel_params_amp[i]) == -1) return -1;
         }
       }
+    }
 
-      // zero some data buffers
+    // zero some data buffers
 
-      if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_plain_bufs,    device_param->size_plains)   == -1) return -1;
-      if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_digests_shown, device_param->size_shown)    == -1) return -1;
-      if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_result,        device_param->size_results)  == -1) return -1;
+    if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_plain_bufs,    device_param->size_plains)   == -1) return -1;
+    if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_digests_shown, device_param->size_shown)    == -1) return -1;
+    if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_result,        device_param->size_results)  == -1) return -1;
 
-      /**
-       * special buffers
-       */
+    /**
+     * special buffers
+     */
 
-      if (user_options->slow_candidates == true)
+    if (user_options->slow_candidates == true)
+    {
+      if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_rules_c, size_rules_c) == -1) return -1;
+    }
+    else
+    {
+      if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
       {
         if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_rules_c, size_rules_c) == -1) return -1;
       }
-      else
+      else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
       {
-        if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
-        {
-          if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_rules_c, size_rules_c) == -1) return -1;
-        }
-        else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
+        if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_combs,          size_combs)      == -1) return -1;
+        if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_combs_c,        size_combs)      == -1) return -1;
+        if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_root_css_buf,   size_root_css)   == -1) return -1;
+        if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_markov_css_buf, size_markov_css) == -1) return -1;
+      }
+      else if (user_options_extra->attack_kern == ATTACK_KERN_BF)
+      {
+        if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_bfs,            size_bfs)        == -1) return -1;
+        if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_bfs_c,          size_bfs)        == -1) return -1;
+        if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_tm_c,           size_tm)         == -1) return -1;
+        if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_root_css_buf,   size_root_css)   == -1) return -1;
+        if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_markov_css_buf, size_markov_css) == -1) return -1;
+      }
+    }
+
+    if (user_options->slow_candidates == true)
+    {
+    }
+    else
+    {
+      if ((user_options->attack_mode == ATTACK_MODE_HYBRID1) || (user_options->attack_mode == ATTACK_MODE_HYBRID2))
+      {
+        /**
+         * prepare mp
+         */
+
+        if (user_options->attack_mode == ATTACK_MODE_HYBRID1)
         {
-          if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_combs,          size_combs)      == -1) return -1;
-          if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_combs_c,        size_combs)      == -1) return -1;
-          if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_root_css_buf,   size_root_css)   == -1) return -1;
-          if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_markov_css_buf, size_markov_css) == -1) return -1;
+          device_param->kernel_params_mp_buf32[5] = 0;
+          device_param->kernel_params_mp_buf32[6] = 0;
+          device_param->kernel_params_mp_buf32[7] = 0;
+
+          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD01)     device_param->kernel_params_mp_buf32[5] = full01;
+          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD06)     device_param->kernel_params_mp_buf32[5] = full06;
+          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD80)     device_param->kernel_params_mp_buf32[5] = full80;
+          if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS14) device_param->kernel_params_mp_buf32[6] = 1;
+          if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS15) device_param->kernel_params_mp_buf32[7] = 1;
         }
-        else if (user_options_extra->attack_kern == ATTACK_KERN_BF)
+        else if (user_options->attack_mode == ATTACK_MODE_HYBRID2)
         {
-          if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_bfs,            size_bfs)        == -1) return -1;
-          if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_bfs_c,          size_bfs)        == -1) return -1;
-          if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_tm_c,           size_tm)         == -1) return -1;
-          if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_root_css_buf,   size_root_css)   == -1) return -1;
-          if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_markov_css_buf, size_markov_css) == -1) return -1;
+          device_param->kernel_params_mp_buf32[5] = 0;
+          device_param->kernel_params_mp_buf32[6] = 0;
+          device_param->kernel_params_mp_buf32[7] = 0;
         }
+
+        for (u32 i = 0; i < 3; i++) { if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp, i, sizeof (cl_mem), device_param->kernel_params_mp[i]) == -1) return -1; }
+      }
+      else if (user_options->attack_mode == ATTACK_MODE_BF)
+      {
+        /**
+         * prepare mp_r and mp_l
+         */
+
+        device_param->kernel_params_mp_l_buf32[6] = 0;
+        device_param->kernel_params_mp_l_buf32[7] = 0;
+        device_param->kernel_params_mp_l_buf32[8] = 0;
+
+        if (hashconfig->opts_type & OPTS_TYPE_PT_ADD01)     device_param->kernel_params_mp_l_buf32[6] = full01;
+        if (hashconfig->opts_type & OPTS_TYPE_PT_ADD06)     device_param->kernel_params_mp_l_buf32[6] = full06;
+        if (hashconfig->opts_type & OPTS_TYPE_PT_ADD80)     device_param->kernel_params_mp_l_buf32[6] = full80;
+        if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS14) device_param->kernel_params_mp_l_buf32[7] = 1;
+        if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS15) device_param->kernel_params_mp_l_buf32[8] = 1;
+
+        for (u32 i = 0; i < 3; i++) { if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp_l, i, sizeof (cl_mem), device_param->kernel_params_mp_l[i]) == -1) return -1; }
+        for (u32 i = 0; i < 3; i++) { if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp_r, i, sizeof (cl_mem), device_param->kernel_params_mp_r[i]) == -1) return -1; }
       }
+    }
+  }
 
-      if (user_options->slow_candidates == true)
+  // this is required because inside the kernels there is this:
+  // __local pw_t s_pws[64];
+
+  if (user_options->attack_mode == ATTACK_MODE_STRAIGHT)
+  {
+    if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+    {
+      if (hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL)
       {
+        // not required
       }
       else
       {
-        if ((user_options->attack_mode == ATTACK_MODE_HYBRID1) || (user_options->attack_mode == ATTACK_MODE_HYBRID2))
-        {
-          /**
-           * prepare mp
-           */
+        device_param->kernel_threads_max = MIN (device_param->kernel_threads_max, 64);
+      }
+    }
+  }
 
-          if (user_options->attack_mode == ATTACK_MODE_HYBRID1)
-          {
-            device_param->kernel_params_mp_buf32[5] = 0;
-            device_param->kernel_params_mp_buf32[6] = 0;
-            device_param->kernel_params_mp_buf32[7] = 0;
-
-            if (hashconfig->opts_type & OPTS_TYPE_PT_ADD01)     device_param->kernel_params_mp_buf32[5] = full01;
-            if (hashconfig->opts_type & OPTS_TYPE_PT_ADD06)     device_param->kernel_params_mp_buf32[5] = full06;
-            if (hashconfig->opts_type & OPTS_TYPE_PT_ADD80)     device_param->kernel_params_mp_buf32[5] = full80;
-            if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS14) device_param->kernel_params_mp_buf32[6] = 1;
-            if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS15) device_param->kernel_params_mp_buf32[7] = 1;
-          }
-          else if (user_options->attack_mode == ATTACK_MODE_HYBRID2)
-          {
-            device_param->kernel_params_mp_buf32[5] = 0;
-            device_param->kernel_params_mp_buf32[6] = 0;
-            device_param->kernel_params_mp_buf32[7] = 0;
-          }
+  /**
+   * now everything that depends on threads and accel, basically dynamic workload
+   */
 
-          for (u32 i = 0; i < 3; i++) { if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp, i, sizeof (cl_mem), device_param->kernel_params_mp[i]) == -1) return -1; }
-        }
-        else if (user_options->attack_mode == ATTACK_MODE_BF)
-        {
-          /**
-           * prepare mp_r and mp_l
-           */
+  const u32 kernel_threads = get_kernel_threads (device_param);
+
+  device_param->kernel_threads = kernel_threads;
+
+  device_param->hardware_power = device_processors * kernel_threads;
+
+  u32 kernel_accel_min = device_param->kernel_accel_min;
+  u32 kernel_accel_max = device_param->kernel_accel_max;
+
+  /**
+   * We need a kernel accel limiter otherwise we will allocate too much memory (Example 4* GTX1080):
+   * 4 (gpus) * 260 (sizeof pw_t) * 3 (pws, pws_comp, pw_pre) * 20 (MCU) * 1024 (threads) * 1024 (accel) = 65,431,142,400 bytes RAM!!
+   */
+
+  const u32 accel_limit = CEILDIV ((64 * 1024), kernel_threads); // this should result in less than 4GB per GPU, but allow higher accel in case user reduces the threads manually using -T
+
+  kernel_accel_max = MIN (kernel_accel_max, accel_limit);
+
+  if (kernel_accel_min > kernel_accel_max)
+  {
+    event_log_error (hashcat_ctx, "* Device #%u: Too many compute units to keep minimum kernel accel limit. Retry with lower --backend-kernel-threads value.", device_id + 1);
+
+    return -1;
+  }
 
-          device_param->kernel_params_mp_l_buf32[6] = 0;
-          device_param->kernel_params_mp_l_buf32[7] = 0;
-          device_param->kernel_params_mp_l_buf32[8] = 0;
+  // find out if we would request too much memory on memory blocks which are based on kernel_accel
+
+  u64 size_pws      = 4;
+  u64 size_pws_amp  = 4;
+  u64 size_pws_comp = 4;
+  u64 size_pws_idx  = 4;
+  u64 size_pws_prefetch = 0;
+  u64 size_pws_pre  = 4;
+  u64 size_pws_base = 4;
+  u64 size_tmps     = 4;
+  u64 size_hooks    = 4;
+  #ifdef WITH_BRAIN
+  u64 size_brain_link_in  = 4;
+  u64 size_brain_link_out = 4;
+  #endif
 
-          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD01)     device_param->kernel_params_mp_l_buf32[6] = full01;
-          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD06)     device_param->kernel_params_mp_l_buf32[6] = full06;
-          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD80)     device_param->kernel_params_mp_l_buf32[6] = full80;
-          if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS14) device_param->kernel_params_mp_l_buf32[7] = 1;
-          if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS15) device_param->kernel_params_mp_l_buf32[8] = 1;
+  // instead of a thread limit we can also use a memory limit.
+  // this value should represent a reasonable amount of memory a host system has per GPU.
+  // note we're allocating 3 blocks of that size.
 
-          for (u32 i = 0; i < 3; i++) { if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp_l, i, sizeof (cl_mem), device_param->kernel_params_mp_l[i]) == -1) return -1; }
-          for (u32 i = 0; i < 3; i++) { if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp_r, i, sizeof (cl_mem), device_param->kernel_params_mp_r[i]) == -1) return -1; }
-        }
-      }
-    }
+  const u64 PWS_SPACE = 1024ULL * 1024ULL * 1024ULL;
 
-    // this is required because inside the kernels there is this:
-    // __local pw_t s_pws[64];
+  // sometimes device_available_mem and device_maxmem_alloc reported back from the opencl runtime are a bit inaccurate.
+  // let's add some extra space just to be sure.
 
-    if (user_options->attack_mode == ATTACK_MODE_STRAIGHT)
-    {
-      if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-      {
-        if (hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL)
-        {
-          // not required
-        }
-        else
-        {
-          device_param->kernel_threads_max = MIN (device_param->kernel_threads_max, 64);
-        }
-      }
-    }
+  const u64 EXTRA_SPACE = 64ULL * 1024ULL * 1024ULL;
 
-    /**
-     * now everything that depends on threads and accel, basically dynamic workload
-     */
+  while (kernel_accel_max >= kernel_accel_min)
+  {
+    const u64 kernel_power_max = device_param->hardware_power * kernel_accel_max;
 
-    const u32 kernel_threads = get_kernel_threads (device_param);
+    // size_pws
 
-    device_param->kernel_threads = kernel_threads;
+    size_pws = kernel_power_max * sizeof (pw_t);
 
-    device_param->hardware_power = device_processors * kernel_threads;
+    size_pws_amp = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL) ? 1 : size_pws;
 
-    u32 kernel_accel_min = device_param->kernel_accel_min;
-    u32 kernel_accel_max = device_param->kernel_accel_max;
+    // size_pws_comp
 
-    /**
-     * We need a kernel accel limiter otherwise we will allocate too much memory (Example 4* GTX1080):
-     * 4 (gpus) * 260 (sizeof pw_t) * 3 (pws, pws_comp, pw_pre) * 20 (MCU) * 1024 (threads) * 1024 (accel) = 65,431,142,400 bytes RAM!!
-     */
+    size_pws_comp = kernel_power_max * (sizeof (u32) * 64);
 
-    const u32 accel_limit = CEILDIV ((64 * 1024), kernel_threads); // this should result in less than 4GB per GPU, but allow higher accel in case user reduces the threads manually using -T
+    // size_pws_idx
 
-    kernel_accel_max = MIN (kernel_accel_max, accel_limit);
+    size_pws_idx = (u64) (kernel_power_max + 1) * sizeof (pw_idx_t);
 
-    if (kernel_accel_min > kernel_accel_max)
-    {
-      event_log_error (hashcat_ctx, "* Device #%u: Too many compute units to keep minimum kernel accel limit. Retry with lower --backend-kernel-threads value.", device_id + 1);
+    // size_pws_prefetch, the second pws_comp_buf and pws_idx slot
 
-      return -1;
+    if (device_param->pws_prefetch == true)
+    {
+      size_pws_prefetch = size_pws_comp + size_pws_idx;
     }
 
-    // find out if we would request too much memory on memory blocks which are based on kernel_accel
+    // size_tmps
 
-    u64 size_pws      = 4;
-    u64 size_pws_amp  = 4;
-    u64 size_pws_comp = 4;
-    u64 size_pws_idx  = 4;
-    u64 size_pws_pre  = 4;
-    u64 size_pws_base = 4;
-    u64 size_tmps     = 4;
-    u64 size_hooks    = 4;
-    #ifdef WITH_BRAIN
-    u64 size_brain_link_in  = 4;
-    u64 size_brain_link_out = 4;
-    #endif
+    size_tmps = kernel_power_max * (hashconfig->tmp_size + hashconfig->extra_tmp_size);
 
-    // instead of a thread limit we can also use a memory limit.
-    // this value should represent a reasonable amount of memory a host system has per GPU.
-    // note we're allocating 3 blocks of that size.
+    // size_hooks
 
-    const u64 PWS_SPACE = 1024ULL * 1024ULL * 1024ULL;
+    size_hooks = kernel_power_max * hashconfig->hook_size;
 
-    // sometimes device_available_mem and device_maxmem_alloc reported back from the opencl runtime are a bit inaccurate.
-    // let's add some extra space just to be sure.
+    #ifdef WITH_BRAIN
+    // size_brains
 
-    const u64 EXTRA_SPACE = 64ULL * 1024ULL * 1024ULL;
+    size_brain_link_in  = kernel_power_max * 1;
+    size_brain_link_out = kernel_power_max * 8;
+    #endif
 
-    while (kernel_accel_max >= kernel_accel_min)
+    if (user_options->slow_candidates == true)
     {
-      const u64 kernel_power_max = device_param->hardware_power * kernel_accel_max;
+      // size_pws_pre
 
-      // size_pws
+      size_pws_pre = kernel_power_max * sizeof (pw_pre_t);
 
-      size_pws = kernel_power_max * sizeof (pw_t);
+      // size_pws_base
 
-      size_pws_amp = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL) ? 1 : size_pws;
+      size_pws_base = kernel_power_max * sizeof (pw_pre_t);
+    }
 
-      // size_pws_comp
+    // now check if all device-memory sizes which depend on the kernel_accel_max amplifier are within its boundaries
+    // if not, decrease amplifier and try again
 
-      size_pws_comp = kernel_power_max * (sizeof (u32) * 64);
+    int memory_limit_hit = 0;
 
-      // size_pws_idx
+    if (size_pws > PWS_SPACE) memory_limit_hit = 1;
 
-      size_pws_idx = (u64) (kernel_power_max + 1) * sizeof (pw_idx_t);
+    if ((size_pws   + EXTRA_SPACE) > device_param->device_maxmem_alloc) memory_limit_hit = 1;
+    if ((size_tmps  + EXTRA_SPACE) > device_param->device_maxmem_alloc) memory_limit_hit = 1;
+    if ((size_hooks + EXTRA_SPACE) > device_param->device_maxmem_alloc) memory_limit_hit = 1;
 
-      // size_tmps
+    const u64 size_total
+      = bitmap_ctx->bitmap_size
+      + bitmap_ctx->bitmap_size
+      + bitmap_ctx->bitmap_size
+      + bitmap_ctx->bitmap_size
+      + bitmap_ctx->bitmap_size
+      + bitmap_ctx->bitmap_size
+      + bitmap_ctx->bitmap_size
+      + bitmap_ctx->bitmap_size
+      + size_bfs
+      + size_combs
+      + size_digests
+      + size_esalts
+      + size_hooks
+      + size_markov_css
+      + size_plains
+      + size_pws
+      + size_pws_amp
+      + size_pws_comp
+      + size_pws_idx
+      + size_pws_prefetch
+      + size_results
+      + size_root_css
+      + size_rules
+      + size_rules_c
+      + size_salts
+      + size_extra_buffer
+      + size_shown
+      + size_tm
+      + size_tmps
+      + size_st_digests
+      + size_st_salts
+      + size_st_esalts;
 
-      size_tmps = kernel_power_max * (hashconfig->tmp_size + hashconfig->extra_tmp_size);
+    if ((size_total + EXTRA_SPACE) > device_param->device_available_mem) memory_limit_hit = 1;
 
-      // size_hooks
+    if (memory_limit_hit == 1)
+    {
+      kernel_accel_max--;
 
-      size_hooks = kernel_power_max * hashconfig->hook_size;
+      continue;
+    }
 
+    const u64 size_total_host
+      = size_pws_comp
+      + size_pws_idx
+      + size_pws_prefetch
+      + size_hooks
       #ifdef WITH_BRAIN
-      // size_brains
-
-      size_brain_link_in  = kernel_power_max * 1;
-      size_brain_link_out = kernel_power_max * 8;
+      + size_brain_link_in
+      + size_brain_link_out
       #endif
+      + size_pws_pre
+      + size_pws_base;
 
-      if (user_options->slow_candidates == true)
-      {
-        // size_pws_pre
-
-        size_pws_pre = kernel_power_max * sizeof (pw_pre_t);
-
-        // size_pws_base
-
-        size_pws_base = kernel_power_max * sizeof (pw_pre_t);
-      }
-
-      // now check if all device-memory sizes which depend on the kernel_accel_max amplifier are within its boundaries
-      // if not, decrease amplifier and try again
-
-      int memory_limit_hit = 0;
-
-      if (size_pws > PWS_SPACE) memory_limit_hit = 1;
-
-      if ((size_pws   + EXTRA_SPACE) > device_param->device_maxmem_alloc) memory_limit_hit = 1;
-      if ((size_tmps  + EXTRA_SPACE) > device_param->device_maxmem_alloc) memory_limit_hit = 1;
-      if ((size_hooks + EXTRA_SPACE) > device_param->device_maxmem_alloc) memory_limit_hit = 1;
-
-      const u64 size_total
-        = bitmap_ctx->bitmap_size
-        + bitmap_ctx->bitmap_size
-        + bitmap_ctx->bitmap_size
-        + bitmap_ctx->bitmap_size
-        + bitmap_ctx->bitmap_size
-        + bitmap_ctx->bitmap_size
-        + bitmap_ctx->bitmap_size
-        + bitmap_ctx->bitmap_size
-        + size_bfs
-        + size_combs
-        + size_digests
-        + size_esalts
-        + size_hooks
-        + size_markov_css
-        + size_plains
-        + size_pws
-        + size_pws_amp
-        + size_pws_comp
-        + size_pws_idx
-        + size_results
-        + size_root_css
-        + size_rules
-        + size_rules_c
-        + size_salts
-        + size_extra_buffer
-        + size_shown
-        + size_tm
-        + size_tmps
-        + size_st_digests
-        + size_st_salts
-        + size_st_esalts;
-
-      if ((size_total + EXTRA_SPACE) > device_param->device_available_mem) memory_limit_hit = 1;
-
-      if (memory_limit_hit == 1)
-      {
-        kernel_accel_max--;
+    *size_total_host_all += size_total_host + EXTRA_SPACE;
 
-        continue;
-      }
+    break;
+  }
 
-      const u64 size_total_host
-        = size_pws_comp
-        + size_pws_idx
-        + size_hooks
-        #ifdef WITH_BRAIN
-        + size_brain_link_in
-        + size_brain_link_out
-        #endif
-        + size_pws_pre
-        + size_pws_base;
+  if (kernel_accel_max < kernel_accel_min)
+  {
+    event_log_error (hashcat_ctx, "* Device #%u: Not enough allocatable device memory for this attack.", device_id + 1);
+
+    return -1;
+  }
 
-      size_total_host_all += size_total_host + EXTRA_SPACE;
+  device_param->kernel_accel_min = kernel_accel_min;
+  device_param->kernel_accel_max = kernel_accel_max;
+
+  device_param->size_pws      = size_pws;
+  device_param->size_pws_amp  = size_pws_amp;
+  device_param->size_pws_comp = size_pws_comp;
+  device_param->size_pws_idx  = size_pws_idx;
+  device_param->size_pws_pre  = size_pws_pre;
+  device_param->size_pws_base = size_pws_base;
+  device_param->size_tmps     = size_tmps;
+  device_param->size_hooks    = size_hooks;
+  #ifdef WITH_BRAIN
+  device_param->size_brain_link_in  = size_brain_link_in;
+  device_param->size_brain_link_out = size_brain_link_out;
+  #endif
 
-      break;
-    }
+  if (device_param->is_cuda == true)
+  {
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_pws_buf,      size_pws)      == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_pws_amp_buf,  size_pws_amp)  == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_pws_comp_buf, size_pws_comp) == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_pws_idx,      size_pws_idx)  == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_tmps,         size_tmps)     == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_hooks,        size_hooks)    == -1) return -1;
 
-    if (kernel_accel_max < kernel_accel_min)
+    if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_pws_buf,       device_param->size_pws)      == -1) return -1;
+    if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_pws_amp_buf,   device_param->size_pws_amp)  == -1) return -1;
+    if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_pws_comp_buf,  device_param->size_pws_comp) == -1) return -1;
+    if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_pws_idx,       device_param->size_pws_idx)  == -1) return -1;
+    if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_tmps,          device_param->size_tmps)     == -1) return -1;
+    if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_hooks,         device_param->size_hooks)    == -1) return -1;
+
+    if (device_param->pws_prefetch == true)
     {
-      event_log_error (hashcat_ctx, "* Device #%u: Not enough allocatable device memory for this attack.", device_id + 1);
+      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_pws_prefetch_comp_buf, size_pws_comp) == -1) return -1;
+      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_pws_prefetch_idx,      size_pws_idx)  == -1) return -1;
 
-      return -1;
+      if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_pws_prefetch_comp_buf, device_param->size_pws_comp) == -1) return -1;
+      if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_pws_prefetch_idx,      device_param->size_pws_idx)  == -1) return -1;
     }
+  }
 
-    device_param->kernel_accel_min = kernel_accel_min;
-    device_param->kernel_accel_max = kernel_accel_max;
+  if (device_param->is_opencl == true)
+  {
+    if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_WRITE,  size_pws,      NULL, &device_param->opencl_d_pws_buf)      == -1) return -1;
+    if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_WRITE,  size_pws_amp,  NULL, &device_param->opencl_d_pws_amp_buf)  == -1) return -1;
+    if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY,   size_pws_comp, NULL, &device_param->opencl_d_pws_comp_buf) == -1) return -1;
+    if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY,   size_pws_idx,  NULL, &device_param->opencl_d_pws_idx)      == -1) return -1;
+    if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_WRITE,  size_tmps,     NULL, &device_param->opencl_d_tmps)         == -1) return -1;
+    if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_WRITE,  size_hooks,    NULL, &device_param->opencl_d_hooks)        == -1) return -1;
 
-    device_param->size_pws      = size_pws;
-    device_param->size_pws_amp  = size_pws_amp;
-    device_param->size_pws_comp = size_pws_comp;
-    device_param->size_pws_idx  = size_pws_idx;
-    device_param->size_pws_pre  = size_pws_pre;
-    device_param->size_pws_base = size_pws_base;
-    device_param->size_tmps     = size_tmps;
-    device_param->size_hooks    = size_hooks;
-    #ifdef WITH_BRAIN
-    device_param->size_brain_link_in  = size_brain_link_in;
-    device_param->size_brain_link_out = size_brain_link_out;
-    #endif
+    if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_pws_buf,       device_param->size_pws)      == -1) return -1;
+    if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_pws_amp_buf,   device_param->size_pws_amp)  == -1) return -1;
+    if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_pws_comp_buf,  device_param->size_pws_comp) == -1) return -1;
+    if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_pws_idx,       device_param->size_pws_idx)  == -1) return -1;
+    if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_tmps,          device_param->size_tmps)     == -1) return -1;
+    if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_hooks,         device_param->size_hooks)    == -1) return -1;
 
-    if (device_param->is_cuda == true)
+    if (device_param->pws_prefetch == true)
     {
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_pws_buf,      size_pws)      == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_pws_amp_buf,  size_pws_amp)  == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_pws_comp_buf, size_pws_comp) == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_pws_idx,      size_pws_idx)  == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_tmps,         size_tmps)     == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_hooks,        size_hooks)    == -1) return -1;
+      if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY, size_pws_comp, NULL, &device_param->opencl_d_pws_prefetch_comp_buf) == -1) return -1;
+      if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY, size_pws_idx,  NULL, &device_param->opencl_d_pws_prefetch_idx)      == -1) return -1;
 
-      if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_pws_buf,       device_param->size_pws)      == -1) return -1;
-      if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_pws_amp_buf,   device_param->size_pws_amp)  == -1) return -1;
-      if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_pws_comp_buf,  device_param->size_pws_comp) == -1) return -1;
-      if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_pws_idx,       device_param->size_pws_idx)  == -1) return -1;
-      if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_tmps,          device_param->size_tmps)     == -1) return -1;
-      if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_hooks,         device_param->size_hooks)    == -1) return -1;
+      if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_pws_prefetch_comp_buf, device_param->size_pws_comp) == -1) return -1;
+      if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_pws_prefetch_idx,      device_param->size_pws_idx)  == -1) return -1;
     }
+  }
 
-    if (device_param->is_opencl == true)
-    {
-      if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_WRITE,  size_pws,      NULL, &device_param->opencl_d_pws_buf)      == -1) return -1;
-      if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_WRITE,  size_pws_amp,  NULL, &device_param->opencl_d_pws_amp_buf)  == -1) return -1;
-      if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY,   size_pws_comp, NULL, &device_param->opencl_d_pws_comp_buf) == -1) return -1;
-      if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_ONLY,   size_pws_idx,  NULL, &device_param->opencl_d_pws_idx)      == -1) return -1;
-      if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_WRITE,  size_tmps,     NULL, &device_param->opencl_d_tmps)         == -1) return -1;
-      if (hc_clCreateBuffer (hashcat_ctx, device_param->opencl_context, CL_MEM_READ_WRITE,  size_hooks,    NULL, &device_param->opencl_d_hooks)        == -1) return -1;
-
-      if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_pws_buf,       device_param->size_pws)      == -1) return -1;
-      if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_pws_amp_buf,   device_param->size_pws_amp)  == -1) return -1;
-      if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_pws_comp_buf,  device_param->size_pws_comp) == -1) return -1;
-      if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_pws_idx,       device_param->size_pws_idx)  == -1) return -1;
-      if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_tmps,          device_param->size_tmps)     == -1) return -1;
-      if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_hooks,         device_param->size_hooks)    == -1) return -1;
-    }
+  /**
+   * main host data
+   */
 
-    /**
-     * main host data
-     */
+  host_buffers_alloc (hashcat_ctx, device_param);
 
-    u32 *pws_comp = (u32 *) hcmalloc (size_pws_comp);
+  if (hashconfig->opts_type & (OPTS_TYPE_HOOK12 | OPTS_TYPE_HOOK23))
+  {
+    hook_pool_init (hashcat_ctx, device_param);
+  }
 
-    device_param->pws_comp = pws_comp;
+  void *hooks_buf = hcmalloc (size_hooks);
 
-    pw_idx_t *pws_idx = (pw_idx_t *) hcmalloc (size_pws_idx);
+  device_param->hooks_buf = hooks_buf;
 
-    device_param->pws_idx = pws_idx;
+  char *scratch_buf = (char *) hcmalloc (HCBUFSIZ_LARGE);
 
-    pw_t *combs_buf = (pw_t *) hccalloc (KERNEL_COMBS, sizeof (pw_t));
+  device_param->scratch_buf = scratch_buf;
 
-    device_param->combs_buf = combs_buf;
+  #ifdef WITH_BRAIN
 
-    void *hooks_buf = hcmalloc (size_hooks);
+  u8 *brain_link_in_buf = (u8 *) hcmalloc (size_brain_link_in);
 
-    device_param->hooks_buf = hooks_buf;
+  device_param->brain_link_in_buf = brain_link_in_buf;
 
-    char *scratch_buf = (char *) hcmalloc (HCBUFSIZ_LARGE);
+  u32 *brain_link_out_buf = (u32 *) hcmalloc (size_brain_link_out);
 
-    device_param->scratch_buf = scratch_buf;
+  device_param->brain_link_out_buf = brain_link_out_buf;
+  #endif
 
-    #ifdef WITH_BRAIN
+  pw_pre_t *pws_pre_buf = (pw_pre_t *) hcmalloc (size_pws_pre);
 
-    u8 *brain_link_in_buf = (u8 *) hcmalloc (size_brain_link_in);
+  device_param->pws_pre_buf = pws_pre_buf;
 
-    device_param->brain_link_in_buf = brain_link_in_buf;
+  pw_pre_t *pws_base_buf = (pw_pre_t *) hcmalloc (size_pws_base);
 
-    u32 *brain_link_out_buf = (u32 *) hcmalloc (size_brain_link_out);
+  device_param->pws_base_buf = pws_base_buf;
 
-    device_param->brain_link_out_buf = brain_link_out_buf;
-    #endif
+  /**
+   * kernel args
+   */
 
-    pw_pre_t *pws_pre_buf = (pw_pre_t *) hcmalloc (size_pws_pre);
+  if (device_param->is_cuda == true)
+  {
+    device_param->kernel_params[ 0] = &device_param->cuda_d_pws_buf;
+    device_param->kernel_params[ 4] = &device_param->cuda_d_tmps;
+    device_param->kernel_params[ 5] = &device_param->cuda_d_hooks;
+  }
 
-    device_param->pws_pre_buf = pws_pre_buf;
+  if (device_param->is_opencl == true)
+  {
+    device_param->kernel_params[ 0] = &device_param->opencl_d_pws_buf;
+    device_param->kernel_params[ 4] = &device_param->opencl_d_tmps;
+    device_param->kernel_params[ 5] = &device_param->opencl_d_hooks;
+  }
 
-    pw_pre_t *pws_base_buf = (pw_pre_t *) hcmalloc (size_pws_base);
+  if (user_options->slow_candidates == true)
+  {
+  }
+  else
+  {
+    if (hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL)
+    {
+      // nothing to do
+    }
+    else
+    {
+      if (user_options->attack_mode == ATTACK_MODE_HYBRID2)
+      {
+        if (device_param->is_cuda == true)
+        {
+          device_param->kernel_params_mp[0] = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+                                            ? &device_param->cuda_d_pws_buf
+                                            : &device_param->cuda_d_pws_amp_buf;
 
-    device_param->pws_base_buf = pws_base_buf;
+          //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp, 0, sizeof (cl_mem), device_param->kernel_params_mp[0]); if (CL_rc == -1) return -1;
+        }
 
-    /**
-     * kernel args
-     */
+        if (device_param->is_opencl == true)
+        {
+          device_param->kernel_params_mp[0] = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+                                            ? &device_param->opencl_d_pws_buf
+                                            : &device_param->opencl_d_pws_amp_buf;
 
-    if (device_param->is_cuda == true)
-    {
-      device_param->kernel_params[ 0] = &device_param->cuda_d_pws_buf;
-      device_param->kernel_params[ 4] = &device_param->cuda_d_tmps;
-      device_param->kernel_params[ 5] = &device_param->cuda_d_hooks;
+          if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp, 0, sizeof (cl_mem), device_param->kernel_params_mp[0]) == -1) return -1;
+        }
+      }
     }
 
-    if (device_param->is_opencl == true)
+    if (user_options->attack_mode == ATTACK_MODE_BF)
     {
-      device_param->kernel_params[ 0] = &device_param->opencl_d_pws_buf;
-      device_param->kernel_params[ 4] = &device_param->opencl_d_tmps;
-      device_param->kernel_params[ 5] = &device_param->opencl_d_hooks;
+      if (device_param->is_cuda == true)
+      {
+        device_param->kernel_params_mp_l[0] = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+                                            ? &device_param->cuda_d_pws_buf
+                                            : &device_param->cuda_d_pws_amp_buf;
+
+        //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp_l, 0, sizeof (cl_mem), device_param->kernel_params_mp_l[0]); if (CL_rc == -1) return -1;
+      }
+
+      if (device_param->is_opencl == true)
+      {
+        device_param->kernel_params_mp_l[0] = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+                                            ? &device_param->opencl_d_pws_buf
+                                            : &device_param->opencl_d_pws_amp_buf;
+
+        if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp_l, 0, sizeof (cl_mem), device_param->kernel_params_mp_l[0]) == -1) return -1;
+      }
     }
 
-    if (user_options->slow_candidates == true)
+    if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
     {
+      // nothing to do
     }
     else
     {
-      if (hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL)
+      if (device_param->is_cuda == true)
       {
-        // nothing to do
+        device_param->kernel_params_amp[0] = &device_param->cuda_d_pws_buf;
+        device_param->kernel_params_amp[1] = &device_param->cuda_d_pws_amp_buf;
+
+        //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, 0, sizeof (cl_mem), device_param->kernel_params_amp[0]); if (CL_rc == -1) return -1;
+        //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, 1, sizeof (cl_mem), device_param->kernel_params_amp[1]); if (CL_rc == -1) return -1;
       }
-      else
+
+      if (device_param->is_opencl == true)
       {
-        if (user_options->attack_mode == ATTACK_MODE_HYBRID2)
-        {
-          if (device_param->is_cuda == true)
-          {
-            device_param->kernel_params_mp[0] = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+        device_param->kernel_params_amp[0] = &device_param->opencl_d_pws_buf;
+        device_param->kernel_params_amp[1] = &device_param->opencl_d_pws_amp_buf;
+
+        if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, 0, sizeof (cl_mem), device_param->kernel_params_amp[0]) == -1) return -1;
+        if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, 1, sizeof (cl_mem), device_param->kernel_params_amp[1]) == -1) return -1;
+      }
+    }
+  }
+
+  if (device_param->is_cuda == true)
+  {
+    device_param->kernel_params_decompress[0] = &device_param->cuda_d_pws_idx;
+    device_param->kernel_params_decompress[1] = &device_param->cuda_d_pws_comp_buf;
+    device_param->kernel_params_decompress[2] = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
                                               ? &device_param->cuda_d_pws_buf
                                               : &device_param->cuda_d_pws_amp_buf;
 
-            //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp, 0, sizeof (cl_mem), device_param->kernel_params_mp[0]); if (CL_rc == -1) return -1;
-          }
+    //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 0, sizeof (cl_mem), device_param->kernel_params_decompress[0]); if (CL_rc == -1) return -1;
+    //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 1, sizeof (cl_mem), device_param->kernel_params_decompress[1]); if (CL_rc == -1) return -1;
+    //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 2, sizeof (cl_mem), device_param->kernel_params_decompress[2]); if (CL_rc == -1) return -1;
+  }
 
-          if (device_param->is_opencl == true)
-          {
-            device_param->kernel_params_mp[0] = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+  if (device_param->is_opencl == true)
+  {
+    device_param->kernel_params_decompress[0] = &device_param->opencl_d_pws_idx;
+    device_param->kernel_params_decompress[1] = &device_param->opencl_d_pws_comp_buf;
+    device_param->kernel_params_decompress[2] = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
                                               ? &device_param->opencl_d_pws_buf
                                               : &device_param->opencl_d_pws_amp_buf;
 
-            if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp, 0, sizeof (cl_mem), device_param->kernel_params_mp[0]) == -1) return -1;
-          }
-        }
-      }
+    if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 0, sizeof (cl_mem), device_param->kernel_params_decompress[0]) == -1) return -1;
+    if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 1, sizeof (cl_mem), device_param->kernel_params_decompress[1]) == -1) return -1;
+    if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 2, sizeof (cl_mem), device_param->kernel_params_decompress[2]) == -1) return -1;
+  }
 
-      if (user_options->attack_mode == ATTACK_MODE_BF)
-      {
-        if (device_param->is_cuda == true)
-        {
-          device_param->kernel_params_mp_l[0] = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-                                              ? &device_param->cuda_d_pws_buf
-                                              : &device_param->cuda_d_pws_amp_buf;
+  return 0;
+}
 
-          //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp_l, 0, sizeof (cl_mem), device_param->kernel_params_mp_l[0]); if (CL_rc == -1) return -1;
-        }
+static HC_API_CALL void *backend_session_begin_thread (void *p)
+{
+  backend_session_param_t *backend_session_param = (backend_session_param_t *) p;
 
-        if (device_param->is_opencl == true)
-        {
-          device_param->kernel_params_mp_l[0] = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-                                              ? &device_param->opencl_d_pws_buf
-                                              : &device_param->opencl_d_pws_amp_buf;
+  backend_session_param->rc = backend_session_begin_device (backend_session_param->hashcat_ctx, backend_session_param->backend_devices_idx, &backend_session_param->size_total_host);
 
-          if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp_l, 0, sizeof (cl_mem), device_param->kernel_params_mp_l[0]) == -1) return -1;
-        }
-      }
+  return NULL;
+}
 
-      if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-      {
-        // nothing to do
-      }
-      else
-      {
-        if (device_param->is_cuda == true)
-        {
-          device_param->kernel_params_amp[0] = &device_param->cuda_d_pws_buf;
-          device_param->kernel_params_amp[1] = &device_param->cuda_d_pws_amp_buf;
+int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
+{
+  backend_ctx_t        *backend_ctx         = hashcat_ctx->backend_ctx;
+  const user_options_t *user_options        = hashcat_ctx->user_options;
 
-          //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, 0, sizeof (cl_mem), device_param->kernel_params_amp[0]); if (CL_rc == -1) return -1;
-          //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, 1, sizeof (cl_mem), device_param->kernel_params_amp[1]); if (CL_rc == -1) return -1;
-        }
+  if (backend_ctx->enabled == false) return 0;
 
-        if (device_param->is_opencl == true)
-        {
-          device_param->kernel_params_amp[0] = &device_param->opencl_d_pws_buf;
-          device_param->kernel_params_amp[1] = &device_param->opencl_d_pws_amp_buf;
+  // each device creates its context, builds or loads its kernels and allocates its buffers in its own thread,
+  // so a cold kernel cache costs one JIT build instead of one per device
 
-          if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, 0, sizeof (cl_mem), device_param->kernel_params_amp[0]) == -1) return -1;
-          if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, 1, sizeof (cl_mem), device_param->kernel_params_amp[1]) == -1) return -1;
-        }
-      }
-    }
+  const int backend_devices_cnt = backend_ctx->backend_devices_cnt;
 
-    if (device_param->is_cuda == true)
-    {
-      device_param->kernel_params_decompress[0] = &device_param->cuda_d_pws_idx;
-      device_param->kernel_params_decompress[1] = &device_param->cuda_d_pws_comp_buf;
-      device_param->kernel_params_decompress[2] = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-                                                ? &device_param->cuda_d_pws_buf
-                                                : &device_param->cuda_d_pws_amp_buf;
+  backend_session_param_t *backend_session_params = (backend_session_param_t *) hccalloc (backend_devices_cnt, sizeof (backend_session_param_t));
 
-      //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 0, sizeof (cl_mem), device_param->kernel_params_decompress[0]); if (CL_rc == -1) return -1;
-      //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 1, sizeof (cl_mem), device_param->kernel_params_decompress[1]); if (CL_rc == -1) return -1;
-      //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 2, sizeof (cl_mem), device_param->kernel_params_decompress[2]); if (CL_rc == -1) return -1;
-    }
+  hc_thread_t *c_threads = (hc_thread_t *) hccalloc (backend_devices_cnt, sizeof (hc_thread_t));
 
-    if (device_param->is_opencl == true)
-    {
-      device_param->kernel_params_decompress[0] = &device_param->opencl_d_pws_idx;
-      device_param->kernel_params_decompress[1] = &device_param->opencl_d_pws_comp_buf;
-      device_param->kernel_params_decompress[2] = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-                                                ? &device_param->opencl_d_pws_buf
-                                                : &device_param->opencl_d_pws_amp_buf;
+  for (int backend_devices_idx = 0; backend_devices_idx < backend_devices_cnt; backend_devices_idx++)
+  {
+    backend_session_param_t *backend_session_param = backend_session_params + backend_devices_idx;
+
+    backend_session_param->hashcat_ctx         = hashcat_ctx;
+    backend_session_param->backend_devices_idx = backend_devices_idx;
 
-      if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 0, sizeof (cl_mem), device_param->kernel_params_decompress[0]) == -1) return -1;
-      if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 1, sizeof (cl_mem), device_param->kernel_params_decompress[1]) == -1) return -1;
-      if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 2, sizeof (cl_mem), device_param->kernel_params_decompress[2]) == -1) return -1;
+    // the init events are sent from this thread only, so the per device progress lines come out in device order
+
+    if (backend_ctx->devices_param[backend_devices_idx].skipped == false)
+    {
+      EVENT_DATA (EVENT_BACKEND_DEVICE_INIT_PRE, &backend_devices_idx, sizeof (int));
     }
 
-    hardware_power_all += device_param->hardware_power;
+    hc_thread_create (c_threads[backend_devices_idx], backend_session_begin_thread, backend_session_param);
+  }
+
+  hc_thread_wait (backend_devices_cnt, c_threads);
+
+  hcfree (c_threads);
+
+  int rc = 0;
+
+  u64 size_total_host_all = 0;
+
+  u32 hardware_power_all = 0;
+
+  CUcontext cuda_context_last = NULL;
+
+  for (int backend_devices_idx = 0; backend_devices_idx < backend_devices_cnt; backend_devices_idx++)
+  {
+    const backend_session_param_t *backend_session_param = backend_session_params + backend_devices_idx;
+
+    if (backend_session_param->rc == -1) rc = -1;
+
+    if (backend_session_param->rc != 0) continue;
+
+    hc_device_param_t *device_param = &backend_ctx->devices_param[backend_devices_idx];
 
     EVENT_DATA (EVENT_BACKEND_DEVICE_INIT_POST, &backend_devices_idx, sizeof (int));
+
+    size_total_host_all += backend_session_param->size_total_host;
+
+    hardware_power_all += device_param->hardware_power;
+
+    if (device_param->is_cuda == true) cuda_context_last = device_param->cuda_context;
+  }
+
+  hcfree (backend_session_params);
+
+  if (rc == -1) return -1;
+
+  // a CUDA context is only current in the thread that created it, the main thread continues with the last one as before
+
+  if (cuda_context_last != NULL)
+  {
+    if (hc_cuCtxSetCurrent (hashcat_ctx, cuda_context_last) == -1) return -1;
   }
 
   if (user_options->benchmark == false)
@@ -10278,11 +10903,12 @@ void backend_session_destroy (hashcat_ctx_t *hashcat_ctx)
 
     if (device_param->skipped == true) continue;
 
-    hcfree (device_param->pws_comp);
-    hcfree (device_param->pws_idx);
+    hook_pool_destroy (device_param);
+
+    host_buffers_free (hashcat_ctx, device_param);
+
     hcfree (device_param->pws_pre_buf);
     hcfree (device_param->pws_base_buf);
-    hcfree (device_param->combs_buf);
     hcfree (device_param->hooks_buf);
     hcfree (device_param->scratch_buf);
     #ifdef WITH_BRAIN
@@ -10296,6 +10922,8 @@ void backend_session_destroy (hashcat_ctx_t *hashcat_ctx)
       if (device_param->cuda_d_pws_amp_buf)    hc_cuMemFree (hashcat_ctx, device_param->cuda_d_pws_amp_buf);
       if (device_param->cuda_d_pws_comp_buf)   hc_cuMemFree (hashcat_ctx, device_param->cuda_d_pws_comp_buf);
       if (device_param->cuda_d_pws_idx)        hc_cuMemFree (hashcat_ctx, device_param->cuda_d_pws_idx);
+      if (device_param->cuda_d_pws_prefetch_comp_buf) hc_cuMemFree (hashcat_ctx, device_param->cuda_d_pws_prefetch_comp_buf);
+      if (device_param->cuda_d_pws_prefetch_idx)      hc_cuMemFree (hashcat_ctx, device_param->cuda_d_pws_prefetch_idx);
       if (device_param->cuda_d_rules)          hc_cuMemFree (hashcat_ctx, device_param->cuda_d_rules);
       //if (device_param->cuda_d_rules_c)        hc_cuMemFree (hashcat_ctx, device_param->cuda_d_rules_c);
       if (device_param->cuda_d_combs)          hc_cuMemFree (hashcat_ctx, device_param->cuda_d_combs);
@@ -10331,8 +10959,10 @@ void backend_session_destroy (hashcat_ctx_t *hashcat_ctx)
 
       if (device_param->cuda_event1)           hc_cuEventDestroy (hashcat_ctx, device_param->cuda_event1);
       if (device_param->cuda_event2)           hc_cuEventDestroy (hashcat_ctx, device_param->cuda_event2);
+      if (device_param->cuda_event_prefetch)   hc_cuEventDestroy (hashcat_ctx, device_param->cuda_event_prefetch);
 
       if (device_param->cuda_stream)           hc_cuStreamDestroy (hashcat_ctx, device_param->cuda_stream);
+      if (device_param->cuda_stream_copy)      hc_cuStreamDestroy (hashcat_ctx, device_param->cuda_stream_copy);
 
       if (device_param->cuda_module)           hc_cuModuleUnload (hashcat_ctx, device_param->cuda_module);
       if (device_param->cuda_module_mp)        hc_cuModuleUnload (hashcat_ctx, device_param->cuda_module_mp);
@@ -10344,6 +10974,8 @@ void backend_session_destroy (hashcat_ctx_t *hashcat_ctx)
       device_param->cuda_d_pws_amp_buf        = 0;
       device_param->cuda_d_pws_comp_buf       = 0;
       device_param->cuda_d_pws_idx            = 0;
+      device_param->cuda_d_pws_prefetch_comp_buf = 0;
+      device_param->cuda_d_pws_prefetch_idx   = 0;
       device_param->cuda_d_rules              = 0;
       device_param->cuda_d_rules_c            = 0;
       device_param->cuda_d_combs              = 0;
@@ -10403,6 +11035,9 @@ void backend_session_destroy (hashcat_ctx_t *hashcat_ctx)
       device_param->cuda_module_mp            = NULL;
       device_param->cuda_module_amp           = NULL;
 
+      device_param->cuda_event_prefetch       = NULL;
+      device_param->cuda_stream_copy          = NULL;
+
       device_param->cuda_context              = NULL;
     }
 
@@ -10412,6 +11047,8 @@ void backend_session_destroy (hashcat_ctx_t *hashcat_ctx)
       if (device_param->opencl_d_pws_amp_buf)    hc_clReleaseMemObject (hashcat_ctx, device_param->opencl_d_pws_amp_buf);
       if (device_param->opencl_d_pws_comp_buf)   hc_clReleaseMemObject (hashcat_ctx, device_param->opencl_d_pws_comp_buf);
       if (device_param->opencl_d_pws_idx)        hc_clReleaseMemObject (hashcat_ctx, device_param->opencl_d_pws_idx);
+      if (device_param->opencl_d_pws_prefetch_comp_buf) hc_clReleaseMemObject (hashcat_ctx, device_param->opencl_d_pws_prefetch_comp_buf);
+      if (device_param->opencl_d_pws_prefetch_idx)      hc_clReleaseMemObject (hashcat_ctx, device_param->opencl_d_pws_prefetch_idx);
       if (device_param->opencl_d_rules)          hc_clReleaseMemObject (hashcat_ctx, device_param->opencl_d_rules);
       if (device_param->opencl_d_rules_c)        hc_clReleaseMemObject (hashcat_ctx, device_param->opencl_d_rules_c);
       if (device_param->opencl_d_combs)          hc_clReleaseMemObject (hashcat_ctx, device_param->opencl_d_combs);
@@ -10472,6 +11109,7 @@ void backend_session_destroy (hashcat_ctx_t *hashcat_ctx)
       if (device_param->opencl_program_amp)      hc_clReleaseProgram (hashcat_ctx, device_param->opencl_program_amp);
 
       if (device_param->opencl_command_queue)    hc_clReleaseCommandQueue (hashcat_ctx, device_param->opencl_command_queue);
+      if (device_param->opencl_command_queue_copy) hc_clReleaseCommandQueue (hashcat_ctx, device_param->opencl_command_queue_copy);
 
       if (device_param->opencl_context)          hc_clReleaseContext (hashcat_ctx, device_param->opencl_context);
 
@@ -10479,6 +11117,8 @@ void backend_session_destroy (hashcat_ctx_t *hashcat_ctx)
       device_param->opencl_d_pws_amp_buf       = NULL;
       device_param->opencl_d_pws_comp_buf      = NULL;
       device_param->opencl_d_pws_idx           = NULL;
+      device_param->opencl_d_pws_prefetch_comp_buf = NULL;
+      device_param->opencl_d_pws_prefetch_idx  = NULL;
       device_param->opencl_d_rules             = NULL;
       device_param->opencl_d_rules_c           = NULL;
       device_param->opencl_d_combs             = NULL;
@@ -10536,14 +11176,12 @@ void backend_session_destroy (hashcat_ctx_t *hashcat_ctx)
       device_param->opencl_program_mp          = NULL;
       device_param->opencl_program_amp         = NULL;
       device_param->opencl_command_queue       = NULL;
+      device_param->opencl_command_queue_copy  = NULL;
       device_param->opencl_context             = NULL;
     }
 
-    device_param->pws_comp            = NULL;
-    device_param->pws_idx             = NULL;
     device_param->pws_pre_buf         = NULL;
     device_param->pws_base_buf        = NULL;
-    device_param->combs_buf           = NULL;
     device_param->hooks_buf           = NULL;
     device_param->scratch_buf         = NULL;
     #ifdef WITH_BRAIN
@@ -10576,6 +11214,8 @@ void backend_session_reset (hashcat_ctx_t *hashcat_ctx)
 
     memset (device_param->exec_msec, 0, EXEC_CACHE * sizeof (double));
 
+    device_param->hook_usec = 0;
+
     device_param->outerloop_msec = 0;
     device_param->outerloop_pos  = 0;
     device_param->outerloop_left = 0;
@@ -10589,8 +11229,12 @@ void backend_session_reset (hashcat_ctx_t *hashcat_ctx)
 
     device_param->pws_cnt = 0;
 
-    device_param->words_off  = 0;
-    device_param->words_done = 0;
+    device_param->pws_prefetch_cnt = 0;
+
+    device_param->words_off     = 0;
+    device_param->words_done    = 0;
+    device_param->words_claimed = 0;
+    device_param->words_cracked = 0;
 
     #if defined (_WIN)
     device_param->timer_speed.QuadPart = 0;
@@ -10763,49 +11407,43 @@ int backend_session_update_mp_rl (hashcat_ctx_t *hashcat_ctx, const u32 css_cnt_
   return 0;
 }
 
-void *hook12_thread (void *p)
+HC_API_CALL void *hook_thread (void *p)
 {
-  hook_thread_param_t *hook_thread_param = (hook_thread_param_t *) p;
-
-  module_ctx_t *module_ctx = hook_thread_param->module_ctx;
-  status_ctx_t *status_ctx = hook_thread_param->status_ctx;
+  hook_pool_t *hook_pool = (hook_pool_t *) p;
 
-  const u64 tid     = hook_thread_param->tid;
-  const u64 tsz     = hook_thread_param->tsz;
-  const u64 pws_cnt = hook_thread_param->pws_cnt;
+  status_ctx_t *status_ctx = hook_pool->status_ctx;
 
-  for (u64 pw_pos = tid; pw_pos < pws_cnt; pw_pos += tsz)
+  while (true)
   {
-    while (status_ctx->devices_status == STATUS_PAUSED) sleep (1);
+    hc_thread_sem_wait (hook_pool->sem_work);
 
-    if (status_ctx->devices_status == STATUS_RUNNING)
-    {
-      module_ctx->module_hook12 (hook_thread_param->device_param, hook_thread_param->hook_salts_buf, hook_thread_param->salt_pos, pw_pos);
-    }
-  }
+    if (hook_pool->shutdown == true) break;
 
-  return NULL;
-}
+    const u64 pws_cnt   = hook_pool->pws_cnt;
+    const u64 pws_chunk = hook_pool->pws_chunk;
 
-void *hook23_thread (void *p)
-{
-  hook_thread_param_t *hook_thread_param = (hook_thread_param_t *) p;
+    // claim chunks until none is left, a slow password only holds back the rest of its own chunk
 
-  module_ctx_t *module_ctx = hook_thread_param->module_ctx;
-  status_ctx_t *status_ctx = hook_thread_param->status_ctx;
+    while (true)
+    {
+      const u64 pw_start = hc_atomic_fetch_add (&hook_pool->pws_pos, pws_chunk);
 
-  const u64 tid     = hook_thread_param->tid;
-  const u64 tsz     = hook_thread_param->tsz;
-  const u64 pws_cnt = hook_thread_param->pws_cnt;
+      if (pw_start >= pws_cnt) break;
 
-  for (u64 pw_pos = tid; pw_pos < pws_cnt; pw_pos += tsz)
-  {
-    while (status_ctx->devices_status == STATUS_PAUSED) sleep (1);
+      const u64 pw_stop = MIN (pw_start + pws_chunk, pws_cnt);
 
-    if (status_ctx->devices_status == STATUS_RUNNING)
-    {
-      module_ctx->module_hook23 (hook_thread_param->device_param, hook_thread_param->hook_salts_buf, hook_thread_param->salt_pos, pw_pos);
+      for (u64 pw_pos = pw_start; pw_pos < pw_stop; pw_pos++)
+      {
+        while (status_ctx->devices_status == STATUS_PAUSED) sleep (1);
+
+        if (status_ctx->devices_status == STATUS_RUNNING)
+        {
+          hook_pool->hook (hook_pool->device_param, hook_pool->hook_salts_buf, hook_pool->salt_pos, pw_pos);
+        }
+      }
     }
+
+    hc_thread_sem_post (hook_pool->sem_done);
   }
 
   return NULL;
@@ -32,6 +32,16 @@ int combinator_ctx_init (hashcat_ctx_t *hashcat_ctx)
 
   combinator_ctx->enabled = true;
 
+  if (user_options->kernel_cache_warm == true)
+  {
+    // no wordlists, only the kernels are built
+
+    combinator_ctx->combs_mode = COMBINATOR_MODE_BASE_LEFT;
+    combinator_ctx->combs_cnt  = 1;
+
+    return 0;
+  }
+
   if (user_options->slow_candidates == true)
   {
     // this is always need to be COMBINATOR_MODE_BASE_LEFT
@@ -87,8 +97,6 @@ int combinator_ctx_init (hashcat_ctx_t *hashcat_ctx)
 
       if (rc1 == -1)
       {
-        event_log_error (hashcat_ctx, "Integer overflow detected in keyspace of wordlist: %s", dictfile1);
-
         hc_fclose (&fp1);
         hc_fclose (&fp2);
 
@@ -116,8 +124,6 @@ int combinator_ctx_init (hashcat_ctx_t *hashcat_ctx)
 
       if (rc2 == -1)
       {
-        event_log_error (hashcat_ctx, "Integer overflow detected in keyspace of wordlist: %s", dictfile2);
-
         return -1;
       }
 
@@ -190,8 +196,6 @@ int combinator_ctx_init (hashcat_ctx_t *hashcat_ctx)
 
         if (rc1 == -1)
         {
-          event_log_error (hashcat_ctx, "Integer overflow detected in keyspace of wordlist: %s", dictfile1);
-
           hc_fclose (&fp1);
           hc_fclose (&fp2);
 
@@ -219,8 +223,6 @@ int combinator_ctx_init (hashcat_ctx_t *hashcat_ctx)
 
         if (rc2 == -1)
         {
-          event_log_error (hashcat_ctx, "Integer overflow detected in keyspace of wordlist: %s", dictfile2);
-
           return -1;
         }
 
@@ -321,8 +323,6 @@ int combinator_ctx_init (hashcat_ctx_t *hashcat_ctx)
 
         if (rc1 == -1)
         {
-          event_log_error (hashcat_ctx, "Integer overflow detected in keyspace of wordlist: %s", dictfile1);
-
           hc_fclose (&fp1);
           hc_fclose (&fp2);
 
@@ -350,8 +350,6 @@ int combinator_ctx_init (hashcat_ctx_t *hashcat_ctx)
 
         if (rc2 == -1)
         {
-          event_log_error (hashcat_ctx, "Integer overflow detected in keyspace of wordlist: %s", dictfile2);
-
           return -1;
         }
 
@@ -406,8 +404,6 @@ int combinator_ctx_init (hashcat_ctx_t *hashcat_ctx)
 
         if (rc == -1)
         {
-          event_log_error (hashcat_ctx, "Integer overflow detected in keyspace of wordlist: %s", dictfile);
-
           return -1;
         }
 
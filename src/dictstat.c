@@ -11,6 +11,7 @@
 #include "locking.h"
 #include "shared.h"
 #include "dictstat.h"
+#include "emu_inc_hash_sha1.h"
 
 int sort_by_dictstat (const void *s1, const void *s2)
 {
@@ -85,6 +86,8 @@ void dictstat_destroy (hashcat_ctx_t *hashcat_ctx)
 
   if (hashconfig->dictstat_disable == true) return;
 
+  dictstat_index_reset (hashcat_ctx);
+
   hcfree (dictstat_ctx->filename);
   hcfree (dictstat_ctx->base);
 
@@ -269,3 +272,310 @@ void dictstat_append (hashcat_ctx_t *hashcat_ctx, dictstat_t *d)
 
   lsearch (d, dictstat_ctx->base, &dictstat_ctx->cnt, sizeof (dictstat_t), sort_by_dictstat);
 }
+
+static char *dictstat_index_filename (hashcat_ctx_t *hashcat_ctx, const dictstat_t *d, const u32 parser)
+{
+  folder_config_t *folder_config = hashcat_ctx->folder_config;
+
+  // the filename is derived from everything that changes how the words are counted,
+  // but not from the file stat so that a changed dictionary overwrites its old index
+
+  u32 key[64] = { 0 }; // padding required for sha1_update()
+
+  u8 *key_ptr = (u8 *) key;
+
+  memcpy (key_ptr +   0, d->hash_filename, 16);
+  memcpy (key_ptr +  16, d->encoding_from, 64);
+  memcpy (key_ptr +  80, d->encoding_to,   64);
+  memcpy (key_ptr + 144, &parser,           4);
+
+  sha1_ctx_t sha1_ctx;
+  sha1_init   (&sha1_ctx);
+  sha1_update (&sha1_ctx, key, 148);
+  sha1_final  (&sha1_ctx);
+
+  char *filename;
+
+  hc_asprintf (&filename, "%s/%s/%08x%08x%08x%08x.idx", folder_config->profile_dir, DICTSTAT_INDEX_FOLDER, sha1_ctx.h[0], sha1_ctx.h[1], sha1_ctx.h[2], sha1_ctx.h[3]);
+
+  return filename;
+}
+
+static void dictstat_index_set (hashcat_ctx_t *hashcat_ctx, const char *dictfile, u64 *index_buf, const u64 index_cnt, hc_gzidx_t *gzidx)
+{
+  dictstat_ctx_t *dictstat_ctx = hashcat_ctx->dictstat_ctx;
+
+  dictstat_index_reset (hashcat_ctx);
+
+  dictstat_ctx->index_dictfile = hcstrdup (dictfile);
+  dictstat_ctx->index_buf      = index_buf;
+  dictstat_ctx->index_cnt      = index_cnt;
+  dictstat_ctx->index_gzidx    = gzidx;
+}
+
+void dictstat_index_reset (hashcat_ctx_t *hashcat_ctx)
+{
+  dictstat_ctx_t *dictstat_ctx = hashcat_ctx->dictstat_ctx;
+
+  hcfree (dictstat_ctx->index_dictfile);
+  hcfree (dictstat_ctx->index_buf);
+
+  hc_gzidx_free (dictstat_ctx->index_gzidx);
+
+  dictstat_ctx->index_dictfile = NULL;
+  dictstat_ctx->index_buf      = NULL;
+  dictstat_ctx->index_cnt      = 0;
+  dictstat_ctx->index_gzidx    = NULL;
+}
+
+static hc_gzidx_t *dictstat_index_read_gzidx (HCFILE *fp)
+{
+  u64 gz_cnt;
+  u64 gz_span;
+
+  if (hc_fread (&gz_cnt,  sizeof (u64), 1, fp) != 1) return NULL;
+  if (hc_fread (&gz_span, sizeof (u64), 1, fp) != 1) return NULL;
+
+  if (gz_cnt == 0) return NULL;
+
+  hc_gzidx_t *gzidx = (hc_gzidx_t *) hccalloc (1, sizeof (hc_gzidx_t));
+
+  gzidx->span   = gz_span;
+  gzidx->points = (hc_gzidx_point_t *) hccalloc (gz_cnt, sizeof (hc_gzidx_point_t));
+  gzidx->avail  = gz_cnt;
+
+  for (u64 i = 0; i < gz_cnt; i++)
+  {
+    hc_gzidx_point_t *point = gzidx->points + i;
+
+    size_t nread = 0;
+
+    nread += hc_fread (&point->out,  sizeof (u64), 1,             fp);
+    nread += hc_fread (&point->in,   sizeof (u64), 1,             fp);
+    nread += hc_fread (&point->bits, sizeof (u64), 1,             fp);
+    nread += hc_fread (point->window, 1,           GZIDX_WINSIZE, fp);
+
+    const bool ordered = (i == 0) || (point->out > gzidx->points[i - 1].out);
+
+    if ((nread != (3 + GZIDX_WINSIZE)) || (point->bits > 7) || (ordered == false))
+    {
+      hc_gzidx_free (gzidx);
+
+      return NULL;
+    }
+
+    gzidx->cnt++;
+  }
+
+  return gzidx;
+}
+
+void dictstat_index_read (hashcat_ctx_t *hashcat_ctx, const dictstat_t *d, const u32 parser, const char *dictfile)
+{
+  hashconfig_t   *hashconfig   = hashcat_ctx->hashconfig;
+  dictstat_ctx_t *dictstat_ctx = hashcat_ctx->dictstat_ctx;
+
+  if (dictstat_ctx->enabled == false) return;
+
+  if (hashconfig->dictstat_disable == true) return;
+
+  dictstat_index_reset (hashcat_ctx);
+
+  char *filename = dictstat_index_filename (hashcat_ctx, d, parser);
+
+  HCFILE fp;
+
+  if (hc_fopen (&fp, filename, "rb") == false)
+  {
+    // no index was written for this dictionary (yet), the caller falls back to skipping words
+
+    hcfree (filename);
+
+    return;
+  }
+
+  hcfree (filename);
+
+  u64 v;
+  u64 interval;
+  u64 cnt;
+
+  dictstat_t d_index;
+
+  const size_t nread1 = hc_fread (&v,        sizeof (u64),        1, &fp);
+  const size_t nread2 = hc_fread (&interval, sizeof (u64),        1, &fp);
+  const size_t nread3 = hc_fread (&d_index,  sizeof (dictstat_t), 1, &fp);
+  const size_t nread4 = hc_fread (&cnt,      sizeof (u64),        1, &fp);
+
+  if ((nread1 != 1) || (nread2 != 1) || (nread3 != 1) || (nread4 != 1))
+  {
+    hc_fclose (&fp);
+
+    return;
+  }
+
+  v = byte_swap_64 (v);
+
+  // an index of an outdated version or for a different state of the dictionary is silently ignored
+
+  if ((v != DICTSTAT_INDEX_VERSION) || (interval != DICTSTAT_INDEX_INTERVAL) || (d_index.cnt != d->cnt) || (sort_by_dictstat (&d_index, d) != 0))
+  {
+    hc_fclose (&fp);
+
+    return;
+  }
+
+  if ((cnt == 0) || (cnt > (d->cnt / interval)))
+  {
+    hc_fclose (&fp);
+
+    return;
+  }
+
+  u64 *index_buf = (u64 *) hccalloc (cnt, sizeof (u64));
+
+  const size_t nread = hc_fread (index_buf, sizeof (u64), cnt, &fp);
+
+  if (nread != cnt)
+  {
+    hc_fclose (&fp);
+
+    hcfree (index_buf);
+
+    return;
+  }
+
+  // the inflate checkpoints of a gzip compressed dictionary follow, a damaged list only costs the speedup
+
+  hc_gzidx_t *gzidx = dictstat_index_read_gzidx (&fp);
+
+  hc_fclose (&fp);
+
+  dictstat_index_set (hashcat_ctx, dictfile, index_buf, cnt, gzidx);
+}
+
+int dictstat_index_write (hashcat_ctx_t *hashcat_ctx, const dictstat_t *d, const u32 parser, const char *dictfile, u64 *index_buf, const u64 index_cnt, hc_gzidx_t *gzidx)
+{
+  hashconfig_t   *hashconfig   = hashcat_ctx->hashconfig;
+  dictstat_ctx_t *dictstat_ctx = hashcat_ctx->dictstat_ctx;
+
+  if ((dictstat_ctx->enabled == false) || (hashconfig->dictstat_disable == true) || (index_cnt == 0))
+  {
+    hcfree (index_buf);
+
+    hc_gzidx_free (gzidx);
+
+    return 0;
+  }
+
+  // from here on the index is owned by dictstat_ctx
+
+  dictstat_index_set (hashcat_ctx, dictfile, index_buf, index_cnt, gzidx);
+
+  char *filename = dictstat_index_filename (hashcat_ctx, d, parser);
+
+  HCFILE fp;
+
+  if (hc_fopen (&fp, filename, "wb") == false)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", filename, strerror (errno));
+
+    hcfree (filename);
+
+    return -1;
+  }
+
+  if (hc_lockfile (&fp) == -1)
+  {
+    hc_fclose (&fp);
+
+    event_log_error (hashcat_ctx, "%s: %s", filename, strerror (errno));
+
+    hcfree (filename);
+
+    return -1;
+  }
+
+  // header
+
+  u64 v        = DICTSTAT_INDEX_VERSION;
+  u64 interval = DICTSTAT_INDEX_INTERVAL;
+  u64 cnt      = index_cnt;
+
+  v = byte_swap_64 (v);
+
+  hc_fwrite (&v,        sizeof (u64),        1, &fp);
+  hc_fwrite (&interval, sizeof (u64),        1, &fp);
+  hc_fwrite (d,         sizeof (dictstat_t), 1, &fp);
+  hc_fwrite (&cnt,      sizeof (u64),        1, &fp);
+
+  // data
+
+  hc_fwrite (index_buf, sizeof (u64), index_cnt, &fp);
+
+  u64 gz_cnt  = (gzidx != NULL) ? gzidx->cnt  : 0;
+  u64 gz_span = (gzidx != NULL) ? gzidx->span : 0;
+
+  hc_fwrite (&gz_cnt,  sizeof (u64), 1, &fp);
+  hc_fwrite (&gz_span, sizeof (u64), 1, &fp);
+
+  for (u64 i = 0; i < gz_cnt; i++)
+  {
+    const hc_gzidx_point_t *point = gzidx->points + i;
+
+    hc_fwrite (&point->out,  sizeof (u64), 1,             &fp);
+    hc_fwrite (&point->in,   sizeof (u64), 1,             &fp);
+    hc_fwrite (&point->bits, sizeof (u64), 1,             &fp);
+    hc_fwrite (point->window, 1,           GZIDX_WINSIZE, &fp);
+  }
+
+  if (hc_unlockfile (&fp) == -1)
+  {
+    hc_fclose (&fp);
+
+    event_log_error (hashcat_ctx, "%s: %s", filename, strerror (errno));
+
+    hcfree (filename);
+
+    return -1;
+  }
+
+  hc_fclose (&fp);
+
+  hcfree (filename);
+
+  return 0;
+}
+
+bool dictstat_index_find (hashcat_ctx_t *hashcat_ctx, const char *dictfile, const u64 words, u64 *index_words, u64 *index_off)
+{
+  dictstat_ctx_t *dictstat_ctx = hashcat_ctx->dictstat_ctx;
+
+  if (dictstat_ctx->index_cnt == 0) return false;
+
+  if (strcmp (dictstat_ctx->index_dictfile, dictfile) != 0) return false;
+
+  // index_buf[n] holds the byte offset right after word ((n + 1) * DICTSTAT_INDEX_INTERVAL)
+
+  u64 n = words / DICTSTAT_INDEX_INTERVAL;
+
+  if (n == 0) return false;
+
+  n = MIN (n, dictstat_ctx->index_cnt);
+
+  *index_words = n * DICTSTAT_INDEX_INTERVAL;
+  *index_off   = dictstat_ctx->index_buf[n - 1];
+
+  return true;
+}
+
+const hc_gzidx_t *dictstat_index_find_gzidx (hashcat_ctx_t *hashcat_ctx, const char *dictfile)
+{
+  dictstat_ctx_t *dictstat_ctx = hashcat_ctx->dictstat_ctx;
+
+  if (dictstat_ctx->index_gzidx == NULL) return NULL;
+
+  if (strcmp (dictstat_ctx->index_dictfile, dictfile) != 0) return NULL;
+
+  return dictstat_ctx->index_gzidx;
+}
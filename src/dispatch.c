@@ -15,6 +15,7 @@
 #include "rp.h"
 #include "rp_cpu.h"
 #include "slow_candidates.h"
+#include "status.h"
 #include "dispatch.h"
 
 #ifdef WITH_BRAIN
@@ -107,44 +108,221 @@ static u64 get_power (backend_ctx_t *backend_ctx, hc_device_param_t *device_para
   return device_param->kernel_power;
 }
 
+static bool get_power_balanced (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u64 words_left, u64 *kernel_power_out)
+{
+  backend_ctx_t *backend_ctx = hashcat_ctx->backend_ctx;
+
+  // split the words left plus the words still queued on each device by the measured speed of the devices,
+  // so that all of them are predicted to finish at the same time.
+  // a device with more queued words than its share finishes late anyway and is taken out of the split.
+
+  bool excluded[DEVICES_MAX] = { false };
+
+  while (true)
+  {
+    double speed_all  = 0;
+    double queued_all = 0;
+
+    for (int backend_devices_idx = 0; backend_devices_idx < backend_ctx->backend_devices_cnt; backend_devices_idx++)
+    {
+      hc_device_param_t *device_param_cur = &backend_ctx->devices_param[backend_devices_idx];
+
+      if (device_param_cur->skipped == true) continue;
+
+      if (device_param_cur->skipped_warning == true) continue;
+
+      if (excluded[backend_devices_idx] == true) continue;
+
+      const double speed = status_get_hashes_msec_dev (hashcat_ctx, backend_devices_idx);
+
+      // no speed measured yet, fall back to the hardware_power split of get_power ()
+
+      if (speed <= 0) return false;
+
+      speed_all  += speed;
+      queued_all += hc_atomic_load (&device_param_cur->words_claimed) - hc_atomic_load (&device_param_cur->words_cracked);
+    }
+
+    const double words_all = (double) words_left + queued_all;
+
+    bool changed = false;
+
+    double share_self = 0;
+
+    for (int backend_devices_idx = 0; backend_devices_idx < backend_ctx->backend_devices_cnt; backend_devices_idx++)
+    {
+      hc_device_param_t *device_param_cur = &backend_ctx->devices_param[backend_devices_idx];
+
+      if (device_param_cur->skipped == true) continue;
+
+      if (device_param_cur->skipped_warning == true) continue;
+
+      if (excluded[backend_devices_idx] == true) continue;
+
+      const double queued = hc_atomic_load (&device_param_cur->words_claimed) - hc_atomic_load (&device_param_cur->words_cracked);
+
+      const double share = (words_all * status_get_hashes_msec_dev (hashcat_ctx, backend_devices_idx) / speed_all) - queued;
+
+      if (device_param_cur == device_param)
+      {
+        share_self = share;
+      }
+      else if (share <= 0)
+      {
+        excluded[backend_devices_idx] = true;
+
+        changed = true;
+      }
+    }
+
+    if (changed == true) continue;
+
+    // this device has more queued than its share, the others finish the rest earlier without it
+
+    if (share_self <= 0)
+    {
+      *kernel_power_out = 0;
+
+      return true;
+    }
+
+    // same limits as in get_power (), a chunk smaller than hardware_power does not finish earlier
+
+    const u64 work = MAX ((u64) CEIL (share_self), device_param->hardware_power);
+
+    *kernel_power_out = MIN (work, device_param->kernel_power);
+
+    return true;
+  }
+}
+
 static u64 get_work (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u64 max)
 {
   backend_ctx_t  *backend_ctx  = hashcat_ctx->backend_ctx;
   status_ctx_t   *status_ctx   = hashcat_ctx->status_ctx;
   user_options_t *user_options = hashcat_ctx->user_options;
 
-  hc_thread_mutex_lock (status_ctx->mux_dispatcher);
-
-  const u64 words_off  = status_ctx->words_off;
   const u64 words_base = (user_options->limit == 0) ? status_ctx->words_base : MIN (user_options->limit, status_ctx->words_base);
 
-  device_param->words_off = words_off;
-
   const u64 kernel_power_all = backend_ctx->kernel_power_all;
 
-  const u64 words_left = words_base - words_off;
+  // claim [words_off, words_off + work) with a compare-and-swap, only the switch to kernel_power_final takes mux_dispatcher
+
+  u64 words_off = hc_atomic_load (&status_ctx->words_off);
 
-  if (words_left < kernel_power_all)
+  u64 work = 0;
+
+  while (true)
   {
-    if (backend_ctx->kernel_power_final == 0)
+    const u64 words_left = (words_off < words_base) ? words_base - words_off : 0;
+
+    if ((words_left < kernel_power_all) && (backend_ctx->kernel_power_final == 0))
     {
-      set_kernel_power_final (hashcat_ctx, words_left);
+      hc_thread_mutex_lock (status_ctx->mux_dispatcher);
+
+      if (backend_ctx->kernel_power_final == 0)
+      {
+        set_kernel_power_final (hashcat_ctx, words_left);
+      }
+
+      hc_thread_mutex_unlock (status_ctx->mux_dispatcher);
+
+      hc_atomic_fetch_add (&status_ctx->dispatch_locked_cnt, 1);
     }
-  }
 
-  const u64 kernel_power = get_power (backend_ctx, device_param);
+    u64 kernel_power = get_power (backend_ctx, device_param);
+
+    if ((user_options->dispatch_balance == true) && (backend_ctx->kernel_power_final > 0))
+    {
+      u64 kernel_power_balanced = 0;
+
+      if (get_power_balanced (hashcat_ctx, device_param, words_left, &kernel_power_balanced) == true) kernel_power = kernel_power_balanced;
+    }
+
+    work = MIN (words_left, kernel_power);
+
+    work = MIN (work, max);
 
-  u64 work = MIN (words_left, kernel_power);
+    if (work == 0) break;
+
+    // on failure words_off is reloaded with the offset another device advanced it to
+
+    if (hc_atomic_cas (&status_ctx->words_off, &words_off, words_off + work) == true) break;
+
+    hc_atomic_fetch_add (&status_ctx->dispatch_retry_cnt, 1);
+  }
 
-  work = MIN (work, max);
+  device_param->words_off = words_off;
 
-  status_ctx->words_off += work;
+  if (work > 0)
+  {
+    hc_atomic_store (&device_param->words_claimed, device_param->words_claimed + work);
 
-  hc_thread_mutex_unlock (status_ctx->mux_dispatcher);
+    hc_atomic_fetch_add (&status_ctx->dispatch_cnt, 1);
+  }
 
   return work;
 }
 
+static void calc_fill_pws (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, u64 *words_off_out, u64 *words_fin_out)
+{
+  combinator_ctx_t     *combinator_ctx     = hashcat_ctx->combinator_ctx;
+  hashes_t             *hashes             = hashcat_ctx->hashes;
+  status_ctx_t         *status_ctx         = hashcat_ctx->status_ctx;
+  straight_ctx_t       *straight_ctx       = hashcat_ctx->straight_ctx;
+  user_options_extra_t *user_options_extra = hashcat_ctx->user_options_extra;
+
+  const u32 attack_kern = user_options_extra->attack_kern;
+
+  u64 words_off = 0;
+  u64 words_fin = 0;
+  u64 words_extra = -1U;
+  u64 words_extra_total = 0;
+
+  memset (device_param->pws_comp, 0, device_param->size_pws_comp);
+  memset (device_param->pws_idx,  0, device_param->size_pws_idx);
+
+  while (words_extra)
+  {
+    const u64 work = get_work (hashcat_ctx, device_param, words_extra);
+
+    if (work == 0) break;
+
+    words_off = device_param->words_off;
+    words_fin = words_off + work;
+
+    words_extra = wl_ring_get (hashcat_ctx, device_param, words_off, words_fin);
+
+    words_extra_total += words_extra;
+
+    if (status_ctx->run_thread_level1 == false) break;
+  }
+
+  *words_off_out = words_off;
+  *words_fin_out = words_fin;
+
+  if (status_ctx->run_thread_level1 == false) return;
+
+  if (words_extra_total > 0)
+  {
+    hc_thread_mutex_lock (status_ctx->mux_counter);
+
+    for (u32 salt_pos = 0; salt_pos < hashes->salts_cnt; salt_pos++)
+    {
+      if (attack_kern == ATTACK_KERN_STRAIGHT)
+      {
+        status_ctx->words_progress_rejected[salt_pos] += words_extra_total * straight_ctx->kernel_rules_cnt;
+      }
+      else if (attack_kern == ATTACK_KERN_COMBI)
+      {
+        status_ctx->words_progress_rejected[salt_pos] += words_extra_total * combinator_ctx->combs_cnt;
+      }
+    }
+
+    hc_thread_mutex_unlock (status_ctx->mux_counter);
+  }
+}
+
 static int calc_stdin (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
 {
   user_options_t       *user_options       = hashcat_ctx->user_options;
@@ -363,7 +541,6 @@ HC_API_CALL void *thread_calc_stdin (void *p)
 static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
 {
   user_options_t       *user_options       = hashcat_ctx->user_options;
-  user_options_extra_t *user_options_extra = hashcat_ctx->user_options_extra;
   hashconfig_t         *hashconfig         = hashcat_ctx->hashconfig;
   hashes_t             *hashes             = hashcat_ctx->hashes;
   mask_ctx_t           *mask_ctx           = hashcat_ctx->mask_ctx;
@@ -373,7 +550,6 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
   status_ctx_t         *status_ctx         = hashcat_ctx->status_ctx;
 
   const u32 attack_mode = user_options->attack_mode;
-  const u32 attack_kern = user_options_extra->attack_kern;
 
   if (user_options->slow_candidates == true)
   {
@@ -398,13 +574,18 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
       {
         hc_thread_mutex_lock (status_ctx->mux_dispatcher);
 
-        if (status_ctx->words_off == 0)
+        u64 words_off_zero = 0;
+
+        if (hc_atomic_cas (&status_ctx->words_off, &words_off_zero, highest) == true)
         {
-          status_ctx->words_off = highest;
+          // words below highest are done by other clients, account them as claimed and cracked on this device
+
+          hc_atomic_store (&device_param->words_claimed, device_param->words_claimed + highest);
+          hc_atomic_store (&device_param->words_cracked, device_param->words_cracked + highest);
 
           for (u32 salt_pos = 0; salt_pos < hashes->salts_cnt; salt_pos++)
           {
-            status_ctx->words_progress_rejected[salt_pos] = status_ctx->words_off;
+            status_ctx->words_progress_rejected[salt_pos] = highest;
           }
         }
 
@@ -509,6 +690,10 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
                 words_extra_total += overlap;
                 words_off         += overlap;
                 work              -= overlap;
+
+                // the overlap is skipped, it must not count as queued on this device for --dispatch-balance
+
+                hc_atomic_store (&device_param->words_claimed, device_param->words_claimed - overlap);
               }
             }
             #endif
@@ -687,6 +872,8 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
         {
           device_param->words_done = MAX (device_param->words_done, words_fin);
 
+          hc_atomic_store (&device_param->words_cracked, device_param->words_claimed);
+
           status_ctx->words_cur = get_highest_words_done (hashcat_ctx);
         }
 
@@ -823,6 +1010,10 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
                 words_extra_total += overlap;
                 words_off         += overlap;
                 work              -= overlap;
+
+                // the overlap is skipped, it must not count as queued on this device for --dispatch-balance
+
+                hc_atomic_store (&device_param->words_claimed, device_param->words_claimed - overlap);
               }
             }
             #endif
@@ -1001,6 +1192,8 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
         {
           device_param->words_done = MAX (device_param->words_done, words_fin);
 
+          hc_atomic_store (&device_param->words_cracked, device_param->words_claimed);
+
           status_ctx->words_cur = get_highest_words_done (hashcat_ctx);
         }
 
@@ -1088,6 +1281,10 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
                 words_extra_total += overlap;
                 words_off         += overlap;
                 work              -= overlap;
+
+                // the overlap is skipped, it must not count as queued on this device for --dispatch-balance
+
+                hc_atomic_store (&device_param->words_claimed, device_param->words_claimed - overlap);
               }
             }
             #endif
@@ -1230,6 +1427,8 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
         {
           device_param->words_done = MAX (device_param->words_done, words_fin);
 
+          hc_atomic_store (&device_param->words_cracked, device_param->words_claimed);
+
           status_ctx->words_cur = get_highest_words_done (hashcat_ctx);
         }
 
@@ -1284,25 +1483,16 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
         {
           device_param->words_done = MAX (device_param->words_done, words_fin);
 
+          hc_atomic_store (&device_param->words_cracked, device_param->words_claimed);
+
           status_ctx->words_cur = get_lowest_words_done (hashcat_ctx);
         }
       }
     }
     else
     {
-      char *dictfile = straight_ctx->dict;
-
       if (attack_mode == ATTACK_MODE_COMBI)
       {
-        if (combinator_ctx->combs_mode == COMBINATOR_MODE_BASE_LEFT)
-        {
-          dictfile = combinator_ctx->dict1;
-        }
-        else
-        {
-          dictfile = combinator_ctx->dict2;
-        }
-
         const u32 combs_mode = combinator_ctx->combs_mode;
 
         if (combs_mode == COMBINATOR_MODE_BASE_LEFT)
@@ -1329,135 +1519,41 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
         }
       }
 
-      HCFILE fp;
+      // the base words are read, decoded and filtered by the shared wordlist reader thread, see wl_ring_init ()
 
-      if (hc_fopen (&fp, dictfile, "rb") == false)
-      {
-        event_log_error (hashcat_ctx, "%s: %s", dictfile, strerror (errno));
-
-        return -1;
-      }
+      // with pws_prefetch the next batch is filled and uploaded while the current one is cracked
 
-      hashcat_ctx_t *hashcat_ctx_tmp = (hashcat_ctx_t *) hcmalloc (sizeof (hashcat_ctx_t));
+      bool next_ready = false;
 
-      memcpy (hashcat_ctx_tmp, hashcat_ctx, sizeof (hashcat_ctx_t)); // yes we actually want to copy these pointers
-
-      hashcat_ctx_tmp->wl_data = (wl_data_t *) hcmalloc (sizeof (wl_data_t));
-
-      if (wl_data_init (hashcat_ctx_tmp) == -1)
-      {
-        if (attack_mode == ATTACK_MODE_COMBI) hc_fclose (&device_param->combs_fp);
-
-        hc_fclose (&fp);
-
-        hcfree (hashcat_ctx_tmp->wl_data);
-        hcfree (hashcat_ctx_tmp);
-
-        return -1;
-      }
-
-      u64 words_cur = 0;
+      u64 next_words_off = 0;
+      u64 next_words_fin = 0;
 
       while (status_ctx->run_thread_level1 == true)
       {
         u64 words_off = 0;
         u64 words_fin = 0;
-        u64 words_extra = -1U;
-        u64 words_extra_total = 0;
 
-        memset (device_param->pws_comp, 0, device_param->size_pws_comp);
-        memset (device_param->pws_idx,  0, device_param->size_pws_idx);
-
-        while (words_extra)
+        if (next_ready == true)
         {
-          const u64 work = get_work (hashcat_ctx, device_param, words_extra);
-
-          if (work == 0) break;
-
-          words_extra = 0;
-
-          words_off = device_param->words_off;
-          words_fin = words_off + work;
-
-          char *line_buf;
-          u32   line_len;
-
-          char rule_buf_out[RP_PASSWORD_SIZE];
-
-          for ( ; words_cur < words_off; words_cur++) get_next_word (hashcat_ctx_tmp, &fp, &line_buf, &line_len);
-
-          for ( ; words_cur < words_fin; words_cur++)
-          {
-            get_next_word (hashcat_ctx_tmp, &fp, &line_buf, &line_len);
-
-            // post-process rule engine
-
-            if (run_rule_engine ((int) user_options_extra->rule_len_l, user_options->rule_buf_l))
-            {
-              if (line_len >= RP_PASSWORD_SIZE) continue;
-
-              memset (rule_buf_out, 0, sizeof (rule_buf_out));
-
-              const int rule_len_out = _old_apply_rule (user_options->rule_buf_l, (int) user_options_extra->rule_len_l, line_buf, (int) line_len, rule_buf_out);
-
-              if (rule_len_out < 0) continue;
+          pws_prefetch_swap (device_param, device_param->pws_prefetched);
 
-              line_buf = rule_buf_out;
-              line_len = (u32) rule_len_out;
-            }
-
-            if (attack_kern == ATTACK_KERN_STRAIGHT)
-            {
-              if ((line_len < hashconfig->pw_min) || (line_len > hashconfig->pw_max))
-              {
-                words_extra++;
-
-                continue;
-              }
-            }
-            else if (attack_kern == ATTACK_KERN_COMBI)
-            {
-              // do not check if minimum restriction is satisfied (line_len >= hashconfig->pw_min) here
-              // since we still need to combine the plains
-
-              if (line_len > hashconfig->pw_max)
-              {
-                words_extra++;
-
-                continue;
-              }
-            }
+          device_param->words_off = next_words_off;
 
-            pw_add (device_param, (const u8 *) line_buf, (const int) line_len);
+          words_off = next_words_off;
+          words_fin = next_words_fin;
 
-            if (status_ctx->run_thread_level1 == false) break;
-          }
-
-          words_extra_total += words_extra;
-
-          if (status_ctx->run_thread_level1 == false) break;
+          next_ready = false;
+        }
+        else
+        {
+          calc_fill_pws (hashcat_ctx, device_param, &words_off, &words_fin);
         }
 
         if (status_ctx->run_thread_level1 == false) break;
 
-        if (words_extra_total > 0)
-        {
-          hc_thread_mutex_lock (status_ctx->mux_counter);
-
-          for (u32 salt_pos = 0; salt_pos < hashes->salts_cnt; salt_pos++)
-          {
-            if (attack_kern == ATTACK_KERN_STRAIGHT)
-            {
-              status_ctx->words_progress_rejected[salt_pos] += words_extra_total * straight_ctx->kernel_rules_cnt;
-            }
-            else if (attack_kern == ATTACK_KERN_COMBI)
-            {
-              status_ctx->words_progress_rejected[salt_pos] += words_extra_total * combinator_ctx->combs_cnt;
-            }
-          }
+        // the prefetch below already claims the next batch, this is what is done once the current one is cracked
 
-          hc_thread_mutex_unlock (status_ctx->mux_counter);
-        }
+        const u64 words_claimed = device_param->words_claimed;
 
         //
         // flush
@@ -1471,55 +1567,44 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
           {
             if (attack_mode == ATTACK_MODE_COMBI) hc_fclose (&device_param->combs_fp);
 
-            hc_fclose (&fp);
-
-            hcfree (hashcat_ctx_tmp->wl_data);
-            hcfree (hashcat_ctx_tmp);
-
             return -1;
           }
 
-          if (run_cracker (hashcat_ctx, device_param, pws_cnt) == -1)
-          {
-            if (attack_mode == ATTACK_MODE_COMBI) hc_fclose (&device_param->combs_fp);
+          // near the end of the keyspace the remaining words are split across all devices, so stop reserving ahead
 
-            hc_fclose (&fp);
-
-            hcfree (hashcat_ctx_tmp->wl_data);
-            hcfree (hashcat_ctx_tmp);
+          if ((device_param->pws_prefetch == true) && (backend_ctx->kernel_power_final == 0) && (words_fin > 0))
+          {
+            pws_prefetch_swap (device_param, false);
 
-            return -1;
-          }
+            calc_fill_pws (hashcat_ctx, device_param, &next_words_off, &next_words_fin);
 
-          device_param->pws_cnt = 0;
+            next_ready = (next_words_fin > 0);
 
-          /*
-          still required?
-          if (attack_kern == ATTACK_KERN_STRAIGHT)
-          {
-            CL_rc = run_kernel_bzero (device_param, device_param->d_rules_c, device_param->size_rules_c);
-            if (CL_rc == -1)
+            if ((next_ready == true) && (device_param->pws_cnt))
             {
-              if (attack_mode == ATTACK_MODE_COMBI) fclose (device_param->combs_fp);
-              fclose (fd);
-              hcfree (hashcat_ctx_tmp->wl_data);
-              hcfree (hashcat_ctx_tmp);
-              return -1;
+              if (run_copy_prefetch (hashcat_ctx, device_param, device_param->pws_cnt) == -1)
+              {
+                if (attack_mode == ATTACK_MODE_COMBI) hc_fclose (&device_param->combs_fp);
+
+                return -1;
+              }
             }
+
+            pws_prefetch_swap (device_param, false);
+
+            // crackpos in the outfile refers to the batch being cracked
+
+            device_param->words_off = words_off;
           }
-          else if (attack_kern == ATTACK_KERN_COMBI)
+
+          if (run_cracker (hashcat_ctx, device_param, pws_cnt) == -1)
           {
-            CL_rc = run_kernel_bzero (device_param, device_param->d_combs_c, device_param->size_combs);
-            if (CL_rc == -1)
-            {
-              if (attack_mode == ATTACK_MODE_COMBI) fclose (device_param->combs_fp);
-              fclose (fd);
-              hcfree (hashcat_ctx_tmp->wl_data);
-              hcfree (hashcat_ctx_tmp);
-              return -1;
-            }
+            if (attack_mode == ATTACK_MODE_COMBI) hc_fclose (&device_param->combs_fp);
+
+            return -1;
           }
-          */
+
+          device_param->pws_cnt = 0;
         }
 
         if (device_param->speed_only_finish == true) break;
@@ -1528,6 +1613,8 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
         {
           device_param->words_done = MAX (device_param->words_done, words_fin);
 
+          hc_atomic_store (&device_param->words_cracked, words_claimed);
+
           status_ctx->words_cur = get_lowest_words_done (hashcat_ctx);
         }
 
@@ -1536,14 +1623,21 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
         if (words_fin == 0) break;
       }
 
-      if (attack_mode == ATTACK_MODE_COMBI) hc_fclose (&device_param->combs_fp);
+      // a batch prefetched before an abort is dropped, but its upload has to finish before the buffers are reused
 
-      hc_fclose (&fp);
+      if (device_param->pws_prefetched == true)
+      {
+        if (run_copy_prefetch_wait (hashcat_ctx, device_param) == -1)
+        {
+          if (attack_mode == ATTACK_MODE_COMBI) hc_fclose (&device_param->combs_fp);
 
-      wl_data_destroy (hashcat_ctx_tmp);
+          return -1;
+        }
+      }
 
-      hcfree (hashcat_ctx_tmp->wl_data);
-      hcfree (hashcat_ctx_tmp);
+      device_param->pws_prefetch_cnt = 0;
+
+      if (attack_mode == ATTACK_MODE_COMBI) hc_fclose (&device_param->combs_fp);
     }
   }
 
@@ -79,6 +79,8 @@ size_t event_log_advice_nn (hashcat_ctx_t *hashcat_ctx, const char *fmt, ...)
 {
   event_ctx_t *event_ctx = hashcat_ctx->event_ctx;
 
+  hc_thread_mutex_lock (event_ctx->mux_log);
+
   if (fmt == NULL)
   {
     event_ctx->msg_buf[0] = 0;
@@ -100,13 +102,19 @@ size_t event_log_advice_nn (hashcat_ctx_t *hashcat_ctx, const char *fmt, ...)
 
   event_call (EVENT_LOG_ADVICE, hashcat_ctx, NULL, 0);
 
-  return event_ctx->msg_len;
+  const size_t msg_len = event_ctx->msg_len;
+
+  hc_thread_mutex_unlock (event_ctx->mux_log);
+
+  return msg_len;
 }
 
 size_t event_log_info_nn (hashcat_ctx_t *hashcat_ctx, const char *fmt, ...)
 {
   event_ctx_t *event_ctx = hashcat_ctx->event_ctx;
 
+  hc_thread_mutex_lock (event_ctx->mux_log);
+
   if (fmt == NULL)
   {
     event_ctx->msg_buf[0] = 0;
@@ -128,13 +136,19 @@ size_t event_log_info_nn (hashcat_ctx_t *hashcat_ctx, const char *fmt, ...)
 
   event_call (EVENT_LOG_INFO, hashcat_ctx, NULL, 0);
 
-  return event_ctx->msg_len;
+  const size_t msg_len = event_ctx->msg_len;
+
+  hc_thread_mutex_unlock (event_ctx->mux_log);
+
+  return msg_len;
 }
 
 size_t event_log_warning_nn (hashcat_ctx_t *hashcat_ctx, const char *fmt, ...)
 {
   event_ctx_t *event_ctx = hashcat_ctx->event_ctx;
 
+  hc_thread_mutex_lock (event_ctx->mux_log);
+
   if (fmt == NULL)
   {
     event_ctx->msg_buf[0] = 0;
@@ -156,13 +170,19 @@ size_t event_log_warning_nn (hashcat_ctx_t *hashcat_ctx, const char *fmt, ...)
 
   event_call (EVENT_LOG_WARNING, hashcat_ctx, NULL, 0);
 
-  return event_ctx->msg_len;
+  const size_t msg_len = event_ctx->msg_len;
+
+  hc_thread_mutex_unlock (event_ctx->mux_log);
+
+  return msg_len;
 }
 
 size_t event_log_error_nn (hashcat_ctx_t *hashcat_ctx, const char *fmt, ...)
 {
   event_ctx_t *event_ctx = hashcat_ctx->event_ctx;
 
+  hc_thread_mutex_lock (event_ctx->mux_log);
+
   if (fmt == NULL)
   {
     event_ctx->msg_buf[0] = 0;
@@ -184,13 +204,19 @@ size_t event_log_error_nn (hashcat_ctx_t *hashcat_ctx, const char *fmt, ...)
 
   event_call (EVENT_LOG_ERROR, hashcat_ctx, NULL, 0);
 
-  return event_ctx->msg_len;
+  const size_t msg_len = event_ctx->msg_len;
+
+  hc_thread_mutex_unlock (event_ctx->mux_log);
+
+  return msg_len;
 }
 
 size_t event_log_advice (hashcat_ctx_t *hashcat_ctx, const char *fmt, ...)
 {
   event_ctx_t *event_ctx = hashcat_ctx->event_ctx;
 
+  hc_thread_mutex_lock (event_ctx->mux_log);
+
   if (fmt == NULL)
   {
     event_ctx->msg_buf[0] = 0;
@@ -212,13 +238,19 @@ size_t event_log_advice (hashcat_ctx_t *hashcat_ctx, const char *fmt, ...)
 
   event_call (EVENT_LOG_ADVICE, hashcat_ctx, NULL, 0);
 
-  return event_ctx->msg_len;
+  const size_t msg_len = event_ctx->msg_len;
+
+  hc_thread_mutex_unlock (event_ctx->mux_log);
+
+  return msg_len;
 }
 
 size_t event_log_info (hashcat_ctx_t *hashcat_ctx, const char *fmt, ...)
 {
   event_ctx_t *event_ctx = hashcat_ctx->event_ctx;
 
+  hc_thread_mutex_lock (event_ctx->mux_log);
+
   if (fmt == NULL)
   {
     event_ctx->msg_buf[0] = 0;
@@ -240,13 +272,19 @@ size_t event_log_info (hashcat_ctx_t *hashcat_ctx, const char *fmt, ...)
 
   event_call (EVENT_LOG_INFO, hashcat_ctx, NULL, 0);
 
-  return event_ctx->msg_len;
+  const size_t msg_len = event_ctx->msg_len;
+
+  hc_thread_mutex_unlock (event_ctx->mux_log);
+
+  return msg_len;
 }
 
 size_t event_log_warning (hashcat_ctx_t *hashcat_ctx, const char *fmt, ...)
 {
   event_ctx_t *event_ctx = hashcat_ctx->event_ctx;
 
+  hc_thread_mutex_lock (event_ctx->mux_log);
+
   if (fmt == NULL)
   {
     event_ctx->msg_buf[0] = 0;
@@ -268,13 +306,19 @@ size_t event_log_warning (hashcat_ctx_t *hashcat_ctx, const char *fmt, ...)
 
   event_call (EVENT_LOG_WARNING, hashcat_ctx, NULL, 0);
 
-  return event_ctx->msg_len;
+  const size_t msg_len = event_ctx->msg_len;
+
+  hc_thread_mutex_unlock (event_ctx->mux_log);
+
+  return msg_len;
 }
 
 size_t event_log_error (hashcat_ctx_t *hashcat_ctx, const char *fmt, ...)
 {
   event_ctx_t *event_ctx = hashcat_ctx->event_ctx;
 
+  hc_thread_mutex_lock (event_ctx->mux_log);
+
   if (fmt == NULL)
   {
     event_ctx->msg_buf[0] = 0;
@@ -296,7 +340,11 @@ size_t event_log_error (hashcat_ctx_t *hashcat_ctx, const char *fmt, ...)
 
   event_call (EVENT_LOG_ERROR, hashcat_ctx, NULL, 0);
 
-  return event_ctx->msg_len;
+  const size_t msg_len = event_ctx->msg_len;
+
+  hc_thread_mutex_unlock (event_ctx->mux_log);
+
+  return msg_len;
 }
 
 int event_ctx_init (hashcat_ctx_t *hashcat_ctx)
@@ -306,6 +354,7 @@ int event_ctx_init (hashcat_ctx_t *hashcat_ctx)
   memset (event_ctx, 0, sizeof (event_ctx_t));
 
   hc_thread_mutex_init (event_ctx->mux_event);
+  hc_thread_mutex_init (event_ctx->mux_log);
 
   return 0;
 }
@@ -315,4 +364,5 @@ void event_ctx_destroy (hashcat_ctx_t *hashcat_ctx)
   event_ctx_t *event_ctx = hashcat_ctx->event_ctx;
 
   hc_thread_mutex_delete (event_ctx->mux_event);
+  hc_thread_mutex_delete (event_ctx->mux_log);
 }
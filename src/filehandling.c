@@ -7,8 +7,15 @@
 #include "types.h"
 #include "memory.h"
 #include "shared.h"
+#include "thread.h"
 #include "filehandling.h"
 
+#if defined (_POSIX)
+#include <sys/mman.h>
+#endif
+
+static bool hc_xz_open (HCFILE *fp);
+
 #if defined (__CYGWIN__)
 // workaround for zlib with cygwin build
 int _wopen (const char *path, int oflag, ...)
@@ -60,57 +67,814 @@ bool hc_fopen (HCFILE *fp, const char *path, char *mode)
     return false;
   }
 
-  fp->pfp = NULL;
-  fp->is_gzip = false;
-  fp->is_zip = false;
+  fp->pfp = NULL;
+  fp->is_gzip = false;
+  fp->is_zip = false;
+  fp->is_xz = false;
+  fp->is_mmap = false;
+
+  fp->mm_buf = NULL;
+  fp->mm_len = 0;
+  fp->mm_pos = 0;
+
+  fp->rd_buf = NULL;
+  fp->rd_len = 0;
+  fp->rd_pos = 0;
+
+  fp->gzs   = NULL;
+  fp->gzidx = NULL;
+
+  fp->xzs = NULL;
+
+  unsigned char check[6] = { 0 };
+
+  int fd_tmp = open (path, O_RDONLY);
+
+  if (fd_tmp != -1)
+  {
+    lseek (fd_tmp, 0, SEEK_SET);
+
+    if (read (fd_tmp, check, sizeof(check)) > 0)
+    {
+      if (check[0] == 0x1f && check[1] == 0x8b && check[2] == 0x08 && check[3] == 0x08) fp->is_gzip = true;
+      if (check[0] == 0x50 && check[1] == 0x4b && check[2] == 0x03 && check[3] == 0x04) fp->is_zip = true;
+
+      // xz stream header magic, or an LZMA-alone header with the default properties lc=3 lp=0 pb=2 and a dictionary size in multiples of 64k
+
+      if (strncmp (mode, "r", 1) == 0)
+      {
+        if (check[0] == 0xfd && check[1] == 0x37 && check[2] == 0x7a && check[3] == 0x58 && check[4] == 0x5a && check[5] == 0x00) fp->is_xz = true;
+        if (check[0] == 0x5d && check[1] == 0x00 && check[2] == 0x00)                                                               fp->is_xz = true;
+      }
+    }
+
+    close (fd_tmp);
+  }
+
+  if (fmode == -1)
+  {
+    fp->fd = open (path, oflag);
+  }
+  else
+  {
+    fp->fd = open (path, oflag, fmode);
+  }
+
+  if (fp->fd == -1 && fp->is_zip == false) return false;
+
+  if (fp->is_gzip)
+  {
+    if ((fp->gfp = gzdopen (fp->fd, mode)) == NULL) return false;
+  }
+  else if (fp->is_zip)
+  {
+    if ((fp->ufp = unzOpen64 (path)) == NULL) return false;
+
+    if (unzOpenCurrentFile (fp->ufp) != UNZ_OK) return false;
+  }
+  else if (fp->is_xz)
+  {
+    if (hc_xz_open (fp) == false)
+    {
+      close (fp->fd);
+
+      return false;
+    }
+  }
+  else
+  {
+    if ((fp->pfp = fdopen (fp->fd, mode)) == NULL)  return false;
+  }
+
+  fp->path = path;
+  fp->mode = mode;
+
+  return true;
+}
+
+// own gzip reader, used instead of gzread () once a checkpoint index is built or attached
+// the checkpoints allow to restart inflate in the middle of the stream, see zlib's examples/zran.c
+
+static int hc_gzs_fill (HCFILE *fp)
+{
+  hc_gzstream_t *gzs = fp->gzs;
+
+  if (gzs->strm.avail_in > 0) return 0;
+
+  if (lseek (fp->fd, (off_t) gzs->in_pos, SEEK_SET) == -1) return -1;
+
+  const ssize_t nread = read (fp->fd, gzs->in_buf, GZIDX_CHUNK);
+
+  if (nread <= 0) return -1;
+
+  gzs->strm.next_in  = gzs->in_buf;
+  gzs->strm.avail_in = (uInt) nread;
+
+  gzs->in_pos += (u64) nread;
+
+  return 0;
+}
+
+static void hc_gzs_restart (HCFILE *fp, const hc_gzidx_point_t *point)
+{
+  hc_gzstream_t *gzs = fp->gzs;
+
+  gzs->strm.next_in  = NULL;
+  gzs->strm.avail_in = 0;
+
+  gzs->member   = false;
+  gzs->eof      = false;
+  gzs->win_pend = 0;
+
+  // the checkpoints only stay consistent while inflating the whole file in one go
+
+  hc_gzidx_free (gzs->build);
+
+  gzs->build = NULL;
+
+  if (point == NULL)
+  {
+    inflateReset2 (&gzs->strm, 15 + 16);
+
+    gzs->raw      = false;
+    gzs->in_pos   = 0;
+    gzs->win_have = 0;
+    gzs->win_pos  = 0;
+    gzs->out_pos  = 0;
+
+    return;
+  }
+
+  // the block starts inside the byte before point->in, its remaining bits have to be fed to inflate first
+
+  inflateReset2 (&gzs->strm, -15);
+
+  gzs->raw    = true;
+  gzs->in_pos = point->in - ((point->bits > 0) ? 1 : 0);
+
+  if (point->bits > 0)
+  {
+    if (hc_gzs_fill (fp) == -1)
+    {
+      gzs->eof = true;
+
+      return;
+    }
+
+    const int c = gzs->strm.next_in[0];
+
+    gzs->strm.next_in++;
+    gzs->strm.avail_in--;
+
+    inflatePrime (&gzs->strm, (int) point->bits, c >> (8 - point->bits));
+  }
+
+  inflateSetDictionary (&gzs->strm, point->window, GZIDX_WINSIZE);
+
+  memcpy (gzs->window, point->window, GZIDX_WINSIZE);
+
+  gzs->win_have = GZIDX_WINSIZE;
+  gzs->win_pos  = GZIDX_WINSIZE;
+  gzs->out_pos  = point->out;
+}
+
+static void hc_gzs_record (hc_gzstream_t *gzs)
+{
+  hc_gzidx_t *gzidx = gzs->build;
+
+  const u64 out = gzs->out_pos + gzs->win_pend;
+
+  // at the end of a block, but not the last one, and with a full window of history
+
+  if ((gzs->strm.data_type & 128) == 0) return;
+  if ((gzs->strm.data_type &  64) != 0) return;
+
+  if (gzs->win_have < GZIDX_WINSIZE) return;
+
+  if ((out - gzs->build_last) < gzidx->span) return;
+
+  if (gzidx->cnt == gzidx->avail)
+  {
+    gzidx->points = (hc_gzidx_point_t *) hcrealloc (gzidx->points, gzidx->avail * sizeof (hc_gzidx_point_t), INCR_GZIDX * sizeof (hc_gzidx_point_t));
+
+    gzidx->avail += INCR_GZIDX;
+  }
+
+  hc_gzidx_point_t *point = gzidx->points + gzidx->cnt;
+
+  point->out  = out;
+  point->in   = gzs->in_pos - gzs->strm.avail_in;
+  point->bits = (u64) (gzs->strm.data_type & 7);
+
+  // unroll the ring, the oldest byte sits at win_pos
+
+  const u32 tail = GZIDX_WINSIZE - gzs->win_pos;
+
+  memcpy (point->window,        gzs->window + gzs->win_pos, tail);
+  memcpy (point->window + tail, gzs->window,                gzs->win_pos);
+
+  gzidx->cnt++;
+
+  gzs->build_last = out;
+}
+
+static int hc_gzs_inflate (HCFILE *fp)
+{
+  hc_gzstream_t *gzs = fp->gzs;
+
+  if (gzs->win_pos == GZIDX_WINSIZE) gzs->win_pos = 0;
+
+  // inflate may still hold output of a match even if there is no more input
+
+  hc_gzs_fill (fp);
+
+  const u32 space = GZIDX_WINSIZE - gzs->win_pos;
+
+  gzs->strm.next_out  = gzs->window + gzs->win_pos;
+  gzs->strm.avail_out = space;
+
+  const int rc = inflate (&gzs->strm, Z_BLOCK);
+
+  const u32 produced = space - gzs->strm.avail_out;
+
+  gzs->win_pos  += produced;
+  gzs->win_have  = MIN (gzs->win_have + produced, GZIDX_WINSIZE);
+  gzs->win_pend  = produced;
+
+  if ((rc == Z_NEED_DICT) || (rc == Z_DATA_ERROR) || (rc == Z_MEM_ERROR) || (rc == Z_STREAM_ERROR))
+  {
+    gzs->eof = true;
+
+    // like gzread (), data after the last complete member is ignored
+
+    return (gzs->member == true) ? 0 : -1;
+  }
+
+  if ((rc == Z_BUF_ERROR) && (produced == 0))
+  {
+    // truncated file
+
+    gzs->eof = true;
+
+    return 0;
+  }
+
+  if (produced > 0) gzs->member = false;
+
+  if (gzs->build != NULL) hc_gzs_record (gzs);
+
+  if (rc != Z_STREAM_END) return 0;
+
+  // end of a member, skip the trailer that inflate does not read in raw mode and continue with the next one
+
+  if (gzs->raw == true)
+  {
+    u32 skip = 8;
+
+    while (skip > 0)
+    {
+      if (hc_gzs_fill (fp) == -1) break;
+
+      const u32 take = MIN (skip, gzs->strm.avail_in);
+
+      gzs->strm.next_in  += take;
+      gzs->strm.avail_in -= take;
+
+      skip -= take;
+    }
+
+    gzs->raw = false;
+  }
+
+  if (hc_gzs_fill (fp) == -1)
+  {
+    gzs->eof = true;
+
+    return 0;
+  }
+
+  inflateReset2 (&gzs->strm, 15 + 16);
+
+  gzs->member = true;
+
+  return 0;
+}
+
+static size_t hc_gzs_read (HCFILE *fp, void *ptr, const size_t len)
+{
+  hc_gzstream_t *gzs = fp->gzs;
+
+  size_t got = 0;
+
+  while (got < len)
+  {
+    if (gzs->win_pend > 0)
+    {
+      const u32 take = (u32) MIN ((size_t) gzs->win_pend, len - got);
+
+      if (ptr != NULL) memcpy ((u8 *) ptr + got, gzs->window + gzs->win_pos - gzs->win_pend, take);
+
+      gzs->win_pend -= take;
+      gzs->out_pos  += take;
+
+      got += take;
+
+      continue;
+    }
+
+    if (gzs->eof == true) break;
+
+    if (hc_gzs_inflate (fp) == -1) break;
+  }
+
+  return got;
+}
+
+static int hc_gzs_seek (HCFILE *fp, off_t offset, int whence)
+{
+  hc_gzstream_t *gzs = fp->gzs;
+
+  if (whence == SEEK_CUR) offset += (off_t) gzs->out_pos;
+  else if (whence != SEEK_SET) return -1;
+
+  if (offset < 0) return -1;
+
+  const u64 target = (u64) offset;
+
+  // closest checkpoint at or before the target
+
+  const hc_gzidx_point_t *point = NULL;
+
+  if (fp->gzidx != NULL)
+  {
+    u64 lo = 0;
+    u64 hi = fp->gzidx->cnt;
+
+    while (lo < hi)
+    {
+      const u64 mid = lo + ((hi - lo) / 2);
+
+      if (fp->gzidx->points[mid].out <= target) lo = mid + 1; else hi = mid;
+    }
+
+    if (lo > 0) point = fp->gzidx->points + (lo - 1);
+  }
+
+  // keep inflating from the current position if that is closer than any restart
+
+  const bool forward = (target >= gzs->out_pos) && ((point == NULL) || (point->out <= gzs->out_pos));
+
+  if (forward == false) hc_gzs_restart (fp, point);
+
+  const u64 skip = target - gzs->out_pos;
+
+  if (hc_gzs_read (fp, NULL, skip) != skip) return -1;
+
+  return 0;
+}
+
+static bool hc_gzs_init (HCFILE *fp)
+{
+  if (fp->gzs != NULL) return true;
+
+  if (fp->is_gzip == false) return false;
+
+  if (strncmp (fp->mode, "r", 1) != 0) return false;
+
+  hc_gzstream_t *gzs = (hc_gzstream_t *) hccalloc (1, sizeof (hc_gzstream_t));
+
+  if (inflateInit2 (&gzs->strm, 15 + 16) != Z_OK)
+  {
+    hcfree (gzs);
+
+    return false;
+  }
+
+  gzs->in_buf = (u8 *) hcmalloc (GZIDX_CHUNK);
+
+  fp->gzs = gzs;
+
+  return true;
+}
+
+static void hc_gzs_destroy (HCFILE *fp)
+{
+  hc_gzstream_t *gzs = fp->gzs;
+
+  if (gzs == NULL) return;
+
+  inflateEnd (&gzs->strm);
+
+  hc_gzidx_free (gzs->build);
+
+  hcfree (gzs->in_buf);
+  hcfree (gzs);
+
+  fp->gzs = NULL;
+}
+
+bool hc_gzidx_build (HCFILE *fp, const u64 span)
+{
+  if (fp == NULL) return false;
+
+  // the checkpoints are recorded while the file is read from the start
+
+  if (fp->gzs != NULL) return false;
+
+  if (fp->is_gzip == false) return false;
+
+  if (gztell (fp->gfp) != 0) return false;
+
+  if (hc_gzs_init (fp) == false) return false;
+
+  hc_gzidx_t *gzidx = (hc_gzidx_t *) hccalloc (1, sizeof (hc_gzidx_t));
+
+  gzidx->span = span;
+
+  fp->gzs->build      = gzidx;
+  fp->gzs->build_last = 0;
+
+  return true;
+}
+
+hc_gzidx_t *hc_gzidx_release (HCFILE *fp)
+{
+  if (fp == NULL) return NULL;
+
+  if (fp->gzs == NULL) return NULL;
+
+  hc_gzidx_t *gzidx = fp->gzs->build;
+
+  fp->gzs->build = NULL;
+
+  return gzidx;
+}
+
+void hc_gzidx_attach (HCFILE *fp, const hc_gzidx_t *gzidx)
+{
+  if (fp == NULL) return;
+
+  if (fp->is_gzip == false) return;
+
+  fp->gzidx = gzidx;
+}
+
+void hc_gzidx_free (hc_gzidx_t *gzidx)
+{
+  if (gzidx == NULL) return;
+
+  hcfree (gzidx->points);
+  hcfree (gzidx);
+}
+
+// .xz and .lzma files are decoded by a thread a few blocks ahead of the reader,
+// so that decoding overlaps with whatever the reader does with the data
+
+// the xz unpacker keeps a pointer to it
+
+static const ISzAlloc hc_xz_alloc = { hc_lzma_alloc, hc_lzma_free };
+
+static int hc_xz_decode (HCFILE *fp, u8 *out, const size_t out_size, size_t *out_len)
+{
+  hc_xzstream_t *xzs = fp->xzs;
+
+  while (*out_len < out_size)
+  {
+    if ((xzs->in_pos == xzs->in_len) && (xzs->in_eof == false))
+    {
+      const ssize_t nread = read (fp->fd, xzs->in_buf, XZ_IN_SIZE);
+
+      if (nread == -1) return -1;
+
+      xzs->in_len = (size_t) nread;
+      xzs->in_pos = 0;
+
+      if (nread == 0) xzs->in_eof = true;
+    }
+
+    SizeT src_len = xzs->in_len - xzs->in_pos;
+    SizeT dst_len = out_size - *out_len;
+
+    if (xzs->lzma_alone == true)
+    {
+      if (xzs->lzma_left < dst_len) dst_len = xzs->lzma_left;
+
+      ELzmaStatus status;
+
+      const SRes res = LzmaDec_DecodeToBuf (&xzs->lzma, out + *out_len, &dst_len, xzs->in_buf + xzs->in_pos, &src_len, LZMA_FINISH_ANY, &status);
+
+      xzs->in_pos += src_len;
+
+      *out_len += dst_len;
+
+      if (xzs->lzma_left != (u64) -1) xzs->lzma_left -= dst_len;
+
+      if (res != SZ_OK) return -1;
+
+      if (status == LZMA_STATUS_FINISHED_WITH_MARK) return 1;
+
+      if (xzs->lzma_left == 0) return 1;
+
+      if ((xzs->in_eof == true) && (src_len == 0) && (dst_len == 0)) return (status == LZMA_STATUS_MAYBE_FINISHED_WITHOUT_MARK) ? 1 : -1;
+    }
+    else
+    {
+      ECoderStatus status;
+
+      const SRes res = XzUnpacker_Code (&xzs->xz, out + *out_len, &dst_len, xzs->in_buf + xzs->in_pos, &src_len, xzs->in_eof, CODER_FINISH_ANY, &status);
+
+      xzs->in_pos += src_len;
+
+      *out_len += dst_len;
+
+      // like gzread (), data after the last complete stream is ignored
+
+      if (res == SZ_ERROR_NO_ARCHIVE) return (XzUnpacker_IsStreamWasFinished (&xzs->xz) == True) ? 1 : -1;
+
+      if (res != SZ_OK) return -1;
+
+      if ((xzs->in_eof == true) && (src_len == 0) && (dst_len == 0)) return (XzUnpacker_IsStreamWasFinished (&xzs->xz) == True) ? 1 : -1;
+    }
+  }
+
+  return 0;
+}
+
+static HC_API_CALL void *hc_xz_thread (void *p)
+{
+  HCFILE *fp = (HCFILE *) p;
+
+  hc_xzstream_t *xzs = fp->xzs;
+
+  while (hc_atomic_load (&xzs->run) == true)
+  {
+    const u64 put = xzs->blocks_put;
+
+    if ((put - hc_atomic_load (&xzs->blocks_get)) == XZ_BLOCKS)
+    {
+      usleep (XZ_WAIT_USEC);
+
+      continue;
+    }
+
+    const u32 slot = put % XZ_BLOCKS;
+
+    size_t len = 0;
+
+    const int rc = hc_xz_decode (fp, xzs->blocks[slot], XZ_BLOCK_SIZE, &len);
+
+    xzs->blocks_len[slot] = len;
+
+    if (len > 0) hc_atomic_store (&xzs->blocks_put, put + 1);
+
+    if (rc == 0) continue;
+
+    // corrupt or truncated input, the reader sees it through hc_ferror () once the decoded blocks are consumed
+
+    if (rc == -1) hc_atomic_store (&xzs->error, true);
+
+    break;
+  }
+
+  hc_atomic_store (&xzs->finished, true);
+
+  return NULL;
+}
+
+static bool hc_xz_open (HCFILE *fp)
+{
+  if (lseek (fp->fd, 0, SEEK_SET) == -1) return false;
+
+  hc_xzstream_t *xzs = (hc_xzstream_t *) hccalloc (1, sizeof (hc_xzstream_t));
+
+  u8 check[XZ_SIG_SIZE] = { 0 };
+
+  if (read (fp->fd, check, XZ_SIG_SIZE) != XZ_SIG_SIZE)
+  {
+    hcfree (xzs);
+
+    return false;
+  }
+
+  if (lseek (fp->fd, 0, SEEK_SET) == -1)
+  {
+    hcfree (xzs);
+
+    return false;
+  }
+
+  xzs->lzma_alone = (memcmp (check, XZ_SIG, XZ_SIG_SIZE) != 0);
+
+  // the tables are filled with the same values on every call
+
+  CrcGenerateTable ();
+  Crc64GenerateTable ();
+
+  if (xzs->lzma_alone == true)
+  {
+    // LZMA-alone header: properties, dictionary size, uncompressed size or -1
+
+    u8 header[LZMA_PROPS_SIZE + 8];
+
+    if (read (fp->fd, header, sizeof (header)) != (ssize_t) sizeof (header))
+    {
+      hcfree (xzs);
+
+      return false;
+    }
+
+    LzmaDec_Construct (&xzs->lzma);
+
+    if (LzmaDec_Allocate (&xzs->lzma, header, LZMA_PROPS_SIZE, &hc_xz_alloc) != SZ_OK)
+    {
+      hcfree (xzs);
+
+      return false;
+    }
+
+    LzmaDec_Init (&xzs->lzma);
+
+    memcpy (&xzs->lzma_left, header + LZMA_PROPS_SIZE, 8);
+  }
+  else
+  {
+    XzUnpacker_Construct (&xzs->xz, &hc_xz_alloc);
+    XzUnpacker_Init      (&xzs->xz);
+  }
+
+  xzs->in_buf = (u8 *) hcmalloc (XZ_IN_SIZE);
+
+  for (int i = 0; i < XZ_BLOCKS; i++) xzs->blocks[i] = (u8 *) hcmalloc (XZ_BLOCK_SIZE);
+
+  xzs->run = true;
+
+  fp->xzs = xzs;
+
+  hc_thread_create (xzs->thread, hc_xz_thread, fp);
+
+  return true;
+}
+
+static void hc_xz_close (HCFILE *fp)
+{
+  hc_xzstream_t *xzs = fp->xzs;
+
+  if (xzs == NULL) return;
+
+  hc_atomic_store (&xzs->run, false);
+
+  hc_thread_wait (1, &xzs->thread);
+
+  if (xzs->lzma_alone == true)
+  {
+    LzmaDec_Free (&xzs->lzma, &hc_xz_alloc);
+  }
+  else
+  {
+    XzUnpacker_Free (&xzs->xz);
+  }
+
+  for (int i = 0; i < XZ_BLOCKS; i++) hcfree (xzs->blocks[i]);
+
+  hcfree (xzs->in_buf);
+  hcfree (xzs);
+
+  fp->xzs = NULL;
+}
+
+static size_t hc_xz_read (HCFILE *fp, void *ptr, const size_t len)
+{
+  hc_xzstream_t *xzs = fp->xzs;
+
+  size_t got = 0;
+
+  while (got < len)
+  {
+    const u64 get = xzs->blocks_get;
+
+    if (get == hc_atomic_load (&xzs->blocks_put))
+    {
+      // the last block may have been put right before the thread finished
+
+      if (hc_atomic_load (&xzs->finished) == true)
+      {
+        if (get == hc_atomic_load (&xzs->blocks_put)) break;
+
+        continue;
+      }
+
+      usleep (XZ_WAIT_USEC);
+
+      continue;
+    }
+
+    const u32 slot = get % XZ_BLOCKS;
 
-  unsigned char check[4] = { 0 };
+    const size_t take = MIN (xzs->blocks_len[slot] - xzs->block_pos, len - got);
 
-  int fd_tmp = open (path, O_RDONLY);
+    if (ptr != NULL) memcpy ((u8 *) ptr + got, xzs->blocks[slot] + xzs->block_pos, take);
 
-  if (fd_tmp != -1)
-  {
-    lseek (fd_tmp, 0, SEEK_SET);
+    xzs->block_pos += take;
+    xzs->out_pos   += take;
 
-    if (read (fd_tmp, check, sizeof(check)) > 0)
+    got += take;
+
+    if (xzs->block_pos == xzs->blocks_len[slot])
     {
-      if (check[0] == 0x1f && check[1] == 0x8b && check[2] == 0x08 && check[3] == 0x08) fp->is_gzip = true;
-      if (check[0] == 0x50 && check[1] == 0x4b && check[2] == 0x03 && check[3] == 0x04) fp->is_zip = true;
+      xzs->block_pos = 0;
+
+      hc_atomic_store (&xzs->blocks_get, get + 1);
     }
+  }
 
-    close (fd_tmp);
+  return got;
+}
+
+static bool hc_xz_eof (HCFILE *fp)
+{
+  hc_xzstream_t *xzs = fp->xzs;
+
+  if (hc_atomic_load (&xzs->finished) == false) return false;
+
+  return (xzs->blocks_get == hc_atomic_load (&xzs->blocks_put));
+}
+
+static int hc_xz_seek (HCFILE *fp, off_t offset, int whence)
+{
+  if (whence == SEEK_CUR) offset += (off_t) fp->xzs->out_pos;
+  else if (whence != SEEK_SET) return -1;
+
+  if (offset < 0) return -1;
+
+  const u64 target = (u64) offset;
+
+  // there is no random access, seeking backwards decodes again from the start
+
+  if (target < fp->xzs->out_pos)
+  {
+    hc_xz_close (fp);
+
+    if (hc_xz_open (fp) == false) return -1;
   }
 
-  if (fmode == -1)
+  const u64 skip = target - fp->xzs->out_pos;
+
+  if (hc_xz_read (fp, NULL, skip) != skip) return -1;
+
+  return 0;
+}
+
+static size_t hc_fread_direct (void *ptr, size_t size, size_t nmemb, HCFILE *fp)
+{
+  size_t n = -1;
+
+  if (fp->gzs != NULL)
   {
-    fp->fd = open (path, oflag);
+    n = (size) ? hc_gzs_read (fp, ptr, size * nmemb) / size : 0;
   }
-  else
+  else if (fp->is_gzip)
   {
-    fp->fd = open (path, oflag, fmode);
+    n = gzfread (ptr, size, nmemb, fp->gfp);
   }
+  else if (fp->is_zip)
+  {
+    unsigned s = size * nmemb;
 
-  if (fp->fd == -1 && fp->is_zip == false) return false;
-
-  if (fp->is_gzip)
+    n = unzReadCurrentFile (fp->ufp, ptr, s);
+  }
+  else if (fp->is_xz)
   {
-    if ((fp->gfp = gzdopen (fp->fd, mode)) == NULL) return false;
+    n = (size) ? hc_xz_read (fp, ptr, size * nmemb) / size : 0;
   }
-  else if (fp->is_zip)
+  else if (fp->is_mmap)
   {
-    if ((fp->ufp = unzOpen64 (path)) == NULL) return false;
+    const u64 left = (fp->mm_pos < fp->mm_len) ? fp->mm_len - fp->mm_pos : 0;
 
-    if (unzOpenCurrentFile (fp->ufp) != UNZ_OK) return false;
+    n = (size) ? MIN (nmemb, left / size) : 0;
+
+    memcpy (ptr, fp->mm_buf + fp->mm_pos, n * size);
+
+    fp->mm_pos += n * size;
   }
   else
   {
-    if ((fp->pfp = fdopen (fp->fd, mode)) == NULL)  return false;
+    n = fread (ptr, size, nmemb, fp->pfp);
   }
 
-  fp->path = path;
-  fp->mode = mode;
+  return n;
+}
 
-  return true;
+// bytes read ahead by fgetl () and not yet consumed, every read function has to take them first
+
+static size_t hc_fbuf_left (const HCFILE *fp)
+{
+  return fp->rd_len - fp->rd_pos;
+}
+
+static void hc_fbuf_drop (HCFILE *fp)
+{
+  fp->rd_len = 0;
+  fp->rd_pos = 0;
 }
 
 size_t hc_fread (void *ptr, size_t size, size_t nmemb, HCFILE *fp)
@@ -119,24 +883,89 @@ size_t hc_fread (void *ptr, size_t size, size_t nmemb, HCFILE *fp)
 
   if (fp == NULL) return n;
 
-  if (fp->is_gzip)
-  {
-    n = gzfread (ptr, size, nmemb, fp->gfp);
-  }
-  else if (fp->is_zip)
-  {
-    unsigned s = size * nmemb;
+  const size_t left = hc_fbuf_left (fp);
 
-    n = unzReadCurrentFile (fp->ufp, ptr, s);
-  }
-  else
+  if (left == 0) return hc_fread_direct (ptr, size, nmemb, fp);
+
+  if (size == 0) return 0;
+
+  const size_t want = size * nmemb;
+
+  const size_t copy = MIN (want, left);
+
+  memcpy (ptr, fp->rd_buf + fp->rd_pos, copy);
+
+  fp->rd_pos += copy;
+
+  size_t got = copy;
+
+  if (got < want)
   {
-    n = fread (ptr, size, nmemb, fp->pfp);
+    const size_t r = hc_fread_direct ((char *) ptr + got, 1, want - got, fp);
+
+    if ((r != (size_t) -1) && (r <= (want - got))) got += r;
   }
 
+  n = got / size;
+
   return n;
 }
 
+bool hc_fmmap (HCFILE *fp)
+{
+  if (fp == NULL) return false;
+
+  if (fp->is_mmap) return true;
+
+  #if defined (_POSIX)
+
+  if (hc_fbuf_left (fp) > 0) return false;
+
+  // only uncompressed files opened for reading, compressed files stay on the buffered path
+
+  if (fp->is_gzip || fp->is_zip) return false;
+
+  if (fp->pfp == NULL) return false;
+
+  if (strncmp (fp->mode, "r", 1) != 0) return false;
+
+  struct stat s;
+
+  if (fstat (fp->fd, &s) == -1) return false;
+
+  if (S_ISREG (s.st_mode) == 0) return false;
+
+  if (s.st_size <= 0) return false;
+
+  if ((u64) s.st_size > (u64) SIZE_MAX) return false;
+
+  const off_t pos = ftello (fp->pfp);
+
+  if (pos == -1) return false;
+
+  // read-only mapping: words which get uppercased or hex decoded are copied out first, see get_next_word_decode ()
+
+  char *buf = (char *) mmap (NULL, (size_t) s.st_size, PROT_READ, MAP_PRIVATE, fp->fd, 0);
+
+  if (buf == MAP_FAILED) return false;
+
+  madvise (buf, (size_t) s.st_size, MADV_SEQUENTIAL);
+
+  fp->mm_buf = buf;
+  fp->mm_len = (u64) s.st_size;
+  fp->mm_pos = (u64) pos;
+
+  fp->is_mmap = true;
+
+  return true;
+
+  #else
+
+  return false;
+
+  #endif
+}
+
 size_t hc_fwrite (const void *ptr, size_t size, size_t nmemb, HCFILE *fp)
 {
   size_t n = -1;
@@ -166,9 +995,38 @@ int hc_fseek (HCFILE *fp, off_t offset, int whence)
 
   if (fp == NULL) return r;
 
+  if (whence == SEEK_CUR) offset -= (off_t) hc_fbuf_left (fp);
+
+  hc_fbuf_drop (fp);
+
   if (fp->is_gzip)
   {
-    r = gzseek (fp->gfp, offset, whence);
+    // with checkpoints the seek restarts inflate close to the target instead of at the start of the file
+
+    if ((fp->gzs == NULL) && (fp->gzidx != NULL))
+    {
+      if (whence == SEEK_CUR)
+      {
+        offset += (off_t) gztell (fp->gfp);
+
+        whence = SEEK_SET;
+      }
+
+      hc_gzs_init (fp);
+    }
+
+    if (fp->gzs != NULL)
+    {
+      r = hc_gzs_seek (fp, offset, whence);
+    }
+    else
+    {
+      r = gzseek (fp->gfp, offset, whence);
+    }
+  }
+  else if (fp->is_xz)
+  {
+    r = hc_xz_seek (fp, offset, whence);
   }
   else if (fp->is_zip)
   {
@@ -191,6 +1049,20 @@ int hc_fseek (HCFILE *fp, off_t offset, int whence)
     // r = unzSetOffset (fp->ufp, offset);
     */
   }
+  else if (fp->is_mmap)
+  {
+    off_t base = 0;
+
+    if (whence == SEEK_CUR) base = (off_t) fp->mm_pos;
+    if (whence == SEEK_END) base = (off_t) fp->mm_len;
+
+    if ((base + offset) >= 0)
+    {
+      fp->mm_pos = (u64) (base + offset);
+
+      r = 0;
+    }
+  }
   else
   {
     r = fseeko (fp->pfp, offset, whence);
@@ -203,7 +1075,13 @@ void hc_rewind (HCFILE *fp)
 {
   if (fp == NULL) return;
 
-  if (fp->is_gzip)
+  hc_fbuf_drop (fp);
+
+  if (fp->gzs != NULL)
+  {
+    if (fp->gzs->out_pos > 0) hc_gzs_restart (fp, NULL);
+  }
+  else if (fp->is_gzip)
   {
     gzrewind (fp->gfp);
   }
@@ -211,6 +1089,14 @@ void hc_rewind (HCFILE *fp)
   {
     unzGoToFirstFile (fp->ufp);
   }
+  else if (fp->is_xz)
+  {
+    hc_xz_seek (fp, 0, SEEK_SET);
+  }
+  else if (fp->is_mmap)
+  {
+    fp->mm_pos = 0;
+  }
   else
   {
     rewind (fp->pfp);
@@ -223,7 +1109,11 @@ off_t hc_ftell (HCFILE *fp)
 
   if (fp == NULL) return -1;
 
-  if (fp->is_gzip)
+  if (fp->gzs != NULL)
+  {
+    n = (off_t) fp->gzs->out_pos;
+  }
+  else if (fp->is_gzip)
   {
     n = (off_t) gztell (fp->gfp);
   }
@@ -231,11 +1121,21 @@ off_t hc_ftell (HCFILE *fp)
   {
     n = unztell (fp->ufp);
   }
+  else if (fp->is_xz)
+  {
+    n = (off_t) fp->xzs->out_pos;
+  }
+  else if (fp->is_mmap)
+  {
+    n = (off_t) fp->mm_pos;
+  }
   else
   {
     n = ftello (fp->pfp);
   }
 
+  if (n > 0) n -= (off_t) hc_fbuf_left (fp);
+
   return n;
 }
 
@@ -266,7 +1166,15 @@ int hc_fgetc (HCFILE *fp)
 
   if (fp == NULL) return r;
 
-  if (fp->is_gzip)
+  if (hc_fbuf_left (fp) > 0) return (int) (u8) fp->rd_buf[fp->rd_pos++];
+
+  if (fp->gzs != NULL)
+  {
+    unsigned char c = 0;
+
+    if (hc_gzs_read (fp, &c, 1) == 1) r = (int) c;
+  }
+  else if (fp->is_gzip)
   {
     r = gzgetc (fp->gfp);
   }
@@ -276,6 +1184,16 @@ int hc_fgetc (HCFILE *fp)
 
     if (unzReadCurrentFile (fp->ufp, &c, 1) == 1) r = (int) c;
   }
+  else if (fp->is_xz)
+  {
+    unsigned char c = 0;
+
+    if (hc_xz_read (fp, &c, 1) == 1) r = (int) c;
+  }
+  else if (fp->is_mmap)
+  {
+    if (fp->mm_pos < fp->mm_len) r = (int) (u8) fp->mm_buf[fp->mm_pos++];
+  }
   else
   {
     r = fgetc (fp->pfp);
@@ -290,7 +1208,52 @@ char *hc_fgets (char *buf, int len, HCFILE *fp)
 
   if (fp == NULL) return r;
 
-  if (fp->is_gzip)
+  if (hc_fbuf_left (fp) > 0)
+  {
+    const size_t left = hc_fbuf_left (fp);
+
+    const char *start = fp->rd_buf + fp->rd_pos;
+
+    const char *next = (const char *) memchr (start, '\n', left);
+
+    size_t take = (next == NULL) ? left : (size_t) (next - start) + 1;
+
+    if (take > (size_t) (len - 1)) take = (size_t) (len - 1);
+
+    memcpy (buf, start, take);
+
+    buf[take] = 0;
+
+    fp->rd_pos += take;
+
+    // the line continues beyond the read-ahead buffer
+
+    if ((next == NULL) && (take == left) && ((int) take < (len - 1)))
+    {
+      if (hc_fgets (buf + take, len - (int) take, fp) == NULL) buf[take] = 0;
+    }
+
+    return buf;
+  }
+
+  if (fp->gzs != NULL)
+  {
+    int i = 0;
+
+    unsigned char c = 0;
+
+    while ((i < (len - 1)) && (hc_gzs_read (fp, &c, 1) == 1))
+    {
+      buf[i++] = (char) c;
+
+      if (c == '\n') break;
+    }
+
+    buf[i] = 0;
+
+    if (i > 0) r = buf;
+  }
+  else if (fp->is_gzip)
   {
     r = gzgets (fp->gfp, buf, len);
   }
@@ -298,6 +1261,40 @@ char *hc_fgets (char *buf, int len, HCFILE *fp)
   {
     if (unzReadCurrentFile (fp->ufp, buf, len) > 0) r = buf;
   }
+  else if (fp->is_xz)
+  {
+    int i = 0;
+
+    unsigned char c = 0;
+
+    while ((i < (len - 1)) && (hc_xz_read (fp, &c, 1) == 1))
+    {
+      buf[i++] = (char) c;
+
+      if (c == '\n') break;
+    }
+
+    buf[i] = 0;
+
+    if (i > 0) r = buf;
+  }
+  else if (fp->is_mmap)
+  {
+    int i = 0;
+
+    while ((i < (len - 1)) && (fp->mm_pos < fp->mm_len))
+    {
+      const char c = fp->mm_buf[fp->mm_pos++];
+
+      buf[i++] = c;
+
+      if (c == '\n') break;
+    }
+
+    buf[i] = 0;
+
+    if (i > 0) r = buf;
+  }
   else
   {
     r = fgets (buf, len, fp->pfp);
@@ -391,7 +1388,13 @@ int hc_feof (HCFILE *fp)
 
   if (fp == NULL) return r;
 
-  if (fp->is_gzip)
+  if (hc_fbuf_left (fp) > 0) return 0;
+
+  if (fp->gzs != NULL)
+  {
+    r = ((fp->gzs->eof == true) && (fp->gzs->win_pend == 0));
+  }
+  else if (fp->is_gzip)
   {
     r = gzeof (fp->gfp);
   }
@@ -399,6 +1402,14 @@ int hc_feof (HCFILE *fp)
   {
     r = unzeof (fp->ufp);
   }
+  else if (fp->is_xz)
+  {
+    r = hc_xz_eof (fp);
+  }
+  else if (fp->is_mmap)
+  {
+    r = (fp->mm_pos >= fp->mm_len);
+  }
   else
   {
     r = feof (fp->pfp);
@@ -407,6 +1418,23 @@ int hc_feof (HCFILE *fp)
   return r;
 }
 
+int hc_ferror (HCFILE *fp)
+{
+  if (fp == NULL) return -1;
+
+  if (fp->is_xz)
+  {
+    return (hc_atomic_load (&fp->xzs->error) == true);
+  }
+
+  if ((fp->is_gzip == false) && (fp->is_zip == false) && (fp->pfp != NULL))
+  {
+    return ferror (fp->pfp);
+  }
+
+  return 0;
+}
+
 void hc_fflush (HCFILE *fp)
 {
   if (fp == NULL) return;
@@ -418,6 +1446,9 @@ void hc_fflush (HCFILE *fp)
   else if (fp->is_zip)
   {
   }
+  else if (fp->is_xz)
+  {
+  }
   else
   {
     fflush (fp->pfp);
@@ -430,6 +1461,8 @@ void hc_fclose (HCFILE *fp)
 
   if (fp->is_gzip)
   {
+    hc_gzs_destroy (fp);
+
     gzclose (fp->gfp);
   }
   else if (fp->is_zip)
@@ -438,8 +1471,18 @@ void hc_fclose (HCFILE *fp)
 
     unzClose (fp->ufp);
   }
+  else if (fp->is_xz)
+  {
+    hc_xz_close (fp);
+
+    close (fp->fd);
+  }
   else
   {
+    #if defined (_POSIX)
+    if (fp->is_mmap) munmap (fp->mm_buf, (size_t) fp->mm_len);
+    #endif
+
     fclose (fp->pfp);
   }
 
@@ -447,6 +1490,20 @@ void hc_fclose (HCFILE *fp)
   fp->pfp = NULL;
   fp->is_gzip = false;
   fp->is_zip = false;
+  fp->is_xz = false;
+  fp->is_mmap = false;
+
+  fp->mm_buf = NULL;
+  fp->mm_len = 0;
+  fp->mm_pos = 0;
+
+  hcfree (fp->rd_buf);
+
+  fp->rd_buf = NULL;
+  fp->rd_len = 0;
+  fp->rd_pos = 0;
+
+  fp->gzidx = NULL;
 
   fp->path = NULL;
   fp->mode = NULL;
@@ -458,24 +1515,45 @@ size_t fgetl (HCFILE *fp, char *line_buf, const size_t line_sz)
 
   size_t line_len = 0;
 
-  while (!hc_feof (fp))
-  {
-    const int c = hc_fgetc (fp);
+  // read ahead in blocks and split the lines with memchr () instead of going through hc_fgetc () for every byte
 
-    if (c == EOF) break;
+  if (fp->rd_buf == NULL) fp->rd_buf = (char *) hcmalloc (HCBUFSIZ_LARGE);
 
-    if (line_len == line_sz)
+  while (true)
+  {
+    if (hc_fbuf_left (fp) == 0)
     {
-      line_truncated++;
+      if (hc_feof (fp)) break;
 
-      continue;
+      const size_t nread = hc_fread_direct (fp->rd_buf, 1, HCBUFSIZ_LARGE, fp);
+
+      if ((nread == 0) || (nread > HCBUFSIZ_LARGE)) break;
+
+      fp->rd_len = nread;
+      fp->rd_pos = 0;
     }
 
-    line_buf[line_len] = (char) c;
+    const char *start = fp->rd_buf + fp->rd_pos;
+
+    const size_t left = hc_fbuf_left (fp);
+
+    const char *next = (const char *) memchr (start, '\n', left);
+
+    // the newline itself is consumed but never copied, so it can't count as truncated data
 
-    line_len++;
+    const size_t take = (next == NULL) ? left : (size_t) (next - start);
 
-    if (c == '\n') break;
+    const size_t copy = MIN (take, line_sz - line_len);
+
+    memcpy (line_buf + line_len, start, copy);
+
+    line_len += copy;
+
+    line_truncated += take - copy;
+
+    fp->rd_pos += (next == NULL) ? take : take + 1;
+
+    if (next != NULL) break;
   }
 
   if (line_truncated > 0)
@@ -523,14 +1601,13 @@ u64 count_lines (HCFILE *fp)
 
     if (nread < 1) continue;
 
-    size_t i;
+    // a line starts at the first byte and after every newline but the last byte of the chunk
 
-    for (i = 0; i < nread; i++)
-    {
-      if (prev == '\n') cnt++;
+    if (prev == '\n') cnt++;
 
-      prev = buf[i];
-    }
+    cnt += hc_count_newlines (buf, nread - 1);
+
+    prev = buf[nread - 1];
   }
 
   hcfree (buf);
@@ -9,6 +9,7 @@
 #include "event.h"
 #include "shared.h"
 #include "folder.h"
+#include "autotune.h"
 
 #if defined (__APPLE__)
 #include "event.h"
@@ -492,6 +493,30 @@ int folder_config_init (hashcat_ctx_t *hashcat_ctx, MAYBE_UNUSED const char *ins
 
   hcfree (kernels_folder);
 
+  /**
+   * dictionary offset index, we need to make sure folder exist
+   */
+
+  char *dictidx_folder;
+
+  hc_asprintf (&dictidx_folder, "%s/dictidx", profile_dir);
+
+  hc_mkdir (dictidx_folder, 0700);
+
+  hcfree (dictidx_folder);
+
+  /**
+   * autotune results, we need to make sure folder exist
+   */
+
+  char *autotune_folder;
+
+  hc_asprintf (&autotune_folder, "%s/%s", profile_dir, AUTOTUNE_CACHE_FOLDER);
+
+  hc_mkdir (autotune_folder, 0700);
+
+  hcfree (autotune_folder);
+
   /**
    * store for later use
    */
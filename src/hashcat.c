@@ -27,6 +27,7 @@
 #include "dispatch.h"
 #include "event.h"
 #include "hashes.h"
+#include "hcwl.h"
 #include "hwmon.h"
 #include "induct.h"
 #include "interface.h"
@@ -42,6 +43,7 @@
 #include "restore.h"
 #include "selftest.h"
 #include "status.h"
+#include "stdout.h"
 #include "straight.h"
 #include "tuningdb.h"
 #include "user_options.h"
@@ -132,6 +134,11 @@ static int inner2_loop (hashcat_ctx_t *hashcat_ctx)
 
   if (user_options->keyspace == true)
   {
+    if (user_options->wordlist_compile == true)
+    {
+      if (hcwl_compile (hashcat_ctx) == -1) return -1;
+    }
+
     status_ctx->devices_status = STATUS_RUNNING;
 
     return 0;
@@ -232,6 +239,25 @@ static int inner2_loop (hashcat_ctx_t *hashcat_ctx)
 
   status_ctx->runtime_start = runtime_start;
 
+  /**
+   * start the shared wordlist reader
+   */
+
+  if (wl_ring_init (hashcat_ctx) == -1)
+  {
+    hcfree (c_threads);
+
+    hcfree (threads_param);
+
+    return -1;
+  }
+
+  /**
+   * start the crack writer, it takes the encoding and file I/O of the cracks off the device threads
+   */
+
+  crack_writer_init (hashcat_ctx);
+
   /**
    * create cracker threads
    */
@@ -242,6 +268,16 @@ static int inner2_loop (hashcat_ctx_t *hashcat_ctx)
 
   status_ctx->accessible = true;
 
+  // with --stdout-host no device was initialized, the candidates are written from right here
+
+  if (user_options->stdout_host == true)
+  {
+    if (process_stdout_host (hashcat_ctx) == -1)
+    {
+      status_ctx->devices_status = STATUS_ERROR;
+    }
+  }
+
   for (int backend_devices_idx = 0; backend_devices_idx < backend_ctx->backend_devices_cnt; backend_devices_idx++)
   {
     thread_param_t *thread_param = threads_param + backend_devices_idx;
@@ -261,6 +297,12 @@ static int inner2_loop (hashcat_ctx_t *hashcat_ctx)
 
   hc_thread_wait (backend_ctx->backend_devices_cnt, c_threads);
 
+  wl_ring_destroy (hashcat_ctx);
+
+  // write out whatever is still queued, no crack may be lost on quit, checkpoint or regular end
+
+  crack_writer_destroy (hashcat_ctx);
+
   hcfree (c_threads);
 
   hcfree (threads_param);
@@ -496,13 +538,15 @@ static int outer_loop (hashcat_ctx_t *hashcat_ctx)
     if (user_options->loopback == true)
     {
       loopback_write_open (hashcat_ctx);
+      loopback_write_lock (hashcat_ctx);
     }
 
     potfile_remove_parse (hashcat_ctx);
 
     if (user_options->loopback == true)
     {
-      loopback_write_close (hashcat_ctx);
+      loopback_write_unlock (hashcat_ctx);
+      loopback_write_close  (hashcat_ctx);
     }
 
     EVENT (EVENT_POTFILE_REMOVE_PARSE_POST);
@@ -703,6 +747,29 @@ static int outer_loop (hashcat_ctx_t *hashcat_ctx)
 
   EVENT (EVENT_BACKEND_SESSION_POST);
 
+  /**
+   * in kernel-cache-warm mode we're done as soon as the kernels are built and stored
+   */
+
+  if (user_options->kernel_cache_warm == true)
+  {
+    EVENT (EVENT_BACKEND_KERNEL_CACHE_WARM);
+
+    backend_session_destroy (hashcat_ctx);
+
+    bitmap_ctx_destroy      (hashcat_ctx);
+    combinator_ctx_destroy  (hashcat_ctx);
+    cpt_ctx_destroy         (hashcat_ctx);
+    hashconfig_destroy      (hashcat_ctx);
+    hashes_destroy          (hashcat_ctx);
+    mask_ctx_destroy        (hashcat_ctx);
+    status_progress_destroy (hashcat_ctx);
+    straight_ctx_destroy    (hashcat_ctx);
+    wl_data_destroy         (hashcat_ctx);
+
+    return 0;
+  }
+
   /**
    * create self-test threads
    */
@@ -867,6 +934,39 @@ static int outer_loop (hashcat_ctx_t *hashcat_ctx)
   return 0;
 }
 
+// kernel_cache_warm iterates through the attack kernels and the optimized/pure variants of a hash_mode
+
+static int kernel_cache_warm (hashcat_ctx_t *hashcat_ctx)
+{
+  status_ctx_t         *status_ctx         = hashcat_ctx->status_ctx;
+  user_options_extra_t *user_options_extra = hashcat_ctx->user_options_extra;
+  user_options_t       *user_options       = hashcat_ctx->user_options;
+
+  // hybrid attacks use the combinator kernels, so these three cover all cached kernel files
+
+  const u32 attack_modes[3] = { ATTACK_MODE_STRAIGHT, ATTACK_MODE_COMBI, ATTACK_MODE_BF };
+  const u32 attack_kerns[3] = { ATTACK_KERN_STRAIGHT, ATTACK_KERN_COMBI, ATTACK_KERN_BF };
+
+  for (int optimized = 0; optimized < 2; optimized++)
+  {
+    user_options->optimized_kernel_enable = (optimized == 1);
+
+    for (int attack_idx = 0; attack_idx < 3; attack_idx++)
+    {
+      user_options->attack_mode       = attack_modes[attack_idx];
+      user_options_extra->attack_kern = attack_kerns[attack_idx];
+
+      const int rc = outer_loop (hashcat_ctx);
+
+      if (rc == -1) return -1;
+
+      if (status_ctx->run_main_level1 == false) return 0;
+    }
+  }
+
+  return 0;
+}
+
 static void event_stub (MAYBE_UNUSED const u32 id, MAYBE_UNUSED hashcat_ctx_t *hashcat_ctx, MAYBE_UNUSED const void *buf, MAYBE_UNUSED const size_t len)
 {
 
@@ -886,6 +986,7 @@ int hashcat_init (hashcat_ctx_t *hashcat_ctx, void (*event) (const u32, struct h
   hashcat_ctx->bitmap_ctx         = (bitmap_ctx_t *)          hcmalloc (sizeof (bitmap_ctx_t));
   hashcat_ctx->combinator_ctx     = (combinator_ctx_t *)      hcmalloc (sizeof (combinator_ctx_t));
   hashcat_ctx->cpt_ctx            = (cpt_ctx_t *)             hcmalloc (sizeof (cpt_ctx_t));
+  hashcat_ctx->crack_writer       = (crack_writer_t *)        hcmalloc (sizeof (crack_writer_t));
   hashcat_ctx->debugfile_ctx      = (debugfile_ctx_t *)       hcmalloc (sizeof (debugfile_ctx_t));
   hashcat_ctx->dictstat_ctx       = (dictstat_ctx_t *)        hcmalloc (sizeof (dictstat_ctx_t));
   hashcat_ctx->event_ctx          = (event_ctx_t *)           hcmalloc (sizeof (event_ctx_t));
@@ -911,6 +1012,7 @@ int hashcat_init (hashcat_ctx_t *hashcat_ctx, void (*event) (const u32, struct h
   hashcat_ctx->user_options_extra = (user_options_extra_t *)  hcmalloc (sizeof (user_options_extra_t));
   hashcat_ctx->user_options       = (user_options_t *)        hcmalloc (sizeof (user_options_t));
   hashcat_ctx->wl_data            = (wl_data_t *)             hcmalloc (sizeof (wl_data_t));
+  hashcat_ctx->wl_ring            = (wl_ring_t *)             hcmalloc (sizeof (wl_ring_t));
 
   return 0;
 }
@@ -920,6 +1022,7 @@ void hashcat_destroy (hashcat_ctx_t *hashcat_ctx)
   hcfree (hashcat_ctx->bitmap_ctx);
   hcfree (hashcat_ctx->combinator_ctx);
   hcfree (hashcat_ctx->cpt_ctx);
+  hcfree (hashcat_ctx->crack_writer);
   hcfree (hashcat_ctx->debugfile_ctx);
   hcfree (hashcat_ctx->dictstat_ctx);
   hcfree (hashcat_ctx->event_ctx);
@@ -945,6 +1048,7 @@ void hashcat_destroy (hashcat_ctx_t *hashcat_ctx)
   hcfree (hashcat_ctx->user_options_extra);
   hcfree (hashcat_ctx->user_options);
   hcfree (hashcat_ctx->wl_data);
+  hcfree (hashcat_ctx->wl_ring);
 
   memset (hashcat_ctx, 0, sizeof (hashcat_ctx_t));
 }
@@ -1162,7 +1266,7 @@ int hashcat_session_execute (hashcat_ctx_t *hashcat_ctx)
 
     if (user_options->hash_mode_chgd == true)
     {
-      rc_final = outer_loop (hashcat_ctx);
+      rc_final = (user_options->kernel_cache_warm == true) ? kernel_cache_warm (hashcat_ctx) : outer_loop (hashcat_ctx);
 
       if (rc_final == -1) myabort (hashcat_ctx);
     }
@@ -1174,7 +1278,7 @@ int hashcat_session_execute (hashcat_ctx_t *hashcat_ctx)
       {
         user_options->hash_mode = hash_mode;
 
-        rc_final = outer_loop (hashcat_ctx);
+        rc_final = (user_options->kernel_cache_warm == true) ? kernel_cache_warm (hashcat_ctx) : outer_loop (hashcat_ctx);
 
         if (rc_final == -1) myabort (hashcat_ctx);
 
@@ -1329,6 +1433,10 @@ int hashcat_get_status (hashcat_ctx_t *hashcat_ctx, hashcat_status_t *hashcat_st
   hashcat_status->guess_base_offset           = status_get_guess_base_offset          (hashcat_ctx);
   hashcat_status->guess_base_count            = status_get_guess_base_count           (hashcat_ctx);
   hashcat_status->guess_base_percent          = status_get_guess_base_percent         (hashcat_ctx);
+  hashcat_status->guess_base_io_wait_msec     = status_get_guess_base_io_wait_msec    (hashcat_ctx);
+  hashcat_status->dispatch_cnt                = status_get_dispatch_cnt               (hashcat_ctx);
+  hashcat_status->dispatch_retry_cnt          = status_get_dispatch_retry_cnt         (hashcat_ctx);
+  hashcat_status->dispatch_locked_cnt         = status_get_dispatch_locked_cnt        (hashcat_ctx);
   hashcat_status->guess_mod                   = status_get_guess_mod                  (hashcat_ctx);
   hashcat_status->guess_mod_offset            = status_get_guess_mod_offset           (hashcat_ctx);
   hashcat_status->guess_mod_count             = status_get_guess_mod_count            (hashcat_ctx);
@@ -1390,6 +1498,7 @@ int hashcat_get_status (hashcat_ctx_t *hashcat_ctx, hashcat_status_t *hashcat_st
     device_info->hashes_msec_dev                = status_get_hashes_msec_dev                (hashcat_ctx, device_id);
     device_info->hashes_msec_dev_benchmark      = status_get_hashes_msec_dev_benchmark      (hashcat_ctx, device_id);
     device_info->exec_msec_dev                  = status_get_exec_msec_dev                  (hashcat_ctx, device_id);
+    device_info->hook_msec_dev                  = status_get_hook_msec_dev                  (hashcat_ctx, device_id);
     device_info->speed_sec_dev                  = status_get_speed_sec_dev                  (hashcat_ctx, device_id);
     device_info->guess_candidates_dev           = status_get_guess_candidates_dev           (hashcat_ctx, device_id);
     device_info->hwmon_dev                      = status_get_hwmon_dev                      (hashcat_ctx, device_id);
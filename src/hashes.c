@@ -304,16 +304,10 @@ int save_hash (hashcat_ctx_t *hashcat_ctx)
   return 0;
 }
 
-void check_hash (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, plain_t *plain)
+crack_entry_t *check_hash (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, plain_t *plain)
 {
-  const debugfile_ctx_t *debugfile_ctx = hashcat_ctx->debugfile_ctx;
-  const hashes_t        *hashes        = hashcat_ctx->hashes;
-  const hashconfig_t    *hashconfig    = hashcat_ctx->hashconfig;
-  const loopback_ctx_t  *loopback_ctx  = hashcat_ctx->loopback_ctx;
-  const module_ctx_t    *module_ctx    = hashcat_ctx->module_ctx;
-
-  const u32 salt_pos    = plain->salt_pos;
-  const u32 digest_pos  = plain->digest_pos;  // relative
+  const hashconfig_t *hashconfig = hashcat_ctx->hashconfig;
+  const module_ctx_t *module_ctx = hashcat_ctx->module_ctx;
 
   void *tmps = NULL;
 
@@ -332,22 +326,12 @@ void check_hash (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, pl
     }
   }
 
-  // hash
-
-  u8 *out_buf = hashes->out_buf;
-
-  int out_len = hash_encode (hashcat_ctx->hashconfig, hashcat_ctx->hashes, hashcat_ctx->module_ctx, (char *) out_buf, HCBUFSIZ_LARGE, salt_pos, digest_pos);
-
-  out_buf[out_len] = 0;
-
   // plain
 
   u8 plain_buf[0x1000]; // while the password itself can have only length 256, the module could encode it with something like base64 which inflates the requires buffer size
 
   memset (plain_buf, 0, sizeof (plain_buf));
 
-  u8 *plain_ptr = plain_buf;
-
   int plain_len = 0;
 
   build_plain (hashcat_ctx, device_param, plain, (u32 *) plain_buf, &plain_len);
@@ -368,41 +352,70 @@ void check_hash (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, pl
     }
   }
 
-  // crackpos
+  crack_entry_t *crack = (crack_entry_t *) hcmalloc (sizeof (crack_entry_t) + plain_len + 1);
 
-  u64 crackpos = 0;
+  crack->salt_pos   = plain->salt_pos;
+  crack->digest_pos = plain->digest_pos; // relative
+  crack->plain_buf  = (u8 *) (crack + 1);
+  crack->plain_len  = plain_len;
+  crack->tmps       = tmps;
 
-  build_crackpos (hashcat_ctx, device_param, plain, &crackpos);
+  memcpy (crack->plain_buf, plain_buf, plain_len);
+
+  // crackpos
+
+  build_crackpos (hashcat_ctx, device_param, plain, &crack->crackpos);
 
   // debug
 
-  u8  debug_rule_buf[RP_PASSWORD_SIZE] = { 0 };
-  int debug_rule_len  = 0; // -1 error
+  build_debugdata (hashcat_ctx, device_param, plain, crack->debug_rule_buf, &crack->debug_rule_len, crack->debug_plain_buf, &crack->debug_plain_len);
+
+  return crack;
+}
+
+static void crack_write (hashcat_ctx_t *hashcat_ctx, const crack_entry_t *crack)
+{
+  const debugfile_ctx_t *debugfile_ctx = hashcat_ctx->debugfile_ctx;
+  const hashes_t        *hashes        = hashcat_ctx->hashes;
+  const hashconfig_t    *hashconfig    = hashcat_ctx->hashconfig;
+  const loopback_ctx_t  *loopback_ctx  = hashcat_ctx->loopback_ctx;
+  const module_ctx_t    *module_ctx    = hashcat_ctx->module_ctx;
+  status_ctx_t          *status_ctx    = hashcat_ctx->status_ctx;
+
+  const u32 salt_pos    = crack->salt_pos;
+  const u32 digest_pos  = crack->digest_pos;  // relative
+
+  u8 *plain_ptr = crack->plain_buf;
+
+  const int plain_len = crack->plain_len;
+
+  // hash
+
+  u8 *out_buf = hashes->out_buf;
 
-  u8  debug_plain_ptr[RP_PASSWORD_SIZE] = { 0 };
-  int debug_plain_len = 0;
+  int out_len = hash_encode (hashcat_ctx->hashconfig, hashcat_ctx->hashes, hashcat_ctx->module_ctx, (char *) out_buf, HCBUFSIZ_LARGE, salt_pos, digest_pos);
 
-  build_debugdata (hashcat_ctx, device_param, plain, debug_rule_buf, &debug_rule_len, debug_plain_ptr, &debug_plain_len);
+  out_buf[out_len] = 0;
 
   // outfile, can be either to file or stdout
   // if an error occurs opening the file, send to stdout as fallback
-  // the fp gets opened for each cracked hash so that the user can modify (move) the outfile while hashcat runs
-
-  outfile_write_open (hashcat_ctx);
+  // the fp is opened by crack_write_batch () for each batch, so that the user can modify (move) the outfile while hashcat runs
 
   u8 *tmp_buf = hashes->tmp_buf;
 
   tmp_buf[0] = 0;
 
-  const int tmp_len = outfile_write (hashcat_ctx, (char *) out_buf, out_len, plain_ptr, plain_len, crackpos, NULL, 0, (char *) tmp_buf);
+  const int tmp_len = outfile_write (hashcat_ctx, (char *) out_buf, out_len, plain_ptr, plain_len, crack->crackpos, NULL, 0, (char *) tmp_buf);
+
+  hc_thread_mutex_lock (status_ctx->mux_display);
 
   EVENT_DATA (EVENT_CRACKER_HASH_CRACKED, tmp_buf, tmp_len);
 
-  outfile_write_close (hashcat_ctx);
+  hc_thread_mutex_unlock (status_ctx->mux_display);
 
   // potfile
   // we can have either used-defined hooks or reuse the same format as input format
-  // no need for locking, we're in a mutex protected function
+  // no need for locking, the writer thread is the only one writing and crack_write_batch () holds the file lock
 
   if (module_ctx->module_hash_encode_potfile != MODULE_DEFAULT)
   {
@@ -438,7 +451,7 @@ void check_hash (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, pl
       hash_info_ptr,
       (char *) out_buf,
       HCBUFSIZ_LARGE,
-      tmps
+      crack->tmps
     );
 
     out_buf[out_len] = 0;
@@ -461,15 +474,173 @@ void check_hash (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, pl
     // - (user_options->attack_mode == ATTACK_MODE_STRAIGHT)
     // - debug_mode > 0
 
-    if ((debug_plain_len > 0) || (debug_rule_len > 0))
+    if ((crack->debug_plain_len > 0) || (crack->debug_rule_len > 0))
     {
-      debugfile_write_append (hashcat_ctx, debug_rule_buf, debug_rule_len, plain_ptr, plain_len, debug_plain_ptr, debug_plain_len);
+      debugfile_write_append (hashcat_ctx, crack->debug_rule_buf, crack->debug_rule_len, plain_ptr, plain_len, crack->debug_plain_buf, crack->debug_plain_len);
     }
   }
+}
 
-  if (hashconfig->opts_type & OPTS_TYPE_COPY_TMPS)
+static void crack_write_batch (hashcat_ctx_t *hashcat_ctx, crack_entry_t *cracks)
+{
+  // all cracks of the batch are written in one go, each file is opened or locked and flushed only once
+
+  outfile_write_open  (hashcat_ctx);
+  potfile_write_lock  (hashcat_ctx);
+  loopback_write_lock (hashcat_ctx);
+
+  while (cracks != NULL)
   {
-    hcfree (tmps);
+    crack_entry_t *next = cracks->next;
+
+    crack_write (hashcat_ctx, cracks);
+
+    hcfree (cracks->tmps);
+    hcfree (cracks);
+
+    cracks = next;
+  }
+
+  loopback_write_unlock (hashcat_ctx);
+  potfile_write_unlock  (hashcat_ctx);
+  outfile_write_close   (hashcat_ctx);
+}
+
+HC_API_CALL void *thread_crack_writer (void *p)
+{
+  hashcat_ctx_t *hashcat_ctx = (hashcat_ctx_t *) p;
+
+  crack_writer_t *crack_writer = hashcat_ctx->crack_writer;
+
+  while (true)
+  {
+    hc_thread_sem_wait (crack_writer->sem);
+
+    hc_thread_mutex_lock (crack_writer->mux);
+
+    crack_entry_t *cracks = crack_writer->head;
+
+    const u64 cracks_cnt = crack_writer->queued_cnt;
+
+    crack_writer->head       = NULL;
+    crack_writer->tail       = NULL;
+    crack_writer->queued_cnt = 0;
+
+    // no more pushes after run is cleared, so whatever was taken here is the rest
+
+    const bool run = crack_writer->run;
+
+    hc_thread_mutex_unlock (crack_writer->mux);
+
+    if (cracks != NULL)
+    {
+      crack_write_batch (hashcat_ctx, cracks);
+
+      hc_atomic_fetch_add (&crack_writer->written_cnt, cracks_cnt);
+    }
+
+    if (run == false) break;
+  }
+
+  return NULL;
+}
+
+int crack_writer_init (hashcat_ctx_t *hashcat_ctx)
+{
+  crack_writer_t *crack_writer = hashcat_ctx->crack_writer;
+
+  crack_writer->head        = NULL;
+  crack_writer->tail        = NULL;
+  crack_writer->queued_cnt  = 0;
+  crack_writer->pushed_cnt  = 0;
+  crack_writer->written_cnt = 0;
+  crack_writer->run         = true;
+
+  hc_thread_mutex_init (crack_writer->mux);
+  hc_thread_sem_init   (crack_writer->sem);
+
+  hc_thread_create (crack_writer->thread, thread_crack_writer, hashcat_ctx);
+
+  hc_atomic_store (&crack_writer->enabled, true);
+
+  return 0;
+}
+
+void crack_writer_destroy (hashcat_ctx_t *hashcat_ctx)
+{
+  crack_writer_t *crack_writer = hashcat_ctx->crack_writer;
+
+  if (crack_writer->enabled == false) return;
+
+  // the device threads are gone at this point, the writer empties the queue and leaves
+
+  hc_thread_mutex_lock (crack_writer->mux);
+
+  crack_writer->run = false;
+
+  hc_thread_mutex_unlock (crack_writer->mux);
+
+  hc_thread_sem_post (crack_writer->sem);
+
+  hc_thread_wait (1, &crack_writer->thread);
+
+  hc_atomic_store (&crack_writer->enabled, false);
+
+  hc_thread_sem_close    (crack_writer->sem);
+  hc_thread_mutex_delete (crack_writer->mux);
+}
+
+void crack_writer_push (hashcat_ctx_t *hashcat_ctx, crack_entry_t *cracks_head, crack_entry_t *cracks_tail, const u64 cracks_cnt)
+{
+  crack_writer_t *crack_writer = hashcat_ctx->crack_writer;
+
+  if (cracks_head == NULL) return;
+
+  if (crack_writer->enabled == false)
+  {
+    crack_write_batch (hashcat_ctx, cracks_head);
+
+    return;
+  }
+
+  hc_thread_mutex_lock (crack_writer->mux);
+
+  if (crack_writer->tail == NULL)
+  {
+    crack_writer->head = cracks_head;
+  }
+  else
+  {
+    crack_writer->tail->next = cracks_head;
+  }
+
+  crack_writer->tail = cracks_tail;
+
+  crack_writer->queued_cnt += cracks_cnt;
+  crack_writer->pushed_cnt += cracks_cnt;
+
+  hc_thread_mutex_unlock (crack_writer->mux);
+
+  hc_thread_sem_post (crack_writer->sem);
+}
+
+void crack_writer_drain (hashcat_ctx_t *hashcat_ctx)
+{
+  crack_writer_t *crack_writer = hashcat_ctx->crack_writer;
+
+  if (hc_atomic_load (&crack_writer->enabled) == false) return;
+
+  hc_thread_mutex_lock (crack_writer->mux);
+
+  const u64 pushed_cnt = crack_writer->pushed_cnt;
+
+  hc_thread_mutex_unlock (crack_writer->mux);
+
+  while (hc_atomic_load (&crack_writer->written_cnt) < pushed_cnt)
+  {
+    if (hc_atomic_load (&crack_writer->enabled) == false) break;
+
+    usleep (CRACK_WRITER_WAIT_USEC);
   }
 }
 
@@ -530,6 +701,13 @@ int check_cracked (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
 
     u32 cpt_cracked = 0;
 
+    // the cracks are only collected here, encoding and file I/O is done by the crack writer thread
+
+    crack_entry_t *cracks_head = NULL;
+    crack_entry_t *cracks_tail = NULL;
+
+    u64 cracks_cnt = 0;
+
     hc_thread_mutex_lock (status_ctx->mux_display);
 
     for (u32 i = 0; i < num_cracked; i++)
@@ -558,17 +736,24 @@ int check_cracked (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
 
       if (hashes->salts_done == hashes->salts_cnt) mycracked (hashcat_ctx);
 
-      check_hash (hashcat_ctx, device_param, &cracked[i]);
-    }
+      crack_entry_t *crack = check_hash (hashcat_ctx, device_param, &cracked[i]);
 
-    hc_thread_mutex_unlock (status_ctx->mux_display);
+      if (cracks_tail == NULL)
+      {
+        cracks_head = crack;
+      }
+      else
+      {
+        cracks_tail->next = crack;
+      }
 
-    hcfree (cracked);
+      cracks_tail = crack;
+
+      cracks_cnt++;
+    }
 
     if (cpt_cracked > 0)
     {
-      hc_thread_mutex_lock (status_ctx->mux_display);
-
       cpt_ctx->cpt_buf[cpt_ctx->cpt_pos].timestamp = time (NULL);
       cpt_ctx->cpt_buf[cpt_ctx->cpt_pos].cracked   = cpt_cracked;
 
@@ -577,10 +762,14 @@ int check_cracked (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
       cpt_ctx->cpt_total += cpt_cracked;
 
       if (cpt_ctx->cpt_pos == CPT_CACHE) cpt_ctx->cpt_pos = 0;
-
-      hc_thread_mutex_unlock (status_ctx->mux_display);
     }
 
+    hc_thread_mutex_unlock (status_ctx->mux_display);
+
+    crack_writer_push (hashcat_ctx, cracks_head, cracks_tail, cracks_cnt);
+
+    hcfree (cracked);
+
     if (hashconfig->opts_type & OPTS_TYPE_PT_NEVERCRACK)
     {
       // we need to reset cracked state on the device
@@ -0,0 +1,565 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#include "common.h"
+#include "types.h"
+#include "memory.h"
+#include "bitops.h"
+#include "event.h"
+#include "shared.h"
+#include "thread.h"
+#include "filehandling.h"
+#include "rp.h"
+#include "rp_cpu.h"
+#include "wordlist.h"
+#include "hcwl.h"
+
+// a compiled wordlist (.hcwl) stores the base words exactly as the wordlist reader would produce them,
+// that is after splitting, $HEX[] decoding, iconv and the -j rule, grouped into one bucket per length
+// and already padded to a multiple of 4 bytes. the layout is:
+//
+//   [0]                 hcwl_header_t, zero padded to HCWL_DATA_OFFSET
+//   [HCWL_DATA_OFFSET]  bucket of all words of length 0, then length 1, ... up to PW_MAX
+//
+// since all words of a bucket have the same padded size, the position of any word is computed
+// instead of searched and a range of words can be copied into pws_comp with a single memcpy ()
+
+static u32 hcwl_len4_cnt (const u32 len)
+{
+  return ((len + 3) & ~3u) / 4;
+}
+
+static u64 hcwl_data_size (const hcwl_header_t *header)
+{
+  u64 size = 0;
+
+  for (u32 len = 0; len <= PW_MAX; len++)
+  {
+    size += header->hist[len] * hcwl_len4_cnt (len) * sizeof (u32);
+  }
+
+  return size;
+}
+
+static void hcwl_select (hashcat_ctx_t *hashcat_ctx, u32 *len_min, u32 *len_max)
+{
+  const hashconfig_t *hashconfig = hashcat_ctx->hashconfig;
+
+  *len_min = MIN (hashconfig->pw_min, PW_MAX);
+  *len_max = MIN (hashconfig->pw_max, PW_MAX);
+}
+
+static int hcwl_read_header (HCFILE *fp, hcwl_header_t *header)
+{
+  hc_rewind (fp);
+
+  const size_t nread = hc_fread (header, sizeof (hcwl_header_t), 1, fp);
+
+  hc_rewind (fp);
+
+  if (nread != 1) return -1;
+
+  header->version = byte_swap_64 (header->version);
+
+  if (header->version != HCWL_VERSION) return -1;
+
+  if (header->len_max != PW_MAX) return -1;
+
+  header->encoding_from[sizeof (header->encoding_from) - 1] = 0;
+  header->encoding_to[sizeof (header->encoding_to) - 1]     = 0;
+
+  u64 cnt = 0;
+
+  for (u32 len = 0; len <= PW_MAX; len++) cnt += header->hist[len];
+
+  if (cnt != header->cnt) return -1;
+
+  struct stat s;
+
+  if (fstat (hc_fileno (fp), &s) == -1) return -1;
+
+  if ((u64) s.st_size < (HCWL_DATA_OFFSET + hcwl_data_size (header))) return -1;
+
+  return 0;
+}
+
+bool hcwl_detect (HCFILE *fp)
+{
+  if (fp->is_gzip || fp->is_zip || fp->is_xz) return false;
+
+  u64 version = 0;
+
+  hc_rewind (fp);
+
+  const size_t nread = hc_fread (&version, sizeof (version), 1, fp);
+
+  hc_rewind (fp);
+
+  if (nread != 1) return false;
+
+  version = byte_swap_64 (version);
+
+  return ((version & 0xffffffffffffff00) == (HCWL_VERSION & 0xffffffffffffff00));
+}
+
+int hcwl_check (hashcat_ctx_t *hashcat_ctx, HCFILE *fp, const char *dictfile)
+{
+  const user_options_t       *user_options       = hashcat_ctx->user_options;
+  const user_options_extra_t *user_options_extra = hashcat_ctx->user_options_extra;
+
+  if (hcwl_detect (fp) == false) return 0;
+
+  hcwl_header_t header;
+
+  if (hcwl_read_header (fp, &header) == -1)
+  {
+    event_log_error (hashcat_ctx, "%s: Invalid, truncated or outdated compiled wordlist.", dictfile);
+
+    return -1;
+  }
+
+  if (user_options->wordlist_compile == true)
+  {
+    event_log_error (hashcat_ctx, "%s: Wordlist is already compiled.", dictfile);
+
+    return -1;
+  }
+
+  if (user_options->attack_mode != ATTACK_MODE_STRAIGHT)
+  {
+    event_log_error (hashcat_ctx, "%s: Compiled wordlists are only supported in attack mode 0 (straight).", dictfile);
+
+    return -1;
+  }
+
+  if ((user_options->slow_candidates == true) || (user_options->stdout_flag == true))
+  {
+    event_log_error (hashcat_ctx, "%s: Compiled wordlists are not supported with --slow-candidates or --stdout.", dictfile);
+
+    return -1;
+  }
+
+  if (run_rule_engine ((int) user_options_extra->rule_len_l, user_options->rule_buf_l))
+  {
+    event_log_error (hashcat_ctx, "%s: Compiled wordlists do not support -j, apply it with --wordlist-compile instead.", dictfile);
+
+    return -1;
+  }
+
+  if (header.parser != wl_data_parser (hashcat_ctx))
+  {
+    event_log_error (hashcat_ctx, "%s: Compiled wordlist does not match the hash-mode or --wordlist-autohex-disable, recompile it.", dictfile);
+
+    return -1;
+  }
+
+  if ((strcmp (header.encoding_from, user_options->encoding_from) != 0) || (strcmp (header.encoding_to, user_options->encoding_to) != 0))
+  {
+    event_log_error (hashcat_ctx, "%s: Compiled wordlist does not match --encoding-from or --encoding-to, recompile it.", dictfile);
+
+    return -1;
+  }
+
+  return 0;
+}
+
+int hcwl_count_words (hashcat_ctx_t *hashcat_ctx, HCFILE *fp, u64 *result)
+{
+  hcwl_header_t header;
+
+  if (hcwl_read_header (fp, &header) == -1) return -1;
+
+  u32 len_min = 0;
+  u32 len_max = 0;
+
+  hcwl_select (hashcat_ctx, &len_min, &len_max);
+
+  u64 cnt = 0;
+
+  for (u32 len = len_min; len <= len_max; len++) cnt += header.hist[len];
+
+  *result = cnt;
+
+  return 0;
+}
+
+static bool hcwl_next_word (hashcat_ctx_t *hashcat_ctx, HCFILE *fp, char *rule_buf_out, char **out_buf, u32 *out_len)
+{
+  const user_options_t       *user_options       = hashcat_ctx->user_options;
+  const user_options_extra_t *user_options_extra = hashcat_ctx->user_options_extra;
+
+  char *line_buf = NULL;
+  u32   line_len = 0;
+
+  get_next_word (hashcat_ctx, fp, &line_buf, &line_len);
+
+  if (line_buf == NULL) return false;
+
+  // the -j rule is applied once here, same as the wordlist reader thread does
+
+  if (run_rule_engine ((int) user_options_extra->rule_len_l, user_options->rule_buf_l))
+  {
+    if (line_len >= RP_PASSWORD_SIZE) return false;
+
+    memset (rule_buf_out, 0, RP_PASSWORD_SIZE);
+
+    const int rule_len_out = _old_apply_rule (user_options->rule_buf_l, (int) user_options_extra->rule_len_l, line_buf, (int) line_len, rule_buf_out);
+
+    if (rule_len_out < 0) return false;
+
+    line_buf = rule_buf_out;
+    line_len = (u32) rule_len_out;
+  }
+
+  if (line_len > PW_MAX) return false;
+
+  *out_buf = line_buf;
+  *out_len = line_len;
+
+  return true;
+}
+
+static int hcwl_flush (HCFILE *fp, const u64 off, const u8 *buf, const size_t len)
+{
+  if (len == 0) return 0;
+
+  if (hc_fseek (fp, (off_t) off, SEEK_SET) == -1) return -1;
+
+  if (hc_fwrite (buf, 1, len, fp) != len) return -1;
+
+  return 0;
+}
+
+int hcwl_compile (hashcat_ctx_t *hashcat_ctx)
+{
+  const status_ctx_t   *status_ctx   = hashcat_ctx->status_ctx;
+  const straight_ctx_t *straight_ctx = hashcat_ctx->straight_ctx;
+  const user_options_t *user_options = hashcat_ctx->user_options;
+  wl_data_t            *wl_data      = hashcat_ctx->wl_data;
+
+  const char *dictfile = straight_ctx->dict;
+
+  char *hcwlfile = NULL;
+
+  if (user_options->outfile != NULL)
+  {
+    hcwlfile = hcstrdup (user_options->outfile);
+  }
+  else
+  {
+    hc_asprintf (&hcwlfile, "%s" HCWL_EXTENSION, dictfile);
+  }
+
+  if (strcmp (hcwlfile, dictfile) == 0)
+  {
+    event_log_error (hashcat_ctx, "%s: Refusing to overwrite the wordlist with its compiled version.", dictfile);
+
+    hcfree (hcwlfile);
+
+    return -1;
+  }
+
+  // the base words were counted already by straight_ctx_update_loop ()
+
+  const u64 words_cnt = status_ctx->words_base;
+
+  hcwl_header_t *header = (hcwl_header_t *) hccalloc (1, HCWL_DATA_OFFSET);
+
+  header->version = HCWL_VERSION;
+  header->parser  = wl_data_parser (hashcat_ctx);
+  header->len_max = PW_MAX;
+
+  strncpy (header->encoding_from, user_options->encoding_from, sizeof (header->encoding_from) - 1);
+  strncpy (header->encoding_to,   user_options->encoding_to,   sizeof (header->encoding_to)   - 1);
+
+  char rule_buf_out[RP_PASSWORD_SIZE];
+
+  // first pass: length histogram, it defines where each bucket starts
+
+  HCFILE fp;
+
+  if (hc_fopen (&fp, dictfile, "rb") == false)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", dictfile, strerror (errno));
+
+    hcfree (header);
+    hcfree (hcwlfile);
+
+    return -1;
+  }
+
+  wl_data->pos = 0;
+  wl_data->cnt = 0;
+
+  for (u64 words_cur = 0; words_cur < words_cnt; words_cur++)
+  {
+    char *line_buf = NULL;
+    u32   line_len = 0;
+
+    if (hcwl_next_word (hashcat_ctx, &fp, rule_buf_out, &line_buf, &line_len) == false) continue;
+
+    header->hist[line_len]++;
+
+    header->cnt++;
+  }
+
+  // load_segment () already reported it
+
+  if (hc_ferror (&fp))
+  {
+    hc_fclose (&fp);
+
+    hcfree (header);
+    hcfree (hcwlfile);
+
+    return -1;
+  }
+
+  hc_fclose (&fp);
+
+  u64 *cursor = (u64 *) hccalloc (PW_MAX + 1, sizeof (u64));
+
+  u64 data_off = HCWL_DATA_OFFSET;
+
+  for (u32 len = 0; len <= PW_MAX; len++)
+  {
+    cursor[len] = data_off;
+
+    data_off += header->hist[len] * hcwl_len4_cnt (len) * sizeof (u32);
+  }
+
+  // second pass: the words are staged per length and flushed to the current end of their bucket
+
+  HCFILE out;
+
+  if (hc_fopen (&out, hcwlfile, "wb") == false)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", hcwlfile, strerror (errno));
+
+    hcfree (cursor);
+    hcfree (header);
+    hcfree (hcwlfile);
+
+    return -1;
+  }
+
+  if (hc_fopen (&fp, dictfile, "rb") == false)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", dictfile, strerror (errno));
+
+    hc_fclose (&out);
+
+    hcfree (cursor);
+    hcfree (header);
+    hcfree (hcwlfile);
+
+    return -1;
+  }
+
+  wl_data->pos = 0;
+  wl_data->cnt = 0;
+
+  u8     *stage_buf = (u8 *)     hcmalloc ((PW_MAX + 1) * HCWL_STAGE_SIZE);
+  size_t *stage_len = (size_t *) hccalloc (PW_MAX + 1, sizeof (size_t));
+
+  u64 cnt = 0;
+
+  int rc = 0;
+
+  for (u64 words_cur = 0; words_cur < words_cnt; words_cur++)
+  {
+    char *line_buf = NULL;
+    u32   line_len = 0;
+
+    if (hcwl_next_word (hashcat_ctx, &fp, rule_buf_out, &line_buf, &line_len) == false) continue;
+
+    // the wordlist changed between the passes
+
+    if (cnt == header->cnt)
+    {
+      rc = -1;
+
+      break;
+    }
+
+    const size_t pw_len4 = hcwl_len4_cnt (line_len) * sizeof (u32);
+
+    u8 *stage = stage_buf + ((size_t) line_len * HCWL_STAGE_SIZE);
+
+    if ((stage_len[line_len] + pw_len4) > HCWL_STAGE_SIZE)
+    {
+      if (hcwl_flush (&out, cursor[line_len], stage, stage_len[line_len]) == -1)
+      {
+        rc = -1;
+
+        break;
+      }
+
+      cursor[line_len] += stage_len[line_len];
+
+      stage_len[line_len] = 0;
+    }
+
+    memcpy (stage + stage_len[line_len], line_buf, line_len);
+
+    memset (stage + stage_len[line_len] + line_len, 0, pw_len4 - line_len);
+
+    stage_len[line_len] += pw_len4;
+
+    cnt++;
+  }
+
+  hc_fclose (&fp);
+
+  for (u32 len = 0; len <= PW_MAX; len++)
+  {
+    if (rc == -1) break;
+
+    rc = hcwl_flush (&out, cursor[len], stage_buf + ((size_t) len * HCWL_STAGE_SIZE), stage_len[len]);
+  }
+
+  if (cnt != header->cnt) rc = -1;
+
+  // the header goes last, an interrupted compile leaves no valid header behind
+
+  if (rc == 0)
+  {
+    const u64 version = header->version;
+
+    header->version = byte_swap_64 (version);
+
+    rc = hcwl_flush (&out, 0, (const u8 *) header, HCWL_DATA_OFFSET);
+
+    header->version = version;
+  }
+
+  hc_fclose (&out);
+
+  if (rc == -1)
+  {
+    event_log_error (hashcat_ctx, "%s: Failed to compile the wordlist, it may have changed while being compiled.", hcwlfile);
+
+    unlink (hcwlfile);
+  }
+  else
+  {
+    event_log_info (hashcat_ctx, "%s: %" PRIu64 " words compiled into %s (%" PRIu64 " bytes)", dictfile, header->cnt, hcwlfile, data_off);
+  }
+
+  hcfree (stage_buf);
+  hcfree (stage_len);
+  hcfree (cursor);
+  hcfree (header);
+  hcfree (hcwlfile);
+
+  return rc;
+}
+
+int hcwl_open (hashcat_ctx_t *hashcat_ctx, hcwl_t *hcwl, HCFILE *fp)
+{
+  memset (hcwl, 0, sizeof (hcwl_t));
+
+  if (hcwl_read_header (fp, &hcwl->header) == -1) return -1;
+
+  hcwl_select (hashcat_ctx, &hcwl->len_min, &hcwl->len_max);
+
+  u64 data_off    = HCWL_DATA_OFFSET;
+  u64 words_first = 0;
+
+  for (u32 len = 0; len <= PW_MAX; len++)
+  {
+    hcwl->data_off[len] = data_off;
+
+    data_off += hcwl->header.hist[len] * hcwl_len4_cnt (len) * sizeof (u32);
+
+    if ((len < hcwl->len_min) || (len > hcwl->len_max)) continue;
+
+    hcwl->words_first[len] = words_first;
+
+    words_first += hcwl->header.hist[len];
+  }
+
+  hcwl->words_first[hcwl->len_max + 1] = words_first;
+
+  // the device threads copy from the mapping directly, without it they take turns on the file
+
+  hc_fmmap (fp);
+
+  hc_thread_mutex_init (hcwl->mux_read);
+
+  hcwl->enabled = true;
+
+  return 0;
+}
+
+void hcwl_close (hcwl_t *hcwl)
+{
+  if (hcwl->enabled == false) return;
+
+  hc_thread_mutex_delete (hcwl->mux_read);
+
+  memset (hcwl, 0, sizeof (hcwl_t));
+}
+
+void hcwl_get (hcwl_t *hcwl, HCFILE *fp, hc_device_param_t *device_param, const u64 words_off, const u64 words_fin)
+{
+  u64 words_cur = words_off;
+
+  for (u32 len = hcwl->len_min; len <= hcwl->len_max; len++)
+  {
+    if (words_cur >= words_fin) break;
+
+    const u64 words_first = hcwl->words_first[len];
+    const u64 words_last  = hcwl->words_first[len + 1];
+
+    if (words_cur >= words_last) continue;
+
+    const u64 cnt = MIN (words_last, words_fin) - words_cur;
+
+    const u32 pw_len4_cnt = hcwl_len4_cnt (len);
+
+    pw_idx_t *pw_idx = device_param->pws_idx + device_param->pws_cnt;
+
+    u32 off = pw_idx->off;
+
+    // all words of a bucket have the same size, so the whole range goes into pws_comp at once
+
+    const u64 src_off = hcwl->data_off[len] + ((words_cur - words_first) * pw_len4_cnt * sizeof (u32));
+
+    const size_t size = (size_t) (cnt * pw_len4_cnt * sizeof (u32));
+
+    u8 *dst = (u8 *) (device_param->pws_comp + off);
+
+    if (fp->is_mmap == true)
+    {
+      memcpy (dst, fp->mm_buf + src_off, size);
+    }
+    else if (size > 0)
+    {
+      hc_thread_mutex_lock (hcwl->mux_read);
+
+      if ((hc_fseek (fp, (off_t) src_off, SEEK_SET) == -1) || (hc_fread (dst, 1, size, fp) != size)) memset (dst, 0, size);
+
+      hc_thread_mutex_unlock (hcwl->mux_read);
+    }
+
+    for (u64 i = 0; i < cnt; i++)
+    {
+      pw_idx[i].off = off;
+      pw_idx[i].cnt = pw_len4_cnt;
+      pw_idx[i].len = len;
+
+      off += pw_len4_cnt;
+    }
+
+    // prepare next element, same as pw_add ()
+
+    pw_idx[cnt].off = off;
+
+    device_param->pws_cnt += cnt;
+
+    words_cur += cnt;
+  }
+}
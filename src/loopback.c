@@ -152,13 +152,31 @@ void loopback_write_append (hashcat_ctx_t *hashcat_ctx, const u8 *plain_ptr, con
 
   loopback_format_plain (hashcat_ctx, plain_ptr, plain_len);
 
+  hc_fwrite (EOL, strlen (EOL), 1, &loopback_ctx->fp);
+
+  loopback_ctx->unused = false;
+}
+
+void loopback_write_lock (hashcat_ctx_t *hashcat_ctx)
+{
+  loopback_ctx_t *loopback_ctx = hashcat_ctx->loopback_ctx;
+
+  if (loopback_ctx->enabled == false) return;
+
+  if (loopback_ctx->fp.pfp == NULL) return;
+
   hc_lockfile (&loopback_ctx->fp);
+}
 
-  hc_fwrite (EOL, strlen (EOL), 1, &loopback_ctx->fp);
+void loopback_write_unlock (hashcat_ctx_t *hashcat_ctx)
+{
+  loopback_ctx_t *loopback_ctx = hashcat_ctx->loopback_ctx;
+
+  if (loopback_ctx->enabled == false) return;
+
+  if (loopback_ctx->fp.pfp == NULL) return;
 
   hc_fflush (&loopback_ctx->fp);
 
   hc_unlockfile (&loopback_ctx->fp);
-
-  loopback_ctx->unused = false;
 }
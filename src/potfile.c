@@ -14,6 +14,7 @@
 #include "outfile.h"
 #include "locking.h"
 #include "shared.h"
+#include "thread.h"
 #include "potfile.h"
 
 static const char MASKED_PLAIN[] = "[notfound]";
@@ -58,49 +59,296 @@ static int sort_by_hash_t_salt (const void *v1, const void *v2)
 }
 */
 
-// this function is special and only used whenever --username and --show are used together:
-// it will sort all tree entries according to the settings stored in hashconfig
+// this function is used to reproduce the hash ordering based on the original input hash file
+
+int sort_pot_orig_line (const void *v1, const void *v2)
+{
+  const pot_orig_line_entry_t *t1 = (const pot_orig_line_entry_t *) v1;
+  const pot_orig_line_entry_t *t2 = (const pot_orig_line_entry_t *) v2;
+
+  return t1->line_pos > t2->line_pos;
+}
+
+// the binary index next to the potfile stores a fingerprint and the offset of every line hashcat appends,
+// so that on startup only the lines of the loaded hashes need to be decoded.
+// lines which were not written through the index (older versions, other tools) are recorded as legacy ranges.
+// a legacy range is parsed completely once for each hash-mode, afterwards its lines are in the index, too.
+// the same is done with the lines indexed for other hash-modes, a line can match hashes of several hash-modes.
 
-int sort_pot_tree_by_hash (const void *v1, const void *v2)
+static bool potfile_idx_usable (const hashcat_ctx_t *hashcat_ctx)
 {
-  const pot_tree_entry_t *t1 = (const pot_tree_entry_t *) v1;
-  const pot_tree_entry_t *t2 = (const pot_tree_entry_t *) v2;
+  const hashconfig_t *hashconfig = hashcat_ctx->hashconfig;
+  const module_ctx_t *module_ctx = hashcat_ctx->module_ctx;
+
+  // with these the potfile lines can not be matched by digest and salt
+
+  if (module_ctx->module_hash_decode_potfile != MODULE_DEFAULT) return false;
 
-  const hash_t *h1 = (const hash_t *) t1->nodes->hash_buf;
-  const hash_t *h2 = (const hash_t *) t2->nodes->hash_buf;
+  if (module_ctx->module_hash_encode == MODULE_DEFAULT) return false;
 
-  hashconfig_t *hc = t1->hashconfig; // is same as t2->hashconfig
+  if (hashconfig->opts_type & OPTS_TYPE_BINARY_HASHFILE) return false;
 
-  return sort_by_hash (h1, h2, hc);
+  return true;
 }
 
-// this function is used to reproduce the hash ordering based on the original input hash file
+// must be equal for two hashes whenever sort_by_hash () says they are equal
 
-int sort_pot_orig_line (const void *v1, const void *v2)
+static u64 potfile_idx_fingerprint (const hashconfig_t *hashconfig, const hash_t *hash)
 {
-  const pot_orig_line_entry_t *t1 = (const pot_orig_line_entry_t *) v1;
-  const pot_orig_line_entry_t *t2 = (const pot_orig_line_entry_t *) v2;
+  u64 fingerprint = 0xcbf29ce484222325;
 
-  return t1->line_pos > t2->line_pos;
+  #define FP_ADD(v) { fingerprint ^= (u64) (v); fingerprint *= 0x100000001b3; }
+
+  const u32 *digest = (const u32 *) hash->digest;
+
+  FP_ADD (digest[hashconfig->dgst_pos0]);
+  FP_ADD (digest[hashconfig->dgst_pos1]);
+  FP_ADD (digest[hashconfig->dgst_pos2]);
+  FP_ADD (digest[hashconfig->dgst_pos3]);
+
+  if (hashconfig->is_salted == true)
+  {
+    const salt_t *salt = hash->salt;
+
+    FP_ADD (salt->salt_len);
+    FP_ADD (salt->salt_iter);
+
+    for (int n = 0; n < 64; n++) FP_ADD (salt->salt_buf[n]);
+    for (int n = 0; n < 64; n++) FP_ADD (salt->salt_buf_pc[n]);
+  }
+
+  #undef FP_ADD
+
+  return fingerprint;
+}
+
+// identifies the content of an indexed line, to notice a potfile which was rewritten in place.
+// trailing '\r' and '\n' are left out, the parser strips them, too
+
+static u64 potfile_idx_line_hash (const char *line_buf, size_t line_len)
+{
+  while ((line_len > 0) && ((line_buf[line_len - 1] == '\n') || (line_buf[line_len - 1] == '\r'))) line_len--;
+
+  u64 line_hash = 0xcbf29ce484222325;
+
+  for (size_t i = 0; i < line_len; i++)
+  {
+    line_hash ^= (u8) line_buf[i];
+    line_hash *= 0x100000001b3;
+  }
+
+  return line_hash;
+}
+
+static int sort_by_idx_offset (const void *v1, const void *v2)
+{
+  const u64 d1 = ((const potfile_idx_entry_t *) v1)->offset;
+  const u64 d2 = ((const potfile_idx_entry_t *) v2)->offset;
+
+  if (d1 > d2) return  1;
+  if (d1 < d2) return -1;
+
+  return 0;
+}
+
+// the fingerprint is spread over the slots, the low bits alone are not mixed well enough
+
+static u64 pot_hash_table_slot (const pot_hash_table_t *hash_table, const u64 fingerprint)
+{
+  return (fingerprint ^ (fingerprint >> 32)) & hash_table->mask;
+}
+
+void pot_hash_table_init (pot_hash_table_t *hash_table, const hashconfig_t *hashconfig, const hash_t *hashes_buf, const u32 hashes_cnt)
+{
+  // at most half of the slots are used, this keeps the probe sequences short
+
+  u64 slots_cnt = 16;
+
+  while (slots_cnt < ((u64) hashes_cnt * 2)) slots_cnt *= 2;
+
+  hash_table->slots     = (pot_hash_slot_t *) hccalloc (slots_cnt, sizeof (pot_hash_slot_t));
+  hash_table->mask      = slots_cnt - 1;
+  hash_table->line_offs = (u64 *) hccalloc (MAX (hashes_cnt, 1), sizeof (u64));
+
+  for (u32 hash_pos = 0; hash_pos < hashes_cnt; hash_pos++)
+  {
+    const u64 fingerprint = potfile_idx_fingerprint (hashconfig, &hashes_buf[hash_pos]);
+
+    u64 slot_pos = pot_hash_table_slot (hash_table, fingerprint);
+
+    while (hash_table->slots[slot_pos].hash_idx != 0) slot_pos = (slot_pos + 1) & hash_table->mask;
+
+    hash_table->slots[slot_pos].fingerprint = fingerprint;
+    hash_table->slots[slot_pos].hash_idx    = hash_pos + 1;
+  }
+}
+
+void pot_hash_table_destroy (pot_hash_table_t *hash_table)
+{
+  hcfree (hash_table->slots);
+  hcfree (hash_table->line_offs);
+
+  hash_table->slots     = NULL;
+  hash_table->mask      = 0;
+  hash_table->line_offs = NULL;
+}
+
+bool pot_hash_table_exists (const pot_hash_table_t *hash_table, const u64 fingerprint)
+{
+  for (u64 slot_pos = pot_hash_table_slot (hash_table, fingerprint); hash_table->slots[slot_pos].hash_idx != 0; slot_pos = (slot_pos + 1) & hash_table->mask)
+  {
+    if (hash_table->slots[slot_pos].fingerprint == fingerprint) return true;
+  }
+
+  return false;
+}
+
+static void potfile_idx_write_entry (HCFILE *fp, const u32 type, const u32 hash_mode, const u64 fingerprint, const u64 offset, const u64 length, const u64 line_hash)
+{
+  potfile_idx_entry_t entry;
+
+  entry.type        = type;
+  entry.hash_mode   = hash_mode;
+  entry.fingerprint = fingerprint;
+  entry.offset      = offset;
+  entry.length      = length;
+  entry.line_hash   = line_hash;
+
+  hc_fwrite (&entry, sizeof (potfile_idx_entry_t), 1, fp);
+}
+
+// the covered ranges are kept sorted, touching or overlapping ranges are merged
+
+static void potfile_idx_cover (u64 **cover_buf, u32 *cover_cnt, u32 *cover_avail, const u64 beg, const u64 end)
+{
+  u64 *cover = *cover_buf;
+
+  u32 cnt = *cover_cnt;
+
+  // the common case, lines appended in order
+
+  if ((cnt > 0) && (beg >= cover[(cnt - 1) * 2]) && (beg <= cover[(cnt - 1) * 2 + 1]))
+  {
+    cover[(cnt - 1) * 2 + 1] = MAX (cover[(cnt - 1) * 2 + 1], end);
+
+    return;
+  }
+
+  u32 first = 0;
+
+  while ((first < cnt) && (cover[first * 2 + 1] < beg)) first++;
+
+  u32 last = first;
+
+  while ((last < cnt) && (cover[last * 2] <= end)) last++;
+
+  if (first == last)
+  {
+    if (cnt == *cover_avail)
+    {
+      cover = (u64 *) hcrealloc (cover, (size_t) *cover_avail * 2 * sizeof (u64), INCR_POTFILE_IDX * 2 * sizeof (u64));
+
+      *cover_buf    = cover;
+      *cover_avail += INCR_POTFILE_IDX;
+    }
+
+    memmove (cover + (first + 1) * 2, cover + first * 2, (size_t) (cnt - first) * 2 * sizeof (u64));
+
+    cover[first * 2 + 0] = beg;
+    cover[first * 2 + 1] = end;
+
+    *cover_cnt = cnt + 1;
+
+    return;
+  }
+
+  // ranges first .. last - 1 are merged into first
+
+  cover[first * 2 + 0] = MIN (cover[first * 2 + 0], beg);
+  cover[first * 2 + 1] = MAX (cover[(last - 1) * 2 + 1], end);
+
+  memmove (cover + (first + 1) * 2, cover + last * 2, (size_t) (cnt - last) * 2 * sizeof (u64));
+
+  *cover_cnt = cnt - (last - first - 1);
+}
+
+// reads the line of an index entry into line_buf (at least HCBUFSIZ_LARGE bytes), without line ending.
+// exactly the indexed line is read, with the potfile mapped that is a copy out of the mapping,
+// fgetl () would read ahead a whole block for every single line.
+// returns false if the line is not there anymore or is not the line the entry was written for
+
+static bool potfile_idx_read_line (HCFILE *fp, const potfile_idx_entry_t *line, char *line_buf, size_t *line_len)
+{
+  if (line->length >= HCBUFSIZ_LARGE) return false;
+
+  if (hc_fseek (fp, (off_t) line->offset, SEEK_SET) == -1) return false;
+
+  if (hc_fread (line_buf, 1, (size_t) line->length, fp) != (size_t) line->length) return false;
+
+  size_t len = (size_t) line->length;
+
+  while ((len > 0) && ((line_buf[len - 1] == '\n') || (line_buf[len - 1] == '\r'))) len--;
+
+  line_buf[len] = 0;
+
+  *line_len = len;
+
+  return (potfile_idx_line_hash (line_buf, len) == line->line_hash);
 }
 
-// the problem with the GNU tdestroy () function is that it doesn't work with mingw etc
-// there are 2 alternatives:
-// 1. recursively delete the entries with entry->left and entry->right
-// 2. use tdelete () <- this is what we currently use, but this could be slower!
+// true if beg .. end lies within one of the ranges of a cover built by potfile_idx_cover ()
 
-void pot_tree_destroy (pot_tree_entry_t *tree)
+static bool potfile_idx_covered (const u64 *cover_buf, const u32 cover_cnt, const u64 beg, const u64 end)
 {
-  pot_tree_entry_t *entry = tree;
+  u32 lo = 0;
+  u32 hi = cover_cnt;
 
-  while (tree != NULL)
+  while (lo < hi)
+  {
+    const u32 mid = lo + ((hi - lo) / 2);
+
+    if (cover_buf[mid * 2] <= beg) lo = mid + 1; else hi = mid;
+  }
+
+  if (lo == 0) return false;
+
+  return (end <= cover_buf[(lo - 1) * 2 + 1]);
+}
+
+// scratch hash for decoding potfile lines, each parser thread has its own
+
+static void potfile_hash_alloc (const hashconfig_t *hashconfig, hash_t *hash_buf)
+{
+  memset (hash_buf, 0, sizeof (hash_t));
+
+  hash_buf->digest = hcmalloc (hashconfig->dgst_size);
+
+  if (hashconfig->is_salted == true)
+  {
+    hash_buf->salt = (salt_t *) hcmalloc (sizeof (salt_t));
+  }
+
+  if (hashconfig->esalt_size > 0)
   {
-    entry = *(pot_tree_entry_t **) tree;
+    hash_buf->esalt = hcmalloc (hashconfig->esalt_size);
+  }
 
-    tdelete (entry, (void **) &tree, sort_pot_tree_by_hash);
+  if (hashconfig->hook_salt_size > 0)
+  {
+    hash_buf->hook_salt = hcmalloc (hashconfig->hook_salt_size);
   }
 }
 
+static void potfile_hash_free (hash_t *hash_buf)
+{
+  hcfree (hash_buf->digest);
+  hcfree (hash_buf->salt);
+  hcfree (hash_buf->esalt);
+  hcfree (hash_buf->hook_salt);
+
+  memset (hash_buf, 0, sizeof (hash_t));
+}
+
 int potfile_init (hashcat_ctx_t *hashcat_ctx)
 {
   const folder_config_t *folder_config = hashcat_ctx->folder_config;
@@ -137,6 +385,11 @@ int potfile_init (hashcat_ctx_t *hashcat_ctx)
     potfile_ctx->fp.pfp   = NULL;
   }
 
+  hc_asprintf (&potfile_ctx->idx_filename, "%s" POTFILE_IDX_SUFFIX, potfile_ctx->filename);
+
+  potfile_ctx->idx_fp.pfp  = NULL;
+  potfile_ctx->idx_enabled = false;
+
   // starting from here, we should allocate some scratch buffer for later use
 
   u8 *out_buf = (u8 *) hcmalloc (HCBUFSIZ_LARGE);
@@ -182,6 +435,8 @@ void potfile_destroy (hashcat_ctx_t *hashcat_ctx)
   hcfree (potfile_ctx->out_buf);
   hcfree (potfile_ctx->tmp_buf);
 
+  hcfree (potfile_ctx->idx_filename);
+
   memset (potfile_ctx, 0, sizeof (potfile_ctx_t));
 }
 
@@ -228,6 +483,23 @@ int potfile_write_open (hashcat_ctx_t *hashcat_ctx)
     return -1;
   }
 
+  potfile_ctx->idx_enabled = false;
+
+  if (potfile_idx_usable (hashcat_ctx) == false) return 0;
+
+  // without the index the potfile still works, the new lines are picked up as legacy range on the next start
+
+  if (hc_fopen (&potfile_ctx->idx_fp, potfile_ctx->idx_filename, "ab") == false)
+  {
+    event_log_warning (hashcat_ctx, "%s: %s", potfile_ctx->idx_filename, strerror (errno));
+
+    return 0;
+  }
+
+  potfile_hash_alloc (hashcat_ctx->hashconfig, &potfile_ctx->idx_hash);
+
+  potfile_ctx->idx_enabled = true;
+
   return 0;
 }
 
@@ -241,6 +513,14 @@ void potfile_write_close (hashcat_ctx_t *hashcat_ctx)
   if (hashconfig->potfile_disable == true) return;
 
   hc_fclose (&potfile_ctx->fp);
+
+  if (potfile_ctx->idx_enabled == false) return;
+
+  hc_fclose (&potfile_ctx->idx_fp);
+
+  potfile_hash_free (&potfile_ctx->idx_hash);
+
+  potfile_ctx->idx_enabled = false;
 }
 
 void potfile_write_append (hashcat_ctx_t *hashcat_ctx, const char *out_buf, const int out_len, u8 *plain_ptr, unsigned int plain_len)
@@ -296,12 +576,86 @@ void potfile_write_append (hashcat_ctx_t *hashcat_ctx, const char *out_buf, cons
 
   tmp_buf[tmp_len] = 0;
 
+  hc_fprintf (&potfile_ctx->fp, "%s" EOL, tmp_buf);
+
+  const u64 line_pos = potfile_ctx->idx_pos;
+  const u64 line_len = (u64) tmp_len + strlen (EOL);
+
+  potfile_ctx->idx_pos += line_len;
+
+  if (potfile_ctx->idx_enabled == false) return;
+
+  // the line is decoded the same way potfile_remove_parse () does it, this way the fingerprints match for sure
+
+  const module_ctx_t *module_ctx = hashcat_ctx->module_ctx;
+
+  hash_t *idx_hash = &potfile_ctx->idx_hash;
+
+  if (idx_hash->salt)      memset (idx_hash->salt,      0, sizeof (salt_t));
+  if (idx_hash->esalt)     memset (idx_hash->esalt,     0, hashconfig->esalt_size);
+  if (idx_hash->hook_salt) memset (idx_hash->hook_salt, 0, hashconfig->hook_salt_size);
+
+  const int parser_status = module_ctx->module_hash_decode (hashconfig, idx_hash->digest, idx_hash->salt, idx_hash->esalt, idx_hash->hook_salt, idx_hash->hash_info, out_buf, out_len);
+
+  if (parser_status != PARSER_OK) return;
+
+  potfile_idx_write_entry (&potfile_ctx->idx_fp, POTFILE_IDX_LINE, (u32) hashconfig->hash_mode, potfile_idx_fingerprint (hashconfig, idx_hash), line_pos, line_len, potfile_idx_line_hash ((const char *) tmp_buf, (size_t) tmp_len));
+}
+
+void potfile_write_lock (hashcat_ctx_t *hashcat_ctx)
+{
+  const hashconfig_t *hashconfig  = hashcat_ctx->hashconfig;
+  potfile_ctx_t      *potfile_ctx = hashcat_ctx->potfile_ctx;
+
+  if (potfile_ctx->enabled == false) return;
+
+  if (hashconfig->potfile_disable == true) return;
+
   hc_lockfile (&potfile_ctx->fp);
 
-  hc_fprintf (&potfile_ctx->fp, "%s" EOL, tmp_buf);
+  // other sessions may have appended in the meantime, the index needs the real offset of our lines
+
+  hc_fseek (&potfile_ctx->fp, 0, SEEK_END);
+
+  potfile_ctx->idx_pos = (u64) hc_ftell (&potfile_ctx->fp);
+
+  if (potfile_ctx->idx_enabled == false) return;
+
+  hc_lockfile (&potfile_ctx->idx_fp);
+
+  hc_fseek (&potfile_ctx->idx_fp, 0, SEEK_END);
+
+  if (hc_ftell (&potfile_ctx->idx_fp) == 0)
+  {
+    const u64 version = POTFILE_IDX_VERSION;
+
+    hc_fwrite (&version, sizeof (u64), 1, &potfile_ctx->idx_fp);
+  }
+}
+
+void potfile_write_unlock (hashcat_ctx_t *hashcat_ctx)
+{
+  const hashconfig_t *hashconfig  = hashcat_ctx->hashconfig;
+  potfile_ctx_t      *potfile_ctx = hashcat_ctx->potfile_ctx;
+
+  if (potfile_ctx->enabled == false) return;
+
+  if (hashconfig->potfile_disable == true) return;
 
   hc_fflush (&potfile_ctx->fp);
 
+  // the index entries only become visible after the lines they point to
+
+  if (potfile_ctx->idx_enabled == true)
+  {
+    hc_fflush (&potfile_ctx->idx_fp);
+
+    if (hc_unlockfile (&potfile_ctx->idx_fp))
+    {
+      event_log_error (hashcat_ctx, "%s: Failed to unlock file.", potfile_ctx->idx_filename);
+    }
+  }
+
   if (hc_unlockfile (&potfile_ctx->fp))
   {
     event_log_error (hashcat_ctx, "%s: Failed to unlock file.", potfile_ctx->filename);
@@ -317,6 +671,10 @@ void potfile_update_hash (hashcat_ctx_t *hashcat_ctx, hash_t *found, char *line_
   char *pw_buf = line_pw_buf;
   int   pw_len = line_pw_len;
 
+  // a hash can be on several lines, a later line replaces the password of an earlier one
+
+  hcfree (found->pw_buf);
+
   found->pw_buf = (char *) hcmalloc (pw_len + 1);
   found->pw_len = pw_len;
 
@@ -337,296 +695,891 @@ void potfile_update_hash (hashcat_ctx_t *hashcat_ctx, hash_t *found, char *line_
   }
 }
 
-void potfile_update_hashes (hashcat_ctx_t *hashcat_ctx, hash_t *hash_buf, char *line_pw_buf, int line_pw_len, pot_tree_entry_t *tree)
-{
-  hashconfig_t *hashconfig = hashcat_ctx->hashconfig;
+// the lines are not parsed in file order, so the password of the last line in the file is kept by comparing the line offsets
 
-  // the linked list node:
+static void potfile_update_hash_at (hashcat_ctx_t *hashcat_ctx, const pot_hash_table_t *hash_table, const u32 hash_idx, const u64 line_off, char *line_pw_buf, int line_pw_len)
+{
+  const hashes_t *hashes = hashcat_ctx->hashes;
 
-  pot_hash_node_t search_node;
+  if (hash_table->line_offs[hash_idx] > line_off + 1) return;
 
-  search_node.hash_buf = hash_buf;
-  search_node.next     = NULL;
+  potfile_update_hash (hashcat_ctx, &hashes->hashes_buf[hash_idx], line_pw_buf, line_pw_len);
 
-  // the search entry:
+  hash_table->line_offs[hash_idx] = line_off + 1;
+}
 
-  pot_tree_entry_t search_entry;
+// with potfile_keep_all_hashes all loaded hashes equal to hash_buf are updated, otherwise (the hashes are unique then) the first one
+// mux can be NULL if there is only one thread
 
-  search_entry.nodes      = &search_node;
-  search_entry.hashconfig = hashconfig;
+void potfile_update_hashes (hashcat_ctx_t *hashcat_ctx, hash_t *hash_buf, char *line_pw_buf, int line_pw_len, const u64 line_off, const pot_hash_table_t *hash_table, hc_thread_mutex_t *mux)
+{
+  const hashconfig_t *hashconfig = hashcat_ctx->hashconfig;
+  const hashes_t     *hashes     = hashcat_ctx->hashes;
 
-  // the main search function is this:
+  hash_t *hashes_buf = hashes->hashes_buf;
 
-  void **found = (void **) tfind (&search_entry, (void **) &tree, sort_pot_tree_by_hash);
+  const u64 fingerprint = potfile_idx_fingerprint (hashconfig, hash_buf);
 
-  if (found)
+  for (u64 slot_pos = pot_hash_table_slot (hash_table, fingerprint); hash_table->slots[slot_pos].hash_idx != 0; slot_pos = (slot_pos + 1) & hash_table->mask)
   {
-    pot_tree_entry_t *found_entry = (pot_tree_entry_t *) *found;
+    const pot_hash_slot_t *slot = &hash_table->slots[slot_pos];
 
-    pot_hash_node_t *node = found_entry->nodes;
+    if (slot->fingerprint != fingerprint) continue;
 
-    while (node)
-    {
-      potfile_update_hash (hashcat_ctx, node->hash_buf, line_pw_buf, line_pw_len);
+    hash_t *found = &hashes_buf[slot->hash_idx - 1];
 
-      node = node->next;
-    }
+    // different keys can still have the same fingerprint
+
+    if (sort_by_hash (hash_buf, found, (void *) hashconfig) != 0) continue;
+
+    if (mux) hc_thread_mutex_lock (*mux);
+
+    potfile_update_hash_at (hashcat_ctx, hash_table, slot->hash_idx - 1, line_off, line_pw_buf, line_pw_len);
+
+    if (mux) hc_thread_mutex_unlock (*mux);
+
+    if (hashconfig->potfile_keep_all_hashes == false) break;
   }
 }
 
-int potfile_remove_parse (hashcat_ctx_t *hashcat_ctx)
+// returns true if the hash of the line could be decoded by module_hash_decode (), that is whenever it can go into the index
+
+static bool potfile_remove_line (hashcat_ctx_t *hashcat_ctx, hash_t *hash_buf, char *line_buf, const size_t line_len, const u64 line_off, void *tmps, const pot_hash_table_t *hash_table, hc_thread_mutex_t *mux)
 {
-  const hashconfig_t   *hashconfig   = hashcat_ctx->hashconfig;
-  const hashes_t       *hashes       = hashcat_ctx->hashes;
-  const module_ctx_t   *module_ctx   = hashcat_ctx->module_ctx;
-  potfile_ctx_t        *potfile_ctx  = hashcat_ctx->potfile_ctx;
+  const hashconfig_t *hashconfig = hashcat_ctx->hashconfig;
+  const hashes_t     *hashes     = hashcat_ctx->hashes;
+  const module_ctx_t *module_ctx = hashcat_ctx->module_ctx;
 
-  if (potfile_ctx->enabled == false) return 0;
+  hash_t *hashes_buf = hashes->hashes_buf;
+  u32     hashes_cnt = hashes->hashes_cnt;
 
-  if (hashconfig->potfile_disable == true) return 0;
+  char *last_separator = strrchr (line_buf, hashconfig->separator);
 
-  if (hashconfig->opts_type & OPTS_TYPE_PT_NEVERCRACK) return 0;
+  if (last_separator == NULL) return false; // ??
 
-  // if no potfile exists yet we don't need to do anything here
+  char *line_pw_buf = last_separator + 1;
 
-  if (hc_path_exist (potfile_ctx->filename) == false) return 0;
+  size_t line_pw_len = line_buf + line_len - line_pw_buf;
 
-  hash_t *hashes_buf = hashes->hashes_buf;
-  u32     hashes_cnt = hashes->hashes_cnt;
+  char *line_hash_buf = line_buf;
 
-  // no solution for these special hash types (for instane because they use hashfile in output etc)
+  int line_hash_len = last_separator - line_buf;
 
-  hash_t hash_buf;
+  line_hash_buf[line_hash_len] = 0;
 
-  hash_buf.digest    = hcmalloc (hashconfig->dgst_size);
-  hash_buf.salt      = NULL;
-  hash_buf.esalt     = NULL;
-  hash_buf.hook_salt = NULL;
-  hash_buf.cracked   = 0;
-  hash_buf.hash_info = NULL;
-  hash_buf.pw_buf    = NULL;
-  hash_buf.pw_len    = 0;
+  if (line_hash_len == 0) return false;
 
-  if (hashconfig->is_salted == true)
+  if (hash_buf->salt)
   {
-    hash_buf.salt = (salt_t *) hcmalloc (sizeof (salt_t));
+    memset (hash_buf->salt, 0, sizeof (salt_t));
   }
 
-  if (hashconfig->esalt_size > 0)
+  if (hash_buf->esalt)
   {
-    hash_buf.esalt = hcmalloc (hashconfig->esalt_size);
+    memset (hash_buf->esalt, 0, hashconfig->esalt_size);
   }
 
-  if (hashconfig->hook_salt_size > 0)
+  if (hash_buf->hook_salt)
   {
-    hash_buf.hook_salt = hcmalloc (hashconfig->hook_salt_size);
+    memset (hash_buf->hook_salt, 0, hashconfig->hook_salt_size);
   }
 
-  // we only need this variable in a very specific situation:
-  // whenever we use --username and --show together we want to keep all hashes sorted within a nice structure
-
-  pot_tree_entry_t *all_hashes_tree  = NULL;
-  pot_tree_entry_t *tree_entry_cache = NULL;
-  pot_hash_node_t  *tree_nodes_cache = NULL;
-
-  if (hashconfig->potfile_keep_all_hashes == true)
+  if (module_ctx->module_hash_decode_potfile != MODULE_DEFAULT)
   {
-    // we need *at most* one entry for every hash
-    // (if there are no hashes with the same keys (hash + salt), a counter example would be: same hash but different user name)
-    tree_entry_cache = (pot_tree_entry_t *) hccalloc (hashes_cnt, sizeof (pot_tree_entry_t));
-
-    // we need *always exactly* one linked list for every hash
-    tree_nodes_cache = (pot_hash_node_t  *) hccalloc (hashes_cnt, sizeof (pot_hash_node_t));
-
-    for (u32 hash_pos = 0; hash_pos < hashes_cnt; hash_pos++)
+    if (module_ctx->module_potfile_custom_check != MODULE_DEFAULT)
     {
-      // initialize the linked list node:
-      // we always need to create a new one and add it, because we want to keep and later update all hashes:
+      const int parser_status = module_ctx->module_hash_decode_potfile (hashconfig, hash_buf->digest, hash_buf->salt, hash_buf->esalt, hash_buf->hook_salt, hash_buf->hash_info, line_hash_buf, line_hash_len, tmps);
 
-      pot_hash_node_t *new_node = &tree_nodes_cache[hash_pos];
+      if (parser_status != PARSER_OK) return false;
 
-      new_node->hash_buf = &hashes_buf[hash_pos];
-      new_node->next     = NULL;
+      for (u32 hashes_pos = 0; hashes_pos < hashes_cnt; hashes_pos++)
+      {
+        const bool cracked = module_ctx->module_potfile_custom_check (hashconfig, &hashes_buf[hashes_pos], hash_buf, tmps);
 
-      // initialize the entry:
+        if (cracked == true)
+        {
+          hc_thread_mutex_lock (*mux);
 
-      pot_tree_entry_t *new_entry = &tree_entry_cache[hash_pos];
+          potfile_update_hash_at (hashcat_ctx, hash_table, hashes_pos, line_off, line_pw_buf, (u32) line_pw_len);
 
-      // note: the "key" (hash + salt) is indirectly accessible via the first nodes "hash_buf"
+          hc_thread_mutex_unlock (*mux);
+        }
+      }
 
-      new_entry->nodes      = new_node;
-      // the hashconfig is needed here because we need to be able to check within the sort function if we also need
-      // to sort by salt and we also need to have the correct order of dgst_pos0...dgst_pos3:
-      new_entry->hashconfig = (hashconfig_t *) hashconfig; // "const hashconfig_t" gives a warning
+      return false;
+    }
 
-      // the following function searches if the "key" is already present and if not inserts the new entry:
+    // should be rejected?
+    //const int parser_status = module_ctx->module_hash_decode_potfile (hashconfig, hash_buf->digest, hash_buf->salt, hash_buf->esalt, hash_buf->hook_salt, hash_buf->hash_info, line_hash_buf, line_hash_len, NULL);
+    //if (parser_status != PARSER_OK) return false;
 
-      void **found = (void **) tsearch (new_entry, (void **) &all_hashes_tree, sort_pot_tree_by_hash);
+    return false;
+  }
+  else
+  {
+    const int parser_status = module_ctx->module_hash_decode (hashconfig, hash_buf->digest, hash_buf->salt, hash_buf->esalt, hash_buf->hook_salt, hash_buf->hash_info, line_hash_buf, line_hash_len);
 
-      pot_tree_entry_t *found_entry = (pot_tree_entry_t *) *found;
+    if (parser_status != PARSER_OK) return false;
 
-      // we now need to check these cases; tsearch () could return:
-      // 1. NULL : if we have a memory allocation problem (not enough memory for the tree structure)
-      // 2. found_entry == new_entry: if we successfully insert a new key (which was not present yet)
-      // 3. found_entry != new_entry: if the key was already present
+    potfile_update_hashes (hashcat_ctx, hash_buf, line_pw_buf, (u32) line_pw_len, line_off, hash_table, mux);
+  }
 
-      // case 1: memory allocation error
+  return true;
+}
 
-      if (found_entry == NULL)
-      {
-        fprintf (stderr, "Error while allocating memory for the potfile search: %s\n", MSG_ENOMEM);
+HC_API_CALL void *thread_potfile_remove (void *p)
+{
+  potfile_remove_chunk_t *chunk = (potfile_remove_chunk_t *) p;
 
-        return -1;
-      }
+  hashcat_ctx_t *hashcat_ctx = chunk->hashcat_ctx;
 
-      // case 2: this means it was a new insert (and the insert was successful)
+  const hashconfig_t *hashconfig = hashcat_ctx->hashconfig;
 
-      if (found_entry == new_entry)
+  HCFILE *fp = chunk->fp;
+
+  hash_t hash_buf;
+
+  potfile_hash_alloc (hashconfig, &hash_buf);
+
+  void *tmps = NULL;
+
+  if (hashconfig->tmp_size > 0)
+  {
+    tmps = hcmalloc (hashconfig->tmp_size);
+  }
+
+  char *line_buf = (char *) hcmalloc (HCBUFSIZ_LARGE);
+
+  if (chunk->lines_buf != NULL)
+  {
+    for (u64 lines_pos = 0; lines_pos < chunk->lines_cnt; lines_pos++)
+    {
+      const potfile_idx_entry_t *line = &chunk->lines_buf[lines_pos];
+
+      // oversized lines were truncated when they were indexed, there is nothing to compare
+
+      if (line->length >= HCBUFSIZ_LARGE) continue;
+
+      size_t line_len = 0;
+
+      if (potfile_idx_read_line (fp, line, line_buf, &line_len) == false)
       {
-        // no updates to the linked list required (since it is the first one!)
+        chunk->idx_stale = true;
+
+        break;
       }
-      // case 3: if we have found an already existing entry
-      else
+
+      if (line_len == 0) continue;
+
+      const bool decoded = potfile_remove_line (hashcat_ctx, &hash_buf, line_buf, line_len, line->offset, tmps, chunk->hash_table, chunk->mux);
+
+      if ((decoded == true) && (chunk->idx_fp != NULL))
       {
-        new_node->next = found_entry->nodes;
+        const u64 fingerprint = potfile_idx_fingerprint (hashconfig, &hash_buf);
+
+        hc_thread_mutex_lock (*chunk->mux);
+
+        potfile_idx_write_entry (chunk->idx_fp, POTFILE_IDX_LINE, (u32) hashconfig->hash_mode, fingerprint, line->offset, line->length, line->line_hash);
+
+        hc_thread_mutex_unlock (*chunk->mux);
       }
+    }
+  }
+  else
+  {
+    if ((u64) hc_ftell (fp) != chunk->off_start) hc_fseek (fp, (off_t) chunk->off_start, SEEK_SET);
+
+    u64 line_pos = chunk->off_start;
+
+    while ((line_pos < chunk->off_end) && !hc_feof (fp))
+    {
+      const size_t line_len = fgetl (fp, line_buf, HCBUFSIZ_LARGE);
+
+      const u64 line_next = (u64) hc_ftell (fp);
 
-      // we always insert the new node at the very beginning
-      // (or in other words: the head of the linked list always points to *this* new inserted node)
+      if (line_len > 0)
+      {
+        // taken before potfile_remove_line () cuts the line at the separator
+
+        const u64 line_hash = (chunk->idx_fp != NULL) ? potfile_idx_line_hash (line_buf, line_len) : 0;
+
+        const bool decoded = potfile_remove_line (hashcat_ctx, &hash_buf, line_buf, line_len, line_pos, tmps, chunk->hash_table, chunk->mux);
+
+        if ((decoded == true) && (chunk->idx_fp != NULL))
+        {
+          const u64 fingerprint = potfile_idx_fingerprint (hashconfig, &hash_buf);
+
+          hc_thread_mutex_lock (*chunk->mux);
 
-      found_entry->nodes = new_node;
+          potfile_idx_write_entry (chunk->idx_fp, POTFILE_IDX_LINE, (u32) hashconfig->hash_mode, fingerprint, line_pos, line_next - line_pos, line_hash);
+
+          hc_thread_mutex_unlock (*chunk->mux);
+        }
+      }
+
+      line_pos = line_next;
     }
   }
 
-  // do not use this unless really needed, for example as in LM
+  hcfree (line_buf);
+  hcfree (tmps);
 
-  if (module_ctx->module_hash_decode_zero_hash != MODULE_DEFAULT)
+  potfile_hash_free (&hash_buf);
+
+  return NULL;
+}
+
+// the lines are decoded and compared on all cores, each thread gets a line aligned part of the mapped potfile
+// or a share of the given indexed lines. without a mapping (compressed potfiles) everything is done right here
+// returns -1 if an indexed line does not match its entry anymore
+
+static int potfile_remove_parse_mt (hashcat_ctx_t *hashcat_ctx, const u64 off_start, const u64 off_end, const potfile_idx_entry_t *lines_buf, const u64 lines_cnt, HCFILE *idx_fp, const pot_hash_table_t *hash_table)
+{
+  potfile_ctx_t *potfile_ctx = hashcat_ctx->potfile_ctx;
+
+  HCFILE *fp = &potfile_ctx->fp;
+
+  hc_thread_mutex_t mux;
+
+  hc_thread_mutex_init (mux);
+
+  int chunks_cnt = 1;
+
+  if (fp->is_mmap == true)
   {
-    module_ctx->module_hash_decode_zero_hash (hashconfig, hash_buf.digest, hash_buf.salt, hash_buf.esalt, hash_buf.hook_salt, hash_buf.hash_info);
+    const int processors = hc_get_processor_count ();
 
-    if (hashconfig->potfile_keep_all_hashes == true)
+    u64 chunks_max = 0;
+
+    if (lines_buf != NULL)
     {
-      potfile_update_hashes (hashcat_ctx, &hash_buf, NULL, 0, all_hashes_tree);
+      chunks_max = lines_cnt / POTFILE_REMOVE_LINES_MIN;
     }
     else
     {
-      hash_t *found = (hash_t *) hc_bsearch_r (&hash_buf, hashes_buf, hashes_cnt, sizeof (hash_t), sort_by_hash_no_salt, (void *) hashconfig);
-
-      potfile_update_hash (hashcat_ctx, found, NULL, 0);
+      chunks_max = (MIN (off_end, fp->mm_len) - MIN (off_start, fp->mm_len)) / POTFILE_REMOVE_CHUNK_MIN;
     }
-  }
 
-  const int rc = potfile_read_open (hashcat_ctx);
+    chunks_cnt = (int) MAX (1, MIN (chunks_max, (u64) processors));
+  }
 
-  if (rc == -1) return -1;
+  potfile_remove_chunk_t *chunks = (potfile_remove_chunk_t *) hccalloc (chunks_cnt, sizeof (potfile_remove_chunk_t));
 
-  void *tmps = NULL;
+  for (int chunk_idx = 0; chunk_idx < chunks_cnt; chunk_idx++)
+  {
+    potfile_remove_chunk_t *chunk = chunks + chunk_idx;
+
+    chunk->hashcat_ctx     = hashcat_ctx;
+    chunk->fp              = fp;
+    chunk->off_start       = off_start;
+    chunk->off_end         = off_end;
+    chunk->lines_buf       = lines_buf;
+    chunk->lines_cnt       = lines_cnt;
+    chunk->idx_fp          = idx_fp;
+    chunk->hash_table      = hash_table;
+    chunk->mux             = &mux;
+  }
 
-  if (hashconfig->tmp_size > 0)
+  if (chunks_cnt == 1)
   {
-    tmps = hcmalloc (hashconfig->tmp_size);
+    thread_potfile_remove (chunks);
   }
+  else
+  {
+    HCFILE *views = (HCFILE *) hccalloc (chunks_cnt, sizeof (HCFILE));
 
-  char *line_buf = (char *) hcmalloc (HCBUFSIZ_LARGE);
+    hc_thread_t *threads = (hc_thread_t *) hccalloc (chunks_cnt, sizeof (hc_thread_t));
 
-  while (!hc_feof (&potfile_ctx->fp))
-  {
-    size_t line_len = fgetl (&potfile_ctx->fp, line_buf, HCBUFSIZ_LARGE);
+    const u64 range_start = MIN (off_start, fp->mm_len);
+    const u64 range_end   = MIN (off_end,   fp->mm_len);
 
-    if (line_len == 0) continue;
+    u64 off = range_start;
 
-    char *last_separator = strrchr (line_buf, hashconfig->separator);
+    for (int chunk_idx = 0; chunk_idx < chunks_cnt; chunk_idx++)
+    {
+      potfile_remove_chunk_t *chunk = chunks + chunk_idx;
 
-    if (last_separator == NULL) continue; // ??
+      // a private view of the shared mapping, it is never closed
 
-    char *line_pw_buf = last_separator + 1;
+      HCFILE *view = views + chunk_idx;
 
-    size_t line_pw_len = line_buf + line_len - line_pw_buf;
+      memcpy (view, fp, sizeof (HCFILE));
 
-    char *line_hash_buf = line_buf;
+      view->rd_buf = NULL;
+      view->rd_len = 0;
+      view->rd_pos = 0;
 
-    int line_hash_len = last_separator - line_buf;
+      chunk->fp = view;
 
-    line_hash_buf[line_hash_len] = 0;
+      if (lines_buf != NULL)
+      {
+        const u64 lines_beg = (lines_cnt / chunks_cnt) * chunk_idx;
+        const u64 lines_end = (chunk_idx < (chunks_cnt - 1)) ? (lines_cnt / chunks_cnt) * (chunk_idx + 1) : lines_cnt;
 
-    if (line_hash_len == 0) continue;
+        chunk->lines_buf = lines_buf + lines_beg;
+        chunk->lines_cnt = lines_end - lines_beg;
 
-    if (hash_buf.salt)
-    {
-      memset (hash_buf.salt, 0, sizeof (salt_t));
+        continue;
+      }
+
+      u64 end = range_end;
+
+      if (chunk_idx < (chunks_cnt - 1))
+      {
+        end = MAX (off, range_start + ((range_end - range_start) / chunks_cnt) * (chunk_idx + 1));
+
+        if (end < range_end) end += hc_find_newline (fp->mm_buf + end, range_end - end) + 1;
+
+        end = MIN (end, range_end);
+      }
+
+      view->mm_pos = off;
+      view->mm_len = end;
+
+      chunk->off_start = off;
+      chunk->off_end   = end;
+
+      off = end;
     }
 
-    if (hash_buf.esalt)
+    for (int chunk_idx = 0; chunk_idx < chunks_cnt; chunk_idx++)
     {
-      memset (hash_buf.esalt, 0, hashconfig->esalt_size);
+      hc_thread_create (threads[chunk_idx], thread_potfile_remove, chunks + chunk_idx);
     }
 
-    if (hash_buf.hook_salt)
+    hc_thread_wait (chunks_cnt, threads);
+
+    // the views are never closed, but fgetl () gave each of them a read-ahead buffer
+
+    for (int chunk_idx = 0; chunk_idx < chunks_cnt; chunk_idx++)
     {
-      memset (hash_buf.hook_salt, 0, hashconfig->hook_salt_size);
+      hcfree (views[chunk_idx].rd_buf);
     }
 
-    if (module_ctx->module_hash_decode_potfile != MODULE_DEFAULT)
+    hcfree (threads);
+    hcfree (views);
+  }
+
+  int rc = 0;
+
+  for (int chunk_idx = 0; chunk_idx < chunks_cnt; chunk_idx++)
+  {
+    if (chunks[chunk_idx].idx_stale == true) rc = -1;
+  }
+
+  hcfree (chunks);
+
+  hc_thread_mutex_delete (mux);
+
+  return rc;
+}
+
+// returns -1 if the index can not be used, the potfile needs to be parsed in full then
+
+static int potfile_idx_remove_parse (hashcat_ctx_t *hashcat_ctx, const pot_hash_table_t *hash_table)
+{
+  const hashconfig_t *hashconfig  = hashcat_ctx->hashconfig;
+  potfile_ctx_t      *potfile_ctx = hashcat_ctx->potfile_ctx;
+
+  // offsets into compressed potfiles are of no use
+
+  if (potfile_ctx->fp.is_gzip || potfile_ctx->fp.is_zip || potfile_ctx->fp.is_xz) return -1;
+
+  const u32 hash_mode = (u32) hashconfig->hash_mode;
+
+  // read the index, whatever is not covered by it is a legacy range
+
+  potfile_idx_entry_t *lines_buf    = NULL; // the lines which are worth decoding
+  u32                  lines_cnt    = 0;
+  u32                  lines_avail  = 0;
+
+  potfile_idx_entry_t *ranges_buf   = NULL; // legacy ranges, POTFILE_IDX_LEGACY
+  u32                  ranges_cnt   = 0;
+  u32                  ranges_avail = 0;
+
+  potfile_idx_entry_t *scans_buf    = NULL; // legacy ranges already parsed for this hash-mode, POTFILE_IDX_SCAN
+  u32                  scans_cnt    = 0;
+  u32                  scans_avail  = 0;
+
+  potfile_idx_entry_t *others_buf   = NULL; // lines indexed by other hash-modes, they are parsed like a legacy range
+  u32                  others_cnt   = 0;
+  u32                  others_avail = 0;
+  u64                  others_seen  = 0;
+
+  u64 entries_cnt = 0;
+
+  u64 *cover_buf   = NULL;
+  u32  cover_cnt   = 0;
+  u32  cover_avail = 0;
+
+  u64 *done_buf    = NULL; // parsed for this hash-mode already (POTFILE_IDX_SCAN) or going to be (POTFILE_IDX_LEGACY)
+  u32  done_cnt    = 0;
+  u32  done_avail  = 0;
+
+  bool idx_valid = false;
+
+  u64 idx_end = 0;
+
+  potfile_idx_entry_t line_first; // the first and the last indexed line are always compared with the potfile
+  potfile_idx_entry_t line_last;
+
+  memset (&line_first, 0, sizeof (potfile_idx_entry_t));
+  memset (&line_last,  0, sizeof (potfile_idx_entry_t));
+
+  HCFILE fp;
+
+  if (hc_fopen (&fp, potfile_ctx->idx_filename, "rb") == true)
+  {
+    u64 version = 0;
+
+    if ((hc_fread (&version, sizeof (u64), 1, &fp) == 1) && (version == POTFILE_IDX_VERSION))
     {
-      if (module_ctx->module_potfile_custom_check != MODULE_DEFAULT)
+      idx_valid = true;
+
+      potfile_idx_entry_t entry;
+
+      while (hc_fread (&entry, sizeof (potfile_idx_entry_t), 1, &fp) == 1)
       {
-        const int parser_status = module_ctx->module_hash_decode_potfile (hashconfig, hash_buf.digest, hash_buf.salt, hash_buf.esalt, hash_buf.hook_salt, hash_buf.hash_info, line_hash_buf, line_hash_len, tmps);
+        entries_cnt++;
+
+        idx_end = MAX (idx_end, entry.offset + entry.length);
+
+        if (entry.type == POTFILE_IDX_LINE)
+        {
+          potfile_idx_cover (&cover_buf, &cover_cnt, &cover_avail, entry.offset, entry.offset + entry.length);
+
+          if (entry.length < HCBUFSIZ_LARGE)
+          {
+            if ((line_first.type == 0) || (entry.offset < line_first.offset)) line_first = entry;
+            if ((line_last.type  == 0) || (entry.offset > line_last.offset))  line_last  = entry;
+          }
+
+          // a line can match hashes of other hash-modes with the same encoding, too. which of these lines were
+          // parsed for this hash-mode already is only known after all entries are read, they are picked up in a second pass
+
+          if (entry.hash_mode != hash_mode)
+          {
+            others_seen++;
+
+            continue;
+          }
+
+          if (pot_hash_table_exists (hash_table, entry.fingerprint) == false) continue;
+
+          if (lines_cnt == lines_avail)
+          {
+            lines_buf = (potfile_idx_entry_t *) hcrealloc (lines_buf, lines_avail * sizeof (potfile_idx_entry_t), INCR_POTFILE_IDX * sizeof (potfile_idx_entry_t));
 
-        if (parser_status != PARSER_OK) continue;
+            lines_avail += INCR_POTFILE_IDX;
+          }
 
-        for (u32 hashes_pos = 0; hashes_pos < hashes_cnt; hashes_pos++)
+          lines_buf[lines_cnt++] = entry;
+        }
+        else if (entry.type == POTFILE_IDX_LEGACY)
         {
-          const bool cracked = module_ctx->module_potfile_custom_check (hashconfig, &hashes_buf[hashes_pos], &hash_buf, tmps);
+          potfile_idx_cover (&cover_buf, &cover_cnt, &cover_avail, entry.offset, entry.offset + entry.length);
+          potfile_idx_cover (&done_buf,  &done_cnt,  &done_avail,  entry.offset, entry.offset + entry.length);
 
-          if (cracked == true)
+          if (ranges_cnt == ranges_avail)
           {
-            potfile_update_hash (hashcat_ctx, &hashes_buf[hashes_pos], line_pw_buf, (u32) line_pw_len);
+            ranges_buf = (potfile_idx_entry_t *) hcrealloc (ranges_buf, ranges_avail * sizeof (potfile_idx_entry_t), INCR_POTFILE_IDX * sizeof (potfile_idx_entry_t));
+
+            ranges_avail += INCR_POTFILE_IDX;
           }
+
+          ranges_buf[ranges_cnt++] = entry;
         }
+        else if (entry.type == POTFILE_IDX_SCAN)
+        {
+          if (entry.hash_mode != hash_mode) continue;
 
-        continue;
+          potfile_idx_cover (&done_buf, &done_cnt, &done_avail, entry.offset, entry.offset + entry.length);
+
+          if (scans_cnt == scans_avail)
+          {
+            scans_buf = (potfile_idx_entry_t *) hcrealloc (scans_buf, scans_avail * sizeof (potfile_idx_entry_t), INCR_POTFILE_IDX * sizeof (potfile_idx_entry_t));
+
+            scans_avail += INCR_POTFILE_IDX;
+          }
+
+          scans_buf[scans_cnt++] = entry;
+        }
       }
 
-      // should be rejected?
-      //const int parser_status = module_ctx->module_hash_decode_potfile (hashconfig, hash_buf.digest, hash_buf.salt, hash_buf.esalt, hash_buf.hook_salt, hash_buf.hash_info, line_hash_buf, line_hash_len, NULL);
-      //if (parser_status != PARSER_OK) continue;
+      // only the lines of other hash-modes which were not parsed for this hash-mode yet are kept,
+      // entries appended by other sessions in the meantime are left for the next start
+
+      if (others_seen > 0)
+      {
+        hc_fseek (&fp, sizeof (u64), SEEK_SET);
+
+        for (u64 entries_pos = 0; entries_pos < entries_cnt; entries_pos++)
+        {
+          if (hc_fread (&entry, sizeof (potfile_idx_entry_t), 1, &fp) != 1) break;
+
+          if (entry.type != POTFILE_IDX_LINE) continue;
+
+          if (entry.hash_mode == hash_mode) continue;
+
+          if (potfile_idx_covered (done_buf, done_cnt, entry.offset, entry.offset + entry.length) == true) continue;
+
+          if (others_cnt == others_avail)
+          {
+            others_buf = (potfile_idx_entry_t *) hcrealloc (others_buf, others_avail * sizeof (potfile_idx_entry_t), INCR_POTFILE_IDX * sizeof (potfile_idx_entry_t));
+
+            others_avail += INCR_POTFILE_IDX;
+          }
+
+          others_buf[others_cnt++] = entry;
+        }
+      }
     }
-    else
+
+    hc_fclose (&fp);
+  }
+
+  // the index entries are written after the lines they point to, so the potfile size is taken afterwards
+
+  struct stat st;
+
+  if (stat (potfile_ctx->filename, &st) == -1)
+  {
+    hcfree (lines_buf);
+    hcfree (ranges_buf);
+    hcfree (scans_buf);
+    hcfree (others_buf);
+    hcfree (cover_buf);
+    hcfree (done_buf);
+
+    return -1;
+  }
+
+  const u64 potfile_size = (u64) st.st_size;
+
+  // the potfile was truncated or replaced, the offsets are of no use anymore
+
+  if (idx_end > potfile_size) idx_valid = false;
+
+  // a potfile rewritten in place (sorted, deduplicated) can keep its size, the lines at the offsets are different then
+
+  if ((idx_valid == true) && (line_first.type == POTFILE_IDX_LINE))
+  {
+    char *line_buf = (char *) hcmalloc (HCBUFSIZ_LARGE);
+
+    size_t line_len = 0;
+
+    if (potfile_idx_read_line (&potfile_ctx->fp, &line_first, line_buf, &line_len) == false) idx_valid = false;
+    if (potfile_idx_read_line (&potfile_ctx->fp, &line_last,  line_buf, &line_len) == false) idx_valid = false;
+
+    hcfree (line_buf);
+  }
+
+  // a missing, damaged or outdated index is started over, the whole potfile becomes one legacy range
+  // the new index is written to a temporary file and renamed, other sessions may still append to the old one
+
+  char *idx_tmp = NULL;
+
+  if (idx_valid == false)
+  {
+    lines_cnt  = 0;
+    ranges_cnt = 0;
+    scans_cnt  = 0;
+    others_cnt = 0;
+    cover_cnt  = 0;
+    done_cnt   = 0;
+
+    hc_asprintf (&idx_tmp, "%s.%d.tmp", potfile_ctx->idx_filename, getpid ());
+  }
+
+  if (hc_fopen (&fp, (idx_valid == true) ? potfile_ctx->idx_filename : idx_tmp, (idx_valid == true) ? "ab" : "wb") == false)
+  {
+    event_log_warning (hashcat_ctx, "%s: %s", (idx_valid == true) ? potfile_ctx->idx_filename : idx_tmp, strerror (errno));
+
+    hcfree (idx_tmp);
+
+    hcfree (lines_buf);
+    hcfree (ranges_buf);
+    hcfree (scans_buf);
+    hcfree (others_buf);
+    hcfree (cover_buf);
+    hcfree (done_buf);
+
+    return -1;
+  }
+
+  hc_lockfile (&fp);
+
+  hc_fseek (&fp, 0, SEEK_END);
+
+  if (hc_ftell (&fp) == 0)
+  {
+    const u64 version = POTFILE_IDX_VERSION;
+
+    hc_fwrite (&version, sizeof (u64), 1, &fp);
+  }
+
+  // the gaps become new legacy ranges
+
+  u64 gap_beg = 0;
+
+  for (u32 cover_pos = 0; cover_pos <= cover_cnt; cover_pos++)
+  {
+    const u64 gap_end = (cover_pos < cover_cnt) ? cover_buf[cover_pos * 2 + 0] : potfile_size;
+
+    if (gap_end > gap_beg)
+    {
+      potfile_idx_write_entry (&fp, POTFILE_IDX_LEGACY, 0, 0, gap_beg, gap_end - gap_beg, 0);
+
+      if (ranges_cnt == ranges_avail)
+      {
+        ranges_buf = (potfile_idx_entry_t *) hcrealloc (ranges_buf, ranges_avail * sizeof (potfile_idx_entry_t), INCR_POTFILE_IDX * sizeof (potfile_idx_entry_t));
+
+        ranges_avail += INCR_POTFILE_IDX;
+      }
+
+      potfile_idx_entry_t *range = &ranges_buf[ranges_cnt++];
+
+      range->type        = POTFILE_IDX_LEGACY;
+      range->hash_mode   = 0;
+      range->fingerprint = 0;
+      range->offset      = gap_beg;
+      range->length      = gap_end - gap_beg;
+    }
+
+    if (cover_pos < cover_cnt) gap_beg = MAX (gap_beg, cover_buf[cover_pos * 2 + 1]);
+  }
+
+  // legacy ranges are parsed line by line, but only once per hash-mode
+
+  for (u32 ranges_pos = 0; ranges_pos < ranges_cnt; ranges_pos++)
+  {
+    const potfile_idx_entry_t *range = &ranges_buf[ranges_pos];
+
+    bool scanned = false;
+
+    for (u32 scans_pos = 0; scans_pos < scans_cnt; scans_pos++)
     {
-      const int parser_status = module_ctx->module_hash_decode (hashconfig, hash_buf.digest, hash_buf.salt, hash_buf.esalt, hash_buf.hook_salt, hash_buf.hash_info, line_hash_buf, line_hash_len);
+      if ((scans_buf[scans_pos].offset != range->offset) || (scans_buf[scans_pos].length != range->length)) continue;
+
+      scanned = true;
+
+      break;
+    }
+
+    if (scanned == true) continue;
+
+    potfile_remove_parse_mt (hashcat_ctx, range->offset, range->offset + range->length, NULL, 0, &fp, hash_table);
+
+    potfile_idx_write_entry (&fp, POTFILE_IDX_SCAN, hash_mode, 0, range->offset, range->length, 0);
+  }
+
+  // the lines of other hash-modes are parsed once per hash-mode as well, each run of them gets a POTFILE_IDX_SCAN entry
 
-      if (parser_status != PARSER_OK) continue;
+  qsort (others_buf, others_cnt, sizeof (potfile_idx_entry_t), sort_by_idx_offset);
+
+  u32 others_todo = 0;
+
+  for (u32 others_pos = 0; others_pos < others_cnt; others_pos++)
+  {
+    const potfile_idx_entry_t *other = &others_buf[others_pos];
+
+    if ((others_todo > 0) && (other->offset == others_buf[others_todo - 1].offset)) continue;
+
+    others_buf[others_todo++] = *other;
+  }
 
-      if (hashconfig->potfile_keep_all_hashes == true)
+  int rc = 0;
+
+  if (others_todo > 0)
+  {
+    rc = potfile_remove_parse_mt (hashcat_ctx, 0, 0, others_buf, others_todo, &fp, hash_table);
+  }
+
+  if ((rc == 0) && (others_todo > 0))
+  {
+    u64 run_beg = others_buf[0].offset;
+    u64 run_end = others_buf[0].offset + others_buf[0].length;
+
+    for (u32 others_pos = 1; others_pos <= others_todo; others_pos++)
+    {
+      if ((others_pos < others_todo) && (others_buf[others_pos].offset == run_end))
       {
-        potfile_update_hashes (hashcat_ctx, &hash_buf, line_pw_buf, (u32) line_pw_len, all_hashes_tree);
+        run_end += others_buf[others_pos].length;
 
         continue;
       }
 
-      hash_t *found = (hash_t *) hc_bsearch_r (&hash_buf, hashes_buf, hashes_cnt, sizeof (hash_t), sort_by_hash, (void *) hashconfig);
+      potfile_idx_write_entry (&fp, POTFILE_IDX_SCAN, hash_mode, 0, run_beg, run_end - run_beg, 0);
 
-      potfile_update_hash (hashcat_ctx, found, line_pw_buf, (u32) line_pw_len);
+      if (others_pos < others_todo)
+      {
+        run_beg = others_buf[others_pos].offset;
+        run_end = others_buf[others_pos].offset + others_buf[others_pos].length;
+      }
     }
   }
 
-  hcfree (line_buf);
+  hc_fflush (&fp);
 
-  if (hashconfig->tmp_size > 0)
+  if (hc_unlockfile (&fp))
   {
-    hcfree (tmps);
+    event_log_error (hashcat_ctx, "%s: Failed to unlock file.", potfile_ctx->idx_filename);
   }
 
-  potfile_read_close (hashcat_ctx);
+  hc_fclose (&fp);
+
+  if (idx_tmp != NULL)
+  {
+    if (rename (idx_tmp, potfile_ctx->idx_filename) == -1)
+    {
+      event_log_warning (hashcat_ctx, "%s: %s", potfile_ctx->idx_filename, strerror (errno));
+
+      unlink (idx_tmp);
+    }
+
+    hcfree (idx_tmp);
+  }
+
+  // from the indexed lines, only those with a matching fingerprint are decoded, in file order
+
+  qsort (lines_buf, lines_cnt, sizeof (potfile_idx_entry_t), sort_by_idx_offset);
+
+  u32 lines_uniq = 0;
 
-  if (hashconfig->potfile_keep_all_hashes == true)
+  for (u32 lines_pos = 0; lines_pos < lines_cnt; lines_pos++)
   {
-    pot_tree_destroy (all_hashes_tree); // this could be slow (should we just skip it?)
+    if ((lines_uniq > 0) && (lines_buf[lines_pos].offset == lines_buf[lines_uniq - 1].offset)) continue;
 
-    hcfree (tree_nodes_cache);
-    hcfree (tree_entry_cache);
+    lines_buf[lines_uniq++] = lines_buf[lines_pos];
   }
 
+  if ((rc == 0) && (lines_uniq > 0))
+  {
+    rc = potfile_remove_parse_mt (hashcat_ctx, 0, 0, lines_buf, lines_uniq, NULL, hash_table);
+  }
+
+  hcfree (lines_buf);
+  hcfree (ranges_buf);
+  hcfree (scans_buf);
+  hcfree (others_buf);
+  hcfree (cover_buf);
+  hcfree (done_buf);
+
+  // an indexed line changed, so none of the offsets can be trusted. the cracks taken so far came from real lines,
+  // the full parse finds the rest and the next start builds a new index
+
+  if (rc == -1)
+  {
+    unlink (potfile_ctx->idx_filename);
+
+    return -1;
+  }
+
+  return 0;
+}
+
+int potfile_remove_parse (hashcat_ctx_t *hashcat_ctx)
+{
+  const hashconfig_t   *hashconfig   = hashcat_ctx->hashconfig;
+  const hashes_t       *hashes       = hashcat_ctx->hashes;
+  const module_ctx_t   *module_ctx   = hashcat_ctx->module_ctx;
+  potfile_ctx_t        *potfile_ctx  = hashcat_ctx->potfile_ctx;
+
+  if (potfile_ctx->enabled == false) return 0;
+
+  if (hashconfig->potfile_disable == true) return 0;
+
+  if (hashconfig->opts_type & OPTS_TYPE_PT_NEVERCRACK) return 0;
+
+  // if no potfile exists yet we don't need to do anything here
+
+  if (hc_path_exist (potfile_ctx->filename) == false) return 0;
+
+  hash_t *hashes_buf = hashes->hashes_buf;
+  u32     hashes_cnt = hashes->hashes_cnt;
+
+  // no solution for these special hash types (for instane because they use hashfile in output etc)
+
+  hash_t hash_buf;
+
+  hash_buf.digest    = hcmalloc (hashconfig->dgst_size);
+  hash_buf.salt      = NULL;
+  hash_buf.esalt     = NULL;
+  hash_buf.hook_salt = NULL;
+  hash_buf.cracked   = 0;
+  hash_buf.hash_info = NULL;
+  hash_buf.pw_buf    = NULL;
+  hash_buf.pw_len    = 0;
+
+  if (hashconfig->is_salted == true)
+  {
+    hash_buf.salt = (salt_t *) hcmalloc (sizeof (salt_t));
+  }
+
+  if (hashconfig->esalt_size > 0)
+  {
+    hash_buf.esalt = hcmalloc (hashconfig->esalt_size);
+  }
+
+  if (hashconfig->hook_salt_size > 0)
+  {
+    hash_buf.hook_salt = hcmalloc (hashconfig->hook_salt_size);
+  }
+
+  // all loaded hashes go into a hash table, this is also where the hashes with the same key are found,
+  // which we only need in a very specific situation: whenever we use --username and --show together
+
+  pot_hash_table_t hash_table;
+
+  pot_hash_table_init (&hash_table, hashconfig, hashes_buf, hashes_cnt);
+
+  // do not use this unless really needed, for example as in LM
+
+  if (module_ctx->module_hash_decode_zero_hash != MODULE_DEFAULT)
+  {
+    module_ctx->module_hash_decode_zero_hash (hashconfig, hash_buf.digest, hash_buf.salt, hash_buf.esalt, hash_buf.hook_salt, hash_buf.hash_info);
+
+    if (hashconfig->potfile_keep_all_hashes == true)
+    {
+      potfile_update_hashes (hashcat_ctx, &hash_buf, NULL, 0, 0, &hash_table, NULL);
+    }
+    else
+    {
+      hash_t *found = (hash_t *) hc_bsearch_r (&hash_buf, hashes_buf, hashes_cnt, sizeof (hash_t), sort_by_hash_no_salt, (void *) hashconfig);
+
+      potfile_update_hash (hashcat_ctx, found, NULL, 0);
+    }
+  }
+
+  const int rc = potfile_read_open (hashcat_ctx);
+
+  if (rc == -1)
+  {
+    pot_hash_table_destroy (&hash_table);
+
+    return -1;
+  }
+
+  // uncompressed potfiles are mapped, so they can be parsed on all cores
+
+  hc_fmmap (&potfile_ctx->fp);
+
+  bool idx_done = false;
+
+  if (potfile_idx_usable (hashcat_ctx) == true)
+  {
+    if (potfile_idx_remove_parse (hashcat_ctx, &hash_table) == 0) idx_done = true;
+  }
+
+  if (idx_done == false)
+  {
+    potfile_remove_parse_mt (hashcat_ctx, 0, (u64) -1, NULL, 0, NULL, &hash_table);
+  }
+
+  potfile_read_close (hashcat_ctx);
+
+  pot_hash_table_destroy (&hash_table);
+
   if (hashconfig->esalt_size > 0)
   {
     hcfree (hash_buf.esalt);
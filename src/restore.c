@@ -11,6 +11,7 @@
 #include "shared.h"
 #include "pidfile.h"
 #include "folder.h"
+#include "hashes.h"
 #include "restore.h"
 
 #if defined (_WIN)
@@ -252,6 +253,10 @@ int cycle_restore (hashcat_ctx_t *hashcat_ctx)
   const char *eff_restore_file = restore_ctx->eff_restore_file;
   const char *new_restore_file = restore_ctx->new_restore_file;
 
+  // the restore point must not be ahead of the cracks in the potfile
+
+  crack_writer_drain (hashcat_ctx);
+
   if (write_restore (hashcat_ctx) == -1) return -1;
 
   if (hc_path_exist (eff_restore_file) == true)
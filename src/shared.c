@@ -15,6 +15,11 @@
 #include <sys/cygwin.h>
 #endif
 
+#if (defined (__x86_64__) || defined (__i386__)) && (defined (__GNUC__) || defined (__clang__))
+#define HC_SIMD_NEWLINE
+#include <immintrin.h>
+#endif
+
 static const char *PA_000 = "OK";
 static const char *PA_001 = "Ignored due to comment";
 static const char *PA_002 = "Ignored due to zero length";
@@ -804,6 +809,171 @@ int count_char (const u8 *buf, const int len, const u8 c)
   return r;
 }
 
+/**
+ * line boundary scanners, the vector versions are picked at runtime by the cpu features
+ */
+
+static u64 find_newline_scalar (const char *buf, const u64 len)
+{
+  for (u64 i = 0; i < len; i++)
+  {
+    if (buf[i] == '\n') return i;
+  }
+
+  return len;
+}
+
+static u64 count_newlines_scalar (const char *buf, const u64 len)
+{
+  u64 cnt = 0;
+
+  for (u64 i = 0; i < len; i++)
+  {
+    if (buf[i] == '\n') cnt++;
+  }
+
+  return cnt;
+}
+
+#if defined (HC_SIMD_NEWLINE)
+
+__attribute__ ((target ("sse2")))
+static u64 find_newline_sse2 (const char *buf, const u64 len)
+{
+  const __m128i nl = _mm_set1_epi8 ('\n');
+
+  u64 i = 0;
+
+  for ( ; (i + 16) <= len; i += 16)
+  {
+    const __m128i v = _mm_loadu_si128 ((const __m128i *) (buf + i));
+
+    const u32 mask = (u32) _mm_movemask_epi8 (_mm_cmpeq_epi8 (v, nl));
+
+    if (mask) return i + (u64) __builtin_ctz (mask);
+  }
+
+  return i + find_newline_scalar (buf + i, len - i);
+}
+
+__attribute__ ((target ("sse2")))
+static u64 count_newlines_sse2 (const char *buf, const u64 len)
+{
+  const __m128i nl = _mm_set1_epi8 ('\n');
+
+  u64 cnt = 0;
+
+  u64 i = 0;
+
+  for ( ; (i + 16) <= len; i += 16)
+  {
+    const __m128i v = _mm_loadu_si128 ((const __m128i *) (buf + i));
+
+    cnt += (u64) __builtin_popcount ((u32) _mm_movemask_epi8 (_mm_cmpeq_epi8 (v, nl)));
+  }
+
+  return cnt + count_newlines_scalar (buf + i, len - i);
+}
+
+__attribute__ ((target ("avx2")))
+static u64 find_newline_avx2 (const char *buf, const u64 len)
+{
+  const __m256i nl = _mm256_set1_epi8 ('\n');
+
+  u64 i = 0;
+
+  for ( ; (i + 32) <= len; i += 32)
+  {
+    const __m256i v = _mm256_loadu_si256 ((const __m256i *) (buf + i));
+
+    const u32 mask = (u32) _mm256_movemask_epi8 (_mm256_cmpeq_epi8 (v, nl));
+
+    if (mask) return i + (u64) __builtin_ctz (mask);
+  }
+
+  return i + find_newline_sse2 (buf + i, len - i);
+}
+
+__attribute__ ((target ("avx2,popcnt")))
+static u64 count_newlines_avx2 (const char *buf, const u64 len)
+{
+  const __m256i nl = _mm256_set1_epi8 ('\n');
+
+  u64 cnt = 0;
+
+  u64 i = 0;
+
+  for ( ; (i + 32) <= len; i += 32)
+  {
+    const __m256i v = _mm256_loadu_si256 ((const __m256i *) (buf + i));
+
+    cnt += (u64) __builtin_popcount ((u32) _mm256_movemask_epi8 (_mm256_cmpeq_epi8 (v, nl)));
+  }
+
+  return cnt + count_newlines_sse2 (buf + i, len - i);
+}
+
+#endif
+
+static u64 find_newline_init   (const char *buf, const u64 len);
+static u64 count_newlines_init (const char *buf, const u64 len);
+
+static u64 (*find_newline_func)   (const char *, const u64) = find_newline_init;
+static u64 (*count_newlines_func) (const char *, const u64) = count_newlines_init;
+
+static void newline_scanner_init (void)
+{
+  // every thread resolves to the same functions, so a race on the first call is harmless
+
+  u64 (*find_func)  (const char *, const u64) = find_newline_scalar;
+  u64 (*count_func) (const char *, const u64) = count_newlines_scalar;
+
+  #if defined (HC_SIMD_NEWLINE)
+
+  __builtin_cpu_init ();
+
+  if (__builtin_cpu_supports ("sse2"))
+  {
+    find_func  = find_newline_sse2;
+    count_func = count_newlines_sse2;
+  }
+
+  if (__builtin_cpu_supports ("avx2") && __builtin_cpu_supports ("popcnt"))
+  {
+    find_func  = find_newline_avx2;
+    count_func = count_newlines_avx2;
+  }
+
+  #endif
+
+  find_newline_func   = find_func;
+  count_newlines_func = count_func;
+}
+
+static u64 find_newline_init (const char *buf, const u64 len)
+{
+  newline_scanner_init ();
+
+  return find_newline_func (buf, len);
+}
+
+static u64 count_newlines_init (const char *buf, const u64 len)
+{
+  newline_scanner_init ();
+
+  return count_newlines_func (buf, len);
+}
+
+u64 hc_find_newline (const char *buf, const u64 len)
+{
+  return find_newline_func (buf, len);
+}
+
+u64 hc_count_newlines (const char *buf, const u64 len)
+{
+  return count_newlines_func (buf, len);
+}
+
 float get_entropy (const u8 *buf, const int len)
 {
   float entropy = 0.0;
@@ -602,6 +602,43 @@ double status_get_guess_base_percent (const hashcat_ctx_t *hashcat_ctx)
   return ((double) guess_base_offset / (double) guess_base_count) * 100;
 }
 
+u64 status_get_dispatch_cnt (const hashcat_ctx_t *hashcat_ctx)
+{
+  const status_ctx_t *status_ctx = hashcat_ctx->status_ctx;
+
+  return hc_atomic_load (&status_ctx->dispatch_cnt);
+}
+
+u64 status_get_dispatch_retry_cnt (const hashcat_ctx_t *hashcat_ctx)
+{
+  const status_ctx_t *status_ctx = hashcat_ctx->status_ctx;
+
+  return hc_atomic_load (&status_ctx->dispatch_retry_cnt);
+}
+
+u64 status_get_dispatch_locked_cnt (const hashcat_ctx_t *hashcat_ctx)
+{
+  const status_ctx_t *status_ctx = hashcat_ctx->status_ctx;
+
+  return hc_atomic_load (&status_ctx->dispatch_locked_cnt);
+}
+
+double status_get_guess_base_io_wait_msec (const hashcat_ctx_t *hashcat_ctx)
+{
+  const user_options_t *user_options = hashcat_ctx->user_options;
+  const wl_ring_t      *wl_ring      = hashcat_ctx->wl_ring;
+
+  // only measured while the wordlist reader thread is fed by the read-ahead
+
+  if (user_options->wordlist_read_ahead == 0) return -1;
+
+  if (wl_ring->enabled == false) return -1;
+
+  if (wl_ring->hcwl.enabled == true) return -1;
+
+  return (double) hc_atomic_load (&wl_ring->io_wait_usec) / 1000;
+}
+
 char *status_get_guess_mod (const hashcat_ctx_t *hashcat_ctx)
 {
   const hashconfig_t   *hashconfig   = hashcat_ctx->hashconfig;
@@ -1466,6 +1503,22 @@ double status_get_exec_msec_dev (const hashcat_ctx_t *hashcat_ctx, const int bac
   return exec_dev_msec;
 }
 
+double status_get_hook_msec_dev (const hashcat_ctx_t *hashcat_ctx, const int backend_devices_idx)
+{
+  const backend_ctx_t *backend_ctx = hashcat_ctx->backend_ctx;
+
+  hc_device_param_t *device_param = &backend_ctx->devices_param[backend_devices_idx];
+
+  double hook_dev_msec = -1;
+
+  if ((device_param->skipped == false) && (device_param->skipped_warning == false) && (device_param->hook_pool != NULL))
+  {
+    hook_dev_msec = (double) hc_atomic_load (&device_param->hook_usec) / 1000;
+  }
+
+  return hook_dev_msec;
+}
+
 char *status_get_speed_sec_all (const hashcat_ctx_t *hashcat_ctx)
 {
   const double hashes_msec_all = status_get_hashes_msec_all (hashcat_ctx);
@@ -2153,6 +2206,10 @@ int status_ctx_init (hashcat_ctx_t *hashcat_ctx)
 
   status_ctx->checkpoint_shutdown = false;
 
+  status_ctx->dispatch_cnt        = 0;
+  status_ctx->dispatch_retry_cnt  = 0;
+  status_ctx->dispatch_locked_cnt = 0;
+
   status_ctx->hashcat_status_final = (hashcat_status_t *) hcmalloc (sizeof (hashcat_status_t));
 
   hc_thread_mutex_init (status_ctx->mux_dispatcher);
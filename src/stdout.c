@@ -12,6 +12,10 @@
 #include "mpsp.h"
 #include "backend.h"
 #include "shared.h"
+#include "memory.h"
+#include "thread.h"
+#include "wordlist.h"
+#include "slow_candidates.h"
 #include "stdout.h"
 
 static void out_flush (out_t *out)
@@ -50,31 +54,24 @@ static void out_push (out_t *out, const u8 *pw_buf, const int pw_len)
   }
 }
 
-int process_stdout (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u64 pws_cnt)
+static int out_open (hashcat_ctx_t *hashcat_ctx, out_t *out)
 {
-  combinator_ctx_t *combinator_ctx = hashcat_ctx->combinator_ctx;
-  hashconfig_t     *hashconfig     = hashcat_ctx->hashconfig;
-  mask_ctx_t       *mask_ctx       = hashcat_ctx->mask_ctx;
-  outfile_ctx_t    *outfile_ctx    = hashcat_ctx->outfile_ctx;
-  straight_ctx_t   *straight_ctx   = hashcat_ctx->straight_ctx;
-  user_options_t   *user_options   = hashcat_ctx->user_options;
+  outfile_ctx_t *outfile_ctx = hashcat_ctx->outfile_ctx;
 
   char *filename = outfile_ctx->filename;
 
-  out_t out;
-
   if (filename)
   {
-    if (hc_fopen (&out.fp, filename, "ab") == false)
+    if (hc_fopen (&out->fp, filename, "ab") == false)
     {
       event_log_error (hashcat_ctx, "%s: %s", filename, strerror (errno));
 
       return -1;
     }
 
-    if (hc_lockfile (&out.fp) == -1)
+    if (hc_lockfile (&out->fp) == -1)
     {
-      hc_fclose (&out.fp);
+      hc_fclose (&out->fp);
 
       event_log_error (hashcat_ctx, "%s: %s", filename, strerror (errno));
 
@@ -83,12 +80,98 @@ int process_stdout (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
   }
   else
   {
-    out.fp.is_gzip = false;
-    out.fp.pfp = stdout;
-    out.fp.fd = fileno (stdout);
+    memset (&out->fp, 0, sizeof (HCFILE));
+
+    out->fp.is_gzip = false;
+    out->fp.pfp = stdout;
+    out->fp.fd = fileno (stdout);
   }
 
-  out.len = 0;
+  out->len = 0;
+
+  return 0;
+}
+
+static void out_close (hashcat_ctx_t *hashcat_ctx, out_t *out)
+{
+  outfile_ctx_t *outfile_ctx = hashcat_ctx->outfile_ctx;
+
+  out_flush (out);
+
+  if (outfile_ctx->filename)
+  {
+    hc_unlockfile (&out->fp);
+
+    hc_fclose (&out->fp);
+  }
+}
+
+// the device holds the same candidates we uploaded in run_copy(), reading them back one by one costs two blocking transfers each
+
+static void host_gidd_to_pw_t (const hc_device_param_t *device_param, const u64 gidd, pw_t *pw)
+{
+  const pw_idx_t *pw_idx = device_param->pws_idx + gidd;
+
+  const u32 off = pw_idx->off;
+  const u32 cnt = pw_idx->cnt;
+  const u32 len = pw_idx->len;
+
+  memcpy (pw->i, device_param->pws_comp + off, cnt * sizeof (u32));
+
+  for (u32 i = cnt; i < 64; i++)
+  {
+    pw->i[i] = 0;
+  }
+
+  pw->pw_len = len;
+}
+
+static void stdout_worker_push (stdout_worker_t *stdout_worker, const u8 *pw_buf, const int pw_len)
+{
+  if ((stdout_worker->len + pw_len + 2) > stdout_worker->avail)
+  {
+    const u64 add = MAX ((u64) HCBUFSIZ_LARGE, stdout_worker->avail);
+
+    stdout_worker->buf = (char *) hcrealloc (stdout_worker->buf, stdout_worker->avail, add);
+
+    stdout_worker->avail += add;
+  }
+
+  char *ptr = stdout_worker->buf + stdout_worker->len;
+
+  memcpy (ptr, pw_buf, pw_len);
+
+  #if defined (_WIN)
+
+  ptr[pw_len + 0] = '\r';
+  ptr[pw_len + 1] = '\n';
+
+  stdout_worker->len += pw_len + 2;
+
+  #else
+
+  ptr[pw_len] = '\n';
+
+  stdout_worker->len += pw_len + 1;
+
+  #endif
+}
+
+static void stdout_worker_generate (stdout_worker_t *stdout_worker)
+{
+  hashcat_ctx_t     *hashcat_ctx  = stdout_worker->hashcat_ctx;
+  hc_device_param_t *device_param = stdout_worker->device_param;
+
+  combinator_ctx_t *combinator_ctx = hashcat_ctx->combinator_ctx;
+  hashconfig_t     *hashconfig     = hashcat_ctx->hashconfig;
+  mask_ctx_t       *mask_ctx       = hashcat_ctx->mask_ctx;
+  straight_ctx_t   *straight_ctx   = hashcat_ctx->straight_ctx;
+  user_options_t   *user_options   = hashcat_ctx->user_options;
+
+  const u64 gidvid_start = stdout_worker->gidvid_start;
+  const u64 gidvid_stop  = stdout_worker->gidvid_stop;
+
+  stdout_worker->len = 0;
 
   u32 plain_buf[64] = { 0 };
 
@@ -102,16 +185,9 @@ int process_stdout (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
   {
     pw_t pw;
 
-    for (u64 gidvid = 0; gidvid < pws_cnt; gidvid++)
+    for (u64 gidvid = gidvid_start; gidvid < gidvid_stop; gidvid++)
     {
-      const int rc = gidd_to_pw_t (hashcat_ctx, device_param, gidvid, &pw);
-
-      if (rc == -1)
-      {
-        if (filename) hc_fclose (&out.fp);
-
-        return -1;
-      }
+      host_gidd_to_pw_t (device_param, gidvid, &pw);
 
       for (u32 il_pos = 0; il_pos < il_cnt; il_pos++)
       {
@@ -138,7 +214,7 @@ int process_stdout (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
 
         if (plain_len > hashconfig->pw_max) plain_len = hashconfig->pw_max;
 
-        out_push (&out, plain_ptr, plain_len);
+        stdout_worker_push (stdout_worker, plain_ptr, plain_len);
       }
     }
   }
@@ -146,16 +222,9 @@ int process_stdout (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
   {
     pw_t pw;
 
-    for (u64 gidvid = 0; gidvid < pws_cnt; gidvid++)
+    for (u64 gidvid = gidvid_start; gidvid < gidvid_stop; gidvid++)
     {
-      const int rc = gidd_to_pw_t (hashcat_ctx, device_param, gidvid, &pw);
-
-      if (rc == -1)
-      {
-        if (filename) hc_fclose (&out.fp);
-
-        return -1;
-      }
+      host_gidd_to_pw_t (device_param, gidvid, &pw);
 
       for (u32 il_pos = 0; il_pos < il_cnt; il_pos++)
       {
@@ -184,13 +253,13 @@ int process_stdout (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
 
         if (plain_len > hashconfig->pw_max) plain_len = hashconfig->pw_max;
 
-        out_push (&out, plain_ptr, plain_len);
+        stdout_worker_push (stdout_worker, plain_ptr, plain_len);
       }
     }
   }
   else if (user_options->attack_mode == ATTACK_MODE_BF)
   {
-    for (u64 gidvid = 0; gidvid < pws_cnt; gidvid++)
+    for (u64 gidvid = gidvid_start; gidvid < gidvid_stop; gidvid++)
     {
       for (u32 il_pos = 0; il_pos < il_cnt; il_pos++)
       {
@@ -208,7 +277,7 @@ int process_stdout (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
 
         plain_len = mask_ctx->css_cnt;
 
-        out_push (&out, plain_ptr, plain_len);
+        stdout_worker_push (stdout_worker, plain_ptr, plain_len);
       }
     }
   }
@@ -216,16 +285,9 @@ int process_stdout (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
   {
     pw_t pw;
 
-    for (u64 gidvid = 0; gidvid < pws_cnt; gidvid++)
+    for (u64 gidvid = gidvid_start; gidvid < gidvid_stop; gidvid++)
     {
-      const int rc = gidd_to_pw_t (hashcat_ctx, device_param, gidvid, &pw);
-
-      if (rc == -1)
-      {
-        if (filename) hc_fclose (&out.fp);
-
-        return -1;
-      }
+      host_gidd_to_pw_t (device_param, gidvid, &pw);
 
       for (u32 il_pos = 0; il_pos < il_cnt; il_pos++)
       {
@@ -245,25 +307,14 @@ int process_stdout (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
 
         plain_len += start + stop;
 
-        out_push (&out, plain_ptr, plain_len);
+        stdout_worker_push (stdout_worker, plain_ptr, plain_len);
       }
     }
   }
   else if (user_options->attack_mode == ATTACK_MODE_HYBRID2)
   {
-    pw_t pw;
-
-    for (u64 gidvid = 0; gidvid < pws_cnt; gidvid++)
+    for (u64 gidvid = gidvid_start; gidvid < gidvid_stop; gidvid++)
     {
-      const int rc = gidd_to_pw_t (hashcat_ctx, device_param, gidvid, &pw);
-
-      if (rc == -1)
-      {
-        if (filename) hc_fclose (&out.fp);
-
-        return -1;
-      }
-
       for (u32 il_pos = 0; il_pos < il_cnt; il_pos++)
       {
         u64 off = device_param->kernel_params_mp_buf64[3] + gidvid;
@@ -284,19 +335,337 @@ int process_stdout (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
 
         if (plain_len > hashconfig->pw_max) plain_len = hashconfig->pw_max;
 
-        out_push (&out, plain_ptr, plain_len);
+        stdout_worker_push (stdout_worker, plain_ptr, plain_len);
       }
     }
   }
+}
+
+static HC_API_CALL void *thread_stdout_worker (void *p)
+{
+  stdout_worker_t *stdout_worker = (stdout_worker_t *) p;
 
-  out_flush (&out);
+  stdout_worker_generate (stdout_worker);
 
-  if (filename)
+  return NULL;
+}
+
+// the buffers are written in the order of their gidvid ranges, so the output is the same as a serial run
+
+static int stdout_workers_write (hashcat_ctx_t *hashcat_ctx, out_t *out, stdout_worker_t *stdout_workers, const int workers_cnt)
+{
+  #if defined (_POSIX)
+
+  if (out->fp.pfp) fflush (out->fp.pfp);
+
+  struct iovec iov[STDOUT_WORKERS_MAX];
+
+  int iov_cnt = 0;
+
+  for (int worker_idx = 0; worker_idx < workers_cnt; worker_idx++)
+  {
+    stdout_worker_t *stdout_worker = stdout_workers + worker_idx;
+
+    if (stdout_worker->len == 0) continue;
+
+    iov[iov_cnt].iov_base = stdout_worker->buf;
+    iov[iov_cnt].iov_len  = stdout_worker->len;
+
+    iov_cnt++;
+  }
+
+  int iov_pos = 0;
+
+  while (iov_pos < iov_cnt)
+  {
+    const ssize_t nwrite = writev (out->fp.fd, iov + iov_pos, iov_cnt - iov_pos);
+
+    if (nwrite == -1)
+    {
+      if (errno == EINTR) continue;
+
+      event_log_error (hashcat_ctx, "writev(): %s", strerror (errno));
+
+      return -1;
+    }
+
+    // partial writes resume in the middle of the buffer they stopped in
+
+    size_t left = (size_t) nwrite;
+
+    while ((iov_pos < iov_cnt) && (left >= iov[iov_pos].iov_len))
+    {
+      left -= iov[iov_pos].iov_len;
+
+      iov_pos++;
+    }
+
+    if (iov_pos < iov_cnt)
+    {
+      iov[iov_pos].iov_base  = (char *) iov[iov_pos].iov_base + left;
+      iov[iov_pos].iov_len  -= left;
+    }
+  }
+
+  #else
+
+  for (int worker_idx = 0; worker_idx < workers_cnt; worker_idx++)
   {
-    hc_unlockfile (&out.fp);
+    stdout_worker_t *stdout_worker = stdout_workers + worker_idx;
+
+    if (stdout_worker->len == 0) continue;
+
+    if (hc_fwrite (stdout_worker->buf, 1, stdout_worker->len, &out->fp) != stdout_worker->len)
+    {
+      event_log_error (hashcat_ctx, "fwrite(): %s", strerror (errno));
 
-    hc_fclose (&out.fp);
+      return -1;
+    }
   }
 
+  #endif
+
   return 0;
 }
+
+int process_stdout (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u64 pws_cnt)
+{
+  const u32 il_cnt = device_param->kernel_params_buf32[30]; // ugly, i know
+
+  if ((pws_cnt == 0) || (il_cnt == 0)) return 0;
+
+  // rules, combinations and masks are expanded by contiguous gidvid ranges on all cores,
+  // the candidates of one round are bounded to limit the memory of the per-worker buffers
+
+  const u64 words_per_worker = MAX (1, STDOUT_WORKER_CANDIDATES / il_cnt);
+
+  int workers_cnt = MIN (hc_get_processor_count (), STDOUT_WORKERS_MAX);
+
+  workers_cnt = (int) MAX (1, MIN ((u64) workers_cnt, CEILDIV (pws_cnt, words_per_worker)));
+
+  out_t out;
+
+  if (out_open (hashcat_ctx, &out) == -1) return -1;
+
+  stdout_worker_t *stdout_workers = (stdout_worker_t *) hccalloc (workers_cnt, sizeof (stdout_worker_t));
+
+  hc_thread_t *threads = (hc_thread_t *) hccalloc (workers_cnt, sizeof (hc_thread_t));
+
+  int rc = 0;
+
+  for (u64 gidvid_round = 0; gidvid_round < pws_cnt; gidvid_round += words_per_worker * workers_cnt)
+  {
+    for (int worker_idx = 0; worker_idx < workers_cnt; worker_idx++)
+    {
+      stdout_worker_t *stdout_worker = stdout_workers + worker_idx;
+
+      stdout_worker->hashcat_ctx  = hashcat_ctx;
+      stdout_worker->device_param = device_param;
+
+      stdout_worker->gidvid_start = MIN (gidvid_round + (worker_idx + 0) * words_per_worker, pws_cnt);
+      stdout_worker->gidvid_stop  = MIN (gidvid_round + (worker_idx + 1) * words_per_worker, pws_cnt);
+    }
+
+    if (workers_cnt == 1)
+    {
+      stdout_worker_generate (stdout_workers);
+    }
+    else
+    {
+      for (int worker_idx = 0; worker_idx < workers_cnt; worker_idx++)
+      {
+        hc_thread_create (threads[worker_idx], thread_stdout_worker, stdout_workers + worker_idx);
+      }
+
+      hc_thread_wait (workers_cnt, threads);
+    }
+
+    rc = stdout_workers_write (hashcat_ctx, &out, stdout_workers, workers_cnt);
+
+    if (rc == -1) break;
+  }
+
+  for (int worker_idx = 0; worker_idx < workers_cnt; worker_idx++)
+  {
+    hcfree (stdout_workers[worker_idx].buf);
+  }
+
+  hcfree (stdout_workers);
+  hcfree (threads);
+
+  out_close (hashcat_ctx, &out);
+
+  return rc;
+}
+
+int process_stdout_host (hashcat_ctx_t *hashcat_ctx)
+{
+  combinator_ctx_t *combinator_ctx = hashcat_ctx->combinator_ctx;
+  hashconfig_t     *hashconfig     = hashcat_ctx->hashconfig;
+  hashes_t         *hashes         = hashcat_ctx->hashes;
+  mask_ctx_t       *mask_ctx       = hashcat_ctx->mask_ctx;
+  status_ctx_t     *status_ctx     = hashcat_ctx->status_ctx;
+  straight_ctx_t   *straight_ctx   = hashcat_ctx->straight_ctx;
+  user_options_t   *user_options   = hashcat_ctx->user_options;
+
+  const u32 attack_mode = user_options->attack_mode;
+
+  const u64 words_off = status_ctx->words_off;
+  const u64 words_fin = (user_options->limit == 0) ? status_ctx->words_base : MIN (user_options->limit, status_ctx->words_base);
+
+  // these are the generators of the slow-candidates dispatcher, without a device to feed
+
+  extra_info_straight_t extra_info_straight;
+  extra_info_combi_t    extra_info_combi;
+  extra_info_mask_t     extra_info_mask;
+
+  memset (&extra_info_straight, 0, sizeof (extra_info_straight));
+  memset (&extra_info_combi,    0, sizeof (extra_info_combi));
+  memset (&extra_info_mask,     0, sizeof (extra_info_mask));
+
+  void *extra_info = NULL;
+
+  const u8  *out_buf = NULL;
+  const u32 *out_len = NULL;
+
+  if (attack_mode == ATTACK_MODE_STRAIGHT)
+  {
+    char *dictfile = straight_ctx->dict;
+
+    if (hc_fopen (&extra_info_straight.fp, dictfile, "rb") == false)
+    {
+      event_log_error (hashcat_ctx, "%s: %s", dictfile, strerror (errno));
+
+      return -1;
+    }
+
+    extra_info = &extra_info_straight;
+
+    out_buf = extra_info_straight.out_buf;
+    out_len = &extra_info_straight.out_len;
+  }
+  else if (attack_mode == ATTACK_MODE_COMBI)
+  {
+    char *base_file  = combinator_ctx->dict1;
+    char *combs_file = combinator_ctx->dict2;
+
+    if (combinator_ctx->combs_mode == COMBINATOR_MODE_BASE_RIGHT)
+    {
+      base_file  = combinator_ctx->dict2;
+      combs_file = combinator_ctx->dict1;
+    }
+
+    if (hc_fopen (&extra_info_combi.base_fp, base_file, "rb") == false)
+    {
+      event_log_error (hashcat_ctx, "%s: %s", base_file, strerror (errno));
+
+      return -1;
+    }
+
+    if (hc_fopen (&extra_info_combi.combs_fp, combs_file, "rb") == false)
+    {
+      event_log_error (hashcat_ctx, "%s: %s", combs_file, strerror (errno));
+
+      hc_fclose (&extra_info_combi.base_fp);
+
+      return -1;
+    }
+
+    extra_info_combi.scratch_buf = (char *) hcmalloc (HCBUFSIZ_LARGE);
+
+    extra_info = &extra_info_combi;
+
+    out_buf = extra_info_combi.out_buf;
+    out_len = &extra_info_combi.out_len;
+  }
+  else if (attack_mode == ATTACK_MODE_BF)
+  {
+    extra_info_mask.out_len = mask_ctx->css_cnt;
+
+    extra_info = &extra_info_mask;
+
+    out_buf = extra_info_mask.out_buf;
+    out_len = &extra_info_mask.out_len;
+  }
+
+  // the shared wl_data is left as the keyspace count left it, the generators get their own
+
+  hashcat_ctx_t *hashcat_ctx_tmp = (hashcat_ctx_t *) hcmalloc (sizeof (hashcat_ctx_t));
+
+  memcpy (hashcat_ctx_tmp, hashcat_ctx, sizeof (hashcat_ctx_t)); // yes we actually want to copy these pointers
+
+  hashcat_ctx_tmp->wl_data = (wl_data_t *) hcmalloc (sizeof (wl_data_t));
+
+  int rc = wl_data_init (hashcat_ctx_tmp);
+
+  out_t out;
+
+  if (rc == 0) rc = out_open (hashcat_ctx, &out);
+
+  if (rc == 0)
+  {
+    slow_candidates_seek (hashcat_ctx_tmp, extra_info, 0, words_off);
+
+    u64 words_cur = words_off;
+
+    while ((words_cur < words_fin) && (status_ctx->run_thread_level1 == true))
+    {
+      const u64 words_end = MIN (words_cur + STDOUT_HOST_BATCH, words_fin);
+
+      u64 words_rejected = 0;
+
+      for (u64 i = words_cur; i < words_end; i++)
+      {
+        if      (attack_mode == ATTACK_MODE_STRAIGHT) extra_info_straight.pos = i;
+        else if (attack_mode == ATTACK_MODE_COMBI)    extra_info_combi.pos    = i;
+        else if (attack_mode == ATTACK_MODE_BF)       extra_info_mask.pos     = i;
+
+        slow_candidates_next (hashcat_ctx_tmp, extra_info);
+
+        if ((*out_len < hashconfig->pw_min) || (*out_len > hashconfig->pw_max))
+        {
+          words_rejected++;
+
+          continue;
+        }
+
+        out_push (&out, out_buf, (const int) *out_len);
+      }
+
+      hc_thread_mutex_lock (status_ctx->mux_counter);
+
+      for (u32 salt_pos = 0; salt_pos < hashes->salts_cnt; salt_pos++)
+      {
+        status_ctx->words_progress_done[salt_pos]     += words_end - words_cur - words_rejected;
+        status_ctx->words_progress_rejected[salt_pos] += words_rejected;
+      }
+
+      hc_thread_mutex_unlock (status_ctx->mux_counter);
+
+      words_cur = words_end;
+
+      status_ctx->words_cur = words_cur;
+    }
+
+    out_close (hashcat_ctx, &out);
+  }
+
+  wl_data_destroy (hashcat_ctx_tmp);
+
+  hcfree (hashcat_ctx_tmp->wl_data);
+  hcfree (hashcat_ctx_tmp);
+
+  if (attack_mode == ATTACK_MODE_STRAIGHT)
+  {
+    hc_fclose (&extra_info_straight.fp);
+  }
+  else if (attack_mode == ATTACK_MODE_COMBI)
+  {
+    hc_fclose (&extra_info_combi.base_fp);
+    hc_fclose (&extra_info_combi.combs_fp);
+
+    hcfree (extra_info_combi.scratch_buf);
+  }
+
+  return rc;
+}
@@ -12,6 +12,7 @@
 #include "folder.h"
 #include "rp.h"
 #include "wordlist.h"
+#include "hcwl.h"
 #include "straight.h"
 
 static int straight_ctx_add_wl (hashcat_ctx_t *hashcat_ctx, const char *dict)
@@ -79,14 +80,19 @@ int straight_ctx_update_loop (hashcat_ctx_t *hashcat_ctx)
         return -1;
       }
 
+      if (hcwl_check (hashcat_ctx, &fp, straight_ctx->dict) == -1)
+      {
+        hc_fclose (&fp);
+
+        return -1;
+      }
+
       const int rc = count_words (hashcat_ctx, &fp, straight_ctx->dict, &status_ctx->words_cnt);
 
       hc_fclose (&fp);
 
       if (rc == -1)
       {
-        event_log_error (hashcat_ctx, "Integer overflow detected in keyspace of wordlist: %s", straight_ctx->dict);
-
         return -1;
       }
 
@@ -114,14 +120,19 @@ int straight_ctx_update_loop (hashcat_ctx_t *hashcat_ctx)
         return -1;
       }
 
+      if (hcwl_check (hashcat_ctx, &fp, combinator_ctx->dict1) == -1)
+      {
+        hc_fclose (&fp);
+
+        return -1;
+      }
+
       const int rc = count_words (hashcat_ctx, &fp, combinator_ctx->dict1, &status_ctx->words_cnt);
 
       hc_fclose (&fp);
 
       if (rc == -1)
       {
-        event_log_error (hashcat_ctx, "Integer overflow detected in keyspace of wordlist: %s", combinator_ctx->dict1);
-
         return -1;
       }
     }
@@ -136,14 +147,19 @@ int straight_ctx_update_loop (hashcat_ctx_t *hashcat_ctx)
         return -1;
       }
 
+      if (hcwl_check (hashcat_ctx, &fp, combinator_ctx->dict2) == -1)
+      {
+        hc_fclose (&fp);
+
+        return -1;
+      }
+
       const int rc = count_words (hashcat_ctx, &fp, combinator_ctx->dict2, &status_ctx->words_cnt);
 
       hc_fclose (&fp);
 
       if (rc == -1)
       {
-        event_log_error (hashcat_ctx, "Integer overflow detected in keyspace of wordlist: %s", combinator_ctx->dict2);
-
         return -1;
       }
     }
@@ -182,14 +198,19 @@ int straight_ctx_update_loop (hashcat_ctx_t *hashcat_ctx)
       return -1;
     }
 
+    if (hcwl_check (hashcat_ctx, &fp, straight_ctx->dict) == -1)
+    {
+      hc_fclose (&fp);
+
+      return -1;
+    }
+
     const int rc = count_words (hashcat_ctx, &fp, straight_ctx->dict, &status_ctx->words_cnt);
 
     hc_fclose (&fp);
 
     if (rc == -1)
     {
-      event_log_error (hashcat_ctx, "Integer overflow detected in keyspace of wordlist: %s", straight_ctx->dict);
-
       return -1;
     }
 
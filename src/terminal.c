@@ -700,6 +700,12 @@ void backend_info (hashcat_ctx_t *hashcat_ctx)
       event_log_info (hashcat_ctx, "  Clock..........: %u", device_maxclock_frequency);
       event_log_info (hashcat_ctx, "  Memory.Total...: %" PRIu64 " MB", device_global_mem / 1024 / 1024);
       event_log_info (hashcat_ctx, "  Memory.Free....: %" PRIu64 " MB", device_available_mem / 1024 / 1024);
+
+      if (device_param->device_transfer_pageable > 0)
+      {
+        event_log_info (hashcat_ctx, "  Transfer.HtoD..: %.0f MB/s pinned, %.0f MB/s pageable", device_param->device_transfer_pinned, device_param->device_transfer_pageable);
+      }
+
       event_log_info (hashcat_ctx, NULL);
     }
   }
@@ -767,6 +773,12 @@ void backend_info (hashcat_ctx_t *hashcat_ctx)
         event_log_info (hashcat_ctx, "    Clock..........: %u", device_maxclock_frequency);
         event_log_info (hashcat_ctx, "    Memory.Total...: %" PRIu64 " MB (limited to %" PRIu64 " MB allocatable in one block)", device_global_mem / 1024 / 1024, device_maxmem_alloc / 1024 / 1024);
         event_log_info (hashcat_ctx, "    Memory.Free....: %" PRIu64 " MB", device_available_mem / 1024 / 1024);
+
+        if (device_param->device_transfer_pageable > 0)
+        {
+          event_log_info (hashcat_ctx, "    Transfer.HtoD..: %.0f MB/s pinned, %.0f MB/s pageable", device_param->device_transfer_pinned, device_param->device_transfer_pageable);
+        }
+
         event_log_info (hashcat_ctx, "    OpenCL.Version.: %s", opencl_device_c_version);
         event_log_info (hashcat_ctx, "    Driver.Version.: %s", opencl_driver_version);
         event_log_info (hashcat_ctx, NULL);
@@ -1454,6 +1466,14 @@ void status_display (hashcat_ctx_t *hashcat_ctx)
       break;
   }
 
+  if (hashcat_status->guess_base_io_wait_msec >= 0)
+  {
+    event_log_info (hashcat_ctx,
+      "Guess.Base.Wait..: %.02fs (I/O, read-ahead %u)",
+      hashcat_status->guess_base_io_wait_msec / 1000,
+      user_options->wordlist_read_ahead);
+  }
+
   for (int device_id = 0; device_id < hashcat_status->device_info_cnt; device_id++)
   {
     const device_info_t *device_info = hashcat_status->device_info_buf + device_id;
@@ -1477,6 +1497,34 @@ void status_display (hashcat_ctx_t *hashcat_ctx)
     event_log_info (hashcat_ctx,
       "Speed.#*.........: %9sH/s",
       hashcat_status->speed_sec_all);
+
+    const double dispatch_retry_percent = (hashcat_status->dispatch_cnt > 0) ? ((double) hashcat_status->dispatch_retry_cnt / hashcat_status->dispatch_cnt) * 100 : 0;
+
+    event_log_info (hashcat_ctx,
+      "Dispatch.........: %" PRIu64 " chunks, %" PRIu64 " retries (%.02f%%), %" PRIu64 " locked",
+      hashcat_status->dispatch_cnt,
+      hashcat_status->dispatch_retry_cnt,
+      dispatch_retry_percent,
+      hashcat_status->dispatch_locked_cnt);
+  }
+
+  for (int device_id = 0; device_id < hashcat_status->device_info_cnt; device_id++)
+  {
+    const device_info_t *device_info = hashcat_status->device_info_buf + device_id;
+
+    if (device_info->skipped_dev == true) continue;
+
+    if (device_info->skipped_warning_dev == true) continue;
+
+    if (device_info->hook_msec_dev < 0) continue;
+
+    const double hook_percent = (hashcat_status->msec_running > 0) ? (device_info->hook_msec_dev / hashcat_status->msec_running) * 100 : 0;
+
+    event_log_info (hashcat_ctx,
+      "Hook.#%d..........: %.02fs (%.02f%% of runtime, %u threads)", device_id + 1,
+      device_info->hook_msec_dev / 1000,
+      hook_percent,
+      user_options->hook_threads);
   }
 
   if (hashcat_status->salts_cnt > 1)
@@ -1784,6 +1832,33 @@ void status_benchmark (hashcat_ctx_t *hashcat_ctx)
   hcfree (hashcat_status);
 }
 
+void status_kernel_cache_warm (hashcat_ctx_t *hashcat_ctx)
+{
+  const backend_ctx_t  *backend_ctx  = hashcat_ctx->backend_ctx;
+  const hashconfig_t   *hashconfig   = hashcat_ctx->hashconfig;
+  const user_options_t *user_options = hashcat_ctx->user_options;
+
+  const char *kernel_variant = (user_options->optimized_kernel_enable == true) ? "optimized" : "pure";
+
+  for (int backend_devices_idx = 0; backend_devices_idx < backend_ctx->backend_devices_cnt; backend_devices_idx++)
+  {
+    const hc_device_param_t *device_param = backend_ctx->devices_param + backend_devices_idx;
+
+    if (device_param->skipped == true) continue;
+
+    if (device_param->skipped_warning == true) continue;
+
+    if (user_options->machine_readable == true)
+    {
+      event_log_info (hashcat_ctx, "%u:%u:%u:%s:%.2f:%u:%u", device_param->device_id + 1, hashconfig->hash_mode, user_options->attack_mode, kernel_variant, device_param->kernels_msec, device_param->kernels_built, device_param->kernels_cached);
+    }
+    else
+    {
+      event_log_info (hashcat_ctx, "* Device #%u: -m %u -a %u (%s): %u kernels in %.2f ms, %u from cache", device_param->device_id + 1, hashconfig->hash_mode, user_options->attack_mode, kernel_variant, device_param->kernels_built, device_param->kernels_msec, device_param->kernels_cached);
+    }
+  }
+}
+
 void status_speed_machine_readable (hashcat_ctx_t *hashcat_ctx)
 {
   hashcat_status_t *hashcat_status = (hashcat_status_t *) hcmalloc (sizeof (hashcat_status_t));
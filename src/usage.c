@@ -57,8 +57,10 @@ static const char *const USAGE_BIG_PRE_HASHMODES[] =
   "     --outfile-autohex-disable  |      | Disable the use of $HEX[] in output plains           |",
   "     --outfile-check-timer      | Num  | Sets seconds between outfile checks to X             | --outfile-check=30",
   "     --wordlist-autohex-disable |      | Disable the conversion of $HEX[] from the wordlist   |",
+  "     --wordlist-compile         |      | Compile the wordlist into a .hcwl file and quit      |",
   " -p, --separator                | Char | Separator char for hashlists and outfile             | -p :",
   "     --stdout                   |      | Do not crack a hash, instead print candidates only   |",
+  "     --stdout-host              |      | Generate --stdout candidates on the host, no devices |",
   "     --show                     |      | Compare hashlist with potfile; show cracked hashes   |",
   "     --left                     |      | Compare hashlist with potfile; show uncracked hashes |",
   "     --username                 |      | Enable ignoring of usernames in hashfile             |",
@@ -82,9 +84,11 @@ static const char *const USAGE_BIG_PRE_HASHMODES[] =
   "     --veracrypt-pim-stop       | Num  | VeraCrypt personal iterations multiplier stop        | --veracrypt-pim-stop=500",
   " -b, --benchmark                |      | Run benchmark of selected hash-modes                 |",
   "     --benchmark-all            |      | Run benchmark of all hash-modes (requires -b)        |",
+  "     --kernel-cache-warm        |      | Build and cache kernels of all hash-modes, then quit |",
   "     --speed-only               |      | Return expected speed of the attack, then quit       |",
   "     --progress-only            |      | Return ideal progress step size and time to process  |",
   " -c, --segment-size             | Num  | Sets size in MB to cache from the wordfile to X      | -c 32",
+  "     --wordlist-read-ahead      | Num  | Segments read ahead from the wordfile, 0 to disable  | --wordlist-read-ahead=4",
   "     --bitmap-min               | Num  | Sets minimum bits allowed for bitmaps to X           | --bitmap-min=24",
   "     --bitmap-max               | Num  | Sets maximum bits allowed for bitmaps to X           | --bitmap-max=24",
   "     --cpu-affinity             | Str  | Locks to CPU devices, separated with commas          | --cpu-affinity=1,2,3",
@@ -102,6 +106,7 @@ static const char *const USAGE_BIG_PRE_HASHMODES[] =
   " -T, --kernel-threads           | Num  | Manual workload tuning, set thread count to X        | -T 64",
   "     --backend-vector-width     | Num  | Manually override backend vector-width to X          | --backend-vector=4",
   "     --spin-damp                | Num  | Use CPU for device synchronization, in percent       | --spin-damp=10",
+  "     --dispatch-balance         |      | Size the last chunks by measured device speed        |",
   "     --hwmon-disable            |      | Disable temperature and fanspeed reads and triggers  |",
   "     --hwmon-temp-abort         | Num  | Abort if temperature reaches X degrees Celsius       | --hwmon-temp-abort=100",
   "     --scrypt-tmto              | Num  | Manually override TMTO value for scrypt to X         | --scrypt-tmto=3",
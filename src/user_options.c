@@ -45,6 +45,7 @@ static const struct option long_options[] =
   {"custom-charset4",           required_argument, NULL, IDX_CUSTOM_CHARSET_4},
   {"debug-file",                required_argument, NULL, IDX_DEBUG_FILE},
   {"debug-mode",                required_argument, NULL, IDX_DEBUG_MODE},
+  {"dispatch-balance",          no_argument,       NULL, IDX_DISPATCH_BALANCE},
   {"encoding-from",             required_argument, NULL, IDX_ENCODING_FROM},
   {"encoding-to",               required_argument, NULL, IDX_ENCODING_TO},
   {"example-hashes",            no_argument,       NULL, IDX_EXAMPLE_HASHES},
@@ -68,6 +69,7 @@ static const struct option long_options[] =
   {"induction-dir",             required_argument, NULL, IDX_INDUCTION_DIR},
   {"keep-guessing",             no_argument,       NULL, IDX_KEEP_GUESSING},
   {"kernel-accel",              required_argument, NULL, IDX_KERNEL_ACCEL},
+  {"kernel-cache-warm",         no_argument,       NULL, IDX_KERNEL_CACHE_WARM},
   {"kernel-loops",              required_argument, NULL, IDX_KERNEL_LOOPS},
   {"kernel-threads",            required_argument, NULL, IDX_KERNEL_THREADS},
   {"keyboard-layout-mapping",   required_argument, NULL, IDX_KEYBOARD_LAYOUT_MAPPING},
@@ -104,6 +106,7 @@ static const struct option long_options[] =
   {"runtime",                   required_argument, NULL, IDX_RUNTIME},
   {"scrypt-tmto",               required_argument, NULL, IDX_SCRYPT_TMTO},
   {"segment-size",              required_argument, NULL, IDX_SEGMENT_SIZE},
+  {"wordlist-read-ahead",       required_argument, NULL, IDX_WORDLIST_READ_AHEAD},
   {"self-test-disable",         no_argument,       NULL, IDX_SELF_TEST_DISABLE},
   {"separator",                 required_argument, NULL, IDX_SEPARATOR},
   {"seperator",                 required_argument, NULL, IDX_SEPARATOR},
@@ -117,6 +120,7 @@ static const struct option long_options[] =
   {"status-json",               no_argument,       NULL, IDX_STATUS_JSON},
   {"status-timer",              required_argument, NULL, IDX_STATUS_TIMER},
   {"stdout",                    no_argument,       NULL, IDX_STDOUT_FLAG},
+  {"stdout-host",               no_argument,       NULL, IDX_STDOUT_HOST},
   {"stdin-timeout-abort",       required_argument, NULL, IDX_STDIN_TIMEOUT_ABORT},
   {"truecrypt-keyfiles",        required_argument, NULL, IDX_TRUECRYPT_KEYFILES},
   {"username",                  no_argument,       NULL, IDX_USERNAME},
@@ -125,6 +129,7 @@ static const struct option long_options[] =
   {"veracrypt-pim-stop",        required_argument, NULL, IDX_VERACRYPT_PIM_STOP},
   {"version",                   no_argument,       NULL, IDX_VERSION},
   {"wordlist-autohex-disable",  no_argument,       NULL, IDX_WORDLIST_AUTOHEX_DISABLE},
+  {"wordlist-compile",          no_argument,       NULL, IDX_WORDLIST_COMPILE},
   {"workload-profile",          required_argument, NULL, IDX_WORKLOAD_PROFILE},
   #ifdef WITH_BRAIN
   {"brain-client",              no_argument,       NULL, IDX_BRAIN_CLIENT},
@@ -182,6 +187,7 @@ int user_options_init (hashcat_ctx_t *hashcat_ctx)
   user_options->custom_charset_4          = NULL;
   user_options->debug_file                = NULL;
   user_options->debug_mode                = DEBUG_MODE;
+  user_options->dispatch_balance          = DISPATCH_BALANCE;
   user_options->encoding_from             = ENCODING_FROM;
   user_options->encoding_to               = ENCODING_TO;
   user_options->example_hashes            = EXAMPLE_HASHES;
@@ -200,6 +206,7 @@ int user_options_init (hashcat_ctx_t *hashcat_ctx)
   user_options->induction_dir             = NULL;
   user_options->keep_guessing             = KEEP_GUESSING;
   user_options->kernel_accel              = KERNEL_ACCEL;
+  user_options->kernel_cache_warm         = KERNEL_CACHE_WARM;
   user_options->kernel_loops              = KERNEL_LOOPS;
   user_options->kernel_threads            = KERNEL_THREADS;
   user_options->keyboard_layout_mapping   = NULL;
@@ -240,6 +247,7 @@ int user_options_init (hashcat_ctx_t *hashcat_ctx)
   user_options->runtime                   = RUNTIME;
   user_options->scrypt_tmto               = SCRYPT_TMTO;
   user_options->segment_size              = SEGMENT_SIZE;
+  user_options->wordlist_read_ahead       = WORDLIST_READ_AHEAD;
   user_options->self_test_disable         = SELF_TEST_DISABLE;
   user_options->separator                 = SEPARATOR;
   user_options->session                   = PROGNAME;
@@ -253,6 +261,7 @@ int user_options_init (hashcat_ctx_t *hashcat_ctx)
   user_options->status_timer              = STATUS_TIMER;
   user_options->stdin_timeout_abort       = STDIN_TIMEOUT_ABORT;
   user_options->stdout_flag               = STDOUT_FLAG;
+  user_options->stdout_host               = STDOUT_HOST;
   user_options->truecrypt_keyfiles        = NULL;
   user_options->usage                     = USAGE;
   user_options->username                  = USERNAME;
@@ -261,6 +270,7 @@ int user_options_init (hashcat_ctx_t *hashcat_ctx)
   user_options->veracrypt_pim_stop        = VERACRYPT_PIM_STOP;
   user_options->version                   = VERSION;
   user_options->wordlist_autohex_disable  = WORDLIST_AUTOHEX_DISABLE;
+  user_options->wordlist_compile          = WORDLIST_COMPILE;
   user_options->workload_profile          = WORKLOAD_PROFILE;
   user_options->rp_files_cnt              = 0;
   user_options->rp_files                  = (char **) hccalloc (256, sizeof (char *));
@@ -324,6 +334,7 @@ int user_options_getopt (hashcat_ctx_t *hashcat_ctx, int argc, char **argv)
       case IDX_VERACRYPT_PIM_START:
       case IDX_VERACRYPT_PIM_STOP:
       case IDX_SEGMENT_SIZE:
+      case IDX_WORDLIST_READ_AHEAD:
       case IDX_SCRYPT_TMTO:
       case IDX_BITMAP_MIN:
       case IDX_BITMAP_MAX:
@@ -375,6 +386,7 @@ int user_options_getopt (hashcat_ctx_t *hashcat_ctx, int argc, char **argv)
       case IDX_POTFILE_DISABLE:           user_options->potfile_disable           = true;                            break;
       case IDX_POTFILE_PATH:              user_options->potfile_path              = optarg;                          break;
       case IDX_DEBUG_MODE:                user_options->debug_mode                = hc_strtoul (optarg, NULL, 10);   break;
+      case IDX_DISPATCH_BALANCE:          user_options->dispatch_balance          = true;                            break;
       case IDX_DEBUG_FILE:                user_options->debug_file                = optarg;                          break;
       case IDX_ENCODING_FROM:             user_options->encoding_from             = optarg;                          break;
       case IDX_ENCODING_TO:               user_options->encoding_to               = optarg;                          break;
@@ -388,10 +400,12 @@ int user_options_getopt (hashcat_ctx_t *hashcat_ctx, int argc, char **argv)
       case IDX_LIMIT:                     user_options->limit                     = hc_strtoull (optarg, NULL, 10);
                                           user_options->limit_chgd                = true;                            break;
       case IDX_KEEP_GUESSING:             user_options->keep_guessing             = true;                            break;
+      case IDX_KERNEL_CACHE_WARM:         user_options->kernel_cache_warm         = true;                            break;
       case IDX_KEYSPACE:                  user_options->keyspace                  = true;                            break;
       case IDX_BENCHMARK:                 user_options->benchmark                 = true;                            break;
       case IDX_BENCHMARK_ALL:             user_options->benchmark_all             = true;                            break;
       case IDX_STDOUT_FLAG:               user_options->stdout_flag               = true;                            break;
+      case IDX_STDOUT_HOST:               user_options->stdout_host               = true;                            break;
       case IDX_STDIN_TIMEOUT_ABORT:       user_options->stdin_timeout_abort       = hc_strtoul (optarg, NULL, 10);
                                           user_options->stdin_timeout_abort_chgd  = true;                            break;
       case IDX_SPEED_ONLY:                user_options->speed_only                = true;                            break;
@@ -428,6 +442,7 @@ int user_options_getopt (hashcat_ctx_t *hashcat_ctx, int argc, char **argv)
       case IDX_OUTFILE_AUTOHEX_DISABLE:   user_options->outfile_autohex           = false;                           break;
       case IDX_OUTFILE_CHECK_TIMER:       user_options->outfile_check_timer       = hc_strtoul (optarg, NULL, 10);   break;
       case IDX_WORDLIST_AUTOHEX_DISABLE:  user_options->wordlist_autohex_disable  = true;                            break;
+      case IDX_WORDLIST_COMPILE:          user_options->wordlist_compile          = true;                            break;
       case IDX_HEX_CHARSET:               user_options->hex_charset               = true;                            break;
       case IDX_HEX_SALT:                  user_options->hex_salt                  = true;                            break;
       case IDX_HEX_WORDLIST:              user_options->hex_wordlist              = true;                            break;
@@ -466,6 +481,7 @@ int user_options_getopt (hashcat_ctx_t *hashcat_ctx, int argc, char **argv)
                                           user_options->veracrypt_pim_stop_chgd   = true;                            break;
       case IDX_SEGMENT_SIZE:              user_options->segment_size              = hc_strtoul (optarg, NULL, 10);
                                           user_options->segment_size_chgd         = true;                            break;
+      case IDX_WORDLIST_READ_AHEAD:       user_options->wordlist_read_ahead       = hc_strtoul (optarg, NULL, 10);   break;
       case IDX_SCRYPT_TMTO:               user_options->scrypt_tmto               = hc_strtoul (optarg, NULL, 10);   break;
       case IDX_SEPARATOR:                 user_options->separator                 = optarg[0];                       break;
       case IDX_BITMAP_MIN:                user_options->bitmap_min                = hc_strtoul (optarg, NULL, 10);   break;
@@ -960,6 +976,37 @@ int user_options_sanity (hashcat_ctx_t *hashcat_ctx)
     }
   }
 
+  if (user_options->wordlist_compile == true)
+  {
+    if (user_options->attack_mode != ATTACK_MODE_STRAIGHT)
+    {
+      event_log_error (hashcat_ctx, "Use of --wordlist-compile is only supported in attack mode 0 (straight).");
+
+      return -1;
+    }
+
+    if (user_options->keyspace == true)
+    {
+      event_log_error (hashcat_ctx, "Combining --wordlist-compile with --keyspace is not allowed.");
+
+      return -1;
+    }
+
+    if (user_options->stdout_flag == true)
+    {
+      event_log_error (hashcat_ctx, "Combining --wordlist-compile with --stdout is not allowed.");
+
+      return -1;
+    }
+
+    if (user_options->slow_candidates == true)
+    {
+      event_log_error (hashcat_ctx, "Combining --wordlist-compile with --slow-candidates is not allowed.");
+
+      return -1;
+    }
+  }
+
   if (user_options->machine_readable == true)
   {
     if (user_options->status_json == true)
@@ -1057,6 +1104,32 @@ int user_options_sanity (hashcat_ctx_t *hashcat_ctx)
     return -1;
   }
 
+  if (user_options->wordlist_read_ahead > 64)
+  {
+    event_log_error (hashcat_ctx, "Values of --wordlist-read-ahead must be between 0 and 64 (inclusive).");
+
+    return -1;
+  }
+
+  if (user_options->stdout_host == true)
+  {
+    if (user_options->stdout_flag == false)
+    {
+      event_log_error (hashcat_ctx, "Use of --stdout-host requires --stdout.");
+
+      return -1;
+    }
+
+    if ((user_options->attack_mode != ATTACK_MODE_STRAIGHT)
+     && (user_options->attack_mode != ATTACK_MODE_COMBI)
+     && (user_options->attack_mode != ATTACK_MODE_BF))
+    {
+      event_log_error (hashcat_ctx, "Use of --stdout-host is only supported in attack modes 0, 1 and 3.");
+
+      return -1;
+    }
+  }
+
   if (user_options->benchmark == true)
   {
     // sanity checks based on automatically overwritten configuration variables by
@@ -1176,6 +1249,32 @@ int user_options_sanity (hashcat_ctx_t *hashcat_ctx)
     }
   }
 
+  if (user_options->kernel_cache_warm == true)
+  {
+    // all attack-modes are built, one after the other
+
+    if (user_options->attack_mode_chgd == true)
+    {
+      event_log_error (hashcat_ctx, "Can't change --attack-mode (-a) in kernel-cache-warm mode.");
+
+      return -1;
+    }
+
+    if (user_options->benchmark == true)
+    {
+      event_log_error (hashcat_ctx, "Combining --kernel-cache-warm with --benchmark is not allowed.");
+
+      return -1;
+    }
+
+    if (user_options->slow_candidates == true)
+    {
+      event_log_error (hashcat_ctx, "Combining --kernel-cache-warm with --slow-candidates is not allowed.");
+
+      return -1;
+    }
+  }
+
   if (user_options->markov_hcstat2 != NULL)
   {
     if (strlen (user_options->markov_hcstat2) == 0)
@@ -1362,6 +1461,13 @@ int user_options_sanity (hashcat_ctx_t *hashcat_ctx)
       show_error = false;
     }
   }
+  else if (user_options->kernel_cache_warm == true)
+  {
+    if (user_options->hc_argc == 0)
+    {
+      show_error = false;
+    }
+  }
   else if (user_options->example_hashes == true)
   {
     if (user_options->hc_argc == 0)
@@ -1383,6 +1489,13 @@ int user_options_sanity (hashcat_ctx_t *hashcat_ctx)
       show_error = false;
     }
   }
+  else if (user_options->wordlist_compile == true)
+  {
+    if (user_options->hc_argc == 1)
+    {
+      show_error = false;
+    }
+  }
   else if (user_options->keyspace == true)
   {
     if (user_options->attack_mode == ATTACK_MODE_STRAIGHT)
@@ -1428,6 +1541,13 @@ int user_options_sanity (hashcat_ctx_t *hashcat_ctx)
       // all argc possible because of stdin mode
 
       show_error = false;
+
+      if ((user_options->hc_argc == 0) && (user_options->stdout_host == true))
+      {
+        event_log_error (hashcat_ctx, "Use of --stdout-host is not possible in stdin mode.");
+
+        return -1;
+      }
     }
     else if (user_options->attack_mode == ATTACK_MODE_COMBI)
     {
@@ -1539,6 +1659,11 @@ void user_options_session_auto (hashcat_ctx_t *hashcat_ctx)
       user_options->session = "benchmark";
     }
 
+    if (user_options->kernel_cache_warm == true)
+    {
+      user_options->session = "kernel_cache_warm";
+    }
+
     if (user_options->example_hashes == true)
     {
       user_options->session = "example_hashes";
@@ -1564,6 +1689,11 @@ void user_options_session_auto (hashcat_ctx_t *hashcat_ctx)
       user_options->session = "keyspace";
     }
 
+    if (user_options->wordlist_compile == true)
+    {
+      user_options->session = "wordlist_compile";
+    }
+
     if (user_options->stdout_flag == true)
     {
       user_options->session = "stdout";
@@ -1599,6 +1729,25 @@ void user_options_preprocess (hashcat_ctx_t *hashcat_ctx)
   }
   #endif
 
+  if (user_options->kernel_cache_warm == true)
+  {
+    // runs through the benchmark setup, but stops as soon as the kernels are built
+
+    user_options->benchmark = true;
+
+    if (user_options->hash_mode_chgd == false)
+    {
+      user_options->benchmark_all = true;
+    }
+  }
+
+  // compiling a wordlist takes the same path as --keyspace: no hashes, no backend, only the wordlist is counted
+
+  if (user_options->wordlist_compile == true)
+  {
+    user_options->keyspace = true;
+  }
+
   if (user_options->stdout_flag)
   {
     user_options->hwmon_disable       = true;
@@ -1707,6 +1856,13 @@ void user_options_preprocess (hashcat_ctx_t *hashcat_ctx)
     user_options->outfile_format        = OUTFILE_FMT_PLAIN;
     user_options->quiet                 = true;
 
+    // the host-only mode walks the keyspace with the slow-candidates generators, no device is involved
+
+    if (user_options->stdout_host == true)
+    {
+      user_options->slow_candidates = true;
+    }
+
     if (user_options->attack_mode == ATTACK_MODE_STRAIGHT)
     {
       user_options->kernel_loops = KERNEL_RULES;
@@ -1852,6 +2008,8 @@ void user_options_info (hashcat_ctx_t *hashcat_ctx)
 
   if (user_options->benchmark == false) return;
 
+  if (user_options->kernel_cache_warm == true) return;
+
   if (user_options->machine_readable == false)
   {
     event_log_info (hashcat_ctx, "Benchmark relevant options:");
@@ -2864,6 +3022,7 @@ void user_options_logger (hashcat_ctx_t *hashcat_ctx)
   logfile_top_uint   (user_options->bitmap_max);
   logfile_top_uint   (user_options->bitmap_min);
   logfile_top_uint   (user_options->debug_mode);
+  logfile_top_uint   (user_options->dispatch_balance);
   logfile_top_uint   (user_options->example_hashes);
   logfile_top_uint   (user_options->force);
   logfile_top_uint   (user_options->hwmon_disable);
@@ -2878,6 +3037,7 @@ void user_options_logger (hashcat_ctx_t *hashcat_ctx)
   logfile_top_uint   (user_options->increment_min);
   logfile_top_uint   (user_options->keep_guessing);
   logfile_top_uint   (user_options->kernel_accel);
+  logfile_top_uint   (user_options->kernel_cache_warm);
   logfile_top_uint   (user_options->kernel_loops);
   logfile_top_uint   (user_options->kernel_threads);
   logfile_top_uint   (user_options->keyspace);
@@ -2895,6 +3055,7 @@ void user_options_logger (hashcat_ctx_t *hashcat_ctx)
   logfile_top_uint   (user_options->outfile_check_timer);
   logfile_top_uint   (user_options->outfile_format);
   logfile_top_uint   (user_options->wordlist_autohex_disable);
+  logfile_top_uint   (user_options->wordlist_compile);
   logfile_top_uint   (user_options->potfile_disable);
   logfile_top_uint   (user_options->progress_only);
   logfile_top_uint   (user_options->quiet);
@@ -2911,6 +3072,7 @@ void user_options_logger (hashcat_ctx_t *hashcat_ctx)
   logfile_top_uint   (user_options->runtime);
   logfile_top_uint   (user_options->scrypt_tmto);
   logfile_top_uint   (user_options->segment_size);
+  logfile_top_uint   (user_options->wordlist_read_ahead);
   logfile_top_uint   (user_options->self_test_disable);
   logfile_top_uint   (user_options->slow_candidates);
   logfile_top_uint   (user_options->show);
@@ -2920,6 +3082,7 @@ void user_options_logger (hashcat_ctx_t *hashcat_ctx)
   logfile_top_uint   (user_options->status_json);
   logfile_top_uint   (user_options->status_timer);
   logfile_top_uint   (user_options->stdout_flag);
+  logfile_top_uint   (user_options->stdout_host);
   logfile_top_uint   (user_options->usage);
   logfile_top_uint   (user_options->username);
   logfile_top_uint   (user_options->veracrypt_pim_start);
@@ -12,9 +12,17 @@
 #include "rp.h"
 #include "rp_cpu.h"
 #include "shared.h"
+#include "filehandling.h"
+#include "thread.h"
+#include "timer.h"
+#include "hcwl.h"
 #include "wordlist.h"
 #include "emu_inc_hash_sha1.h"
 
+#if defined (_POSIX)
+#include <sys/mman.h>
+#endif
+
 size_t convert_from_hex (hashcat_ctx_t *hashcat_ctx, char *line_buf, const size_t line_len)
 {
   const hashconfig_t   *hashconfig   = hashcat_ctx->hashconfig;
@@ -49,62 +57,354 @@ size_t convert_from_hex (hashcat_ctx_t *hashcat_ctx, char *line_buf, const size_
   return (line_len);
 }
 
-int load_segment (hashcat_ctx_t *hashcat_ctx, HCFILE *fp)
+u32 wl_data_parser (hashcat_ctx_t *hashcat_ctx)
 {
-  wl_data_t *wl_data = hashcat_ctx->wl_data;
+  const hashconfig_t   *hashconfig   = hashcat_ctx->hashconfig;
+  const user_options_t *user_options = hashcat_ctx->user_options;
 
-  // NOTE: use (never changing) ->incr here instead of ->avail otherwise the buffer gets bigger and bigger
+  // everything which changes how a dictionary is split into words or which words are rejected
 
-  wl_data->pos = 0;
+  u32 parser = 0;
+
+  if (hashconfig->opts_type & OPTS_TYPE_PT_UPPER)     parser |= 1u << 0;
+  if (hashconfig->opts_type & OPTS_TYPE_PT_LM)        parser |= 1u << 1;
+  if (hashconfig->opts_type & OPTS_TYPE_PT_HEX)       parser |= 1u << 2;
+  if (user_options->wordlist_autohex_disable == true) parser |= 1u << 3;
+
+  return parser;
+}
+
+static u64 load_segment_map (HCFILE *fp, const u64 incr, char **seg_out, char **buf, u64 *avail)
+{
+  *seg_out = *buf;
+
+  if (fp->mm_pos >= fp->mm_len) return 0;
+
+  char *seg = fp->mm_buf + fp->mm_pos;
+
+  const u64 left = fp->mm_len - fp->mm_pos;
+
+  // same segment size as the buffered path, extended to the end of the line it stops in
+
+  u64 cnt = MIN (left, incr - 1000);
+
+  if (cnt < left)
+  {
+    const char *next = (const char *) memchr (seg + cnt, '\n', left - cnt);
+
+    cnt = (next == NULL) ? left : (u64) (next - seg) + 1;
+  }
+
+  fp->mm_pos += cnt;
+
+  if (seg[cnt - 1] == '\n')
+  {
+    *seg_out = seg;
+
+    return cnt;
+  }
+
+  // the last line has no newline and we can not append one to the mapping, so copy this segment only
+
+  if ((cnt + 1) >= *avail)
+  {
+    const u64 add = ((cnt + 1 - *avail) / incr + 1) * incr;
+
+    *buf = (char *) hcrealloc (*buf, *avail, add);
+
+    *avail += add;
+  }
+
+  memcpy (*buf, seg, cnt);
 
-  wl_data->cnt = hc_fread (wl_data->buf, 1, wl_data->incr - 1000, fp);
+  (*buf)[cnt] = '\n';
 
-  wl_data->buf[wl_data->cnt] = 0;
+  *seg_out = *buf;
 
-  if (wl_data->cnt == 0) return 0;
+  return cnt + 1;
+}
+
+static u64 load_segment_stream (HCFILE *fp, const u64 incr, char **buf, u64 *avail)
+{
+  // NOTE: use (never changing) incr here instead of avail otherwise the buffer gets bigger and bigger
+
+  u64 cnt = hc_fread (*buf, 1, incr - 1000, fp);
 
-  if (wl_data->buf[wl_data->cnt - 1] == '\n') return 0;
+  (*buf)[cnt] = 0;
+
+  if (cnt == 0) return 0;
+
+  if ((*buf)[cnt - 1] == '\n') return cnt;
 
   while (!hc_feof (fp))
   {
-    if (wl_data->cnt == wl_data->avail)
+    if (cnt == *avail)
     {
-      wl_data->buf = (char *) hcrealloc (wl_data->buf, wl_data->avail, wl_data->incr);
+      *buf = (char *) hcrealloc (*buf, *avail, incr);
 
-      wl_data->avail += wl_data->incr;
+      *avail += incr;
     }
 
     const int c = hc_fgetc (fp);
 
     if (c == EOF) break;
 
-    wl_data->buf[wl_data->cnt] = (char) c;
+    (*buf)[cnt] = (char) c;
 
-    wl_data->cnt++;
+    cnt++;
 
     if (c == '\n') break;
   }
 
   // ensure stream ends with a newline
 
-  if (wl_data->buf[wl_data->cnt - 1] != '\n')
+  if ((*buf)[cnt - 1] != '\n')
+  {
+    if (cnt == *avail)
+    {
+      *buf = (char *) hcrealloc (*buf, *avail, incr);
+
+      *avail += incr;
+    }
+
+    cnt++;
+
+    (*buf)[cnt - 1] = '\n';
+  }
+
+  return cnt;
+}
+
+static void load_segment_readahead_wait (wl_readahead_t *ra)
+{
+  if (hc_atomic_load (&ra->filled) > ra->taken) return;
+
+  hc_timer_t timer;
+
+  hc_timer_set (&timer);
+
+  while (hc_atomic_load (&ra->filled) <= ra->taken)
+  {
+    if (hc_atomic_load (&ra->finished) == true) break;
+
+    usleep (WL_READAHEAD_WAIT_USEC);
+  }
+
+  ra->wait_usec += (u64) (hc_timer_get (timer) * 1000);
+}
+
+static int load_segment_readahead (hashcat_ctx_t *hashcat_ctx)
+{
+  wl_data_t      *wl_data = hashcat_ctx->wl_data;
+  wl_readahead_t *ra      = &wl_data->ra;
+
+  // the parser is done with the previous segment, the I/O thread may refill its slot
+
+  hc_atomic_store (&ra->released, ra->taken);
+
+  wl_data->pos = 0;
+  wl_data->cnt = 0;
+
+  load_segment_readahead_wait (ra);
+
+  if (hc_atomic_load (&ra->filled) <= ra->taken) return 0;
+
+  const wl_readahead_slot_t *slot = ra->slots + (ra->taken % ra->slots_cnt);
+
+  wl_data->seg = slot->seg;
+  wl_data->cnt = slot->cnt;
+
+  ra->taken++;
+
+  return 0;
+}
+
+int load_segment (hashcat_ctx_t *hashcat_ctx, HCFILE *fp)
+{
+  wl_data_t *wl_data = hashcat_ctx->wl_data;
+
+  if (wl_data->ra.enabled == true)
+  {
+    load_segment_readahead (hashcat_ctx);
+  }
+  else
+  {
+    wl_data->pos = 0;
+
+    // plain wordlists are mapped once and handed out in place, see load_segment_map ()
+
+    if (hc_fmmap (fp) == true)
+    {
+      wl_data->cnt = load_segment_map (fp, wl_data->incr, &wl_data->seg, &wl_data->buf, &wl_data->avail);
+
+      return 0;
+    }
+
+    wl_data->cnt = load_segment_stream (fp, wl_data->incr, &wl_data->buf, &wl_data->avail);
+
+    wl_data->seg = wl_data->buf;
+  }
+
+  // a corrupt or truncated compressed wordlist ends early, it must not pass as a complete one
+
+  if (hc_ferror (fp))
   {
-    wl_data->cnt++;
+    event_log_error (hashcat_ctx, "%s: Read error, corrupt or truncated file.", fp->path);
+
+    wl_data->pos = 0;
+    wl_data->cnt = 0;
 
-    wl_data->buf[wl_data->cnt - 1] = '\n';
+    return -1;
   }
 
   return 0;
 }
 
-void get_next_word_lm (char *buf, u64 sz, u64 *len, u64 *off)
+bool wl_data_feof (hashcat_ctx_t *hashcat_ctx, HCFILE *fp)
 {
-  char *ptr = buf;
+  wl_data_t      *wl_data = hashcat_ctx->wl_data;
+  wl_readahead_t *ra      = &wl_data->ra;
 
-  for (u64 i = 0; i < sz; i++, ptr++)
+  if (ra->enabled == false) return (hc_feof (fp) != 0);
+
+  // the file itself is read ahead, only the segments not yet handed to the parser count
+
+  load_segment_readahead_wait (ra);
+
+  return (hc_atomic_load (&ra->filled) <= ra->taken);
+}
+
+HC_API_CALL void *thread_wl_readahead (void *p)
+{
+  wl_data_t *wl_data = (wl_data_t *) p;
+
+  wl_readahead_t *ra = &wl_data->ra;
+
+  HCFILE *fp = ra->fp;
+
+  for (u64 seq = 0; ; seq++)
+  {
+    if (hc_feof (fp)) break;
+
+    // wait until the parser released the segment previously loaded into this slot
+
+    while ((seq - hc_atomic_load (&ra->released)) >= ra->slots_cnt)
+    {
+      if (hc_atomic_load (&ra->run) == false) break;
+
+      usleep (WL_READAHEAD_WAIT_USEC);
+    }
+
+    if (hc_atomic_load (&ra->run) == false) break;
+
+    wl_readahead_slot_t *slot = ra->slots + (seq % ra->slots_cnt);
+
+    if (slot->buf == NULL)
+    {
+      slot->buf   = (char *) hcmalloc (wl_data->incr);
+      slot->avail = wl_data->incr;
+    }
+
+    if (fp->is_mmap == true)
+    {
+      slot->cnt = load_segment_map (fp, wl_data->incr, &slot->seg, &slot->buf, &slot->avail);
+
+      #if defined (_POSIX)
+
+      // fault the pages in here, otherwise the parser would block on them instead of this thread
+
+      madvise ((void *) ((uintptr_t) slot->seg & ~((uintptr_t) 4095)), slot->cnt + ((uintptr_t) slot->seg & 4095), MADV_WILLNEED);
+
+      volatile char sink = 0;
+
+      for (u64 i = 0; i < slot->cnt; i += 4096) sink ^= slot->seg[i];
+
+      (void) sink;
+
+      #endif
+    }
+    else
+    {
+      slot->cnt = load_segment_stream (fp, wl_data->incr, &slot->buf, &slot->avail);
+
+      slot->seg = slot->buf;
+    }
+
+    if (slot->cnt == 0) break;
+
+    hc_atomic_store (&ra->filled, seq + 1);
+  }
+
+  hc_atomic_store (&ra->finished, true);
+
+  return NULL;
+}
+
+int wl_readahead_start (hashcat_ctx_t *hashcat_ctx, HCFILE *fp)
+{
+  const user_options_t *user_options = hashcat_ctx->user_options;
+  wl_data_t            *wl_data      = hashcat_ctx->wl_data;
+  wl_readahead_t       *ra           = &wl_data->ra;
+
+  memset (ra, 0, sizeof (wl_readahead_t));
+
+  if (user_options->wordlist_read_ahead == 0) return 0;
+
+  // from here on only the I/O thread touches the file, the parser finishes its current segment first
+
+  hc_fmmap (fp);
+
+  ra->fp        = fp;
+  ra->slots_cnt = user_options->wordlist_read_ahead + 1;
+  ra->slots     = (wl_readahead_slot_t *) hccalloc (ra->slots_cnt, sizeof (wl_readahead_slot_t));
+
+  ra->run      = true;
+  ra->finished = false;
+
+  ra->enabled = true;
+
+  hc_thread_create (ra->thread, thread_wl_readahead, wl_data);
+
+  return 0;
+}
+
+void wl_readahead_stop (hashcat_ctx_t *hashcat_ctx)
+{
+  wl_data_t      *wl_data = hashcat_ctx->wl_data;
+  wl_readahead_t *ra      = &wl_data->ra;
+
+  if (ra->enabled == false) return;
+
+  hc_atomic_store (&ra->run, false);
+
+  hc_thread_wait (1, &ra->thread);
+
+  for (u32 slot_idx = 0; slot_idx < ra->slots_cnt; slot_idx++)
   {
-    if (*ptr >= 'a' && *ptr <= 'z') *ptr -= 0x20;
+    hcfree (ra->slots[slot_idx].buf);
+  }
+
+  hcfree (ra->slots);
+
+  // the current segment may live in one of the slots, and the file position is somewhere ahead of the parser
+
+  wl_data->seg = wl_data->buf;
+  wl_data->pos = 0;
+  wl_data->cnt = 0;
+
+  const u64 wait_usec = ra->wait_usec;
+
+  memset (ra, 0, sizeof (wl_readahead_t));
+
+  ra->wait_usec = wait_usec;
+}
+
+void get_next_word_lm (const char *buf, u64 sz, u64 *len, u64 *off)
+{
+  const char *ptr = buf;
 
+  for (u64 i = 0; i < sz; i++, ptr++)
+  {
     if (i == 7)
     {
       *off = i;
@@ -128,48 +428,87 @@ void get_next_word_lm (char *buf, u64 sz, u64 *len, u64 *off)
   *len = sz;
 }
 
-void get_next_word_uc (char *buf, u64 sz, u64 *len, u64 *off)
+void get_next_word_uc (const char *buf, u64 sz, u64 *len, u64 *off)
 {
-  char *ptr = buf;
+  u64 i = hc_find_newline (buf, sz);
 
-  for (u64 i = 0; i < sz; i++, ptr++)
+  if (i == sz)
   {
-    if (*ptr >= 'a' && *ptr <= 'z') *ptr -= 0x20;
+    *off = sz;
+    *len = sz;
 
-    if (*ptr != '\n') continue;
+    return;
+  }
 
-    *off = i + 1;
+  *off = i + 1;
 
-    if ((i > 0) && (buf[i - 1] == '\r')) i--;
+  if ((i > 0) && (buf[i - 1] == '\r')) i--;
 
-    *len = i;
+  *len = i;
+}
+
+void get_next_word_std (const char *buf, u64 sz, u64 *len, u64 *off)
+{
+  u64 i = hc_find_newline (buf, sz);
+
+  if (i == sz)
+  {
+    *off = sz;
+    *len = sz;
 
     return;
   }
 
-  *off = sz;
-  *len = sz;
+  *off = i + 1;
+
+  if ((i > 0) && (buf[i - 1] == '\r')) i--;
+
+  *len = i;
 }
 
-void get_next_word_std (char *buf, u64 sz, u64 *len, u64 *off)
+static char *get_next_word_decode (hashcat_ctx_t *hashcat_ctx, char *ptr, u64 *len)
 {
-  char *ptr = buf;
+  const hashconfig_t   *hashconfig   = hashcat_ctx->hashconfig;
+  const user_options_t *user_options = hashcat_ctx->user_options;
+  wl_data_t            *wl_data      = hashcat_ctx->wl_data;
 
-  for (u64 i = 0; i < sz; i++, ptr++)
+  const bool upper = ((hashconfig->opts_type & (OPTS_TYPE_PT_UPPER | OPTS_TYPE_PT_LM)) != 0);
+
+  // most words are used as they are, straight from the segment
+
+  if (upper == false)
   {
-    if (*ptr != '\n') continue;
+    if (*len & 1) return ptr;
 
-    *off = i + 1;
+    if (((hashconfig->opts_type & OPTS_TYPE_PT_HEX) == 0) && ((user_options->wordlist_autohex_disable == true) || (is_hexify ((const u8 *) ptr, *len) == false))) return ptr;
+  }
 
-    if ((i > 0) && (buf[i - 1] == '\r')) i--;
+  // the segment can be a read-only mapping of the wordlist, decode a copy
 
-    *len = i;
+  if ((*len + 1) > wl_data->word_avail)
+  {
+    const u64 add = *len + 1 - wl_data->word_avail + HCBUFSIZ_TINY;
 
-    return;
+    wl_data->word_buf = (char *) hcrealloc (wl_data->word_buf, wl_data->word_avail, add);
+
+    wl_data->word_avail += add;
   }
 
-  *off = sz;
-  *len = sz;
+  char *word = wl_data->word_buf;
+
+  memcpy (word, ptr, *len);
+
+  if (upper == true)
+  {
+    for (u64 i = 0; i < *len; i++)
+    {
+      if (word[i] >= 'a' && word[i] <= 'z') word[i] -= 0x20;
+    }
+  }
+
+  *len = convert_from_hex (hashcat_ctx, word, *len);
+
+  return word;
 }
 
 void get_next_word (hashcat_ctx_t *hashcat_ctx, HCFILE *fp, char **out_buf, u32 *out_len)
@@ -183,16 +522,15 @@ void get_next_word (hashcat_ctx_t *hashcat_ctx, HCFILE *fp, char **out_buf, u32
     u64 off;
     u64 len;
 
-    char *ptr = wl_data->buf + wl_data->pos;
+    char *ptr = wl_data->seg + wl_data->pos;
 
     wl_data->func (ptr, wl_data->cnt - wl_data->pos, &len, &off);
 
     wl_data->pos += off;
 
-    // do the on-the-fly hex decode using original buffer
-    // this is safe as length only decreases in size
+    // do the on-the-fly uppercase and hex decode
 
-    len = (u32) convert_from_hex (hashcat_ctx, ptr, len);
+    ptr = get_next_word_decode (hashcat_ctx, ptr, &len);
 
     // do the on-the-fly encoding
     // needs to write into new buffer because size case both decrease and increase
@@ -235,18 +573,51 @@ void get_next_word (hashcat_ctx_t *hashcat_ctx, HCFILE *fp, char **out_buf, u32
     return;
   }
 
-  if (hc_feof (fp))
+  if (wl_data_feof (hashcat_ctx, fp))
   {
     fprintf (stderr, "BUG feof()!!\n");
 
     return;
   }
 
-  load_segment (hashcat_ctx, fp);
+  if (load_segment (hashcat_ctx, fp) == -1) return;
 
   get_next_word (hashcat_ctx, fp, out_buf, out_len);
 }
 
+void skip_words (hashcat_ctx_t *hashcat_ctx, HCFILE *fp, const char *dictfile, u64 *words_cur, const u64 words_off)
+{
+  wl_data_t *wl_data = hashcat_ctx->wl_data;
+
+  u64 index_words = 0;
+  u64 index_off   = 0;
+
+  // jump forward to the closest indexed word, if there is one between the current position and the target
+
+  if (dictstat_index_find (hashcat_ctx, dictfile, words_off, &index_words, &index_off) == true)
+  {
+    if (index_words > *words_cur)
+    {
+      if (fp->is_gzip == true) hc_gzidx_attach (fp, dictstat_index_find_gzidx (hashcat_ctx, dictfile));
+
+      if (hc_fseek (fp, (off_t) index_off, SEEK_SET) != -1)
+      {
+        // drop the current segment, the next get_next_word() reloads from the new position
+
+        wl_data->pos = 0;
+        wl_data->cnt = 0;
+
+        *words_cur = index_words;
+      }
+    }
+  }
+
+  char *line_buf;
+  u32   line_len;
+
+  for ( ; *words_cur < words_off; (*words_cur)++) get_next_word (hashcat_ctx, fp, &line_buf, &line_len);
+}
+
 void pw_pre_add (hc_device_param_t *device_param, const u8 *pw_buf, const int pw_len, const u8 *base_buf, const int base_len, const int rule_idx)
 {
   if (device_param->pws_pre_cnt < device_param->kernel_power)
@@ -327,39 +698,440 @@ void pw_add (hc_device_param_t *device_param, const u8 *pw_buf, const int pw_len
   }
 }
 
-int count_words (hashcat_ctx_t *hashcat_ctx, HCFILE *fp, const char *dictfile, u64 *result)
+static u64 count_words_multiplier (hashcat_ctx_t *hashcat_ctx)
+{
+  const combinator_ctx_t     *combinator_ctx     = hashcat_ctx->combinator_ctx;
+  const hashconfig_t         *hashconfig         = hashcat_ctx->hashconfig;
+  const straight_ctx_t       *straight_ctx       = hashcat_ctx->straight_ctx;
+  const mask_ctx_t           *mask_ctx           = hashcat_ctx->mask_ctx;
+  const user_options_extra_t *user_options_extra = hashcat_ctx->user_options_extra;
+  const user_options_t       *user_options       = hashcat_ctx->user_options;
+
+  if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
+  {
+    return straight_ctx->kernel_rules_cnt;
+  }
+
+  if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
+  {
+    if (((hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL) == 0) && (user_options->attack_mode == ATTACK_MODE_HYBRID2))
+    {
+      return mask_ctx->bfs_cnt;
+    }
+
+    return combinator_ctx->combs_cnt;
+  }
+
+  return 1;
+}
+
+static void count_words_segment (hashcat_ctx_t *hashcat_ctx, const u64 seg_off, const u64 interval, u64 *words, u64 *words2, u64 **index_buf, u64 *index_cnt, u64 *index_avail)
 {
-  combinator_ctx_t     *combinator_ctx     = hashcat_ctx->combinator_ctx;
-  hashconfig_t         *hashconfig         = hashcat_ctx->hashconfig;
-  straight_ctx_t       *straight_ctx       = hashcat_ctx->straight_ctx;
-  mask_ctx_t           *mask_ctx           = hashcat_ctx->mask_ctx;
   user_options_extra_t *user_options_extra = hashcat_ctx->user_options_extra;
   user_options_t       *user_options       = hashcat_ctx->user_options;
   wl_data_t            *wl_data            = hashcat_ctx->wl_data;
 
-  //hc_signal (NULL);
+  u64 i = 0;
 
-  dictstat_t d;
+  while (i < wl_data->cnt)
+  {
+    u64 len;
+    u64 off;
 
-  memset (&d, 0, sizeof (d));
+    char *ptr = wl_data->seg + i;
 
-  if (fstat (hc_fileno (fp), &d.stat))
-  {
-    *result = 0;
+    wl_data->func (ptr, wl_data->cnt - i, &len, &off);
 
-    return 0;
-  }
+    i += off;
 
-  d.stat.st_mode    = 0;
-  d.stat.st_nlink   = 0;
-  d.stat.st_uid     = 0;
-  d.stat.st_gid     = 0;
-  d.stat.st_rdev    = 0;
-  d.stat.st_atime   = 0;
+    // do the on-the-fly uppercase and hex decode
 
-  #if defined (STAT_NANOSECONDS_ACCESS_TIME)
-  d.stat.STAT_NANOSECONDS_ACCESS_TIME = 0;
-  #endif
+    ptr = get_next_word_decode (hashcat_ctx, ptr, &len);
+
+    // do the on-the-fly encoding
+
+    if (wl_data->iconv_enabled == true)
+    {
+      char  *iconv_ptr = wl_data->iconv_tmp;
+      size_t iconv_sz  = HCBUFSIZ_TINY;
+
+      size_t ptr_len = len;
+
+      const size_t iconv_rc = iconv (wl_data->iconv_ctx, &ptr, &ptr_len, &iconv_ptr, &iconv_sz);
+
+      if (iconv_rc == (size_t) -1) continue;
+
+      ptr = wl_data->iconv_tmp;
+      len = HCBUFSIZ_TINY - iconv_sz;
+    }
+
+    if (run_rule_engine (user_options_extra->rule_len_l, user_options->rule_buf_l))
+    {
+      if (len >= RP_PASSWORD_SIZE) continue;
+
+      char rule_buf_out[RP_PASSWORD_SIZE];
+
+      memset (rule_buf_out, 0, sizeof (rule_buf_out));
+
+      const int rule_len_out = _old_apply_rule (user_options->rule_buf_l, user_options_extra->rule_len_l, ptr, (u32) len, rule_buf_out);
+
+      if (rule_len_out < 0) continue;
+    }
+
+    (*words2)++;
+
+    if (len > PW_MAX) continue;
+
+    (*words)++;
+
+    // remember where the word following every interval'th word starts
+
+    if ((interval > 0) && ((*words % interval) == 0))
+    {
+      if (*index_cnt == *index_avail)
+      {
+        *index_buf = (u64 *) hcrealloc (*index_buf, *index_avail * sizeof (u64), INCR_DICTSTAT_INDEX * sizeof (u64));
+
+        *index_avail += INCR_DICTSTAT_INDEX;
+      }
+
+      (*index_buf)[*index_cnt] = seg_off + i;
+
+      (*index_cnt)++;
+    }
+  }
+}
+
+static void count_words_progress (hashcat_ctx_t *hashcat_ctx, const char *dictfile, const off_t size, const u64 comp, const u64 cnt, const u64 cnt2)
+{
+  double percent = ((double) comp / (double) size) * 100;
+
+  if (percent < 100)
+  {
+    cache_generate_t cache_generate;
+
+    cache_generate.dictfile    = dictfile;
+    cache_generate.comp        = comp;
+    cache_generate.percent     = percent;
+    cache_generate.cnt         = cnt;
+    cache_generate.cnt2        = cnt2;
+
+    EVENT_DATA (EVENT_WORDLIST_CACHE_GENERATE, &cache_generate, sizeof (cache_generate));
+  }
+}
+
+HC_API_CALL void *thread_count_words (void *p)
+{
+  count_words_chunk_t *chunk = (count_words_chunk_t *) p;
+
+  hashcat_ctx_t *hashcat_ctx = chunk->hashcat_ctx;
+
+  const u64 interval = (chunk->index_enabled == true) ? COUNT_WORDS_CHECKPOINT : 0;
+
+  u64 words  = 0;
+  u64 words2 = 0;
+
+  while (!hc_feof (&chunk->fp))
+  {
+    const u64 seg_off = chunk->fp.mm_pos;
+
+    load_segment (hashcat_ctx, &chunk->fp);
+
+    count_words_segment (hashcat_ctx, seg_off, interval, &words, &words2, &chunk->index_buf, &chunk->index_cnt, &chunk->index_avail);
+
+    hc_atomic_store (&chunk->comp,   chunk->fp.mm_pos - chunk->off_start);
+    hc_atomic_store (&chunk->words,  words);
+    hc_atomic_store (&chunk->words2, words2);
+  }
+
+  hc_atomic_store (&chunk->finished, true);
+
+  return NULL;
+}
+
+static int count_words_chunks (hashcat_ctx_t *hashcat_ctx, HCFILE *fp)
+{
+  const user_options_t *user_options = hashcat_ctx->user_options;
+
+  if (hc_fmmap (fp) == false) return 1;
+
+  const u64 chunks_max = (fp->mm_len - fp->mm_pos) / MAX (COUNT_WORDS_CHUNK_MIN, user_options->segment_size);
+
+  const int processors = hc_get_processor_count ();
+
+  if (processors < 2) return 1;
+
+  return (int) MAX (1, MIN (chunks_max, (u64) processors));
+}
+
+// the mapped wordlist is split into byte ranges at line boundaries which are counted on all cores
+// the offsets of the sparse word index are only known after the counts of all preceding ranges are,
+// so each range remembers a position every COUNT_WORDS_CHECKPOINT words and the index is built from
+// these by parsing the few words between the closest checkpoint and the indexed word once again
+
+static int count_words_mt (hashcat_ctx_t *hashcat_ctx, HCFILE *fp, const char *dictfile, const off_t size, const int chunks_cnt, const bool index_enabled, const u64 multiplier, u64 *words, u64 *words2, u64 **index_buf, u64 *index_cnt)
+{
+  wl_data_t *wl_data = hashcat_ctx->wl_data;
+
+  count_words_chunk_t *chunks = (count_words_chunk_t *) hccalloc (chunks_cnt, sizeof (count_words_chunk_t));
+
+  hc_thread_t *threads = (hc_thread_t *) hccalloc (chunks_cnt, sizeof (hc_thread_t));
+
+  int rc = 0;
+
+  int chunks_init = 0;
+
+  u64 off = fp->mm_pos;
+
+  for (int chunk_idx = 0; chunk_idx < chunks_cnt; chunk_idx++)
+  {
+    count_words_chunk_t *chunk = chunks + chunk_idx;
+
+    u64 end = fp->mm_len;
+
+    if (chunk_idx < (chunks_cnt - 1))
+    {
+      end = MAX (off, fp->mm_pos + ((fp->mm_len - fp->mm_pos) / chunks_cnt) * (chunk_idx + 1));
+
+      if (end < fp->mm_len) end += hc_find_newline (fp->mm_buf + end, fp->mm_len - end) + 1;
+
+      end = MIN (end, fp->mm_len);
+    }
+
+    hashcat_ctx_t *hashcat_ctx_tmp = (hashcat_ctx_t *) hcmalloc (sizeof (hashcat_ctx_t));
+
+    memcpy (hashcat_ctx_tmp, hashcat_ctx, sizeof (hashcat_ctx_t)); // yes we actually want to copy these pointers
+
+    hashcat_ctx_tmp->wl_data = (wl_data_t *) hcmalloc (sizeof (wl_data_t));
+
+    chunk->hashcat_ctx = hashcat_ctx_tmp;
+
+    if (wl_data_init (hashcat_ctx_tmp) == -1)
+    {
+      hcfree (hashcat_ctx_tmp->wl_data);
+      hcfree (hashcat_ctx_tmp);
+
+      rc = -1;
+
+      break;
+    }
+
+    chunks_init++;
+
+    // a private view of the shared mapping limited to this range, it is never closed
+
+    memcpy (&chunk->fp, fp, sizeof (HCFILE));
+
+    chunk->fp.mm_pos = off;
+    chunk->fp.mm_len = end;
+
+    chunk->fp.rd_buf = NULL;
+    chunk->fp.rd_len = 0;
+    chunk->fp.rd_pos = 0;
+
+    chunk->off_start = off;
+    chunk->off_end   = end;
+
+    chunk->index_enabled = index_enabled;
+
+    off = end;
+  }
+
+  if (rc == 0)
+  {
+    for (int chunk_idx = 0; chunk_idx < chunks_cnt; chunk_idx++)
+    {
+      hc_thread_create (threads[chunk_idx], thread_count_words, chunks + chunk_idx);
+    }
+
+    time_t now  = 0;
+    time_t prev = 0;
+
+    time (&prev);
+
+    while (true)
+    {
+      bool finished = true;
+
+      u64 comp = 0;
+      u64 cnt  = 0;
+      u64 cnt2 = 0;
+
+      for (int chunk_idx = 0; chunk_idx < chunks_cnt; chunk_idx++)
+      {
+        count_words_chunk_t *chunk = chunks + chunk_idx;
+
+        if (hc_atomic_load (&chunk->finished) == false) finished = false;
+
+        comp += hc_atomic_load (&chunk->comp);
+        cnt  += hc_atomic_load (&chunk->words) * multiplier;
+        cnt2 += hc_atomic_load (&chunk->words2);
+      }
+
+      if (finished == true) break;
+
+      usleep (COUNT_WORDS_WAIT_USEC);
+
+      time (&now);
+
+      if ((now - prev) == 0) continue;
+
+      time (&prev);
+
+      count_words_progress (hashcat_ctx, dictfile, size, comp, cnt, cnt2);
+    }
+
+    hc_thread_wait (chunks_cnt, threads);
+
+    for (int chunk_idx = 0; chunk_idx < chunks_cnt; chunk_idx++)
+    {
+      *words  += chunks[chunk_idx].words;
+      *words2 += chunks[chunk_idx].words2;
+    }
+  }
+
+  // build the sparse word index from the checkpoints of the ranges
+
+  if ((rc == 0) && (index_enabled == true))
+  {
+    HCFILE fp_rescan;
+
+    bool rescan_open = false;
+
+    u64 index_avail = 0;
+
+    u64 prefix = 0;
+
+    u64 target = DICTSTAT_INDEX_INTERVAL;
+
+    for (int chunk_idx = 0; chunk_idx < chunks_cnt; chunk_idx++)
+    {
+      count_words_chunk_t *chunk = chunks + chunk_idx;
+
+      for ( ; target <= (prefix + chunk->words); target += DICTSTAT_INDEX_INTERVAL)
+      {
+        const u64 local = target - prefix;
+
+        const u64 checkpoint = local / COUNT_WORDS_CHECKPOINT;
+
+        u64 index_off = (checkpoint == 0) ? chunk->off_start : chunk->index_buf[checkpoint - 1];
+
+        const u64 skip = local - (checkpoint * COUNT_WORDS_CHECKPOINT);
+
+        if (skip > 0)
+        {
+          // a fresh mapping, the one we counted on may already hold words decoded in place
+
+          if (rescan_open == false)
+          {
+            if (hc_fopen (&fp_rescan, dictfile, "rb") == false) break;
+
+            rescan_open = true;
+          }
+
+          if (hc_fseek (&fp_rescan, (off_t) index_off, SEEK_SET) == -1) break;
+
+          wl_data->pos = 0;
+          wl_data->cnt = 0;
+
+          char *line_buf;
+          u32   line_len;
+
+          for (u64 skip_pos = 0; skip_pos < skip; skip_pos++) get_next_word (hashcat_ctx, &fp_rescan, &line_buf, &line_len);
+
+          const u64 seg_end = (u64) hc_ftell (&fp_rescan);
+
+          index_off = seg_end - (wl_data->cnt - wl_data->pos);
+
+          // load_segment () appends the missing newline of the last line, count it the way the serial path does
+
+          if ((seg_end == fp->mm_len) && (fp->mm_buf[fp->mm_len - 1] != '\n')) index_off++;
+        }
+
+        if (*index_cnt == index_avail)
+        {
+          *index_buf = (u64 *) hcrealloc (*index_buf, index_avail * sizeof (u64), INCR_DICTSTAT_INDEX * sizeof (u64));
+
+          index_avail += INCR_DICTSTAT_INDEX;
+        }
+
+        (*index_buf)[*index_cnt] = index_off;
+
+        (*index_cnt)++;
+      }
+
+      // an incomplete index is not written at all
+
+      if (target <= (prefix + chunk->words))
+      {
+        hcfree (*index_buf);
+
+        *index_buf = NULL;
+        *index_cnt = 0;
+
+        break;
+      }
+
+      prefix += chunk->words;
+    }
+
+    if (rescan_open == true) hc_fclose (&fp_rescan);
+
+    wl_data->pos = 0;
+    wl_data->cnt = 0;
+  }
+
+  for (int chunk_idx = 0; chunk_idx < chunks_init; chunk_idx++)
+  {
+    count_words_chunk_t *chunk = chunks + chunk_idx;
+
+    wl_data_destroy (chunk->hashcat_ctx);
+
+    hcfree (chunk->hashcat_ctx->wl_data);
+    hcfree (chunk->hashcat_ctx);
+
+    hcfree (chunk->index_buf);
+  }
+
+  hcfree (chunks);
+  hcfree (threads);
+
+  // the whole file was consumed, same as after the serial count
+
+  fp->mm_pos = fp->mm_len;
+
+  return rc;
+}
+
+int count_words (hashcat_ctx_t *hashcat_ctx, HCFILE *fp, const char *dictfile, u64 *result)
+{
+  user_options_extra_t *user_options_extra = hashcat_ctx->user_options_extra;
+  user_options_t       *user_options       = hashcat_ctx->user_options;
+  wl_data_t            *wl_data            = hashcat_ctx->wl_data;
+
+  //hc_signal (NULL);
+
+  dictstat_t d;
+
+  memset (&d, 0, sizeof (d));
+
+  if (fstat (hc_fileno (fp), &d.stat))
+  {
+    *result = 0;
+
+    return 0;
+  }
+
+  d.stat.st_mode    = 0;
+  d.stat.st_nlink   = 0;
+  d.stat.st_uid     = 0;
+  d.stat.st_gid     = 0;
+  d.stat.st_rdev    = 0;
+  d.stat.st_atime   = 0;
+
+  #if defined (STAT_NANOSECONDS_ACCESS_TIME)
+  d.stat.STAT_NANOSECONDS_ACCESS_TIME = 0;
+  #endif
 
   #if defined (_POSIX)
   d.stat.st_blksize = 0;
@@ -379,6 +1151,33 @@ int count_words (hashcat_ctx_t *hashcat_ctx, HCFILE *fp, const char *dictfile, u
     return 0;
   }
 
+  // a compiled wordlist carries its length histogram, nothing to count
+
+  if (hcwl_detect (fp) == true)
+  {
+    u64 cnt = 0;
+
+    if (hcwl_count_words (hashcat_ctx, fp, &cnt) == -1)
+    {
+      event_log_error (hashcat_ctx, "%s: Invalid, truncated or outdated compiled wordlist.", dictfile);
+
+      return -1;
+    }
+
+    const u64 multiplier = count_words_multiplier (hashcat_ctx);
+
+    if (overflow_check_u64_mul (cnt, multiplier) == false)
+    {
+      event_log_error (hashcat_ctx, "Integer overflow detected in keyspace of wordlist: %s", dictfile);
+
+      return -1;
+    }
+
+    *result = cnt * multiplier;
+
+    return 0;
+  }
+
   const size_t dictfile_len = strlen (dictfile);
 
   u32 *dictfile_padded = (u32 *) hcmalloc (dictfile_len + 64); // padding required for sha1_update()
@@ -394,36 +1193,39 @@ int count_words (hashcat_ctx_t *hashcat_ctx, HCFILE *fp, const char *dictfile, u
 
   memcpy (d.hash_filename, sha1_ctx.h, 16);
 
+  // the sparse word offset index is only valid for the parser configuration it was built with
+  // words rejected by -j are not counted either, and seeking is not supported for zip files
+
+  const u32 parser = wl_data_parser (hashcat_ctx);
+
+  const bool index_enabled = (run_rule_engine (user_options_extra->rule_len_l, user_options->rule_buf_l) == 0) && (fp->is_zip == false);
+
+  dictstat_index_reset (hashcat_ctx);
+
   const u64 cached_cnt = dictstat_find (hashcat_ctx, &d);
 
   if (run_rule_engine (user_options_extra->rule_len_l, user_options->rule_buf_l) == 0)
   {
     if (cached_cnt)
     {
-      u64 keyspace = cached_cnt;
-
-      if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
+      if (index_enabled == true)
       {
-        if (overflow_check_u64_mul (keyspace, straight_ctx->kernel_rules_cnt) == false) return -1;
+        d.cnt = cached_cnt;
 
-        keyspace *= straight_ctx->kernel_rules_cnt;
+        dictstat_index_read (hashcat_ctx, &d, parser, dictfile);
       }
-      else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
-      {
-        if (((hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL) == 0) && (user_options->attack_mode == ATTACK_MODE_HYBRID2))
-        {
-          if (overflow_check_u64_mul (keyspace, mask_ctx->bfs_cnt) == false) return -1;
 
-          keyspace *= mask_ctx->bfs_cnt;
-        }
-        else
-        {
-          if (overflow_check_u64_mul (keyspace, combinator_ctx->combs_cnt) == false) return -1;
+      const u64 multiplier = count_words_multiplier (hashcat_ctx);
 
-          keyspace *= combinator_ctx->combs_cnt;
-        }
+      if (overflow_check_u64_mul (cached_cnt, multiplier) == false)
+      {
+        event_log_error (hashcat_ctx, "Integer overflow detected in keyspace of wordlist: %s", dictfile);
+
+        return -1;
       }
 
+      const u64 keyspace = cached_cnt * multiplier;
+
       cache_hit_t cache_hit;
 
       cache_hit.dictfile      = dictfile;
@@ -443,118 +1245,89 @@ int count_words (hashcat_ctx_t *hashcat_ctx, HCFILE *fp, const char *dictfile, u
 
   time (&rt_start);
 
-  time_t now  = 0;
-  time_t prev = 0;
+  const u64 multiplier = count_words_multiplier (hashcat_ctx);
 
   u64 comp = 0;
-  u64 cnt  = 0;
   u64 cnt2 = 0;
 
-  while (!hc_feof (fp))
-  {
-    load_segment (hashcat_ctx, fp);
+  u64 *index_buf   = NULL;
+  u64  index_cnt   = 0;
+  u64  index_avail = 0;
 
-    comp += wl_data->cnt;
+  hc_gzidx_t *gzidx = NULL;
 
-    u64 i = 0;
+  const int chunks_cnt = count_words_chunks (hashcat_ctx, fp);
 
-    while (i < wl_data->cnt)
+  if (chunks_cnt > 1)
+  {
+    if (count_words_mt (hashcat_ctx, fp, dictfile, d.stat.st_size, chunks_cnt, index_enabled, multiplier, &d.cnt, &cnt2, &index_buf, &index_cnt) == -1)
     {
-      u64 len;
-      u64 off;
-
-      char *ptr = wl_data->buf + i;
-
-      wl_data->func (ptr, wl_data->cnt - i, &len, &off);
+      hcfree (index_buf);
 
-      i += off;
-
-      // do the on-the-fly hex decode using original buffer
-      // this is safe as length only decreases in size
-
-      len = (u32) convert_from_hex (hashcat_ctx, ptr, len);
-
-      // do the on-the-fly encoding
+      return -1;
+    }
 
-      if (wl_data->iconv_enabled == true)
-      {
-        char  *iconv_ptr = wl_data->iconv_tmp;
-        size_t iconv_sz  = HCBUFSIZ_TINY;
+    comp = (u64) d.stat.st_size;
+  }
+  else
+  {
+    time_t now  = 0;
+    time_t prev = 0;
 
-        size_t ptr_len = len;
+    // record inflate checkpoints along the way, a later seek into a gzip compressed dictionary then no longer inflates from the start
 
-        const size_t iconv_rc = iconv (wl_data->iconv_ctx, &ptr, &ptr_len, &iconv_ptr, &iconv_sz);
+    if ((index_enabled == true) && (fp->is_gzip == true)) hc_gzidx_build (fp, DICTSTAT_GZIDX_SPAN);
 
-        if (iconv_rc == (size_t) -1) continue;
+    // decompression and disk reads overlap with the counting
 
-        ptr = wl_data->iconv_tmp;
-        len = HCBUFSIZ_TINY - iconv_sz;
-      }
+    wl_readahead_start (hashcat_ctx, fp);
 
-      if (run_rule_engine (user_options_extra->rule_len_l, user_options->rule_buf_l))
+    while (!wl_data_feof (hashcat_ctx, fp))
+    {
+      if (load_segment (hashcat_ctx, fp) == -1)
       {
-        if (len >= RP_PASSWORD_SIZE) continue;
+        wl_readahead_stop (hashcat_ctx);
 
-        char rule_buf_out[RP_PASSWORD_SIZE];
-
-        memset (rule_buf_out, 0, sizeof (rule_buf_out));
+        hc_gzidx_free (hc_gzidx_release (fp));
 
-        const int rule_len_out = _old_apply_rule (user_options->rule_buf_l, user_options_extra->rule_len_l, ptr, (u32) len, rule_buf_out);
+        hcfree (index_buf);
 
-        if (rule_len_out < 0) continue;
+        return -1;
       }
 
-      cnt2++;
+      const u64 seg_off = comp;
 
-      if (len > PW_MAX) continue;
+      comp += wl_data->cnt;
 
-      d.cnt++;
+      count_words_segment (hashcat_ctx, seg_off, (index_enabled == true) ? DICTSTAT_INDEX_INTERVAL : 0, &d.cnt, &cnt2, &index_buf, &index_cnt, &index_avail);
 
-      if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
-      {
-        if (overflow_check_u64_add (cnt, straight_ctx->kernel_rules_cnt) == false) return -1;
+      time (&now);
 
-        cnt += straight_ctx->kernel_rules_cnt;
-      }
-      else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
-      {
-        if (((hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL) == 0) && (user_options->attack_mode == ATTACK_MODE_HYBRID2))
-        {
-          if (overflow_check_u64_add (cnt, mask_ctx->bfs_cnt) == false) return -1;
+      if ((now - prev) == 0) continue;
 
-          cnt += mask_ctx->bfs_cnt;
-        }
-        else
-        {
-          if (overflow_check_u64_add (cnt, combinator_ctx->combs_cnt) == false) return -1;
+      time (&prev);
 
-          cnt += combinator_ctx->combs_cnt;
-        }
-      }
+      count_words_progress (hashcat_ctx, dictfile, d.stat.st_size, comp, d.cnt * multiplier, cnt2);
     }
 
-    time (&now);
-
-    if ((now - prev) == 0) continue;
+    wl_readahead_stop (hashcat_ctx);
 
-    time (&prev);
+    gzidx = hc_gzidx_release (fp);
+  }
 
-    double percent = ((double) comp / (double) d.stat.st_size) * 100;
+  if (overflow_check_u64_mul (d.cnt, multiplier) == false)
+  {
+    event_log_error (hashcat_ctx, "Integer overflow detected in keyspace of wordlist: %s", dictfile);
 
-    if (percent < 100)
-    {
-      cache_generate_t cache_generate;
+    hcfree (index_buf);
 
-      cache_generate.dictfile    = dictfile;
-      cache_generate.comp        = comp;
-      cache_generate.percent     = percent;
-      cache_generate.cnt         = cnt;
-      cache_generate.cnt2        = cnt2;
+    hc_gzidx_free (gzidx);
 
-      EVENT_DATA (EVENT_WORDLIST_CACHE_GENERATE, &cache_generate, sizeof (cache_generate));
-    }
+    return -1;
   }
 
+  const u64 cnt = d.cnt * multiplier;
+
   time_t rt_stop;
 
   time (&rt_stop);
@@ -572,6 +1345,10 @@ int count_words (hashcat_ctx_t *hashcat_ctx, HCFILE *fp, const char *dictfile, u
 
   dictstat_append (hashcat_ctx, &d);
 
+  // a failure to store the index is not fatal, it only makes seeking slower
+
+  dictstat_index_write (hashcat_ctx, &d, parser, dictfile, index_buf, index_cnt, gzidx);
+
   //hc_signal (sigHandler_default);
 
   *result = cnt;
@@ -601,6 +1378,7 @@ int wl_data_init (hashcat_ctx_t *hashcat_ctx)
   wl_data->incr  = user_options->segment_size;
   wl_data->cnt   = 0;
   wl_data->pos   = 0;
+  wl_data->seg   = wl_data->buf;
 
   /**
    * choose dictionary parser
@@ -643,6 +1421,7 @@ void wl_data_destroy (hashcat_ctx_t *hashcat_ctx)
   if (wl_data->enabled == false) return;
 
   hcfree (wl_data->buf);
+  hcfree (wl_data->word_buf);
 
   if (wl_data->iconv_enabled == true)
   {
@@ -655,3 +1434,404 @@ void wl_data_destroy (hashcat_ctx_t *hashcat_ctx)
 
   memset (wl_data, 0, sizeof (wl_data_t));
 }
+
+static const char *wl_ring_dictfile (hashcat_ctx_t *hashcat_ctx)
+{
+  const combinator_ctx_t *combinator_ctx = hashcat_ctx->combinator_ctx;
+  const straight_ctx_t   *straight_ctx   = hashcat_ctx->straight_ctx;
+  const user_options_t   *user_options   = hashcat_ctx->user_options;
+
+  if (user_options->attack_mode == ATTACK_MODE_COMBI)
+  {
+    if (combinator_ctx->combs_mode == COMBINATOR_MODE_BASE_LEFT) return combinator_ctx->dict1;
+
+    return combinator_ctx->dict2;
+  }
+
+  return straight_ctx->dict;
+}
+
+HC_API_CALL void *thread_wl_ring (void *p)
+{
+  hashcat_ctx_t *hashcat_ctx = (hashcat_ctx_t *) p;
+
+  hashconfig_t         *hashconfig         = hashcat_ctx->hashconfig;
+  user_options_t       *user_options       = hashcat_ctx->user_options;
+  user_options_extra_t *user_options_extra = hashcat_ctx->user_options_extra;
+  wl_ring_t            *wl_ring            = hashcat_ctx->wl_ring;
+
+  hashcat_ctx_t *hashcat_ctx_tmp = wl_ring->hashcat_ctx_tmp;
+
+  const u32 attack_kern = user_options_extra->attack_kern;
+
+  u64 words_cur = 0;
+
+  skip_words (hashcat_ctx_tmp, &wl_ring->fp, wl_ring->dictfile, &words_cur, wl_ring->words_start);
+
+  wl_readahead_start (hashcat_ctx_tmp, &wl_ring->fp);
+
+  bool read_error = false;
+
+  for (u64 seq = 0; words_cur < wl_ring->words_end; seq++)
+  {
+    wl_ring_slot_t *slot = wl_ring->slots + (seq % wl_ring->slots_cnt);
+
+    // wait until the device threads took all words of the batch previously stored in this slot
+
+    while ((hc_atomic_load (&slot->seq) != 0) && (hc_atomic_load (&slot->words_done) < slot->words_cnt))
+    {
+      if (hc_atomic_load (&wl_ring->run) == false) break;
+
+      usleep (WL_RING_WAIT_USEC);
+    }
+
+    if (hc_atomic_load (&wl_ring->run) == false) break;
+
+    const u64 words_cnt = MIN (WL_RING_SLOT_WORDS, wl_ring->words_end - words_cur);
+
+    u32 pws_comp_off = 0;
+
+    for (u64 word_pos = 0; word_pos < words_cnt; word_pos++)
+    {
+      pw_idx_t *pw_idx = slot->pws_idx + word_pos;
+
+      pw_idx->off = pws_comp_off;
+      pw_idx->cnt = 0;
+      pw_idx->len = 0;
+
+      slot->pws_rejected[word_pos] = 1;
+
+      char *line_buf = NULL;
+      u32   line_len = 0;
+
+      get_next_word (hashcat_ctx_tmp, &wl_ring->fp, &line_buf, &line_len);
+
+      // a read error was already reported by load_segment (), don't keep feeding the devices with rejects
+
+      if ((line_buf == NULL) && (hc_ferror (&wl_ring->fp)))
+      {
+        read_error = true;
+
+        break;
+      }
+
+      // the wordlist is shorter than what we counted, that is if it changed in the meantime
+
+      if (line_buf == NULL) continue;
+
+      // post-process rule engine
+
+      char rule_buf_out[RP_PASSWORD_SIZE];
+
+      if (run_rule_engine ((int) user_options_extra->rule_len_l, user_options->rule_buf_l))
+      {
+        if (line_len >= RP_PASSWORD_SIZE) continue;
+
+        memset (rule_buf_out, 0, sizeof (rule_buf_out));
+
+        const int rule_len_out = _old_apply_rule (user_options->rule_buf_l, (int) user_options_extra->rule_len_l, line_buf, (int) line_len, rule_buf_out);
+
+        if (rule_len_out < 0) continue;
+
+        line_buf = rule_buf_out;
+        line_len = (u32) rule_len_out;
+      }
+
+      if (attack_kern == ATTACK_KERN_STRAIGHT)
+      {
+        if ((line_len < hashconfig->pw_min) || (line_len > hashconfig->pw_max)) continue;
+      }
+      else if (attack_kern == ATTACK_KERN_COMBI)
+      {
+        // do not check if minimum restriction is satisfied (line_len >= hashconfig->pw_min) here
+        // since we still need to combine the plains
+
+        if (line_len > hashconfig->pw_max) continue;
+      }
+
+      const u32 pw_len4 = (line_len + 3) & ~3; // round up to multiple of 4
+
+      const u32 pw_len4_cnt = pw_len4 / 4;
+
+      if ((pws_comp_off + pw_len4_cnt) > slot->pws_comp_avail)
+      {
+        slot->pws_comp = (u32 *) hcrealloc (slot->pws_comp, slot->pws_comp_avail * sizeof (u32), INCR_WL_RING_COMP * sizeof (u32));
+
+        slot->pws_comp_avail += INCR_WL_RING_COMP;
+      }
+
+      u8 *dst = (u8 *) (slot->pws_comp + pws_comp_off);
+
+      memcpy (dst, line_buf, line_len);
+
+      memset (dst + line_len, 0, pw_len4 - line_len);
+
+      pw_idx->cnt = pw_len4_cnt;
+      pw_idx->len = line_len;
+
+      slot->pws_rejected[word_pos] = 0;
+
+      pws_comp_off += pw_len4_cnt;
+    }
+
+    if (read_error == true)
+    {
+      myabort (hashcat_ctx);
+
+      break;
+    }
+
+    slot->words_cnt  = words_cnt;
+    slot->words_done = 0;
+
+    hc_atomic_store (&slot->seq, seq + 1);
+
+    hc_atomic_store (&wl_ring->io_wait_usec, hashcat_ctx_tmp->wl_data->ra.wait_usec);
+
+    words_cur += words_cnt;
+  }
+
+  wl_readahead_stop (hashcat_ctx_tmp);
+
+  hc_atomic_store (&wl_ring->io_wait_usec, hashcat_ctx_tmp->wl_data->ra.wait_usec);
+
+  hc_atomic_store (&wl_ring->finished, true);
+
+  return NULL;
+}
+
+int wl_ring_init (hashcat_ctx_t *hashcat_ctx)
+{
+  backend_ctx_t        *backend_ctx        = hashcat_ctx->backend_ctx;
+  hashconfig_t         *hashconfig         = hashcat_ctx->hashconfig;
+  status_ctx_t         *status_ctx         = hashcat_ctx->status_ctx;
+  user_options_t       *user_options       = hashcat_ctx->user_options;
+  user_options_extra_t *user_options_extra = hashcat_ctx->user_options_extra;
+  wl_ring_t            *wl_ring            = hashcat_ctx->wl_ring;
+
+  wl_ring->enabled = false;
+
+  if (user_options->slow_candidates == true) return 0;
+
+  if (user_options_extra->wordlist_mode != WL_MODE_FILE) return 0;
+
+  if (((hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL) == 0) && (user_options->attack_mode == ATTACK_MODE_HYBRID2)) return 0;
+
+  wl_ring->dictfile = hcstrdup (wl_ring_dictfile (hashcat_ctx));
+
+  if (hc_fopen (&wl_ring->fp, wl_ring->dictfile, "rb") == false)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", wl_ring->dictfile, strerror (errno));
+
+    hcfree (wl_ring->dictfile);
+
+    return -1;
+  }
+
+  // compiled wordlists are already decoded, filtered and padded, the device threads copy from them directly
+
+  if (hcwl_detect (&wl_ring->fp) == true)
+  {
+    if (hcwl_open (hashcat_ctx, &wl_ring->hcwl, &wl_ring->fp) == -1)
+    {
+      event_log_error (hashcat_ctx, "%s: Invalid, truncated or outdated compiled wordlist.", wl_ring->dictfile);
+
+      hc_fclose (&wl_ring->fp);
+
+      hcfree (wl_ring->dictfile);
+
+      return -1;
+    }
+
+    wl_ring->enabled = true;
+
+    return 0;
+  }
+
+  hashcat_ctx_t *hashcat_ctx_tmp = (hashcat_ctx_t *) hcmalloc (sizeof (hashcat_ctx_t));
+
+  memcpy (hashcat_ctx_tmp, hashcat_ctx, sizeof (hashcat_ctx_t)); // yes we actually want to copy these pointers
+
+  hashcat_ctx_tmp->wl_data = (wl_data_t *) hcmalloc (sizeof (wl_data_t));
+
+  if (wl_data_init (hashcat_ctx_tmp) == -1)
+  {
+    hc_fclose (&wl_ring->fp);
+
+    hcfree (hashcat_ctx_tmp->wl_data);
+    hcfree (hashcat_ctx_tmp);
+
+    hcfree (wl_ring->dictfile);
+
+    return -1;
+  }
+
+  wl_ring->hashcat_ctx_tmp = hashcat_ctx_tmp;
+
+  wl_ring->words_start = status_ctx->words_off;
+  wl_ring->words_end   = (user_options->limit == 0) ? status_ctx->words_base : MIN (user_options->limit, status_ctx->words_base);
+
+  // the devices claim kernel_power_all words per round, twice that if they prefetch the next batch,
+  // and the reader thread has to fill another round of that while they work on the current one
+
+  u64 words_round = backend_ctx->kernel_power_all;
+
+  for (int backend_devices_idx = 0; backend_devices_idx < backend_ctx->backend_devices_cnt; backend_devices_idx++)
+  {
+    const hc_device_param_t *device_param = &backend_ctx->devices_param[backend_devices_idx];
+
+    if (device_param->skipped == true) continue;
+
+    if (device_param->skipped_warning == true) continue;
+
+    if (device_param->pws_prefetch == false) continue;
+
+    words_round = (u64) backend_ctx->kernel_power_all * 2;
+
+    break;
+  }
+
+  const u64 words_total = wl_ring->words_end - MIN (wl_ring->words_start, wl_ring->words_end);
+
+  u64 slots_cnt = CEILDIV (words_round * 2, WL_RING_SLOT_WORDS);
+
+  slots_cnt = MAX (slots_cnt, WL_RING_SLOTS_MIN);
+  slots_cnt = MIN (slots_cnt, CEILDIV (words_total, WL_RING_SLOT_WORDS) + 1);
+
+  wl_ring->slots_cnt = slots_cnt;
+
+  wl_ring->slots = (wl_ring_slot_t *) hccalloc (wl_ring->slots_cnt, sizeof (wl_ring_slot_t));
+
+  for (u64 slot_idx = 0; slot_idx < wl_ring->slots_cnt; slot_idx++)
+  {
+    wl_ring_slot_t *slot = wl_ring->slots + slot_idx;
+
+    slot->pws_idx        = (pw_idx_t *) hccalloc (WL_RING_SLOT_WORDS, sizeof (pw_idx_t));
+    slot->pws_rejected   = (u8 *)       hccalloc (WL_RING_SLOT_WORDS, sizeof (u8));
+    slot->pws_comp       = (u32 *)      hccalloc (INCR_WL_RING_COMP,  sizeof (u32));
+    slot->pws_comp_avail = INCR_WL_RING_COMP;
+  }
+
+  wl_ring->run      = true;
+  wl_ring->finished = false;
+
+  wl_ring->enabled = true;
+
+  hc_thread_create (wl_ring->thread, thread_wl_ring, hashcat_ctx);
+
+  return 0;
+}
+
+void wl_ring_destroy (hashcat_ctx_t *hashcat_ctx)
+{
+  wl_ring_t *wl_ring = hashcat_ctx->wl_ring;
+
+  if (wl_ring->enabled == false) return;
+
+  if (wl_ring->hcwl.enabled == true)
+  {
+    hcwl_close (&wl_ring->hcwl);
+
+    hc_fclose (&wl_ring->fp);
+
+    hcfree (wl_ring->dictfile);
+
+    memset (wl_ring, 0, sizeof (wl_ring_t));
+
+    return;
+  }
+
+  hc_atomic_store (&wl_ring->run, false);
+
+  hc_thread_wait (1, &wl_ring->thread);
+
+  hc_fclose (&wl_ring->fp);
+
+  wl_data_destroy (wl_ring->hashcat_ctx_tmp);
+
+  hcfree (wl_ring->hashcat_ctx_tmp->wl_data);
+  hcfree (wl_ring->hashcat_ctx_tmp);
+
+  for (u64 slot_idx = 0; slot_idx < wl_ring->slots_cnt; slot_idx++)
+  {
+    wl_ring_slot_t *slot = wl_ring->slots + slot_idx;
+
+    hcfree (slot->pws_idx);
+    hcfree (slot->pws_rejected);
+    hcfree (slot->pws_comp);
+  }
+
+  hcfree (wl_ring->slots);
+  hcfree (wl_ring->dictfile);
+
+  memset (wl_ring, 0, sizeof (wl_ring_t));
+}
+
+u64 wl_ring_get (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u64 words_off, const u64 words_fin)
+{
+  status_ctx_t *status_ctx = hashcat_ctx->status_ctx;
+  wl_ring_t    *wl_ring    = hashcat_ctx->wl_ring;
+
+  if (wl_ring->hcwl.enabled == true)
+  {
+    hcwl_get (&wl_ring->hcwl, &wl_ring->fp, device_param, words_off, words_fin);
+
+    return 0;
+  }
+
+  u64 words_extra = 0;
+
+  u64 words_cur = words_off;
+
+  while (words_cur < words_fin)
+  {
+    const u64 words_pos = words_cur - wl_ring->words_start;
+
+    const u64 seq = words_pos / WL_RING_SLOT_WORDS;
+
+    wl_ring_slot_t *slot = wl_ring->slots + (seq % wl_ring->slots_cnt);
+
+    // wait for the reader thread to publish the batch containing words_cur
+
+    while (hc_atomic_load (&slot->seq) != (seq + 1))
+    {
+      if (status_ctx->run_thread_level1 == false) return words_extra;
+
+      if (hc_atomic_load (&wl_ring->finished) == true)
+      {
+        if (hc_atomic_load (&slot->seq) == (seq + 1)) break;
+
+        // nothing more to read, treat the remaining words as rejected
+
+        return words_extra + (words_fin - words_cur);
+      }
+
+      usleep (WL_RING_WAIT_USEC);
+    }
+
+    const u64 word_first = words_pos % WL_RING_SLOT_WORDS;
+    const u64 word_last  = MIN (slot->words_cnt, word_first + (words_fin - words_cur));
+
+    for (u64 word_pos = word_first; word_pos < word_last; word_pos++)
+    {
+      if (slot->pws_rejected[word_pos] == 1)
+      {
+        words_extra++;
+
+        continue;
+      }
+
+      const pw_idx_t *pw_idx = slot->pws_idx + word_pos;
+
+      pw_add (device_param, (const u8 *) (slot->pws_comp + pw_idx->off), (const int) pw_idx->len);
+    }
+
+    // once all words of a batch are taken, the reader thread can reuse the slot
+
+    hc_atomic_fetch_add (&slot->words_done, word_last - word_first);
+
+    words_cur += word_last - word_first;
+  }
+
+  return words_extra;
+}